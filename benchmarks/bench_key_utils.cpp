@@ -0,0 +1,68 @@
+// Key name conversions: keyToString / keyToStringView / stringToKey.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <typr-io/core.hpp>
+
+using typr::io::Key;
+using typr::io::kKeyCount;
+
+namespace {
+
+std::vector<std::string> canonicalNames() {
+  std::vector<std::string> names;
+  for (std::size_t i = 1; i < kKeyCount; ++i)
+    names.push_back(typr::io::keyToString(static_cast<Key>(i)));
+  return names;
+}
+
+void BM_KeyToString(benchmark::State &state) {
+  for (auto _ : state) {
+    for (std::size_t i = 1; i < kKeyCount; ++i)
+      benchmark::DoNotOptimize(typr::io::keyToString(static_cast<Key>(i)));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(kKeyCount - 1));
+}
+BENCHMARK(BM_KeyToString);
+
+void BM_KeyToStringView(benchmark::State &state) {
+  for (auto _ : state) {
+    for (std::size_t i = 1; i < kKeyCount; ++i)
+      benchmark::DoNotOptimize(
+          typr::io::keyToStringView(static_cast<Key>(i)));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(kKeyCount - 1));
+}
+BENCHMARK(BM_KeyToStringView);
+
+void BM_StringToKeyCanonical(benchmark::State &state) {
+  const std::vector<std::string> names = canonicalNames();
+  for (auto _ : state) {
+    for (const std::string &name : names)
+      benchmark::DoNotOptimize(typr::io::stringToKey(name));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(names.size()));
+}
+BENCHMARK(BM_StringToKeyCanonical);
+
+void BM_StringToKeyAliases(benchmark::State &state) {
+  // Case-folded lookups, aliases and the heuristic fallbacks
+  const std::vector<std::string> names = {"enter", "ESC",   "ctrl",  "pgdn",
+                                          "f12",   "kp_5",  "space", "Del",
+                                          "unknown-key-name"};
+  for (auto _ : state) {
+    for (const std::string &name : names)
+      benchmark::DoNotOptimize(typr::io::stringToKey(name));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(names.size()));
+}
+BENCHMARK(BM_StringToKeyAliases);
+
+} // namespace
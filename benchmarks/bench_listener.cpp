@@ -0,0 +1,89 @@
+// Listener dispatch overhead: the per-event work a backend does between
+// decoding an OS event and returning from the consumer's callback (RCU
+// callback read, stats recording, callback adaptation, queue hand-off).
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+
+#include <typr-io/listener.hpp>
+
+#include "common/rcu_cell.hpp"
+#include "common/spsc_ring.hpp"
+#include "common/stats_recorder.hpp"
+
+using typr::io::Key;
+using typr::io::Listener;
+using typr::io::Modifier;
+
+namespace {
+
+Listener::Event sampleEvent() {
+  return Listener::Event{U'a', Key::A, Modifier::None, true,
+                         typr::io::detail::steadyNowNs()};
+}
+
+void BM_ListenerDispatchEvent(benchmark::State &state) {
+  typr::io::detail::RcuCell<Listener::EventCallback> callback;
+  typr::io::detail::ListenerStatsRecorder stats;
+  uint64_t seen = 0;
+  callback.store([&seen](const Listener::Event &ev) { seen += ev.pressed; });
+  stats.reset();
+
+  const Listener::Event event = sampleEvent();
+  for (auto _ : state) {
+    stats.timed(event.timestampNs, [&]() {
+      callback.visit([&](const Listener::EventCallback &cb) { cb(event); });
+    });
+  }
+  benchmark::DoNotOptimize(seen);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ListenerDispatchEvent);
+
+void BM_ListenerDispatchLegacyCallback(benchmark::State &state) {
+  // Four-argument Listener::Callback behind the EventCallback adapter
+  Listener::Callback legacy = [](char32_t cp, Key, Modifier, bool) {
+    benchmark::DoNotOptimize(cp);
+  };
+  typr::io::detail::RcuCell<Listener::EventCallback> callback;
+  callback.store([cb = std::move(legacy)](const Listener::Event &ev) {
+    cb(ev.codepoint, ev.key, ev.mods, ev.pressed);
+  });
+  typr::io::detail::ListenerStatsRecorder stats;
+  stats.reset();
+
+  const Listener::Event event = sampleEvent();
+  for (auto _ : state) {
+    stats.timed(event.timestampNs, [&]() {
+      callback.visit([&](const Listener::EventCallback &cb) { cb(event); });
+    });
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ListenerDispatchLegacyCallback);
+
+void BM_ListenerQueuedRoundTrip(benchmark::State &state) {
+  // Queued delivery: push on the hook side, drain in batches of 64
+  typr::io::detail::SpscRing<Listener::Event> ring(4096);
+  std::array<Listener::Event, 64> batch;
+  const Listener::Event event = sampleEvent();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch.size(); ++i)
+      ring.tryPush(event);
+    benchmark::DoNotOptimize(ring.popBulk(batch.data(), batch.size()));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(batch.size()));
+}
+BENCHMARK(BM_ListenerQueuedRoundTrip);
+
+void BM_SteadyNowNs(benchmark::State &state) {
+  // Timestamping cost paid twice per event by the stats recorder
+  for (auto _ : state)
+    benchmark::DoNotOptimize(typr::io::detail::steadyNowNs());
+}
+BENCHMARK(BM_SteadyNowNs);
+
+} // namespace
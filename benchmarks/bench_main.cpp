@@ -0,0 +1,23 @@
+// Entry point for typr-io-benchmarks.
+//
+// Same as benchmark_main, except that library logging defaults to errors only
+// (the library default is debug) so log I/O does not distort the timings.
+// Set TYPR_IO_LOG_LEVEL to override.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+#include <typr-io/log.hpp>
+
+int main(int argc, char **argv) {
+  if (!std::getenv("TYPR_IO_LOG_LEVEL"))
+    typr::io::log::setLevel(typr::io::log::Level::Error);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
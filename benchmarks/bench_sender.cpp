@@ -0,0 +1,81 @@
+// Sender costs: backend start-up (device creation and layout-map build) and
+// per-keystroke injection. The injection benchmarks need a working sink
+// (e.g. /dev/uinput access on Linux) and are skipped otherwise.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+#include <typr-io/sender.hpp>
+
+using typr::io::Key;
+using typr::io::Sender;
+
+namespace {
+
+/**
+ * @brief Shared sender for the injection benchmarks (created once; backend
+ * start-up is measured separately by BM_SenderCreate).
+ */
+Sender &sharedSender() {
+  static Sender sender = []() {
+    Sender s;
+    s.setKeyDelay(0);
+    return s;
+  }();
+  return sender;
+}
+
+bool requireSink(benchmark::State &state, Sender &sender) {
+  if (sender.isReady() && sender.capabilities().canInjectKeys)
+    return true;
+  state.SkipWithError("no injection sink available (needs uinput access "
+                      "or platform permissions)");
+  return false;
+}
+
+void BM_SenderCreate(benchmark::State &state) {
+  for (auto _ : state) {
+    auto sender = std::make_unique<Sender>();
+    benchmark::DoNotOptimize(sender->capabilities());
+  }
+}
+BENCHMARK(BM_SenderCreate)->Unit(benchmark::kMillisecond)->Iterations(5);
+
+void BM_SenderTap(benchmark::State &state) {
+  Sender &sender = sharedSender();
+  if (!requireSink(state, sender))
+    return;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(sender.tap(Key::F20));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SenderTap)->Unit(benchmark::kMicrosecond);
+
+void BM_SenderTypeText(benchmark::State &state) {
+  Sender &sender = sharedSender();
+  if (!requireSink(state, sender))
+    return;
+  const std::string text = "the quick brown fox jumps over the lazy dog";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(sender.typeText(text));
+  // Items are keystrokes (characters), so the rate reads as keys/second
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_SenderTypeText)->Unit(benchmark::kMicrosecond);
+
+void BM_SenderTypeTextBulk(benchmark::State &state) {
+  Sender &sender = sharedSender();
+  if (!requireSink(state, sender))
+    return;
+  const std::string text = "the quick brown fox jumps over the lazy dog";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(sender.typeTextBulk(text));
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_SenderTypeTextBulk)->Unit(benchmark::kMicrosecond);
+
+} // namespace
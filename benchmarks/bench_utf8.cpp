@@ -0,0 +1,59 @@
+// UTF-8 decoding used by Sender::typeText(const std::string&): UTF-32 for
+// the uinput backend, UTF-16 for the macOS and Windows backends.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "common/utf8.hpp"
+
+namespace {
+
+std::string repeat(const std::string &unit, std::size_t bytes) {
+  std::string out;
+  while (out.size() < bytes)
+    out += unit;
+  return out;
+}
+
+void BM_Utf8DecodeAscii(benchmark::State &state) {
+  const std::string text = repeat("The quick brown fox jumps over the lazy dog. ",
+                                  static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(typr::io::detail::utf8ToUtf32(text));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8DecodeAscii)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+void BM_Utf8DecodeMixed(benchmark::State &state) {
+  const std::string text =
+      repeat("Ça coûte 5 € — Жук 🙂 ", static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(typr::io::detail::utf8ToUtf32(text));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8DecodeMixed)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+void BM_Utf8ToUtf16Ascii(benchmark::State &state) {
+  const std::string text = repeat("The quick brown fox jumps over the lazy dog. ",
+                                  static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(typr::io::detail::utf8ToUtf16(text));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8ToUtf16Ascii)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+void BM_Utf8ToUtf16Mixed(benchmark::State &state) {
+  const std::string text =
+      repeat("Ça coûte 5 € — Жук 🙂 ", static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(typr::io::detail::utf8ToUtf16(text));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8ToUtf16Mixed)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+} // namespace
@@ -0,0 +1,139 @@
+#pragma once
+
+// typr-io - async_sender.hpp
+// Asynchronous front-end for typr::io::Sender.
+// `AsyncSender` owns a Sender and a dedicated injection thread. Any number of
+// threads can submit batches of work without blocking on key delays or
+// syscalls; each submission returns a future that completes once the batch
+// has been injected.
+//
+// Usage:
+//   #include <typr-io/async_sender.hpp>
+//   typr::io::AsyncSender async;
+//   auto done = async.typeText("Hello");
+//   async.submit([](typr::io::Sender &s) { return s.combo(
+//                    typr::io::Modifier::Ctrl, typr::io::Key::S); });
+//   done.wait();
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <typr-io/core.hpp>
+#include <typr-io/sender.hpp>
+
+namespace typr {
+namespace io {
+
+/**
+ * @class AsyncSender
+ * @brief Sender driven by a worker thread and a bounded submission queue.
+ *
+ * Batches are queued in a bounded multi-producer lock-free ring and executed
+ * one at a time, in submission order, on the worker thread. Batches submitted
+ * by the same thread therefore run in the order they were submitted. The
+ * wrapped `Sender` is only ever touched by the worker thread.
+ *
+ * Destroying an AsyncSender runs all batches that are still queued, then
+ * joins the worker.
+ */
+class TYPR_IO_API AsyncSender {
+public:
+  /**
+   * @brief A unit of work executed on the injection thread.
+   *
+   * The job receives the wrapped Sender and returns whether it succeeded;
+   * that value (or any exception thrown) is delivered through the future
+   * returned on submission.
+   */
+  using Job = std::function<bool(Sender &)>;
+
+  /**
+   * @brief Construct an AsyncSender and start its worker thread.
+   * @param queueCapacity Maximum number of queued batches (rounded up to a
+   * power of two).
+   */
+  explicit AsyncSender(std::size_t queueCapacity = 1024);
+
+  /**
+   * @brief Run all queued batches, then stop and join the worker thread.
+   */
+  ~AsyncSender();
+
+  AsyncSender(const AsyncSender &) = delete;
+  AsyncSender &operator=(const AsyncSender &) = delete;
+  AsyncSender(AsyncSender &&) noexcept;
+  AsyncSender &operator=(AsyncSender &&) noexcept;
+
+  // --- Info (snapshotted when the Sender was created) ---
+  /**
+   * @brief Return the backend type of the wrapped Sender.
+   */
+  [[nodiscard]] BackendType type() const;
+
+  /**
+   * @brief Return the capabilities of the wrapped Sender.
+   */
+  [[nodiscard]] Capabilities capabilities() const;
+
+  /**
+   * @brief Whether the wrapped Sender was ready to inject input.
+   */
+  [[nodiscard]] bool isReady() const;
+
+  // --- Submission ---
+  /**
+   * @brief Queue a batch, blocking while the queue is full.
+   * @param job Work to run on the injection thread.
+   * @return std::future<bool> Completes with the job's result.
+   */
+  std::future<bool> submit(Job job);
+
+  /**
+   * @brief Queue a batch without blocking.
+   * @param job Work to run on the injection thread.
+   * @return The completion future, or std::nullopt if the queue is full
+   * (apply backpressure and retry later).
+   */
+  std::optional<std::future<bool>> trySubmit(Job job);
+
+  /**
+   * @brief Number of batches queued and not yet started.
+   */
+  [[nodiscard]] std::size_t queueDepth() const;
+
+  /**
+   * @brief Maximum number of batches the queue can hold.
+   */
+  [[nodiscard]] std::size_t queueCapacity() const;
+
+  /**
+   * @brief Injection counters of the wrapped Sender (see `Sender::stats()`).
+   */
+  [[nodiscard]] SenderStats stats() const;
+
+  // --- Convenience batches (equivalent to submit() with one Sender call) ---
+  std::future<bool> keyDown(Key key);
+  std::future<bool> keyUp(Key key);
+  std::future<bool> tap(Key key);
+  // holdFor() and repeat() sleep between edges on the worker thread, so the
+  // caller is never woken per edge (unlike the synchronous Sender versions)
+  std::future<bool> holdFor(Key key, std::chrono::microseconds duration);
+  std::future<bool> repeat(Key key, uint32_t count, double perSecond);
+  std::future<bool> combo(Modifier mods, Key key);
+  std::future<bool> typeText(std::u32string text);
+  std::future<bool> typeText(std::string utf8Text);
+  std::future<bool> typeTextBulk(std::string utf8Text);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace io
+} // namespace typr
@@ -17,8 +17,14 @@
  *    provided callback must be thread-safe and avoid long-blocking work.
  *
  * Memory ownership:
- *  - Functions that return strings allocate heap memory which callers must
- *    free via `typr_io_free_string`.
+ *  - Functions that return `char *` allocate heap memory which callers must
+ *    free via `typr_io_free_string`. Functions that return `const char *`
+ *    (`typr_io_key_name`, `typr_io_last_error_message`, ...) never allocate
+ *    and must not be freed.
+ *
+ * Errors:
+ *  - The last error is kept per thread: it describes the most recent failing
+ *    C API call made by the calling thread.
  *
  * Example:
  * @code{.c}
@@ -73,6 +79,7 @@ extern "C" {
  */
 typedef void *typr_io_sender_t;
 typedef void *typr_io_listener_t;
+typedef void *typr_io_hotkeys_t;
 
 /**
  * @brief Primitive types used for keys and modifiers in the C API.
@@ -146,6 +153,110 @@ typedef void (*typr_io_listener_cb)(uint32_t codepoint, typr_io_key_t key,
                                     typr_io_modifier_t mods, bool pressed,
                                     void *user_data);
 
+/**
+ * @brief Listener event record (mirrors typr::io::Listener::Event).
+ *
+ * @var typr_io_event_t::codepoint Unicode codepoint (0 if none).
+ * @var typr_io_event_t::key Logical key id (0 if unknown).
+ * @var typr_io_event_t::mods Modifier bitmask at the time of the event.
+ * @var typr_io_event_t::pressed True for key press, false for key release.
+ * @var typr_io_event_t::timestamp_ns OS event time in nanoseconds on the
+ * C++ `std::chrono::steady_clock` timeline.
+ * @var typr_io_event_t::device Source device id, 0 if unknown.
+ */
+typedef struct typr_io_event_t {
+  uint32_t codepoint;
+  typr_io_key_t key;
+  typr_io_modifier_t mods;
+  bool pressed;
+  uint64_t timestamp_ns;
+  uint16_t device;
+} typr_io_event_t;
+
+/**
+ * @typedef typr_io_listener_event_cb
+ * @brief Listener callback receiving the full event record, including its
+ * timestamp.
+ *
+ * @param event Event record, valid only for the duration of the call.
+ * @param user_data Opaque pointer provided by the caller to
+ * `typr_io_listener_start_events`.
+ */
+typedef void (*typr_io_listener_event_cb)(const typr_io_event_t *event,
+                                          void *user_data);
+
+/**
+ * @typedef typr_io_hotkey_cb
+ * @brief Handler invoked when a registered hotkey completes.
+ *
+ * @param hotkey_id Id returned by `typr_io_hotkeys_add`.
+ * @param user_data Opaque pointer provided to `typr_io_hotkeys_add`.
+ */
+typedef void (*typr_io_hotkey_cb)(uint32_t hotkey_id, void *user_data);
+
+/**
+ * @brief Summary of a latency histogram (see typr::io::LatencyHistogram).
+ *
+ * Percentiles are bucket upper bounds (log2 buckets), clamped to `max_ns`.
+ */
+typedef struct typr_io_latency_t {
+  uint64_t count;
+  double mean_ns;
+  uint64_t p50_ns;
+  uint64_t p99_ns;
+  uint64_t max_ns;
+} typr_io_latency_t;
+
+/**
+ * @brief Listener counters (mirrors typr::io::ListenerStats).
+ */
+typedef struct typr_io_listener_stats_t {
+  uint64_t events;
+  uint64_t dropped_events;
+  uint64_t filtered_events; /* rejected by the listener's event filter */
+  uint64_t uptime_ns;
+  double events_per_second;
+  typr_io_latency_t hook_latency;
+  typr_io_latency_t callback_duration;
+} typr_io_listener_stats_t;
+
+/**
+ * @brief Sender counters (mirrors typr::io::SenderStats).
+ */
+typedef struct typr_io_sender_stats_t {
+  uint64_t injected_events;
+  uint64_t inject_calls;
+  uint64_t failed_calls;
+  uint64_t last_inject_ns;
+  typr_io_latency_t inject_duration;
+} typr_io_sender_stats_t;
+
+/**
+ * @brief Sender construction options (mirrors typr::io::SenderOptions).
+ */
+typedef struct typr_io_sender_options_t {
+  /** Linux: share a pool of this many uinput devices (0 = own device). */
+  uint32_t shared_device_pool;
+} typr_io_sender_options_t;
+
+/**
+ * @brief Listener construction options (mirrors typr::io::ListenerOptions).
+ *
+ * With no seats and no devices the listener monitors udev seat "seat0".
+ */
+typedef struct typr_io_listener_options_t {
+  /** Linux: udev seats to monitor, one worker thread each. */
+  const char *const *seats;
+  size_t seat_count;
+  /** Linux: device nodes to monitor (e.g. "/dev/input/event3"). */
+  const char *const *devices;
+  size_t device_count;
+  /** Linux: let workers invoke the callback concurrently (no queued mode). */
+  bool parallel_callbacks;
+  /** Windows: read keyboards through Raw Input instead of a hook. */
+  bool raw_input;
+} typr_io_listener_options_t;
+
 /** @name Sender (input injection)
  * @brief Functions to create and operate a Sender for injecting input.
  * @{
@@ -157,6 +268,14 @@ typedef void (*typr_io_listener_cb)(uint32_t codepoint, typr_io_key_t key,
  */
 TYPR_IO_API typr_io_sender_t typr_io_sender_create(void);
 
+/**
+ * @brief Create a new Sender instance with explicit options.
+ * @param options Options, or NULL for the defaults.
+ * @return typr_io_sender_t Opaque sender handle, or NULL on allocation failure.
+ */
+TYPR_IO_API typr_io_sender_t
+typr_io_sender_create_with_options(const typr_io_sender_options_t *options);
+
 /**
  * @brief Destroy a Sender instance.
  * @param sender Sender handle to destroy (safe to call with NULL).
@@ -268,6 +387,52 @@ TYPR_IO_API bool typr_io_sender_combo(typr_io_sender_t sender,
                                       typr_io_modifier_t mods,
                                       typr_io_key_t key);
 
+/**
+ * @brief Tap several keys in order with one call.
+ * @param sender Sender handle.
+ * @param keys Keys to tap (may be NULL when `count` is 0).
+ * @param count Number of keys.
+ * @return Number of keys tapped; stops at the first key that fails.
+ */
+TYPR_IO_API size_t typr_io_sender_tap_many(typr_io_sender_t sender,
+                                           const typr_io_key_t *keys,
+                                           size_t count);
+
+/**
+ * @brief Hold a key down for `duration_us` microseconds, then release it
+ * (see `Sender::holdFor`). Blocks the calling thread for the hold.
+ * @return true if both edges were injected.
+ */
+TYPR_IO_API bool typr_io_sender_hold_for(typr_io_sender_t sender,
+                                         typr_io_key_t key,
+                                         uint64_t duration_us);
+
+/**
+ * @brief Tap a key `count` times at `per_second` taps per second on an
+ * absolute schedule (see `Sender::repeat`). Blocks for the burst.
+ * @return true if every tap was injected.
+ */
+TYPR_IO_API bool typr_io_sender_repeat(typr_io_sender_t sender,
+                                       typr_io_key_t key, uint32_t count,
+                                       double per_second);
+
+/**
+ * @brief Inject a batch of key events with one call.
+ *
+ * An event with a known `key` presses or releases it. An event whose `key`
+ * is 0 types `codepoint` on press and is skipped on release. `mods`,
+ * `timestamp_ns` and `device` are ignored, so events read from a listener
+ * replay back to back (use a KeySequence for timed playback).
+ *
+ * @param sender Sender handle.
+ * @param events Events to inject (may be NULL when `count` is 0).
+ * @param count Number of events.
+ * @return Number of events injected; stops at the first event that fails.
+ */
+TYPR_IO_API size_t typr_io_sender_send_events(typr_io_sender_t sender,
+                                              const typr_io_event_t *events,
+                                              size_t count);
+
 /**
  * @brief Inject UTF-8 text directly (layout-independent on supporting
  * backends).
@@ -278,6 +443,42 @@ TYPR_IO_API bool typr_io_sender_combo(typr_io_sender_t sender,
 TYPR_IO_API bool typr_io_sender_type_text_utf8(typr_io_sender_t sender,
                                                const char *utf8_text);
 
+/**
+ * @brief Inject UTF-8 text as one pre-planned event stream (see
+ * `Sender::typeTextBulk`). Faster than `typr_io_sender_type_text_utf8` for
+ * large inputs.
+ * @param sender Sender handle.
+ * @param utf8_text Null-terminated UTF-8 string to inject.
+ * @return true if all characters were injected; false otherwise.
+ */
+TYPR_IO_API bool typr_io_sender_type_text_bulk_utf8(typr_io_sender_t sender,
+                                                    const char *utf8_text);
+
+/**
+ * @brief Inject `len` bytes of UTF-8 text without copying them.
+ *
+ * Like `typr_io_sender_type_text_utf8`, but the text needs no terminator and
+ * may contain NUL bytes, so bindings can pass their own string buffers.
+ * @param sender Sender handle.
+ * @param utf8_text UTF-8 bytes to inject (may be NULL when `len` is 0).
+ * @param len Number of bytes.
+ * @return true on success; false if not supported or on failure.
+ */
+TYPR_IO_API bool typr_io_sender_type_text_utf8_n(typr_io_sender_t sender,
+                                                 const char *utf8_text,
+                                                 size_t len);
+
+/**
+ * @brief Pointer + length variant of `typr_io_sender_type_text_bulk_utf8`.
+ * @param sender Sender handle.
+ * @param utf8_text UTF-8 bytes to inject (may be NULL when `len` is 0).
+ * @param len Number of bytes.
+ * @return true if all characters were injected; false otherwise.
+ */
+TYPR_IO_API bool typr_io_sender_type_text_bulk_utf8_n(typr_io_sender_t sender,
+                                                      const char *utf8_text,
+                                                      size_t len);
+
 /**
  * @brief Inject a single Unicode codepoint.
  * @param sender Sender handle.
@@ -301,6 +502,33 @@ TYPR_IO_API void typr_io_sender_flush(typr_io_sender_t sender);
  */
 TYPR_IO_API void typr_io_sender_set_key_delay(typr_io_sender_t sender,
                                               uint32_t delay_us);
+
+/**
+ * @brief Pace text injection at a target rate in characters per second (see
+ * `Sender::setTypingRate`).
+ * @param sender Sender handle.
+ * @param chars_per_second Target rate; 0 restores per-edge key delays.
+ */
+TYPR_IO_API void typr_io_sender_set_typing_rate(typr_io_sender_t sender,
+                                                double chars_per_second);
+
+/**
+ * @brief Group the key edges of one operation into shared event frames when
+ * no key delay is configured (see `Sender::setFrameCoalescing`).
+ * @param sender Sender handle.
+ * @param enabled true to coalesce edges; false for one frame per edge.
+ */
+TYPR_IO_API void typr_io_sender_set_frame_coalescing(typr_io_sender_t sender,
+                                                     bool enabled);
+
+/**
+ * @brief Read the sender's injection counters.
+ * @param sender Sender handle.
+ * @param out Destination for the snapshot.
+ * @return true on success; false if an argument is NULL.
+ */
+TYPR_IO_API bool typr_io_sender_get_stats(typr_io_sender_t sender,
+                                          typr_io_sender_stats_t *out);
 /** @} */ /* end of Sender group */
 
 /** @name Listener (global event monitoring)
@@ -315,6 +543,15 @@ TYPR_IO_API void typr_io_sender_set_key_delay(typr_io_sender_t sender,
  */
 TYPR_IO_API typr_io_listener_t typr_io_listener_create(void);
 
+/**
+ * @brief Create a new Listener instance with explicit options.
+ * @param options Options, or NULL for the defaults. The strings are copied.
+ * @return typr_io_listener_t Opaque listener handle, or NULL on allocation
+ * failure.
+ */
+TYPR_IO_API typr_io_listener_t typr_io_listener_create_with_options(
+    const typr_io_listener_options_t *options);
+
 /**
  * @brief Destroy a Listener instance.
  * @param listener Listener handle to destroy (safe to call with NULL).
@@ -334,6 +571,18 @@ TYPR_IO_API bool typr_io_listener_start(typr_io_listener_t listener,
                                         typr_io_listener_cb cb,
                                         void *user_data);
 
+/**
+ * @brief Start the listener with a callback that receives full event
+ * records (including timestamps).
+ * @param listener Listener handle.
+ * @param cb Callback invoked for each observed event.
+ * @param user_data Opaque pointer forwarded to the callback.
+ * @return true on success; false if the listener could not be started.
+ */
+TYPR_IO_API bool typr_io_listener_start_events(typr_io_listener_t listener,
+                                               typr_io_listener_event_cb cb,
+                                               void *user_data);
+
 /**
  * @brief Stop the listener. Safe to call from any thread; a no-op if not
  * running.
@@ -341,14 +590,113 @@ TYPR_IO_API bool typr_io_listener_start(typr_io_listener_t listener,
  */
 TYPR_IO_API void typr_io_listener_stop(typr_io_listener_t listener);
 
+/**
+ * @brief Start the listener in queued mode: events are buffered in a bounded
+ * ring instead of being delivered to a callback.
+ * @param listener Listener handle.
+ * @param capacity Ring capacity in events (rounded up to a power of two).
+ * @return true on success; false if the listener could not be started.
+ */
+TYPR_IO_API bool typr_io_listener_start_queued(typr_io_listener_t listener,
+                                               size_t capacity);
+
+/**
+ * @brief Drain up to `max_events` queued events (non-blocking).
+ * @param listener Listener handle started with
+ * `typr_io_listener_start_queued`.
+ * @param out Destination array with room for `max_events` entries.
+ * @param max_events Capacity of `out`.
+ * @return Number of events written to `out`.
+ */
+TYPR_IO_API size_t typr_io_listener_read_events(typr_io_listener_t listener,
+                                                typr_io_event_t *out,
+                                                size_t max_events);
+
+/**
+ * @brief Number of events dropped because the queue was full.
+ * @param listener Listener handle.
+ * @return Cumulative drop count since the last queued start.
+ */
+TYPR_IO_API uint64_t
+typr_io_listener_dropped_events(typr_io_listener_t listener);
+
 /**
  * @brief Query whether the listener is currently active.
  * @param listener Listener handle.
  * @return true if listening; false otherwise.
  */
 TYPR_IO_API bool typr_io_listener_is_listening(typr_io_listener_t listener);
+
+/**
+ * @brief Read the listener's delivery counters and latency summaries.
+ * @param listener Listener handle.
+ * @param out Destination for the snapshot.
+ * @return true on success; false if an argument is NULL.
+ */
+TYPR_IO_API bool typr_io_listener_get_stats(typr_io_listener_t listener,
+                                            typr_io_listener_stats_t *out);
 /** @} */ /* end of Listener group */
 
+/** @name Hotkeys (chord and sequence matching)
+ * @brief Functions wrapping typr::io::HotkeyMatcher.
+ * @{
+ */
+
+/**
+ * @brief Create an empty hotkey matcher.
+ * @return typr_io_hotkeys_t Opaque handle, or NULL on allocation failure.
+ */
+TYPR_IO_API typr_io_hotkeys_t typr_io_hotkeys_create(void);
+
+/**
+ * @brief Destroy a hotkey matcher. Stop any listener attached to it first.
+ * @param hotkeys Matcher handle (safe to call with NULL).
+ */
+TYPR_IO_API void typr_io_hotkeys_destroy(typr_io_hotkeys_t hotkeys);
+
+/**
+ * @brief Register a hotkey such as "Ctrl+Shift+P" or "Ctrl+K, Ctrl+S".
+ * @param hotkeys Matcher handle.
+ * @param spec Null-terminated hotkey text (see HotkeyMatcher::parse).
+ * @param cb Handler invoked on the feeding (listener) thread.
+ * @param user_data Opaque pointer forwarded to the handler.
+ * @return Id of the new hotkey, or 0 on error (see typr_io_get_last_error).
+ */
+TYPR_IO_API uint32_t typr_io_hotkeys_add(typr_io_hotkeys_t hotkeys,
+                                         const char *spec, typr_io_hotkey_cb cb,
+                                         void *user_data);
+
+/**
+ * @brief Unregister a hotkey.
+ * @return true if the id was registered.
+ */
+TYPR_IO_API bool typr_io_hotkeys_remove(typr_io_hotkeys_t hotkeys,
+                                        uint32_t hotkey_id);
+
+/**
+ * @brief Set the longest pause between two chords of a sequence
+ * (0 disables the timeout; default 1000 ms).
+ */
+TYPR_IO_API void typr_io_hotkeys_set_step_timeout_ms(typr_io_hotkeys_t hotkeys,
+                                                     uint32_t timeout_ms);
+
+/**
+ * @brief Feed one listener event (e.g. from `typr_io_listener_read_events`).
+ * Must be called from one thread at a time.
+ * @return true if at least one handler ran.
+ */
+TYPR_IO_API bool typr_io_hotkeys_feed(typr_io_hotkeys_t hotkeys,
+                                      const typr_io_event_t *event);
+
+/**
+ * @brief Start `listener` feeding `hotkeys` (presses only, no character
+ * translation). Replaces any callback set on the listener.
+ * @return true on success; false if the listener could not be started.
+ */
+TYPR_IO_API bool typr_io_hotkeys_attach(typr_io_hotkeys_t hotkeys,
+                                        typr_io_listener_t listener);
+/** @} */ /* end of Hotkeys group */
+
 /* ---------------- Utilities / Conversions ---------------- */
 
 /**
@@ -359,6 +707,14 @@ TYPR_IO_API bool typr_io_listener_is_listening(typr_io_listener_t listener);
  */
 TYPR_IO_API char *typr_io_key_to_string(typr_io_key_t key);
 
+/**
+ * @brief Return the canonical name of a Key without allocating.
+ * @param key Key to convert.
+ * @return const char* Statically allocated, null-terminated canonical name
+ * ("Unknown" for keys without a name). Do not free.
+ */
+TYPR_IO_API const char *typr_io_key_name(typr_io_key_t key);
+
 /**
  * @brief Parse a textual key name to a `typr_io_key_t` value.
  * @param name Null-terminated string (case-insensitive; accepts common aliases
@@ -376,9 +732,9 @@ TYPR_IO_API typr_io_key_t typr_io_string_to_key(const char *name);
 TYPR_IO_API const char *typr_io_library_version(void);
 
 /**
- * @brief Retrieve the last process-wide error string, if any.
+ * @brief Retrieve the calling thread's last error string, if any.
  *
- * Many functions record a process-global "last error" string on failure.
+ * Many functions record a per-thread "last error" string on failure.
  * The returned string is heap-allocated and must be freed with
  * `typr_io_free_string`. Returns NULL if there is no last error.
  *
@@ -387,7 +743,14 @@ TYPR_IO_API const char *typr_io_library_version(void);
 TYPR_IO_API char *typr_io_get_last_error(void);
 
 /**
- * @brief Clear the process-wide last error string, if any.
+ * @brief Borrow the calling thread's last error string without allocating.
+ * @return const char* The message, valid until the calling thread's next C
+ * API call, or NULL if there is no last error. Do not free.
+ */
+TYPR_IO_API const char *typr_io_last_error_message(void);
+
+/**
+ * @brief Clear the calling thread's last error string, if any.
  */
 TYPR_IO_API void typr_io_clear_last_error(void);
 
@@ -8,8 +8,10 @@
  * (input injection) and `Listener` (global monitoring) subsystems.
  */
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #ifndef TYPR_IO_VERSION
 // Default version; CMake can override these by defining TYPR_IO_VERSION_* via
@@ -340,6 +342,15 @@ enum class Key : uint16_t {
   RFKill = 267,
 };
 
+/**
+ * @brief One past the highest `Key` value.
+ *
+ * `Key` values are dense enough to index flat tables; use this constant to
+ * size them (e.g. `std::array<T, kKeyCount>` or `std::bitset<kKeyCount>`).
+ */
+inline constexpr std::size_t kKeyCount =
+    static_cast<std::size_t>(Key::RFKill) + 1;
+
 /**
  * @enum Modifier
  * @brief Modifier bitmask flags (type-safe enum class).
@@ -427,6 +438,13 @@ enum class BackendType : uint8_t {
 
 // Utility conversion helpers - implemented in a single translation unit.
 // These are exported so consumer code (or tests) can call them directly.
+/**
+ * @brief Return the canonical textual name of a Key without allocating.
+ * @param key Logical key to convert.
+ * @return std::string_view View of a statically allocated, null-terminated
+ * name (e.g., "A", "Enter"), or "Unknown" for keys without a name.
+ */
+TYPR_IO_API std::string_view keyToStringView(Key key) noexcept;
 /**
  * @brief Convert a Key to its canonical textual name.
  * @param key Logical key to convert.
@@ -438,7 +456,7 @@ TYPR_IO_API std::string keyToString(Key key);
  * @param str Input string (case-insensitive; accepts common aliases).
  * @return Key Parsed key value or Key::Unknown for unrecognized strings.
  */
-TYPR_IO_API Key stringToKey(const std::string &str);
+TYPR_IO_API Key stringToKey(std::string_view str);
 
 /**
  * @brief Convenience access to the library version string (mirrors
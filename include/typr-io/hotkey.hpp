@@ -0,0 +1,167 @@
+#pragma once
+
+// typr-io - hotkey.hpp
+// Global shortcut matching on top of typr::io::Listener.
+// `HotkeyMatcher` compiles registered chords and multi-step sequences
+// (e.g. "Ctrl+K, Ctrl+S") into a trie keyed on (Key, modifiers), so each
+// listener event advances the match with a single lookup and handlers only
+// run when a hotkey completes.
+//
+// Usage:
+//   #include <typr-io/hotkey.hpp>
+//   typr::io::HotkeyMatcher hotkeys;
+//   hotkeys.add("Ctrl+Shift+P", [](auto) { openPalette(); });
+//   hotkeys.add("Ctrl+K, Ctrl+S", [](auto) { saveAll(); });
+//   typr::io::Listener listener;
+//   hotkeys.attach(listener);
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <typr-io/core.hpp>
+#include <typr-io/listener.hpp>
+
+namespace typr {
+namespace io {
+
+/**
+ * @class HotkeyMatcher
+ * @brief Matches listener key presses against registered chords and
+ * sequences.
+ *
+ * A hotkey is a sequence of one or more chords; a chord is a set of held
+ * modifiers plus one non-modifier key. Only Shift, Ctrl, Alt and Super take
+ * part in matching (lock keys are ignored) and modifiers must match exactly.
+ * Presses of modifier keys and all releases never affect a match in
+ * progress. Any other press that does not continue the current sequence
+ * abandons it and is tried as the first chord of a new one.
+ *
+ * When a hotkey is a prefix of a longer one, its handler runs as soon as it
+ * completes and the longer sequence stays in progress.
+ *
+ * Threading: `add()`, `remove()`, `clear()` and `setStepTimeout()` may be
+ * called from any thread, including from a handler. Changes only mark the
+ * registrations dirty; the trie is recompiled once, by the thread that
+ * feeds the next event. `feed()` (and therefore the attached listener)
+ * must be driven from one thread at a time; handlers run on that thread.
+ */
+class TYPR_IO_API HotkeyMatcher {
+public:
+  /// Registration handle; 0 is never a valid id.
+  using Id = uint32_t;
+
+  /**
+   * @brief One step of a hotkey.
+   */
+  struct Chord {
+    Modifier mods{Modifier::None}; ///< Modifiers held (Shift/Ctrl/Alt/Super).
+    Key key{Key::Unknown};         ///< Non-modifier key.
+  };
+
+  /// Invoked with the id of the hotkey that completed.
+  using Handler = std::function<void(Id id)>;
+
+  HotkeyMatcher();
+  ~HotkeyMatcher();
+
+  HotkeyMatcher(const HotkeyMatcher &) = delete;
+  HotkeyMatcher &operator=(const HotkeyMatcher &) = delete;
+  HotkeyMatcher(HotkeyMatcher &&) noexcept;
+  HotkeyMatcher &operator=(HotkeyMatcher &&) noexcept;
+
+  /**
+   * @brief Register a sequence of chords.
+   * @return The new id, or 0 if the sequence is empty or a chord's key is
+   * `Key::Unknown` or a modifier key.
+   */
+  Id add(std::span<const Chord> sequence, Handler handler);
+
+  /**
+   * @brief Register a single chord.
+   */
+  Id add(Chord chord, Handler handler);
+
+  /**
+   * @brief Register a hotkey written as text (see `parse()`).
+   * @return The new id, or 0 if `spec` does not parse.
+   */
+  Id add(std::string_view spec, Handler handler);
+
+  /**
+   * @brief Unregister a hotkey.
+   * @return true if `id` was registered.
+   */
+  bool remove(Id id);
+
+  /**
+   * @brief Unregister every hotkey.
+   */
+  void clear();
+
+  /**
+   * @brief Number of registered hotkeys.
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief Longest pause allowed between two chords of a sequence
+   * (default 1000 ms; zero disables the timeout).
+   */
+  void setStepTimeout(std::chrono::milliseconds timeout);
+  [[nodiscard]] std::chrono::milliseconds stepTimeout() const;
+
+  /**
+   * @brief Advance matching with one listener event.
+   *
+   * Timeouts are measured on `event.timestampNs` (the current steady_clock
+   * time if it is 0).
+   *
+   * @return true if at least one handler ran.
+   */
+  bool feed(const Listener::Event &event);
+
+  /**
+   * @brief Abandon the sequence in progress (feeding thread only).
+   */
+  void reset();
+
+  /**
+   * @brief Start `listener` with a callback that feeds this matcher.
+   *
+   * Without `forward` the listener is started with a `ListenerFilter` that
+   * only delivers presses and skips character translation.
+   *
+   * @param listener Listener to start; stop it before destroying the matcher.
+   * @param forward Optional callback also invoked for every event (on the
+   * platform thread, after matching).
+   * @return Result of `Listener::start()`.
+   */
+  bool attach(Listener &listener, Listener::EventCallback forward = {});
+
+  /**
+   * @brief Parse a textual hotkey.
+   *
+   * Chords are separated by commas, keys within a chord by `+`, e.g.
+   * `"Ctrl+Shift+P"` or `"Ctrl+K, Ctrl+S"`. Modifier names are
+   * case-insensitive: `Ctrl`/`Control`, `Shift`, `Alt`/`Option`,
+   * `Super`/`Cmd`/`Command`/`Win`/`Meta`. The last name of each chord is a
+   * key name accepted by `stringToKey()`.
+   *
+   * @return The chords, or std::nullopt if `spec` is malformed.
+   */
+  static std::optional<std::vector<Chord>> parse(std::string_view spec);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace io
+} // namespace typr
@@ -0,0 +1,149 @@
+#pragma once
+
+// typr-io - key_sequence.hpp
+// Replayable keystroke programs for typr::io::Sender.
+// A `KeySequence` describes keys, combos, text and delays once; the first
+// `Sender::play()` compiles it into the backend's native event buffers and
+// later plays replay those buffers without any layout lookup, UTF decoding or
+// allocation.
+//
+// Usage:
+//   #include <typr-io/key_sequence.hpp>
+//   typr::io::KeySequence save;
+//   save.combo(typr::io::Modifier::Ctrl, typr::io::Key::S)
+//       .delay(std::chrono::milliseconds(50))
+//       .typeText("done\n");
+//   sender.play(save);
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <typr-io/core.hpp>
+
+namespace typr {
+namespace io {
+
+/**
+ * @class KeySequence
+ * @brief Backend-independent description of a keystroke program.
+ *
+ * Builder calls append steps and return `*this` so they can be chained.
+ * Combos are expanded into modifier and key edges when they are added, text
+ * is decoded to UTF-32 when it is added. Every modification bumps
+ * `revision()`, which tells a Sender to recompile its cached program.
+ *
+ * Copies receive a new `id()`, so a Sender never confuses a copy with the
+ * sequence it was copied from.
+ */
+class TYPR_IO_API KeySequence {
+public:
+  /**
+   * @brief Kind of a single step.
+   */
+  enum class StepKind : uint8_t {
+    KeyDown, ///< Press `key`.
+    KeyUp,   ///< Release `key`.
+    Text,    ///< Type `textLength` codepoints starting at `textOffset`.
+    Delay,   ///< Wait `delayUs` microseconds.
+  };
+
+  /**
+   * @brief One step of the program.
+   */
+  struct Step {
+    StepKind kind{StepKind::Delay};
+    Key key{Key::Unknown};
+    uint32_t textOffset{0};
+    uint32_t textLength{0};
+    uint32_t delayUs{0};
+  };
+
+  KeySequence();
+  KeySequence(const KeySequence &other);
+  KeySequence &operator=(const KeySequence &other);
+  KeySequence(KeySequence &&other) noexcept;
+  KeySequence &operator=(KeySequence &&other) noexcept;
+  ~KeySequence() = default;
+
+  // --- Building ---
+  /**
+   * @brief Append a key press.
+   */
+  KeySequence &keyDown(Key key);
+
+  /**
+   * @brief Append a key release.
+   */
+  KeySequence &keyUp(Key key);
+
+  /**
+   * @brief Append a key press followed by its release.
+   */
+  KeySequence &tap(Key key);
+
+  /**
+   * @brief Append a combo: press the (left) modifier keys, tap `key`, then
+   * release the modifiers, in the same order as `Sender::combo()`.
+   */
+  KeySequence &combo(Modifier mods, Key key);
+
+  /**
+   * @brief Append text to type.
+   * @param text Unicode text (UTF-32).
+   */
+  KeySequence &typeText(std::u32string_view text);
+
+  /**
+   * @brief Append UTF-8 text to type; ill-formed sequences become U+FFFD.
+   * @param utf8Text UTF-8 encoded text.
+   */
+  KeySequence &typeText(std::string_view utf8Text);
+
+  /**
+   * @brief Append a pause. Delays are the only waits during `play()`; the
+   * key delay and typing rate of the Sender do not apply.
+   */
+  KeySequence &delay(std::chrono::microseconds duration);
+
+  /**
+   * @brief Remove all steps.
+   */
+  void clear();
+
+  // --- Inspection ---
+  [[nodiscard]] bool empty() const { return m_steps.empty(); }
+
+  /**
+   * @brief Steps in playing order.
+   */
+  [[nodiscard]] const std::vector<Step> &steps() const { return m_steps; }
+
+  /**
+   * @brief Codepoints of a `StepKind::Text` step.
+   */
+  [[nodiscard]] std::u32string_view textOf(const Step &step) const;
+
+  /**
+   * @brief Identity of this sequence, unique within the process.
+   */
+  [[nodiscard]] uint64_t id() const { return m_id; }
+
+  /**
+   * @brief Modification counter, incremented by every builder call.
+   */
+  [[nodiscard]] uint64_t revision() const { return m_revision; }
+
+private:
+  KeySequence &append(const Step &step);
+
+  std::vector<Step> m_steps;
+  std::u32string m_text;
+  uint64_t m_id;
+  uint64_t m_revision{0};
+};
+
+} // namespace io
+} // namespace typr
@@ -46,15 +46,176 @@
  *   return 0;
  * }
  * @endcode
+ *
+ * Queued delivery: instead of running a callback on the platform thread,
+ * `startQueued()` makes the listener append compact `Event` records to a
+ * bounded lock-free ring that the consumer drains in batches with `poll()`.
+ * The platform hook then never waits on consumer code; when the ring is full
+ * new events are dropped and counted (`droppedEvents()`).
+ *
+ * @code{.cpp}
+ * typr::io::Listener l;
+ * l.startQueued(4096);
+ * std::array<typr::io::Listener::Event, 64> batch;
+ * for (;;) {
+ *   for (const auto &ev : std::span(batch.data(), l.poll(batch))) {
+ *     // handle ev.codepoint, ev.key, ev.mods, ev.pressed, ev.timestampNs
+ *   }
+ * }
+ * @endcode
+ *
+ * Timestamps: every `Event` carries `timestampNs`, the time the OS stamped
+ * the input event (libinput, CGEvent or the low-level hook record), mapped
+ * onto the `std::chrono::steady_clock` timeline. Use `start(EventCallback)`
+ * or queued delivery to receive it, and `stats()` for hook-to-callback
+ * latency and callback duration histograms.
+ *
+ * Devices (Linux): by default the listener follows every keyboard of udev
+ * seat `seat0` on one worker thread. `ListenerOptions` selects other seats
+ * or explicit `/dev/input/event*` nodes; each gets a worker of its own, so
+ * a slow hotplug on one never stalls the others. `Event::device` names the
+ * source device, resolved through `Listener::devices()`.
+ *
+ * @code{.cpp}
+ * typr::io::ListenerOptions opts;
+ * opts.seats = {"seat0", "seat1"};
+ * opts.devices = {"/dev/input/event7"};
+ * typr::io::Listener l(opts);
+ * @endcode
  */
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
+#include <string>
+#include <vector>
 
 #include <typr-io/core.hpp>
+#include <typr-io/stats.hpp>
 
 namespace typr {
 namespace io {
 
+/**
+ * @struct ListenerFilter
+ * @brief Selects the events a Listener delivers.
+ *
+ * The filter is checked on the platform thread as early as the backend can
+ * tell the key and edge of an event, before the character is translated and
+ * before the callback is dispatched. Rejected events still update the
+ * listener's internal modifier and layout state, so later events stay
+ * correct; they are counted in `ListenerStats::filteredEvents`.
+ *
+ * A default-constructed filter accepts every event.
+ *
+ * @code
+ * typr::io::ListenerFilter f;
+ * f.addKey(typr::io::Key::F9).addKey(typr::io::Key::F10);
+ * f.requiredMods = typr::io::Modifier::Ctrl;
+ * f.releases = false;
+ * f.needCodepoint = false;
+ * listener.start(onHotkey, f);
+ * @endcode
+ */
+struct ListenerFilter {
+  /// Keys to deliver; when none is set every key (including
+  /// `Key::Unknown`) is delivered.
+  std::bitset<kKeyCount> keys;
+  /// Modifiers that must all be active.
+  Modifier requiredMods{Modifier::None};
+  /// Modifiers of which none may be active.
+  Modifier rejectedMods{Modifier::None};
+  bool presses{true};  ///< Deliver key presses.
+  bool releases{true}; ///< Deliver key releases.
+  /// Translate the typed character; when false `Event::codepoint` is 0 and
+  /// the backend skips layout translation entirely.
+  bool needCodepoint{true};
+
+  /**
+   * @brief Add `key` to `keys`; returns `*this` for chaining.
+   */
+  ListenerFilter &addKey(Key key) {
+    const auto index = static_cast<std::size_t>(key);
+    if (index < kKeyCount)
+      keys.set(index);
+    return *this;
+  }
+
+  /**
+   * @brief Whether any event of `key` (press or release) can pass.
+   */
+  [[nodiscard]] bool wantsKey(Key key) const noexcept {
+    const auto index = static_cast<std::size_t>(key);
+    return (presses || releases) &&
+           (keys.none() || (index < kKeyCount && keys.test(index)));
+  }
+
+  /**
+   * @brief Whether events of `key` in direction `pressed` pass.
+   */
+  [[nodiscard]] bool acceptsKey(Key key, bool pressed) const noexcept {
+    return (pressed ? presses : releases) && wantsKey(key);
+  }
+
+  /**
+   * @brief Whether the modifier state `mods` passes.
+   */
+  [[nodiscard]] bool acceptsMods(Modifier mods) const noexcept {
+    return (mods & requiredMods) == requiredMods &&
+           (mods & rejectedMods) == Modifier::None;
+  }
+
+  /**
+   * @brief Whether the filter accepts every event (the default).
+   */
+  [[nodiscard]] bool acceptsAll() const noexcept {
+    return keys.none() && presses && releases &&
+           requiredMods == Modifier::None && rejectedMods == Modifier::None;
+  }
+};
+
+/**
+ * @struct ListenerOptions
+ * @brief Construction options for `Listener`.
+ *
+ * Each field names the backend it applies to; the others ignore it.
+ */
+struct ListenerOptions {
+  /// Linux: udev seats to monitor, each on its own worker thread. When both
+  /// `seats` and `devices` are empty, `seat0` is monitored.
+  std::vector<std::string> seats;
+  /// Linux: device nodes (e.g. "/dev/input/event3") to monitor through the
+  /// libinput path backend, each on its own worker thread. A node that is
+  /// missing or goes away is reopened when it (re)appears.
+  std::vector<std::string> devices;
+  /// Linux: with several workers, callbacks are serialized by default so
+  /// callers (and `startQueued()`) see one event at a time. Set to let
+  /// workers invoke the callback concurrently; it must then be thread-safe.
+  /// `startQueued()`, `Recorder::attach()` and `HotkeyMatcher::attach()`
+  /// refuse to start such a Listener (see `concurrentCallbacks()`).
+  bool parallelCallbacks{false};
+  /// Windows: read keyboards through Raw Input (`RIDEV_INPUTSINK`, batched
+  /// `GetRawInputBuffer` reads) instead of a `WH_KEYBOARD_LL` hook. Windows
+  /// then no longer waits on the listener before delivering each key to
+  /// other applications, and `Event::device` identifies the keyboard.
+  /// Timestamps are taken when a batch is read.
+  bool rawInput{false};
+};
+
+/**
+ * @struct ListenerDevice
+ * @brief An input device seen by a running Listener.
+ */
+struct ListenerDevice {
+  uint16_t id{0};        ///< Value of `Listener::Event::device`.
+  std::string name;      ///< Device name reported by the kernel (Linux).
+  std::string node;      ///< "/dev/input/event3", or the Windows HID path.
+  std::string seat;      ///< Linux: seat or node of the worker reading it.
+  bool connected{false}; ///< False once the device has been removed.
+};
+
 /**
  * @class Listener
  * @brief Global keyboard event monitoring facility.
@@ -83,7 +244,34 @@ public:
   using Callback = std::function<void(char32_t codepoint, Key key,
                                       Modifier mods, bool pressed)>;
 
+  /**
+   * @brief Compact, trivially copyable event record.
+   *
+   * Delivered to `EventCallback` and through queued delivery.
+   */
+  struct Event {
+    char32_t codepoint{0};         ///< Unicode codepoint (0 if none).
+    Key key{Key::Unknown};         ///< Logical key.
+    Modifier mods{Modifier::None}; ///< Modifier state at event time.
+    bool pressed{false};           ///< True for press, false for release.
+    uint64_t timestampNs{0};       ///< OS event time on steady_clock, ns.
+    uint16_t device{0};            ///< Source device id, 0 if unknown.
+  };
+
+  /**
+   * @brief Callback receiving the full event record, including its
+   * timestamp.
+   */
+  using EventCallback = std::function<void(const Event &event)>;
+
   Listener();
+
+  /**
+   * @brief Construct a Listener with explicit options.
+   * @param options See `ListenerOptions`.
+   */
+  explicit Listener(const ListenerOptions &options);
+
   ~Listener();
 
   Listener(const Listener &) = delete;
@@ -98,9 +286,83 @@ public:
    * will fail to start when platform support or permissions aren't available.
    *
    * @param cb Callback to invoke for each observed event.
+   * @param filter Events to deliver (every event by default).
+   * @return true on success, false on failure.
+   */
+  bool start(Callback cb, const ListenerFilter &filter = {});
+
+  /**
+   * @brief Start listening, delivering complete `Event` records.
+   *
+   * Same threading and failure behaviour as `start(Callback)`.
+   *
+   * @param cb Callback to invoke for each observed event.
+   * @param filter Events to deliver (every event by default).
    * @return true on success, false on failure.
    */
-  bool start(Callback cb);
+  bool start(EventCallback cb, const ListenerFilter &filter = {});
+
+  /**
+   * @brief Start listening and queue events for `poll()` instead of invoking
+   * a callback.
+   *
+   * Events are recorded on the platform thread into a bounded
+   * single-producer ring buffer; nothing else runs on that thread.
+   *
+   * @param capacity Ring capacity in events (rounded up to a power of two).
+   * @param filter Events to queue (every event by default).
+   * @return true on success, false on failure (or if already listening).
+   */
+  bool startQueued(std::size_t capacity = 4096,
+                   const ListenerFilter &filter = {});
+
+  /**
+   * @brief Drain queued events (queued mode only).
+   *
+   * Non-blocking; copies up to `out.size()` events in arrival order. May be
+   * called from any thread (calls are serialized internally) and
+   * concurrently with stop(), but not concurrently with startQueued().
+   *
+   * @param out Destination buffer.
+   * @return Number of events written to `out` (0 if none are pending or the
+   *         listener was not started with `startQueued()`).
+   */
+  std::size_t poll(std::span<Event> out);
+
+  /**
+   * @brief Number of events dropped because the queue was full.
+   *
+   * Cumulative since the last `startQueued()`; use it to size the ring.
+   */
+  [[nodiscard]] uint64_t droppedEvents() const;
+
+  /**
+   * @brief Snapshot of delivery counters and latency histograms.
+   *
+   * Counters restart on every successful start; safe to call from any thread
+   * while the listener runs.
+   */
+  [[nodiscard]] ListenerStats stats() const;
+
+  /**
+   * @brief Devices seen since the last successful start, indexed by
+   * `Event::device - 1`.
+   *
+   * Ids stay valid after `stop()` and after the device is removed; a device
+   * that comes back on the same node keeps its id. Empty on backends that
+   * do not attribute events to devices.
+   */
+  [[nodiscard]] std::vector<ListenerDevice> devices() const;
+
+  /**
+   * @brief Whether callbacks may run on several threads at once.
+   *
+   * True only on Linux with `ListenerOptions::parallelCallbacks` and more
+   * than one seat or device. Consumers that need one event at a time
+   * (`startQueued()`, `Recorder::attach()`, `HotkeyMatcher::attach()`) return
+   * false instead of starting such a Listener.
+   */
+  [[nodiscard]] bool concurrentCallbacks() const;
 
   /**
    * @brief Stop listening for global keyboard events.
@@ -118,7 +380,9 @@ public:
 
 private:
   struct Impl;
+  struct Queue;
   std::unique_ptr<Impl> m_impl;
+  std::unique_ptr<Queue> m_queue;
 };
 
 } // namespace io
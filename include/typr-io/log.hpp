@@ -15,9 +15,17 @@
  *  - TYPR_IO_LOG_LEVEL: one of "debug", "info", "warn", "error".
  *    If unset, the legacy TYPR_OSK_DEBUG_BACKEND is consulted (unset ->
  *    debug enabled for testing; "0" disables debug).
+ *  - TYPR_IO_LOG_ASYNC: "1" -> hand messages to a background writer thread
+ *    instead of writing to stderr on the logging thread (see `setAsync`).
  *  - TYPR_IO_FORCE_COLORS: non-empty -> force ANSI colors on.
  *  - TYPR_IO_NO_COLOR: non-empty -> disable ANSI colors.
  *
+ * Compile-time configuration:
+ *  - TYPR_IO_LOG_MIN_LEVEL: 0 (debug, default) .. 3 (error), or 4 to disable
+ *    logging. Macros below the floor compile to nothing; their arguments are
+ *    never evaluated. Above the floor, arguments are only evaluated when the
+ *    runtime level enables the message.
+ *
  * The header is intentionally small and portable and works in plain C++ and
  * Objective-C++ translation units.
  */
@@ -26,18 +34,26 @@
 #include <atomic>
 #include <chrono>
 #include <cstdarg>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #if defined(_WIN32) || defined(_WIN64)
 #include <io.h>
 #else
 #include <unistd.h>
 #endif
 
+#ifndef TYPR_IO_LOG_MIN_LEVEL
+#define TYPR_IO_LOG_MIN_LEVEL 0
+#endif
+
 namespace typr {
 namespace io {
 namespace log {
@@ -119,16 +135,27 @@ inline std::atomic<Level> &globalLevel() {
 }
 
 inline void setLevel(Level l) { globalLevel().store(l); }
-inline Level getLevel() { return globalLevel().load(); }
+inline Level getLevel() {
+  return globalLevel().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Whether `level` survives the compile-time TYPR_IO_LOG_MIN_LEVEL
+ * floor.
+ */
+constexpr bool compiledIn(Level level) {
+  return static_cast<int>(level) >= TYPR_IO_LOG_MIN_LEVEL;
+}
 
 /**
  * @brief Determine whether a message at `level` should be emitted under the
- * current global level.
+ * compile-time floor and the current global level.
  * @param level Candidate message level to test.
  * @return true if the message should be emitted.
  */
 inline bool isEnabled(Level level) {
-  return static_cast<int>(level) >= static_cast<int>(getLevel());
+  return compiledIn(level) &&
+         static_cast<int>(level) >= static_cast<int>(getLevel());
 }
 
 /**
@@ -226,25 +253,17 @@ inline const char *trimPathToTyprIo(const char *path) {
 
 /**
  * @internal
- * @brief Emit a formatted log message using a va_list (thread-safe).
+ * @brief Format a complete log line (header, body and newline) into `out`.
  *
  * Produces a timestamp (local time, millisecond precision), level name,
- * and source file/line prefix before the formatted message body.
+ * and source file/line prefix before the message body.
  *
- * @param level Log level for the message.
- * @param file Source file name (typically `__FILE__`).
- * @param line Source line number (typically `__LINE__`).
- * @param fmt printf-style format string.
- * @param ap Preinitialized va_list of arguments for `fmt`.
+ * @return size_t Number of bytes written (excluding the terminator).
  */
-inline void vlog(Level level, const char *file, int line, const char *fmt,
-                 va_list ap) {
-  if (!isEnabled(level))
-    return;
-
-  // Grab time
+inline size_t formatLine(char *out, size_t cap, Level level, const char *file,
+                         int line, std::chrono::system_clock::time_point now,
+                         const char *body) {
   using namespace std::chrono;
-  auto now = system_clock::now();
   auto ms =
       duration_cast<milliseconds>(now.time_since_epoch()) % milliseconds(1000);
   std::time_t t = system_clock::to_time_t(now);
@@ -264,39 +283,760 @@ inline void vlog(Level level, const char *file, int line, const char *fmt,
     std::snprintf(timebuf, sizeof(timebuf), "%lld", static_cast<long long>(t));
   }
 
-  // Serialise output to avoid interleaving
-  std::lock_guard<std::mutex> lk(outputMutex());
-
-  const bool use_colors = colorsEnabled();
+  static const bool use_colors = colorsEnabled();
   const char *reset = use_colors ? "\x1b[0m" : "";
   const char *file_color = use_colors ? "\x1b[90m" : "";
   const char *lvl_color = use_colors ? levelColor(level) : "";
 
-  const char *trimmed = trimPathToTyprIo(file);
-
   // Header: timestamp.millis [LEVEL] file:line: (with coloring)
-  std::fprintf(stderr, "[typr-io] %s.%03d [", timebuf,
-               static_cast<int>(ms.count()));
-  if (use_colors)
-    std::fputs(lvl_color, stderr);
-  std::fprintf(stderr, "%s", levelToString(level));
-  if (use_colors)
-    std::fputs(reset, stderr);
-  std::fprintf(stderr, "] ");
-  if (use_colors)
-    std::fputs(file_color, stderr);
-  std::fprintf(stderr, "%s:%d: ", trimmed, line);
-  if (use_colors)
-    std::fputs(reset, stderr);
-
-  // Body
-  std::vfprintf(stderr, fmt, ap);
-
-  // Newline and flush for immediacy (useful when used from tests / CI)
-  std::fprintf(stderr, "\n");
+  int n = std::snprintf(out, cap, "[typr-io] %s.%03d [%s%s%s] %s%s:%d: %s%s\n",
+                        timebuf, static_cast<int>(ms.count()), lvl_color,
+                        levelToString(level), reset, file_color,
+                        trimPathToTyprIo(file), line, reset, body);
+  if (n < 0)
+    return 0;
+  if (static_cast<size_t>(n) >= cap) {
+    // Truncated: keep the line terminated
+    out[cap - 2] = '\n';
+    return cap - 1;
+  }
+  return static_cast<size_t>(n);
+}
+
+/**
+ * @internal
+ * @brief Write a formatted line to stderr with a single write call.
+ */
+inline void writeLine(const char *data, size_t size) {
+  // Serialise output to avoid interleaving; the lock only covers the write
+  std::lock_guard<std::mutex> lk(outputMutex());
+  std::fwrite(data, 1, size, stderr);
   std::fflush(stderr);
 }
 
+/**
+ * @internal
+ * @brief Background writer used when asynchronous logging is enabled.
+ *
+ * Logging threads do not format anything: they copy the format string and
+ * the raw argument values (strings by content) into a fixed-size record and
+ * publish it to a bounded multi-producer ring. The writer thread replays the
+ * conversions with `snprintf`, adds the timestamp / header and performs the
+ * stderr I/O. When the ring is full the message is dropped and counted
+ * rather than blocking the caller. Records that do not fit, or use a
+ * conversion the writer cannot replay (`%n`, wide strings), are formatted
+ * on the logging thread instead.
+ */
+class AsyncSink {
+public:
+  static constexpr size_t kCapacity = 256; // power of two
+  static constexpr size_t kBodySize = 480;
+
+  AsyncSink() : m_slots(new Slot[kCapacity]) {
+    for (size_t i = 0; i < kCapacity; ++i)
+      m_slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  ~AsyncSink() { stop(); }
+
+  AsyncSink(const AsyncSink &) = delete;
+  AsyncSink &operator=(const AsyncSink &) = delete;
+
+  /**
+   * @brief Queue a message; returns false once the sink has been stopped.
+   */
+  bool push(Level level, const char *file, int line, const char *fmt,
+            va_list ap) {
+    // Announce the producer before checking the flag; stop() sets the flag
+    // before waiting for announced producers, so a message published here
+    // is always seen by its final drain (both sides are seq_cst).
+    m_producers.fetch_add(1);
+    if (m_stopped.load()) {
+      m_producers.fetch_sub(1, std::memory_order_release);
+      return false;
+    }
+    ensureStarted();
+
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    for (;;) {
+      slot = &m_slots[pos & (kCapacity - 1)];
+      size_t seq = slot->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) -
+                  static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (m_tail.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_producers.fetch_sub(1, std::memory_order_release);
+        return true;
+      } else {
+        pos = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->level = level;
+    slot->file = file;
+    slot->line = line;
+    slot->time = std::chrono::system_clock::now();
+    va_list args;
+    va_copy(args, ap);
+    slot->deferred = captureArgs(slot->data, kBodySize, fmt, &args);
+    va_end(args);
+    if (!slot->deferred)
+      std::vsnprintf(slot->data, kBodySize, fmt, ap);
+    slot->seq.store(pos + 1, std::memory_order_release);
+
+    m_published.fetch_add(1, std::memory_order_release);
+    m_published.notify_one();
+    m_producers.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Write every queued message before returning.
+   */
+  void flush() {
+    std::lock_guard<std::mutex> lk(m_drainMutex);
+    drainLocked();
+  }
+
+  /**
+   * @brief Drain, stop the writer thread and route later messages back to
+   * the synchronous path.
+   */
+  void stop() {
+    if (m_stopped.exchange(true))
+      return;
+    // Producers that passed the flag check before the exchange finish
+    // publishing before the final drain below
+    while (m_producers.load(std::memory_order_acquire) != 0)
+      std::this_thread::yield();
+    m_published.fetch_add(1, std::memory_order_release);
+    m_published.notify_one();
+    {
+      std::lock_guard<std::mutex> lk(m_startMutex);
+      if (m_worker.joinable()) {
+#if defined(_WIN32) || defined(_WIN64)
+        // May run under the loader lock at DLL teardown, where joining would
+        // deadlock; the writer exits on its own once it sees `m_stopped`.
+        m_worker.detach();
+#else
+        m_worker.join();
+#endif
+      }
+    }
+    flush();
+  }
+
+  /**
+   * @internal
+   * @brief Copy `fmt` and the arguments it consumes from `ap` into `out`.
+   *
+   * Integers, floating-point values and pointers are stored as their raw
+   * (promoted) values and `%s` strings by content, so the record stays valid
+   * after the caller's arguments are gone.
+   *
+   * @return false when the record does not fit in `cap` bytes or `fmt` uses
+   *         a conversion that cannot be replayed; `ap` is then indeterminate.
+   */
+  static bool captureArgs(char *out, size_t cap, const char *fmt,
+                          va_list *ap) {
+    const size_t fmtSize = std::strlen(fmt) + 1;
+    if (fmtSize > cap)
+      return false;
+    std::memcpy(out, fmt, fmtSize);
+    size_t used = fmtSize;
+
+    auto put = [&](const void *value, size_t size) {
+      if (size > cap - used)
+        return false;
+      std::memcpy(out + used, value, size);
+      used += size;
+      return true;
+    };
+    for (const char *p = fmt; *p; ++p) {
+      if (*p != '%')
+        continue;
+      Spec spec;
+      if (!parseSpec(p + 1, spec))
+        return false;
+      p = spec.end - 1;
+      int precision = spec.precision;
+      for (int i = 0; i < spec.stars; ++i) {
+        const int star = va_arg(*ap, int);
+        if (!put(&star, sizeof(star)))
+          return false;
+        // Only a trailing '*' is the precision
+        if (spec.starPrecision && i == spec.stars - 1)
+          precision = star;
+      }
+      bool ok = true;
+      switch (argKind(spec)) {
+      case ArgKind::None:
+        break;
+      case ArgKind::Invalid:
+        return false;
+      case ArgKind::Int:
+        ok = putValue(put, va_arg(*ap, int));
+        break;
+      case ArgKind::UInt:
+        ok = putValue(put, va_arg(*ap, unsigned int));
+        break;
+      case ArgKind::Long:
+        ok = putValue(put, va_arg(*ap, long));
+        break;
+      case ArgKind::ULong:
+        ok = putValue(put, va_arg(*ap, unsigned long));
+        break;
+      case ArgKind::LongLong:
+        ok = putValue(put, va_arg(*ap, long long));
+        break;
+      case ArgKind::ULongLong:
+        ok = putValue(put, va_arg(*ap, unsigned long long));
+        break;
+      case ArgKind::IntMax:
+        ok = putValue(put, va_arg(*ap, intmax_t));
+        break;
+      case ArgKind::UIntMax:
+        ok = putValue(put, va_arg(*ap, uintmax_t));
+        break;
+      case ArgKind::Size:
+        ok = putValue(put, va_arg(*ap, size_t));
+        break;
+      case ArgKind::PtrDiff:
+        ok = putValue(put, va_arg(*ap, ptrdiff_t));
+        break;
+      case ArgKind::Double:
+        ok = putValue(put, va_arg(*ap, double));
+        break;
+      case ArgKind::LongDouble:
+        ok = putValue(put, va_arg(*ap, long double));
+        break;
+      case ArgKind::Pointer:
+        ok = putValue(put, va_arg(*ap, void *));
+        break;
+      case ArgKind::String: {
+        const char *str = va_arg(*ap, const char *);
+        if (!str)
+          str = "(null)";
+        // Honour the precision so unterminated buffers are never overread
+        size_t len = 0;
+        while ((precision < 0 || len < static_cast<size_t>(precision)) &&
+               str[len] != '\0')
+          ++len;
+        const char nul = '\0';
+        ok = put(str, len) && put(&nul, 1);
+        break;
+      }
+      }
+      if (!ok)
+        return false;
+    }
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Format a record written by `captureArgs()` into `out`.
+   */
+  static void renderArgs(char *out, size_t cap, const char *record) {
+    const char *fmt = record;
+    const char *in = record + std::strlen(record) + 1;
+    size_t pos = 0;
+    auto advance = [&](int n) {
+      if (n > 0)
+        pos = std::min(pos + static_cast<size_t>(n), cap - 1);
+    };
+
+    for (const char *p = fmt; *p && pos + 1 < cap;) {
+      if (*p != '%') {
+        out[pos++] = *p++;
+        continue;
+      }
+      Spec spec;
+      parseSpec(p + 1, spec); // validated by captureArgs()
+      char conversion[32];
+      const size_t specLen = std::min(static_cast<size_t>(spec.end - p),
+                                      sizeof(conversion) - 1);
+      std::memcpy(conversion, p, specLen);
+      conversion[specLen] = '\0';
+      p = spec.end;
+
+      int stars[2] = {0, 0};
+      for (int i = 0; i < spec.stars; ++i)
+        in = takeValue(in, stars[i]);
+      char *dst = out + pos;
+      const size_t room = cap - pos;
+      switch (argKind(spec)) {
+      case ArgKind::None:
+      case ArgKind::Invalid:
+        advance(std::snprintf(dst, room, "%%"));
+        break;
+      case ArgKind::Int:
+        advance(replay<int>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::UInt:
+        advance(replay<unsigned int>(dst, room, conversion, stars, spec.stars,
+                                     in));
+        break;
+      case ArgKind::Long:
+        advance(replay<long>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::ULong:
+        advance(replay<unsigned long>(dst, room, conversion, stars,
+                                      spec.stars, in));
+        break;
+      case ArgKind::LongLong:
+        advance(
+            replay<long long>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::ULongLong:
+        advance(replay<unsigned long long>(dst, room, conversion, stars,
+                                           spec.stars, in));
+        break;
+      case ArgKind::IntMax:
+        advance(replay<intmax_t>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::UIntMax:
+        advance(
+            replay<uintmax_t>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::Size:
+        advance(replay<size_t>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::PtrDiff:
+        advance(
+            replay<ptrdiff_t>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::Double:
+        advance(replay<double>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::LongDouble:
+        advance(
+            replay<long double>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::Pointer:
+        advance(replay<void *>(dst, room, conversion, stars, spec.stars, in));
+        break;
+      case ArgKind::String:
+        advance(formatWith(dst, room, conversion, stars, spec.stars, in));
+        in += std::strlen(in) + 1;
+        break;
+      }
+    }
+    out[pos] = '\0';
+  }
+
+  [[nodiscard]] uint64_t dropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Number of queued messages the writer has written so far.
+   */
+  [[nodiscard]] uint64_t written() const {
+    return m_written.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Slot {
+    std::atomic<size_t> seq{0};
+    Level level{Level::Debug};
+    const char *file{nullptr};
+    int line{0};
+    std::chrono::system_clock::time_point time;
+    bool deferred{false}; // `data` is a captureArgs() record, not a body
+    char data[kBodySize];
+  };
+
+  /// Argument type consumed by one conversion specification.
+  enum class ArgKind {
+    None, // "%%"
+    Invalid,
+    Int,
+    UInt,
+    Long,
+    ULong,
+    LongLong,
+    ULongLong,
+    IntMax,
+    UIntMax,
+    Size,
+    PtrDiff,
+    Double,
+    LongDouble,
+    Pointer,
+    String,
+  };
+
+  /// One parsed conversion specification.
+  struct Spec {
+    const char *end{nullptr}; // one past the conversion character
+    int stars{0};             // '*' width / precision arguments
+    bool starPrecision{false};
+    int precision{-1}; // literal precision, -1 when absent or '*'
+    char length{0};    // 'H' (hh), 'h', 'l', 'q' (ll), 'j', 'z', 't', 'L'
+    char conversion{0};
+  };
+
+  /// Parse the specification following a '%' at `p`.
+  static bool parseSpec(const char *p, Spec &spec) {
+    spec = Spec{};
+    const char *start = p;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+      ++p;
+    if (*p == '*') {
+      ++spec.stars;
+      ++p;
+    } else {
+      while (*p >= '0' && *p <= '9')
+        ++p;
+    }
+    if (*p == '.') {
+      ++p;
+      if (*p == '*') {
+        ++spec.stars;
+        spec.starPrecision = true;
+        ++p;
+      } else {
+        spec.precision = 0;
+        while (*p >= '0' && *p <= '9')
+          spec.precision = spec.precision * 10 + (*p++ - '0');
+      }
+    }
+    if ((p[0] == 'h' && p[1] == 'h') || (p[0] == 'l' && p[1] == 'l')) {
+      spec.length = p[0] == 'h' ? 'H' : 'q';
+      p += 2;
+    } else if (*p == 'h' || *p == 'l' || *p == 'j' || *p == 'z' ||
+               *p == 't' || *p == 'L') {
+      spec.length = *p++;
+    }
+    // The replay buffer holds "%" + the specification
+    if (*p == '\0' || p - start + 2 > 31)
+      return false;
+    spec.conversion = *p;
+    spec.end = p + 1;
+    return true;
+  }
+
+  static ArgKind argKind(const Spec &spec) {
+    switch (spec.conversion) {
+    case '%':
+      return ArgKind::None;
+    case 'd':
+    case 'i':
+      switch (spec.length) {
+      case 'l':
+        return ArgKind::Long;
+      case 'q':
+        return ArgKind::LongLong;
+      case 'j':
+        return ArgKind::IntMax;
+      case 'z':
+      case 't':
+        return ArgKind::PtrDiff;
+      default:
+        return ArgKind::Int;
+      }
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+      switch (spec.length) {
+      case 'l':
+        return ArgKind::ULong;
+      case 'q':
+        return ArgKind::ULongLong;
+      case 'j':
+        return ArgKind::UIntMax;
+      case 'z':
+        return ArgKind::Size;
+      case 't':
+        return ArgKind::PtrDiff;
+      default:
+        return ArgKind::UInt;
+      }
+    case 'c':
+      return spec.length == 0 ? ArgKind::Int : ArgKind::Invalid;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      return spec.length == 'L' ? ArgKind::LongDouble : ArgKind::Double;
+    case 'p':
+      return ArgKind::Pointer;
+    case 's':
+      return spec.length == 0 ? ArgKind::String : ArgKind::Invalid;
+    default: // %n, wide characters, unknown conversions
+      return ArgKind::Invalid;
+    }
+  }
+
+  template <class Put, class T> static bool putValue(Put &put, T value) {
+    return put(&value, sizeof(value));
+  }
+
+  template <class T> static const char *takeValue(const char *in, T &value) {
+    std::memcpy(&value, in, sizeof(value));
+    return in + sizeof(value);
+  }
+
+  template <class T>
+  static int formatWith(char *out, size_t cap, const char *conversion,
+                        const int *stars, int starCount, T value) {
+    switch (starCount) {
+    case 0:
+      return std::snprintf(out, cap, conversion, value);
+    case 1:
+      return std::snprintf(out, cap, conversion, stars[0], value);
+    default:
+      return std::snprintf(out, cap, conversion, stars[0], stars[1], value);
+    }
+  }
+
+  template <class T>
+  static int replay(char *out, size_t cap, const char *conversion,
+                    const int *stars, int starCount, const char *&in) {
+    T value{};
+    in = takeValue(in, value);
+    return formatWith(out, cap, conversion, stars, starCount, value);
+  }
+
+  void ensureStarted() {
+    if (m_started.load(std::memory_order_acquire))
+      return;
+    std::lock_guard<std::mutex> lk(m_startMutex);
+    if (m_started.load(std::memory_order_relaxed) ||
+        m_stopped.load(std::memory_order_relaxed))
+      return;
+    m_worker = std::thread([this]() { run(); });
+    m_started.store(true, std::memory_order_release);
+  }
+
+  void run() {
+    for (;;) {
+      uint32_t seen = m_published.load(std::memory_order_acquire);
+      flush();
+      if (m_stopped.load(std::memory_order_acquire))
+        return;
+      m_published.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+  // Consumer side; callers hold m_drainMutex.
+  void drainLocked() {
+    char line[kBodySize + 192];
+    for (;;) {
+      Slot &slot = m_slots[m_head & (kCapacity - 1)];
+      if (slot.seq.load(std::memory_order_acquire) != m_head + 1)
+        break;
+      char body[kBodySize];
+      const char *text = slot.data;
+      if (slot.deferred) {
+        renderArgs(body, sizeof(body), slot.data);
+        text = body;
+      }
+      size_t n = formatLine(line, sizeof(line), slot.level, slot.file,
+                            slot.line, slot.time, text);
+      slot.seq.store(m_head + kCapacity, std::memory_order_release);
+      ++m_head;
+      writeLine(line, n);
+      m_written.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDropped) {
+      char note[96];
+      int n = std::snprintf(note, sizeof(note),
+                            "[typr-io] async log sink dropped %llu message(s)\n",
+                            static_cast<unsigned long long>(dropped -
+                                                            m_reportedDropped));
+      m_reportedDropped = dropped;
+      if (n > 0)
+        writeLine(note, static_cast<size_t>(n));
+    }
+  }
+
+  std::unique_ptr<Slot[]> m_slots;
+  alignas(64) std::atomic<size_t> m_tail{0};
+  alignas(64) size_t m_head{0};
+  uint64_t m_reportedDropped{0};
+  std::atomic<uint32_t> m_published{0};
+  std::atomic<uint32_t> m_producers{0}; // threads inside push()
+  std::atomic<uint64_t> m_dropped{0};
+  std::atomic<uint64_t> m_written{0};
+  std::atomic<bool> m_started{false};
+  std::atomic<bool> m_stopped{false};
+  std::mutex m_drainMutex;
+  std::mutex m_startMutex;
+  std::thread m_worker;
+};
+
+/**
+ * @internal
+ * @brief Process-wide async sink, or nullptr while logging synchronously.
+ */
+inline std::atomic<AsyncSink *> &asyncSinkSlot() {
+  static std::atomic<AsyncSink *> slot{nullptr};
+  return slot;
+}
+
+/**
+ * @internal
+ * @brief Owner of the async sink; drains and stops it at static teardown.
+ *
+ * The stopped sink is deliberately leaked: a thread that loaded the sink
+ * pointer just before teardown then sees it stopped and falls back to the
+ * synchronous path instead of touching freed memory.
+ */
+struct AsyncSinkOwner {
+  std::mutex mutex;
+  std::unique_ptr<AsyncSink> sink;
+
+  ~AsyncSinkOwner() {
+    asyncSinkSlot().store(nullptr, std::memory_order_release);
+    if (sink) {
+      sink->stop();
+      (void)sink.release();
+    }
+  }
+};
+
+inline AsyncSinkOwner &asyncSinkOwner() {
+  static AsyncSinkOwner owner;
+  return owner;
+}
+
+/**
+ * @brief Enable or disable the asynchronous log sink.
+ *
+ * When enabled, the calling thread only copies the format string and its
+ * arguments into a bounded queue; a background thread formats them and
+ * writes to stderr, so hot paths never format, wait on stderr or take the
+ * output mutex. Disabling drains pending messages.
+ * A disabled sink is kept alive so late producers never race its teardown.
+ */
+inline void setAsync(bool enabled) {
+  AsyncSinkOwner &owner = asyncSinkOwner();
+  std::lock_guard<std::mutex> lk(owner.mutex);
+  if (enabled) {
+    if (!owner.sink)
+      owner.sink = std::make_unique<AsyncSink>();
+    asyncSinkSlot().store(owner.sink.get(), std::memory_order_release);
+  } else if (owner.sink) {
+    asyncSinkSlot().store(nullptr, std::memory_order_release);
+    owner.sink->flush();
+  }
+}
+
+/**
+ * @brief Write all messages queued by the asynchronous sink, if enabled.
+ */
+inline void flush() {
+  if (AsyncSink *sink = asyncSinkSlot().load(std::memory_order_acquire))
+    sink->flush();
+}
+
+/**
+ * @brief Number of messages the asynchronous sink dropped because its queue
+ * was full.
+ */
+inline uint64_t droppedMessages() {
+  AsyncSinkOwner &owner = asyncSinkOwner();
+  std::lock_guard<std::mutex> lk(owner.mutex);
+  return owner.sink ? owner.sink->dropped() : 0;
+}
+
+/**
+ * @internal
+ * @brief Apply TYPR_IO_LOG_ASYNC once, on the first emitted message.
+ */
+inline bool asyncFromEnvApplied() {
+  static const bool applied = [] {
+    const char *env = std::getenv("TYPR_IO_LOG_ASYNC");
+    if (env && env[0] != '\0' && env[0] != '0')
+      setAsync(true);
+    return true;
+  }();
+  return applied;
+}
+
+/**
+ * @internal
+ * @brief Emit a formatted log message using a va_list (thread-safe).
+ *
+ * The level must already have been checked by the caller.
+ *
+ * @param level Log level for the message.
+ * @param file Source file name (typically `__FILE__`).
+ * @param line Source line number (typically `__LINE__`).
+ * @param fmt printf-style format string.
+ * @param ap Preinitialized va_list of arguments for `fmt`.
+ */
+inline void vlogUnchecked(Level level, const char *file, int line,
+                          const char *fmt, va_list ap) {
+  (void)asyncFromEnvApplied();
+  if (AsyncSink *sink = asyncSinkSlot().load(std::memory_order_acquire)) {
+    va_list copy;
+    va_copy(copy, ap);
+    bool queued = sink->push(level, file, line, fmt, copy);
+    va_end(copy);
+    if (queued)
+      return;
+  }
+
+  // Synchronous path: format the body on the stack (heap only for very long
+  // messages), then emit the whole line with a single write.
+  char body[512];
+  std::string longBody;
+  const char *text = body;
+  va_list copy;
+  va_copy(copy, ap);
+  int n = std::vsnprintf(body, sizeof(body), fmt, copy);
+  va_end(copy);
+  if (n >= static_cast<int>(sizeof(body))) {
+    longBody.resize(static_cast<size_t>(n) + 1);
+    std::vsnprintf(longBody.data(), longBody.size(), fmt, ap);
+    text = longBody.c_str();
+  }
+
+  std::string lineBuf;
+  char stackLine[768];
+  char *out = stackLine;
+  size_t cap = sizeof(stackLine);
+  if (n >= 0 && static_cast<size_t>(n) + 192 > cap) {
+    lineBuf.resize(static_cast<size_t>(n) + 192);
+    out = lineBuf.data();
+    cap = lineBuf.size();
+  }
+  size_t len = formatLine(out, cap, level, file, line,
+                          std::chrono::system_clock::now(), text);
+  writeLine(out, len);
+}
+
+/**
+ * @internal
+ * @brief Emit a formatted log message using a va_list (thread-safe).
+ *
+ * @param level Log level for the message.
+ * @param file Source file name (typically `__FILE__`).
+ * @param line Source line number (typically `__LINE__`).
+ * @param fmt printf-style format string.
+ * @param ap Preinitialized va_list of arguments for `fmt`.
+ */
+inline void vlog(Level level, const char *file, int line, const char *fmt,
+                 va_list ap) {
+  if (!isEnabled(level))
+    return;
+  vlogUnchecked(level, file, line, fmt, ap);
+}
+
 /**
  * @brief Log a message with varargs.
  *
@@ -313,7 +1053,19 @@ inline void log(Level level, const char *file, int line, const char *fmt, ...) {
     return;
   va_list ap;
   va_start(ap, fmt);
-  vlog(level, file, line, fmt, ap);
+  vlogUnchecked(level, file, line, fmt, ap);
+  va_end(ap);
+}
+
+/**
+ * @internal
+ * @brief Variadic entry point used by the macros once the level is checked.
+ */
+inline void logUnchecked(Level level, const char *file, int line,
+                         const char *fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  vlogUnchecked(level, file, line, fmt, ap);
   va_end(ap);
 }
 
@@ -331,20 +1083,26 @@ inline bool debugEnabled() { return isEnabled(Level::Debug); }
  * @defgroup LoggingMacros Helper logging macros
  * @brief Convenience macros that include file and line automatically.
  *
- * These macros wrap `::typr::io::log::log` and automatically supply `__FILE__`
- * and `__LINE__`.
+ * These macros wrap `::typr::io::log::logUnchecked` and automatically supply
+ * `__FILE__` and `__LINE__`. Levels below TYPR_IO_LOG_MIN_LEVEL are discarded
+ * at compile time, and the arguments are only evaluated when the message is
+ * enabled at runtime, so call sites may pass expensive expressions.
  * @{
  */
+#define TYPR_IO_LOG_AT(level, fmt, ...)                                        \
+  do {                                                                         \
+    if constexpr (::typr::io::log::compiledIn(level)) {                        \
+      if (::typr::io::log::isEnabled(level))                                   \
+        ::typr::io::log::logUnchecked(level, __FILE__, __LINE__, fmt,          \
+                                      ##__VA_ARGS__);                          \
+    }                                                                          \
+  } while (0)
 #define TYPR_IO_LOG_DEBUG(fmt, ...)                                            \
-  ::typr::io::log::log(::typr::io::log::Level::Debug, __FILE__, __LINE__, fmt, \
-                       ##__VA_ARGS__)
+  TYPR_IO_LOG_AT(::typr::io::log::Level::Debug, fmt, ##__VA_ARGS__)
 #define TYPR_IO_LOG_INFO(fmt, ...)                                             \
-  ::typr::io::log::log(::typr::io::log::Level::Info, __FILE__, __LINE__, fmt,  \
-                       ##__VA_ARGS__)
+  TYPR_IO_LOG_AT(::typr::io::log::Level::Info, fmt, ##__VA_ARGS__)
 #define TYPR_IO_LOG_WARN(fmt, ...)                                             \
-  ::typr::io::log::log(::typr::io::log::Level::Warn, __FILE__, __LINE__, fmt,  \
-                       ##__VA_ARGS__)
+  TYPR_IO_LOG_AT(::typr::io::log::Level::Warn, fmt, ##__VA_ARGS__)
 #define TYPR_IO_LOG_ERROR(fmt, ...)                                            \
-  ::typr::io::log::log(::typr::io::log::Level::Error, __FILE__, __LINE__, fmt, \
-                       ##__VA_ARGS__)
+  TYPR_IO_LOG_AT(::typr::io::log::Level::Error, fmt, ##__VA_ARGS__)
 /** @} */ /* end of LoggingMacros */
@@ -0,0 +1,171 @@
+#pragma once
+
+// typr-io - recorder.hpp
+// Capture Listener events to a compact binary log and replay them.
+// `Recorder` takes events on the listener's platform thread without blocking
+// it and encodes them on a writer thread; `RecordingReader` decodes a log and
+// can feed it back into a `Sender` with the original timing.
+//
+// Usage:
+//   #include <typr-io/recorder.hpp>
+//   std::ofstream file("session.typrrec", std::ios::binary);
+//   typr::io::Listener listener;
+//   typr::io::Recorder recorder(file);
+//   recorder.attach(listener);
+//   // ... later
+//   listener.stop();
+//   recorder.stop();
+//
+//   std::ifstream in("session.typrrec", std::ios::binary);
+//   typr::io::RecordingReader reader(in);
+//   typr::io::Sender sender;
+//   reader.replay(sender);
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+
+#include <typr-io/core.hpp>
+#include <typr-io/listener.hpp>
+
+namespace typr {
+namespace io {
+
+class Sender;
+
+/**
+ * @class Recorder
+ * @brief Streams `Listener::Event`s to a binary log.
+ *
+ * Stream format: the 8-byte header `"TYPRREC"` + format version (1), then one
+ * record per event:
+ *
+ * | field                     | encoding                 |
+ * |---------------------------|--------------------------|
+ * | time since previous event | varint, microseconds     |
+ * | key                       | varint of `uint16_t` Key |
+ * | modifiers                 | 1 byte (`Modifier` bits) |
+ * | codepoint and pressed     | varint of `cp * 2 + p`   |
+ *
+ * The first delta is measured from the Recorder's construction. A typing
+ * session costs about 4-5 bytes per event.
+ *
+ * `record()` only copies the event into a bounded single-producer ring; a
+ * writer thread encodes and writes in large buffered chunks. When the ring
+ * is full events are dropped and counted (`droppedEvents()`), so the
+ * platform thread never waits on I/O.
+ */
+class TYPR_IO_API Recorder {
+public:
+  /**
+   * @brief Write the header to `out` and start the writer thread.
+   * @param out Destination; must outlive the Recorder (or `stop()`).
+   * @param capacity Ring capacity in events (rounded up to a power of two).
+   */
+  explicit Recorder(std::ostream &out, std::size_t capacity = 8192);
+
+  /**
+   * @brief `stop()`, then release the writer.
+   */
+  ~Recorder();
+
+  Recorder(const Recorder &) = delete;
+  Recorder &operator=(const Recorder &) = delete;
+  Recorder(Recorder &&) noexcept;
+  Recorder &operator=(Recorder &&) noexcept;
+
+  /**
+   * @brief Queue one event; never blocks.
+   *
+   * Must only be called from one thread at a time (the listener's platform
+   * thread when attached). Events recorded after `stop()` are dropped.
+   */
+  void record(const Listener::Event &event);
+
+  /**
+   * @brief Start `listener` with a callback that records every event.
+   *
+   * @param listener Listener to start; stop it before destroying the
+   * Recorder.
+   * @param forward Optional callback also invoked for every event (on the
+   * platform thread, after recording).
+   * @return Result of `Listener::start()`.
+   */
+  bool attach(Listener &listener, Listener::EventCallback forward = {});
+
+  /**
+   * @brief Write out every queued event, flush the stream and stop the
+   * writer thread. Idempotent.
+   */
+  void stop();
+
+  /**
+   * @brief Events accepted by `record()` so far.
+   */
+  [[nodiscard]] uint64_t recordedEvents() const;
+
+  /**
+   * @brief Events dropped because the ring was full or the recorder stopped.
+   */
+  [[nodiscard]] uint64_t droppedEvents() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @class RecordingReader
+ * @brief Decodes a log written by `Recorder`.
+ *
+ * Decoded events carry `timestampNs` relative to the start of the recording.
+ */
+class TYPR_IO_API RecordingReader {
+public:
+  /**
+   * @brief Read and check the header from `in`.
+   * @param in Source; must outlive the reader.
+   */
+  explicit RecordingReader(std::istream &in);
+  ~RecordingReader();
+
+  RecordingReader(const RecordingReader &) = delete;
+  RecordingReader &operator=(const RecordingReader &) = delete;
+  RecordingReader(RecordingReader &&) noexcept;
+  RecordingReader &operator=(RecordingReader &&) noexcept;
+
+  /**
+   * @brief Whether the header was valid and no malformed record was met.
+   */
+  [[nodiscard]] bool valid() const;
+
+  /**
+   * @brief Decode the next event.
+   * @return The event, or std::nullopt at the end of the stream or on a
+   * malformed record (then `valid()` turns false).
+   */
+  std::optional<Listener::Event> next();
+
+  /**
+   * @brief Replay the remaining events through `sender`.
+   *
+   * Events with a known key become `keyDown()` / `keyUp()`; key presses
+   * without a key but with a codepoint become `typeCharacter()`. Each
+   * event is injected at its original offset from the first replayed event,
+   * divided by `speed`.
+   *
+   * @param sender Sender to inject with.
+   * @param speed Playback speed factor (> 0; 2.0 replays twice as fast).
+   * @return true if every event was injected and the stream ended cleanly.
+   */
+  bool replay(Sender &sender, double speed = 1.0);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace io
+} // namespace typr
@@ -10,15 +10,40 @@
 //   typr::io::Sender sender;
 //   if (sender.capabilities().canInjectKeys) sender.tap(typr::io::Key::A);
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include <typr-io/core.hpp>
+#include <typr-io/stats.hpp>
 
 namespace typr {
 namespace io {
 
+class KeySequence;
+
+/**
+ * @brief Construction options for `Sender`.
+ */
+struct SenderOptions {
+  /**
+   * @brief Share virtual input devices between Senders (Linux/uinput).
+   *
+   * 0 (default) gives the Sender a virtual keyboard of its own. N > 0
+   * attaches it to the least-used device of a process-wide pool of up to N
+   * shared devices, so e.g. 32 Senders with a pool of 2 create 2 input
+   * devices instead of 32. Each event frame is written atomically. A key
+   * stays pressed while any Sender on the device holds it. Sharing one
+   * device is like sharing one physical keyboard, so a modifier held by one
+   * Sender also applies to keys sent by the others. Use a larger pool, or
+   * own devices, to isolate them. Other backends inject without a device
+   * and ignore this option.
+   */
+  uint32_t sharedDevicePool{0};
+};
+
 /**
  * @class Sender
  * @brief Layout-aware input sender (keyboard injection)
@@ -33,6 +58,12 @@ public:
    */
   Sender();
 
+  /**
+   * @brief Construct a Sender with explicit options.
+   * @param options See `SenderOptions`.
+   */
+  explicit Sender(const SenderOptions &options);
+
   /**
    * @brief Destroy the Sender instance and release resources.
    */
@@ -92,6 +123,42 @@ public:
    */
   bool tap(Key key);
 
+  /**
+   * @brief Hold a key down for a fixed time, then release it.
+   *
+   * The release is scheduled on an absolute deadline measured from the
+   * press, so the hold lasts `duration` regardless of injection cost. This
+   * call is synchronous: the calling thread sleeps for the hold and wakes
+   * for the release. Only `AsyncSender::holdFor()` keeps the caller free of
+   * these wakeups, by running the hold on its worker thread.
+   *
+   * @param key Logical key to hold.
+   * @param duration Time between press and release; negative holds release
+   *        immediately and values beyond the clock range saturate.
+   * @return true if both edges were injected.
+   */
+  bool holdFor(Key key, std::chrono::microseconds duration);
+
+  /**
+   * @brief Tap a key repeatedly at a fixed rate.
+   *
+   * Press `i` is scheduled at `start + i / perSecond` and released half an
+   * interval later, all on absolute deadlines, so a long burst keeps its
+   * rate instead of drifting. The key delay does not apply. With a rate of
+   * zero or less the taps run back to back through `tap()`.
+   *
+   * Every edge is injected by the calling thread, which sleeps and wakes
+   * once per press and release (kernel autorepeat is not used). To keep the
+   * caller free of these wakeups, use `AsyncSender::repeat()`, which runs
+   * the burst on its worker thread.
+   *
+   * @param key Logical key to tap.
+   * @param count Number of taps.
+   * @param perSecond Taps per second.
+   * @return true if every tap was injected; stops at the first failure.
+   */
+  bool repeat(Key key, uint32_t count, double perSecond);
+
   // --- Modifier helpers ---
   /**
    * @brief Return the currently active modifier mask.
@@ -134,14 +201,42 @@ public:
    * @param text Unicode text (UTF-32) to inject.
    * @return true on success; false if unsupported or on failure.
    */
-  bool typeText(const std::u32string &text);
+  bool typeText(std::u32string_view text);
 
   /**
    * @brief Convenience overload that accepts UTF-8 text.
+   *
+   * Ill-formed UTF-8 sequences are injected as U+FFFD REPLACEMENT CHARACTER.
+   *
    * @param utf8Text UTF-8 encoded string to inject.
    * @return true on success; false if unsupported or on failure.
    */
-  bool typeText(const std::string &utf8Text);
+  bool typeText(std::string_view utf8Text);
+
+  /**
+   * @brief Inject a whole string as one pre-planned event stream.
+   *
+   * Unlike `typeText()`, which injects character by character, the text is
+   * compiled up front into a flat list of key edges and emitted in a single
+   * pass. Redundant modifier toggles between consecutive characters are
+   * elided and the key delay is applied per batch of events instead of per
+   * edge, which makes large pastes considerably faster. Characters that
+   * cannot be produced are skipped.
+   *
+   * @param text Unicode text (UTF-32) to inject.
+   * @return true if all characters were injected; false otherwise.
+   */
+  bool typeTextBulk(std::u32string_view text);
+
+  /**
+   * @brief Convenience overload of `typeTextBulk()` that accepts UTF-8 text.
+   *
+   * Ill-formed UTF-8 sequences are injected as U+FFFD REPLACEMENT CHARACTER.
+   *
+   * @param utf8Text UTF-8 encoded string to inject.
+   * @return true if all characters were injected; false otherwise.
+   */
+  bool typeTextBulk(std::string_view utf8Text);
 
   /**
    * @brief Inject a single Unicode codepoint.
@@ -150,18 +245,83 @@ public:
    */
   bool typeCharacter(char32_t codepoint);
 
+  // --- Sequences ---
+  /**
+   * @brief Replay a pre-built keystroke program.
+   *
+   * The first play of a sequence (and the first after it was modified)
+   * compiles it into this backend's native event buffers; later plays submit
+   * those buffers directly, without layout lookups, UTF decoding or
+   * allocation. Only the sequence's own `delay()` steps wait: the key delay
+   * and typing rate do not apply. Modifier edges played from a sequence are
+   * not reflected in `activeModifiers()`, so a sequence should release the
+   * keys it presses.
+   *
+   * @param sequence Program to play (see `<typr-io/key_sequence.hpp>`).
+   * @return true if every step was mapped and injected; false otherwise
+   * (unmapped keys and characters are skipped).
+   */
+  bool play(const KeySequence &sequence);
+
   // --- Misc ---
   /**
    * @brief Flush pending events to ensure timely delivery.
+   *
+   * Writes out any buffered event frame. Every public operation already
+   * flushes before returning, so this is only needed by backends or modes
+   * that buffer across calls.
    */
   void flush();
 
   /**
    * @brief Set the key delay used by tap/combo operations.
+   *
+   * Delays are scheduled against absolute deadlines rather than slept
+   * relative to "now", so time spent emitting events is absorbed and the
+   * observed edge rate matches the configured delay even for small values.
+   *
    * @param delayUs Delay in microseconds.
    */
   void setKeyDelay(uint32_t delayUs);
 
+  /**
+   * @brief Pace text injection at a target rate in characters per second.
+   *
+   * When set, `typeText()`, `typeTextBulk()` and `typeCharacter()` start
+   * characters on a fixed schedule of `1 / charsPerSecond` and no longer
+   * apply the key delay between the edges of a single character. `tap()` /
+   * `combo()` keep using the key delay.
+   *
+   * @param charsPerSecond Target rate; 0 (default) restores per-edge key
+   * delays.
+   */
+  void setTypingRate(double charsPerSecond);
+
+  /**
+   * @brief Group modifier and key edges of one operation into shared event
+   * frames.
+   *
+   * When enabled and the key delay is 0, the edges emitted by a single call
+   * (e.g. `combo()` or typing a shifted character) are delivered as a few
+   * SYN frames instead of one frame per edge, e.g. "Shift↓ A↓" then
+   * "A↑ Shift↑". A press and release of the same key never share a frame.
+   * Backends without an event-frame concept (Windows, macOS) ignore this
+   * setting. Disabled by default.
+   *
+   * @param enabled true to coalesce edges; false for one frame per edge.
+   */
+  void setFrameCoalescing(bool enabled);
+
+  /**
+   * @brief Snapshot of injection counters and the per-call duration
+   * histogram.
+   *
+   * `lastInjectNs` is on the steady_clock timeline shared with
+   * `Listener::Event::timestampNs`, so injection-to-observation latency is
+   * the difference between the two.
+   */
+  [[nodiscard]] SenderStats stats() const;
+
 private:
   struct Impl;
   std::unique_ptr<Impl> m_impl;
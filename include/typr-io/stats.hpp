@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file stats.hpp
+ * @brief Latency histograms and counters reported by `Listener::stats()` and
+ * `Sender::stats()`.
+ *
+ * All timestamps and durations are nanoseconds on the `std::chrono::
+ * steady_clock` timeline, the same clock used for `Listener::Event::
+ * timestampNs`. A consumer can therefore measure injection-to-observation
+ * latency by comparing `SenderStats::lastInjectNs` (or its own steady_clock
+ * reading taken before calling the Sender) with the timestamp of the
+ * matching listener event.
+ *
+ * Statistics are collected with relaxed atomic counters and are always on;
+ * recording one sample costs a handful of uncontended atomic increments.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <typr-io/core.hpp>
+
+namespace typr {
+namespace io {
+
+/**
+ * @brief Snapshot of a log2-bucketed latency histogram.
+ *
+ * Bucket 0 counts samples below 2 ns; bucket `i > 0` counts samples in
+ * `[2^i, 2^(i+1))` ns. The last bucket also absorbs every larger sample.
+ */
+struct TYPR_IO_API LatencyHistogram {
+  static constexpr std::size_t kBuckets = 40;
+
+  std::array<uint64_t, kBuckets> buckets{}; ///< Samples per bucket.
+  uint64_t count{0};                        ///< Number of samples.
+  uint64_t totalNs{0};                      ///< Sum of all samples.
+  uint64_t maxNs{0};                        ///< Largest sample.
+
+  /**
+   * @brief Index of the bucket a sample of `ns` nanoseconds falls into.
+   */
+  static constexpr std::size_t bucketFor(uint64_t ns) noexcept {
+    std::size_t i = 0;
+    while (ns > 1 && i + 1 < kBuckets) {
+      ns >>= 1;
+      ++i;
+    }
+    return i;
+  }
+
+  /**
+   * @brief Exclusive upper bound of bucket `i`, in nanoseconds.
+   */
+  static constexpr uint64_t bucketUpperNs(std::size_t i) noexcept {
+    return uint64_t{2} << i;
+  }
+
+  /**
+   * @brief Mean sample value (0 when empty).
+   */
+  [[nodiscard]] double meanNs() const noexcept;
+
+  /**
+   * @brief Approximate percentile.
+   *
+   * @param p Percentile in `[0, 100]`.
+   * @return Upper bound of the bucket holding the requested rank, clamped to
+   *         `maxNs` (0 when empty).
+   */
+  [[nodiscard]] uint64_t percentileNs(double p) const noexcept;
+};
+
+/**
+ * @brief Listener counters, cumulative since the last successful start.
+ */
+struct ListenerStats {
+  uint64_t events{0};          ///< Events delivered (callback or queue).
+  uint64_t droppedEvents{0};   ///< Events lost to a full queue (queued mode).
+  uint64_t filteredEvents{0};  ///< Events rejected by the `ListenerFilter`.
+  uint64_t uptimeNs{0};        ///< Time since the listener was started.
+  double eventsPerSecond{0.0}; ///< `events` averaged over `uptimeNs`.
+  /// Native OS event timestamp to start of delivery on the listener thread.
+  LatencyHistogram hookLatency;
+  /// Time spent inside the user callback (or queue push) per event.
+  LatencyHistogram callbackDuration;
+};
+
+/**
+ * @brief Sender counters, cumulative since the Sender was created.
+ */
+struct SenderStats {
+  uint64_t injectedEvents{0}; ///< Platform input events handed to the OS.
+  uint64_t injectCalls{0};    ///< OS injection calls (write / SendInput / post).
+  uint64_t failedCalls{0};    ///< Injection calls that reported an error.
+  uint64_t lastInjectNs{0};   ///< steady_clock time of the last injection call.
+  /// Duration of each OS injection call.
+  LatencyHistogram injectDuration;
+};
+
+} // namespace io
+} // namespace typr
@@ -5,27 +5,35 @@
  * Implements the C-compatible wrapper declared in `include/typr-io/c_api.h`.
  *
  * The implementation is intentionally defensive: C++ exceptions are caught
- * and converted into a process-wide last-error string retrievable via
- * `typr_io_get_last_error`.
+ * and converted into a per-thread last-error string retrievable via
+ * `typr_io_get_last_error`. The slot is thread-local, so recording or
+ * clearing it takes no lock and, once its buffer has grown, no allocation.
  *
  * Listener callbacks may be invoked from background threads; the wrapper
- * safely bridges those events into C callbacks while protecting callback
- * state with a mutex.
+ * bridges those events into C callbacks through an RCU cell, so the per-event
+ * path takes no lock.
  */
 
 #include <typr-io/c_api.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
+#include <span>
 
-#include <mutex>
 #include <new>
 #include <string>
+#include <string_view>
 
 #include <typr-io/core.hpp>
+#include <typr-io/hotkey.hpp>
 #include <typr-io/listener.hpp>
 #include <typr-io/sender.hpp>
 
+#include "common/rcu_cell.hpp"
+
 namespace {
 
 /**
@@ -36,49 +44,64 @@ namespace {
  * object used by the C API implementation.
  */
 struct SenderWrapper {
+  SenderWrapper() = default;
+  explicit SenderWrapper(const typr::io::SenderOptions &options)
+      : sender(options) {}
+
   typr::io::Sender sender;
 };
 
+/**
+ * @brief A C callback together with its user data pointer.
+ */
+struct CListenerCallback {
+  typr_io_listener_cb cb{nullptr};
+  typr_io_listener_event_cb event_cb{nullptr};
+  void *user_data{nullptr};
+};
+
 /**
  * @brief Internal wrapper that contains a Listener and its C callback state.
  *
- * The `cb` and `user_data` fields are protected by `cb_mutex` so that both
- * the C API entry points and the listener's internal event threads can safely
- * access and update them.
+ * The callback and `user_data` are published together through an RCU cell:
+ * the C API entry points replace them, while the listener's internal event
+ * thread reads them lock-free.
  */
 struct ListenerWrapper {
+  ListenerWrapper() = default;
+  explicit ListenerWrapper(const typr::io::ListenerOptions &options)
+      : listener(options) {}
+
   typr::io::Listener listener;
-  typr_io_listener_cb cb{nullptr};
-  void *user_data{nullptr};
-  std::mutex cb_mutex; // protects cb & user_data
+  typr::io::detail::RcuCell<CListenerCallback> callback;
+};
+
+/**
+ * @brief Internal wrapper that owns a typr::io::HotkeyMatcher.
+ */
+struct HotkeysWrapper {
+  typr::io::HotkeyMatcher matcher;
 };
 
 /**
- * @brief Process-global last-error storage used by the C API implementation.
+ * @brief Last-error storage of the calling thread.
  *
- * The last error is protected by a mutex so it can be safely set and read
- * from multiple threads. Callers can retrieve a heap-allocated copy via
- * `typr_io_get_last_error`.
+ * Each thread sees the error of its own most recent C API call. Callers can
+ * retrieve a heap-allocated copy via `typr_io_get_last_error`, or borrow it
+ * via `typr_io_last_error_message`.
  */
-static std::mutex g_last_error_mutex;
-static std::string g_last_error;
+static thread_local std::string t_last_error;
 
 /**
- * @brief Set the process-wide last error message (thread-safe).
- * @param s The error message to record (copied).
+ * @brief Set the calling thread's last error message.
+ * @param s The error message to record (copied into the thread's buffer).
  */
-static void set_last_error(const std::string &s) {
-  std::lock_guard<std::mutex> lk(g_last_error_mutex);
-  g_last_error = s;
-}
+static void set_last_error(std::string_view s) { t_last_error.assign(s); }
 
 /**
- * @brief Clear the process-wide last error message (thread-safe).
+ * @brief Clear the calling thread's last error message.
  */
-static void clear_last_error() {
-  std::lock_guard<std::mutex> lk(g_last_error_mutex);
-  g_last_error.clear();
-}
+static void clear_last_error() { t_last_error.clear(); }
 
 /**
  * @brief Duplicate a std::string into a C-allocated null-terminated buffer.
@@ -101,6 +124,38 @@ static char *duplicate_c_string(const std::string &s) {
   return p;
 }
 
+/**
+ * @brief Convert a C++ listener event to its C layout.
+ */
+static typr_io_event_t to_c_event(const typr::io::Listener::Event &ev) {
+  return typr_io_event_t{
+      static_cast<uint32_t>(ev.codepoint), static_cast<typr_io_key_t>(ev.key),
+      static_cast<typr_io_modifier_t>(static_cast<uint8_t>(ev.mods)),
+      ev.pressed, ev.timestampNs, ev.device};
+}
+
+/**
+ * @brief Convert a C listener event back to the C++ record.
+ */
+static typr::io::Listener::Event from_c_event(const typr_io_event_t &ev) {
+  typr::io::Listener::Event event;
+  event.codepoint = static_cast<char32_t>(ev.codepoint);
+  event.key = static_cast<typr::io::Key>(ev.key);
+  event.mods = static_cast<typr::io::Modifier>(ev.mods);
+  event.pressed = ev.pressed;
+  event.timestampNs = ev.timestamp_ns;
+  event.device = ev.device;
+  return event;
+}
+
+/**
+ * @brief Summarize a latency histogram for the C API.
+ */
+static typr_io_latency_t to_c_latency(const typr::io::LatencyHistogram &h) {
+  return typr_io_latency_t{h.count, h.meanNs(), h.percentileNs(50.0),
+                           h.percentileNs(99.0), h.maxNs};
+}
+
 } // namespace
 
 #ifdef __cplusplus
@@ -127,6 +182,28 @@ TYPR_IO_API typr_io_sender_t typr_io_sender_create(void) {
   }
 }
 
+TYPR_IO_API typr_io_sender_t
+typr_io_sender_create_with_options(const typr_io_sender_options_t *options) {
+  try {
+    clear_last_error();
+    typr::io::SenderOptions opts;
+    if (options)
+      opts.sharedDevicePool = options->shared_device_pool;
+    SenderWrapper *w = new (std::nothrow) SenderWrapper(opts);
+    if (!w) {
+      set_last_error("Out of memory (sender)");
+      return nullptr;
+    }
+    return reinterpret_cast<typr_io_sender_t>(w);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_create_with_options");
+    return nullptr;
+  }
+}
+
 TYPR_IO_API void typr_io_sender_destroy(typr_io_sender_t sender) {
   if (!sender) {
     return;
@@ -383,6 +460,119 @@ TYPR_IO_API bool typr_io_sender_combo(typr_io_sender_t sender,
   }
 }
 
+TYPR_IO_API size_t typr_io_sender_tap_many(typr_io_sender_t sender,
+                                           const typr_io_key_t *keys,
+                                           size_t count) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  if (!keys && count > 0) {
+    set_last_error("keys is NULL");
+    return 0;
+  }
+  size_t done = 0;
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    for (; done < count; ++done) {
+      if (!w->sender.tap(static_cast<typr::io::Key>(keys[done])))
+        break;
+    }
+    return done;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return done;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_tap_many");
+    return done;
+  }
+}
+
+TYPR_IO_API bool typr_io_sender_hold_for(typr_io_sender_t sender,
+                                         typr_io_key_t key,
+                                         uint64_t duration_us) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    // Sender::holdFor saturates the deadline itself; this only keeps the
+    // unsigned -> signed conversion in range.
+    using Micros = std::chrono::microseconds;
+    constexpr auto kMaxUs = static_cast<uint64_t>(
+        std::chrono::nanoseconds::max().count() / 1000);
+    const Micros duration(
+        static_cast<Micros::rep>(std::min(duration_us, kMaxUs)));
+    return w->sender.holdFor(static_cast<typr::io::Key>(key), duration);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_hold_for");
+    return false;
+  }
+}
+
+TYPR_IO_API bool typr_io_sender_repeat(typr_io_sender_t sender,
+                                       typr_io_key_t key, uint32_t count,
+                                       double per_second) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.repeat(static_cast<typr::io::Key>(key), count,
+                            per_second);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_repeat");
+    return false;
+  }
+}
+
+TYPR_IO_API size_t typr_io_sender_send_events(typr_io_sender_t sender,
+                                              const typr_io_event_t *events,
+                                              size_t count) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  if (!events && count > 0) {
+    set_last_error("events is NULL");
+    return 0;
+  }
+  size_t done = 0;
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    for (; done < count; ++done) {
+      const typr_io_event_t &ev = events[done];
+      const auto key = static_cast<typr::io::Key>(ev.key);
+      bool ok = true;
+      if (key != typr::io::Key::Unknown)
+        ok = ev.pressed ? w->sender.keyDown(key) : w->sender.keyUp(key);
+      else if (ev.pressed && ev.codepoint != 0)
+        ok = w->sender.typeCharacter(static_cast<char32_t>(ev.codepoint));
+      if (!ok)
+        break;
+    }
+    return done;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return done;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_send_events");
+    return done;
+  }
+}
+
 TYPR_IO_API bool typr_io_sender_type_text_utf8(typr_io_sender_t sender,
                                                const char *utf8_text) {
   if (!sender) {
@@ -396,7 +586,7 @@ TYPR_IO_API bool typr_io_sender_type_text_utf8(typr_io_sender_t sender,
   try {
     clear_last_error();
     SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
-    return w->sender.typeText(std::string(utf8_text));
+    return w->sender.typeText(std::string_view(utf8_text));
   } catch (const std::exception &e) {
     set_last_error(e.what());
     return false;
@@ -406,6 +596,77 @@ TYPR_IO_API bool typr_io_sender_type_text_utf8(typr_io_sender_t sender,
   }
 }
 
+TYPR_IO_API bool typr_io_sender_type_text_bulk_utf8(typr_io_sender_t sender,
+                                                    const char *utf8_text) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  if (!utf8_text) {
+    set_last_error("utf8_text is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.typeTextBulk(std::string_view(utf8_text));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_type_text_bulk_utf8");
+    return false;
+  }
+}
+
+TYPR_IO_API bool typr_io_sender_type_text_utf8_n(typr_io_sender_t sender,
+                                                 const char *utf8_text,
+                                                 size_t len) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  if (!utf8_text && len > 0) {
+    set_last_error("utf8_text is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.typeText(std::string_view(utf8_text, len));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_type_text_utf8_n");
+    return false;
+  }
+}
+
+TYPR_IO_API bool typr_io_sender_type_text_bulk_utf8_n(typr_io_sender_t sender,
+                                                      const char *utf8_text,
+                                                      size_t len) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  if (!utf8_text && len > 0) {
+    set_last_error("utf8_text is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.typeTextBulk(std::string_view(utf8_text, len));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_type_text_bulk_utf8_n");
+    return false;
+  }
+}
+
 TYPR_IO_API bool typr_io_sender_type_character(typr_io_sender_t sender,
                                                uint32_t codepoint) {
   if (!sender) {
@@ -458,6 +719,67 @@ TYPR_IO_API void typr_io_sender_set_key_delay(typr_io_sender_t sender,
   }
 }
 
+TYPR_IO_API void typr_io_sender_set_typing_rate(typr_io_sender_t sender,
+                                                double chars_per_second) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    w->sender.setTypingRate(chars_per_second);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_set_typing_rate");
+  }
+}
+
+TYPR_IO_API void typr_io_sender_set_frame_coalescing(typr_io_sender_t sender,
+                                                     bool enabled) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    w->sender.setFrameCoalescing(enabled);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_set_frame_coalescing");
+  }
+}
+
+TYPR_IO_API bool typr_io_sender_get_stats(typr_io_sender_t sender,
+                                          typr_io_sender_stats_t *out) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  if (!out) {
+    set_last_error("out is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    const typr::io::SenderStats st = w->sender.stats();
+    *out = typr_io_sender_stats_t{st.injectedEvents, st.injectCalls,
+                                  st.failedCalls, st.lastInjectNs,
+                                  to_c_latency(st.injectDuration)};
+    return true;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_sender_get_stats");
+    return false;
+  }
+}
+
 /* ---------------- Listener implementation ---------------- */
 
 TYPR_IO_API typr_io_listener_t typr_io_listener_create(void) {
@@ -478,6 +800,38 @@ TYPR_IO_API typr_io_listener_t typr_io_listener_create(void) {
   }
 }
 
+TYPR_IO_API typr_io_listener_t typr_io_listener_create_with_options(
+    const typr_io_listener_options_t *options) {
+  try {
+    clear_last_error();
+    typr::io::ListenerOptions opts;
+    if (options) {
+      for (size_t i = 0; options->seats && i < options->seat_count; ++i) {
+        if (options->seats[i])
+          opts.seats.emplace_back(options->seats[i]);
+      }
+      for (size_t i = 0; options->devices && i < options->device_count; ++i) {
+        if (options->devices[i])
+          opts.devices.emplace_back(options->devices[i]);
+      }
+      opts.parallelCallbacks = options->parallel_callbacks;
+      opts.rawInput = options->raw_input;
+    }
+    ListenerWrapper *w = new (std::nothrow) ListenerWrapper(opts);
+    if (!w) {
+      set_last_error("Out of memory (listener)");
+      return nullptr;
+    }
+    return reinterpret_cast<typr_io_listener_t>(w);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_listener_create_with_options");
+    return nullptr;
+  }
+}
+
 TYPR_IO_API void typr_io_listener_destroy(typr_io_listener_t listener) {
   if (!listener) {
     return;
@@ -517,11 +871,7 @@ TYPR_IO_API bool typr_io_listener_start(typr_io_listener_t listener,
 
     // Store callback and user_data before starting to avoid a race where an
     // internal thread invokes the callback immediately after start() returns.
-    {
-      std::lock_guard<std::mutex> lk(w->cb_mutex);
-      w->cb = cb;
-      w->user_data = user_data;
-    }
+    w->callback.store(CListenerCallback{cb, nullptr, user_data});
 
     /**
      * @internal
@@ -529,9 +879,8 @@ TYPR_IO_API bool typr_io_listener_start(typr_io_listener_t listener,
      * callback.
      *
      * Responsibilities:
-     *  - Acquire `w->cb_mutex` to safely copy the stored C callback pointer
-     *    and the associated `user_data` pointer so invocation can occur
-     *    without holding the lock.
+     *  - Read the stored C callback pointer and the associated `user_data`
+     *    pointer from the RCU cell (lock-free, no allocation).
      *  - Convert/normalize types for the C ABI: `char32_t` -> `uint32_t`,
      *    `typr::io::Key` -> `typr_io_key_t`, `typr::io::Modifier` ->
      *    `typr_io_modifier_t`.
@@ -546,34 +895,26 @@ TYPR_IO_API bool typr_io_listener_start(typr_io_listener_t listener,
      */
     auto bridge = [w](char32_t codepoint, typr::io::Key key,
                       typr::io::Modifier mods, bool pressed) {
-      // Forward event to C callback; protect access to cb & user_data.
-      typr_io_listener_cb local_cb = nullptr;
-      void *local_ud = nullptr;
-      {
-        std::lock_guard<std::mutex> lk(w->cb_mutex);
-        local_cb = w->cb;
-        local_ud = w->user_data;
-      }
-      if (local_cb) {
+      w->callback.visit([&](const CListenerCallback &c) {
+        if (!c.cb)
+          return;
         try {
-          local_cb(static_cast<uint32_t>(codepoint),
-                   static_cast<typr_io_key_t>(key),
-                   static_cast<typr_io_modifier_t>(static_cast<uint8_t>(mods)),
-                   pressed, local_ud);
+          c.cb(static_cast<uint32_t>(codepoint),
+               static_cast<typr_io_key_t>(key),
+               static_cast<typr_io_modifier_t>(static_cast<uint8_t>(mods)),
+               pressed, c.user_data);
         } catch (...) {
           // Swallow exceptions from user-provided C callbacks to avoid letting
           // them unwind into C++ internals.
         }
-      }
+      });
     };
 
     bool ok = w->listener.start(bridge);
     if (!ok) {
       // On failure clear stored callback so listener_destroy/stop sees a clean
       // state.
-      std::lock_guard<std::mutex> lk(w->cb_mutex);
-      w->cb = nullptr;
-      w->user_data = nullptr;
+      w->callback.reset();
     }
     return ok;
   } catch (const std::exception &e) {
@@ -585,6 +926,50 @@ TYPR_IO_API bool typr_io_listener_start(typr_io_listener_t listener,
   }
 }
 
+TYPR_IO_API bool typr_io_listener_start_events(typr_io_listener_t listener,
+                                               typr_io_listener_event_cb cb,
+                                               void *user_data) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  if (!cb) {
+    set_last_error("callback is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    w->callback.store(CListenerCallback{nullptr, cb, user_data});
+
+    // Same contract as the bridge in typr_io_listener_start, but forwarding
+    // the whole event record.
+    auto bridge = [w](const typr::io::Listener::Event &event) {
+      w->callback.visit([&](const CListenerCallback &c) {
+        if (!c.event_cb)
+          return;
+        const typr_io_event_t ev = to_c_event(event);
+        try {
+          c.event_cb(&ev, c.user_data);
+        } catch (...) {
+          // Never let exceptions unwind into the listener thread.
+        }
+      });
+    };
+
+    bool ok = w->listener.start(typr::io::Listener::EventCallback{bridge});
+    if (!ok)
+      w->callback.reset();
+    return ok;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_listener_start_events");
+    return false;
+  }
+}
+
 TYPR_IO_API void typr_io_listener_stop(typr_io_listener_t listener) {
   if (!listener) {
     set_last_error("listener is NULL");
@@ -595,9 +980,7 @@ TYPR_IO_API void typr_io_listener_stop(typr_io_listener_t listener) {
     ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
     w->listener.stop();
     // Clear callback & user_data so subsequent events are ignored.
-    std::lock_guard<std::mutex> lk(w->cb_mutex);
-    w->cb = nullptr;
-    w->user_data = nullptr;
+    w->callback.reset();
   } catch (const std::exception &e) {
     set_last_error(e.what());
   } catch (...) {
@@ -605,6 +988,72 @@ TYPR_IO_API void typr_io_listener_stop(typr_io_listener_t listener) {
   }
 }
 
+TYPR_IO_API bool typr_io_listener_start_queued(typr_io_listener_t listener,
+                                               size_t capacity) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    // Queued mode bypasses the C callback bridge entirely.
+    w->callback.reset();
+    return w->listener.startQueued(capacity);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_listener_start_queued");
+    return false;
+  }
+}
+
+TYPR_IO_API size_t typr_io_listener_read_events(typr_io_listener_t listener,
+                                                typr_io_event_t *out,
+                                                size_t max_events) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return 0;
+  }
+  if (!out && max_events > 0) {
+    set_last_error("out is NULL");
+    return 0;
+  }
+  try {
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    // Drain through a small stack batch and convert to the C layout.
+    typr::io::Listener::Event batch[64];
+    size_t total = 0;
+    while (total < max_events) {
+      size_t want = std::min(max_events - total, std::size(batch));
+      size_t n = w->listener.poll(std::span(batch, want));
+      for (size_t i = 0; i < n; ++i)
+        out[total + i] = to_c_event(batch[i]);
+      total += n;
+      if (n < want)
+        break;
+    }
+    return total;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_listener_read_events");
+    return 0;
+  }
+}
+
+TYPR_IO_API uint64_t
+typr_io_listener_dropped_events(typr_io_listener_t listener) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return 0;
+  }
+  return reinterpret_cast<ListenerWrapper *>(listener)
+      ->listener.droppedEvents();
+}
+
 TYPR_IO_API bool typr_io_listener_is_listening(typr_io_listener_t listener) {
   if (!listener) {
     set_last_error("listener is NULL");
@@ -623,12 +1072,198 @@ TYPR_IO_API bool typr_io_listener_is_listening(typr_io_listener_t listener) {
   }
 }
 
+TYPR_IO_API bool typr_io_listener_get_stats(typr_io_listener_t listener,
+                                            typr_io_listener_stats_t *out) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  if (!out) {
+    set_last_error("out is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    const typr::io::ListenerStats st = w->listener.stats();
+    *out = typr_io_listener_stats_t{st.events,
+                                    st.droppedEvents,
+                                    st.filteredEvents,
+                                    st.uptimeNs,
+                                    st.eventsPerSecond,
+                                    to_c_latency(st.hookLatency),
+                                    to_c_latency(st.callbackDuration)};
+    return true;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_listener_get_stats");
+    return false;
+  }
+}
+
+/* ---------------- Hotkeys implementation ---------------- */
+
+TYPR_IO_API typr_io_hotkeys_t typr_io_hotkeys_create(void) {
+  try {
+    clear_last_error();
+    HotkeysWrapper *w = new (std::nothrow) HotkeysWrapper();
+    if (!w) {
+      set_last_error("Out of memory (hotkeys)");
+      return nullptr;
+    }
+    return reinterpret_cast<typr_io_hotkeys_t>(w);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_hotkeys_create");
+    return nullptr;
+  }
+}
+
+TYPR_IO_API void typr_io_hotkeys_destroy(typr_io_hotkeys_t hotkeys) {
+  if (!hotkeys)
+    return;
+  try {
+    clear_last_error();
+    delete reinterpret_cast<HotkeysWrapper *>(hotkeys);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_hotkeys_destroy");
+  }
+}
+
+TYPR_IO_API uint32_t typr_io_hotkeys_add(typr_io_hotkeys_t hotkeys,
+                                         const char *spec, typr_io_hotkey_cb cb,
+                                         void *user_data) {
+  if (!hotkeys) {
+    set_last_error("hotkeys is NULL");
+    return 0;
+  }
+  if (!spec) {
+    set_last_error("spec is NULL");
+    return 0;
+  }
+  if (!cb) {
+    set_last_error("callback is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    HotkeysWrapper *w = reinterpret_cast<HotkeysWrapper *>(hotkeys);
+    uint32_t id = w->matcher.add(
+        std::string_view(spec), [cb, user_data](uint32_t hotkeyId) {
+          try {
+            cb(hotkeyId, user_data);
+          } catch (...) {
+            // Never let exceptions unwind into the listener thread.
+          }
+        });
+    if (id == 0)
+      set_last_error(std::string("invalid hotkey: ") + spec);
+    return id;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_hotkeys_add");
+    return 0;
+  }
+}
+
+TYPR_IO_API bool typr_io_hotkeys_remove(typr_io_hotkeys_t hotkeys,
+                                        uint32_t hotkey_id) {
+  if (!hotkeys) {
+    set_last_error("hotkeys is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    return reinterpret_cast<HotkeysWrapper *>(hotkeys)->matcher.remove(
+        hotkey_id);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_hotkeys_remove");
+    return false;
+  }
+}
+
+TYPR_IO_API void typr_io_hotkeys_set_step_timeout_ms(typr_io_hotkeys_t hotkeys,
+                                                     uint32_t timeout_ms) {
+  if (!hotkeys) {
+    set_last_error("hotkeys is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    reinterpret_cast<HotkeysWrapper *>(hotkeys)->matcher.setStepTimeout(
+        std::chrono::milliseconds(timeout_ms));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_hotkeys_set_step_timeout_ms");
+  }
+}
+
+TYPR_IO_API bool typr_io_hotkeys_feed(typr_io_hotkeys_t hotkeys,
+                                      const typr_io_event_t *event) {
+  if (!hotkeys) {
+    set_last_error("hotkeys is NULL");
+    return false;
+  }
+  if (!event) {
+    set_last_error("event is NULL");
+    return false;
+  }
+  try {
+    return reinterpret_cast<HotkeysWrapper *>(hotkeys)->matcher.feed(
+        from_c_event(*event));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_hotkeys_feed");
+    return false;
+  }
+}
+
+TYPR_IO_API bool typr_io_hotkeys_attach(typr_io_hotkeys_t hotkeys,
+                                        typr_io_listener_t listener) {
+  if (!hotkeys) {
+    set_last_error("hotkeys is NULL");
+    return false;
+  }
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *lw = reinterpret_cast<ListenerWrapper *>(listener);
+    // The matcher replaces the C callback bridge on this listener
+    lw->callback.reset();
+    return reinterpret_cast<HotkeysWrapper *>(hotkeys)->matcher.attach(
+        lw->listener);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in typr_io_hotkeys_attach");
+    return false;
+  }
+}
+
 /* ---------------- Utilities ---------------- */
 
 TYPR_IO_API char *typr_io_key_to_string(typr_io_key_t key) {
   try {
     clear_last_error();
-    std::string s = typr::io::keyToString(static_cast<typr::io::Key>(key));
+    std::string s(typr::io::keyToStringView(static_cast<typr::io::Key>(key)));
     return duplicate_c_string(s);
   } catch (const std::exception &e) {
     set_last_error(e.what());
@@ -639,6 +1274,12 @@ TYPR_IO_API char *typr_io_key_to_string(typr_io_key_t key) {
   }
 }
 
+TYPR_IO_API const char *typr_io_key_name(typr_io_key_t key) {
+  // Views returned by keyToStringView point at static string literals, so
+  // they are null-terminated and never need to be freed.
+  return typr::io::keyToStringView(static_cast<typr::io::Key>(key)).data();
+}
+
 TYPR_IO_API typr_io_key_t typr_io_string_to_key(const char *name) {
   if (!name) {
     set_last_error("name is NULL");
@@ -646,7 +1287,7 @@ TYPR_IO_API typr_io_key_t typr_io_string_to_key(const char *name) {
   }
   try {
     clear_last_error();
-    typr::io::Key k = typr::io::stringToKey(std::string(name));
+    typr::io::Key k = typr::io::stringToKey(name);
     return static_cast<typr_io_key_t>(k);
   } catch (const std::exception &e) {
     set_last_error(e.what());
@@ -671,11 +1312,14 @@ TYPR_IO_API const char *typr_io_library_version(void) {
 }
 
 TYPR_IO_API char *typr_io_get_last_error(void) {
-  std::lock_guard<std::mutex> lk(g_last_error_mutex);
-  if (g_last_error.empty()) {
+  if (t_last_error.empty()) {
     return nullptr;
   }
-  return duplicate_c_string(g_last_error);
+  return duplicate_c_string(t_last_error);
+}
+
+TYPR_IO_API const char *typr_io_last_error_message(void) {
+  return t_last_error.empty() ? nullptr : t_last_error.c_str();
 }
 
 TYPR_IO_API void typr_io_clear_last_error(void) { clear_last_error(); }
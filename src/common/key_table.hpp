@@ -0,0 +1,238 @@
+#pragma once
+
+/**
+ * @file key_table.hpp
+ * @brief Internal flat lookup tables shared by the Sender and Listener
+ * backends.
+ *
+ * `KeyTable` maps a logical `Key` to a native key code (evdev code, Win32
+ * VK, CGKeyCode) through a dense array indexed by the `Key` value;
+ * `CodeKeyTable` is the reverse direction, indexed by the native code.
+ * `CodepointTable` maps Unicode codepoints to a per-backend value with a
+ * two-level layout: a direct array for U+0000..U+024F (ASCII, Latin-1 and
+ * Latin Extended-A/B, which covers the overwhelming majority of typed text)
+ * and a sorted vector searched by binary search for everything else.
+ *
+ * The tables are built once (when the layout is scanned) and then only read
+ * on the injection and event hot paths, where a lookup is a bounds check
+ * plus one load.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <typr-io/core.hpp>
+
+namespace typr::io::detail {
+
+/**
+ * @internal
+ * @brief Dense `Key` -> native code table.
+ *
+ * @tparam Code Native key code type.
+ * @tparam Invalid Sentinel returned for keys without a mapping.
+ */
+template <typename Code, Code Invalid> class KeyTable {
+public:
+  static constexpr Code kInvalid = Invalid;
+
+  KeyTable() { clear(); }
+
+  /**
+   * @brief Remove every mapping.
+   */
+  void clear() {
+    m_codes.fill(Invalid);
+    m_size = 0;
+  }
+
+  /**
+   * @brief Return the native code for `key`, or `kInvalid`.
+   */
+  [[nodiscard]] Code find(Key key) const {
+    auto index = static_cast<std::size_t>(key);
+    return index < m_codes.size() ? m_codes[index] : Invalid;
+  }
+
+  [[nodiscard]] bool contains(Key key) const { return find(key) != Invalid; }
+
+  /**
+   * @brief Map `key` to `code` unless it already has a mapping.
+   * @return true if the mapping was inserted.
+   */
+  bool insert(Key key, Code code) {
+    auto index = static_cast<std::size_t>(key);
+    if (index >= m_codes.size() || code == Invalid ||
+        m_codes[index] != Invalid)
+      return false;
+    m_codes[index] = code;
+    ++m_size;
+    return true;
+  }
+
+  /**
+   * @brief Number of keys with a mapping.
+   */
+  [[nodiscard]] std::size_t size() const { return m_size; }
+
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+
+  /**
+   * @brief Invoke `fn(Key, Code)` for every mapping, in `Key` order.
+   */
+  template <typename Fn> void forEach(Fn &&fn) const {
+    for (std::size_t i = 0; i < m_codes.size(); ++i) {
+      if (m_codes[i] != Invalid)
+        fn(static_cast<Key>(i), m_codes[i]);
+    }
+  }
+
+private:
+  std::array<Code, kKeyCount> m_codes{};
+  std::size_t m_size{0};
+};
+
+/**
+ * @internal
+ * @brief Dense native code -> `Key` table (the reverse of `KeyTable`).
+ *
+ * Lets a Listener translate the code it receives with one indexed load.
+ * Codes at or above `Limit` never have a mapping.
+ *
+ * @tparam Limit Number of native codes covered.
+ */
+template <std::size_t Limit> class CodeKeyTable {
+public:
+  static constexpr std::size_t kLimit = Limit;
+
+  /**
+   * @brief Remove every mapping.
+   */
+  void clear() {
+    m_keys.fill(Key::Unknown);
+    m_size = 0;
+  }
+
+  /**
+   * @brief Return the `Key` for `code`, or `Key::Unknown`.
+   */
+  [[nodiscard]] Key find(std::size_t code) const {
+    return code < Limit ? m_keys[code] : Key::Unknown;
+  }
+
+  /**
+   * @brief Map `code` to `key` unless it already has a mapping.
+   * @return true if the mapping was inserted.
+   */
+  bool insert(std::size_t code, Key key) {
+    if (code >= Limit || key == Key::Unknown || m_keys[code] != Key::Unknown)
+      return false;
+    m_keys[code] = key;
+    ++m_size;
+    return true;
+  }
+
+  /**
+   * @brief Number of codes with a mapping.
+   */
+  [[nodiscard]] std::size_t size() const { return m_size; }
+
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+
+private:
+  std::array<Key, Limit> m_keys{};
+  std::size_t m_size{0};
+};
+
+/**
+ * @internal
+ * @brief Two-level codepoint -> value table.
+ *
+ * @tparam Value Trivially copyable value stored per codepoint.
+ */
+template <typename Value> class CodepointTable {
+public:
+  /// Codepoints below this limit live in the direct array.
+  static constexpr char32_t kDirectLimit = 0x250;
+
+  /**
+   * @brief Remove every mapping.
+   */
+  void clear() {
+    m_present.reset();
+    m_other.clear();
+    m_size = 0;
+  }
+
+  /**
+   * @brief Return a pointer to the value for `cp`, or nullptr.
+   */
+  [[nodiscard]] const Value *find(char32_t cp) const {
+    if (cp < kDirectLimit)
+      return m_present.test(cp) ? &m_direct[cp] : nullptr;
+    auto it = std::lower_bound(
+        m_other.begin(), m_other.end(), cp,
+        [](const Entry &e, char32_t value) { return e.first < value; });
+    return (it != m_other.end() && it->first == cp) ? &it->second : nullptr;
+  }
+
+  [[nodiscard]] bool contains(char32_t cp) const { return find(cp) != nullptr; }
+
+  /**
+   * @brief Map `cp` to `value` unless it already has a mapping.
+   * @return true if the mapping was inserted.
+   */
+  bool insert(char32_t cp, const Value &value) {
+    if (cp < kDirectLimit) {
+      if (m_present.test(cp))
+        return false;
+      m_present.set(cp);
+      m_direct[cp] = value;
+    } else {
+      auto it = std::lower_bound(
+          m_other.begin(), m_other.end(), cp,
+          [](const Entry &e, char32_t v) { return e.first < v; });
+      if (it != m_other.end() && it->first == cp)
+        return false;
+      m_other.insert(it, Entry{cp, value});
+    }
+    ++m_size;
+    return true;
+  }
+
+  /**
+   * @brief Number of codepoints with a mapping.
+   */
+  [[nodiscard]] std::size_t size() const { return m_size; }
+
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+
+  /**
+   * @brief Invoke `fn(char32_t, const Value&)` for every mapping, in
+   * codepoint order.
+   */
+  template <typename Fn> void forEach(Fn &&fn) const {
+    for (char32_t cp = 0; cp < kDirectLimit; ++cp) {
+      if (m_present.test(cp))
+        fn(cp, m_direct[cp]);
+    }
+    for (const auto &e : m_other)
+      fn(e.first, e.second);
+  }
+
+private:
+  using Entry = std::pair<char32_t, Value>;
+
+  std::array<Value, kDirectLimit> m_direct{};
+  std::bitset<kDirectLimit> m_present;
+  std::vector<Entry> m_other;
+  std::size_t m_size{0};
+};
+
+} // namespace typr::io::detail
@@ -3,19 +3,23 @@
  * @brief Utility helpers for mapping between `Key` enums and their canonical
  * textual names, and other small string helpers used by the key utilities.
  *
- * This file implements `keyToString` and `stringToKey` and several internal
- * helpers used to normalize and escape input for logging and lookups.
+ * This file implements `keyToStringView`, `keyToString` and `stringToKey` and
+ * several internal helpers used to normalize and escape input for logging and
+ * lookups. Both directions are backed by tables generated at compile time:
+ * a dense array indexed by `Key` for names, and a sorted array searched by
+ * binary search for parsing.
  */
 
 #include <typr-io/core.hpp>
 #include <typr-io/log.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <string>
-#include <unordered_map>
-#include <vector>
+#include <string_view>
 
 namespace typr {
 namespace io {
@@ -54,7 +58,7 @@ std::string toLower(std::string inputString) {
  * @param input Input string to escape.
  * @return std::string Escaped string suitable for inline debug logging.
  */
-std::string escapeForLog(const std::string &input) {
+std::string escapeForLog(std::string_view input) {
   std::string out;
   out.reserve(input.size() * 2);
   for (unsigned char c : input) {
@@ -81,287 +85,657 @@ std::string escapeForLog(const std::string &input) {
   return out;
 }
 
+
+/**
+ * @brief ASCII-only lower-casing usable in constant expressions.
+ */
+constexpr char asciiLower(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Case-insensitive three-way comparison of two ASCII strings.
+ */
+constexpr int compareNoCase(std::string_view lhs, std::string_view rhs) {
+  const std::size_t n = std::min(lhs.size(), rhs.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto a = static_cast<unsigned char>(asciiLower(lhs[i]));
+    const auto b = static_cast<unsigned char>(asciiLower(rhs[i]));
+    if (a != b)
+      return a < b ? -1 : 1;
+  }
+  if (lhs.size() == rhs.size())
+    return 0;
+  return lhs.size() < rhs.size() ? -1 : 1;
+}
+
+/**
+ * @brief A canonical `Key` -> name mapping.
+ */
+struct KeyName {
+  Key key;
+  std::string_view name;
+};
+
+/**
+ * @brief Canonical Key -> string mappings.
+ *
+ * Used to generate the dense `kKeyNames` table returned by `keyToStringView`
+ * and to seed the reverse lookup table used by `stringToKey`. All names are
+ * string literals, so views into them are null-terminated.
+ */
+constexpr KeyName kCanonicalNames[] = {
+  {Key::Unknown, "Unknown"},
+  // Letters
+  {Key::A, "A"},
+  {Key::B, "B"},
+  {Key::C, "C"},
+  {Key::D, "D"},
+  {Key::E, "E"},
+  {Key::F, "F"},
+  {Key::G, "G"},
+  {Key::H, "H"},
+  {Key::I, "I"},
+  {Key::J, "J"},
+  {Key::K, "K"},
+  {Key::L, "L"},
+  {Key::M, "M"},
+  {Key::N, "N"},
+  {Key::O, "O"},
+  {Key::P, "P"},
+  {Key::Q, "Q"},
+  {Key::R, "R"},
+  {Key::S, "S"},
+  {Key::T, "T"},
+  {Key::U, "U"},
+  {Key::V, "V"},
+  {Key::W, "W"},
+  {Key::X, "X"},
+  {Key::Y, "Y"},
+  {Key::Z, "Z"},
+  // Numbers (top row)
+  {Key::Num0, "0"},
+  {Key::Num1, "1"},
+  {Key::Num2, "2"},
+  {Key::Num3, "3"},
+  {Key::Num4, "4"},
+  {Key::Num5, "5"},
+  {Key::Num6, "6"},
+  {Key::Num7, "7"},
+  {Key::Num8, "8"},
+  {Key::Num9, "9"},
+  // Function keys
+  {Key::F1, "F1"},
+  {Key::F2, "F2"},
+  {Key::F3, "F3"},
+  {Key::F4, "F4"},
+  {Key::F5, "F5"},
+  {Key::F6, "F6"},
+  {Key::F7, "F7"},
+  {Key::F8, "F8"},
+  {Key::F9, "F9"},
+  {Key::F10, "F10"},
+  {Key::F11, "F11"},
+  {Key::F12, "F12"},
+  {Key::F13, "F13"},
+  {Key::F14, "F14"},
+  {Key::F15, "F15"},
+  {Key::F16, "F16"},
+  {Key::F17, "F17"},
+  {Key::F18, "F18"},
+  {Key::F19, "F19"},
+  {Key::F20, "F20"},
+  // Control keys
+  {Key::Enter, "Enter"},
+  {Key::Escape, "Escape"},
+  {Key::Backspace, "Backspace"},
+  {Key::Tab, "Tab"},
+  {Key::Space, "Space"},
+  // Navigation
+  {Key::Left, "Left"},
+  {Key::Right, "Right"},
+  {Key::Up, "Up"},
+  {Key::Down, "Down"},
+  {Key::Home, "Home"},
+  {Key::End, "End"},
+  {Key::PageUp, "PageUp"},
+  {Key::PageDown, "PageDown"},
+  {Key::Delete, "Delete"},
+  {Key::Insert, "Insert"},
+  {Key::PrintScreen, "PrintScreen"},
+  {Key::ScrollLock, "ScrollLock"},
+  {Key::Pause, "Pause"},
+  // Numpad
+  {Key::NumpadDivide, "NumpadDivide"},
+  {Key::NumpadMultiply, "NumpadMultiply"},
+  {Key::NumpadMinus, "NumpadMinus"},
+  {Key::NumpadPlus, "NumpadPlus"},
+  {Key::NumpadEnter, "NumpadEnter"},
+  {Key::NumpadDecimal, "NumpadDecimal"},
+  {Key::Numpad0, "Numpad0"},
+  {Key::Numpad1, "Numpad1"},
+  {Key::Numpad2, "Numpad2"},
+  {Key::Numpad3, "Numpad3"},
+  {Key::Numpad4, "Numpad4"},
+  {Key::Numpad5, "Numpad5"},
+  {Key::Numpad6, "Numpad6"},
+  {Key::Numpad7, "Numpad7"},
+  {Key::Numpad8, "Numpad8"},
+  {Key::Numpad9, "Numpad9"},
+  // Modifiers
+  {Key::ShiftLeft, "ShiftLeft"},
+  {Key::ShiftRight, "ShiftRight"},
+  {Key::CtrlLeft, "CtrlLeft"},
+  {Key::CtrlRight, "CtrlRight"},
+  {Key::AltLeft, "AltLeft"},
+  {Key::AltRight, "AltRight"},
+  {Key::SuperLeft, "SuperLeft"},
+  {Key::SuperRight, "SuperRight"},
+  {Key::CapsLock, "CapsLock"},
+  {Key::NumLock, "NumLock"},
+  // Misc
+  {Key::Help, "Help"},
+  {Key::Menu, "Menu"},
+  {Key::Power, "Power"},
+  {Key::Sleep, "Sleep"},
+  {Key::Wake, "Wake"},
+  {Key::Mute, "Mute"},
+  {Key::VolumeDown, "VolumeDown"},
+  {Key::VolumeUp, "VolumeUp"},
+  {Key::MediaPlayPause, "MediaPlayPause"},
+  {Key::MediaStop, "MediaStop"},
+  {Key::MediaNext, "MediaNext"},
+  {Key::MediaPrevious, "MediaPrevious"},
+  {Key::BrightnessDown, "BrightnessDown"},
+  {Key::BrightnessUp, "BrightnessUp"},
+  {Key::Eject, "Eject"},
+  // Punctuation / layout-dependent
+  {Key::Grave, "`"},
+  {Key::Minus, "-"},
+  {Key::Equal, "="},
+  {Key::LeftBracket, "["},
+  {Key::RightBracket, "]"},
+  {Key::Backslash, "\\"},
+  {Key::Semicolon, ";"},
+  {Key::Apostrophe, "'"},
+  {Key::Comma, ","},
+  {Key::Period, "."},
+  {Key::Slash, "/"},
+  // Shifted / symbol characters (canonical textual names)
+  {Key::At, "At"},
+  {Key::Hashtag, "Hashtag"},
+  {Key::Exclamation, "Exclamation"},
+  {Key::Dollar, "Dollar"},
+  {Key::Percent, "Percent"},
+  {Key::Caret, "Caret"},
+  {Key::Ampersand, "Ampersand"},
+  {Key::Asterisk, "Asterisk"},
+  {Key::LeftParen, "LeftParen"},
+  {Key::RightParen, "RightParen"},
+  {Key::Underscore, "Underscore"},
+  {Key::Plus, "Plus"},
+  {Key::Colon, "Colon"},
+  {Key::Quote, "Quote"},
+  {Key::QuestionMark, "QuestionMark"},
+  {Key::Bar, "Bar"},
+  {Key::LessThan, "LessThan"},
+  {Key::GreaterThan, "GreaterThan"},
+  // ASCII control canonical names (C0 / DEL)
+  {Key::AsciiNUL, "NUL"},
+  {Key::AsciiSOH, "SOH"},
+  {Key::AsciiSTX, "STX"},
+  {Key::AsciiETX, "ETX"},
+  {Key::AsciiEOT, "EOT"},
+  {Key::AsciiENQ, "ENQ"},
+  {Key::AsciiACK, "ACK"},
+  {Key::AsciiBell, "Bell"},
+  {Key::AsciiVT, "VT"},
+  {Key::AsciiFF, "FF"},
+  {Key::AsciiSO, "SO"},
+  {Key::AsciiSI, "SI"},
+  {Key::AsciiDLE, "DLE"},
+  {Key::AsciiDC1, "DC1"},
+  {Key::AsciiDC2, "DC2"},
+  {Key::AsciiDC3, "DC3"},
+  {Key::AsciiDC4, "DC4"},
+  {Key::AsciiNAK, "NAK"},
+  {Key::AsciiSYN, "SYN"},
+  {Key::AsciiETB, "ETB"},
+  {Key::AsciiCAN, "CAN"},
+  {Key::AsciiEM, "EM"},
+  {Key::AsciiSUB, "SUB"},
+  {Key::AsciiFS, "FS"},
+  {Key::AsciiGS, "GS"},
+  {Key::AsciiRS, "RS"},
+  {Key::AsciiUS, "US"},
+  {Key::AsciiDEL, "DEL"},
+  // Additional canonical names for X11 / XF86 / international keys added
+  // to the Key enum so they can roundtrip via `keyToString` and seed the
+  // reverse lookup table.
+  {Key::NumpadEqual, "NumpadEqual"},
+  {Key::Degree, "Degree"},
+  {Key::Sterling, "Sterling"},
+  {Key::Mu, "Mu"},
+  {Key::PlusMinus, "PlusMinus"},
+  {Key::DeadCircumflex, "DeadCircumflex"},
+  {Key::DeadDiaeresis, "DeadDiaeresis"},
+  {Key::Section, "Section"},
+  {Key::Cancel, "Cancel"},
+  {Key::Redo, "Redo"},
+  {Key::Undo, "Undo"},
+  {Key::Find, "Find"},
+  {Key::Hangul, "Hangul"},
+  {Key::HangulHanja, "HangulHanja"},
+  {Key::Katakana, "Katakana"},
+  {Key::Hiragana, "Hiragana"},
+  {Key::Henkan, "Henkan"},
+  {Key::Muhenkan, "Muhenkan"},
+  {Key::OE, "OE"},
+  {Key::oe, "oe"},
+  {Key::SunProps, "SunProps"},
+  {Key::SunFront, "SunFront"},
+  {Key::Copy, "Copy"},
+  {Key::Open, "Open"},
+  {Key::Paste, "Paste"},
+  {Key::Cut, "Cut"},
+  {Key::Calculator, "Calculator"},
+  {Key::Explorer, "Explorer"},
+  {Key::Phone, "Phone"},
+  {Key::WebCam, "WebCam"},
+  {Key::AudioRecord, "AudioRecord"},
+  {Key::AudioRewind, "AudioRewind"},
+  {Key::AudioPreset, "AudioPreset"},
+  {Key::Messenger, "Messenger"},
+  {Key::Search, "Search"},
+  {Key::Go, "Go"},
+  {Key::Finance, "Finance"},
+  {Key::Game, "Game"},
+  {Key::Shop, "Shop"},
+  {Key::HomePage, "HomePage"},
+  {Key::Reload, "Reload"},
+  {Key::Close, "Close"},
+  {Key::Send, "Send"},
+  {Key::Xfer, "Xfer"},
+  {Key::LaunchA, "LaunchA"},
+  {Key::LaunchB, "LaunchB"},
+  {Key::Launch1, "Launch1"},
+  {Key::Launch2, "Launch2"},
+  {Key::Launch3, "Launch3"},
+  {Key::Launch4, "Launch4"},
+  {Key::Launch5, "Launch5"},
+  {Key::Launch6, "Launch6"},
+  {Key::Launch7, "Launch7"},
+  {Key::Launch8, "Launch8"},
+  {Key::Launch9, "Launch9"},
+  {Key::TouchpadToggle, "TouchpadToggle"},
+  {Key::TouchpadOn, "TouchpadOn"},
+  {Key::TouchpadOff, "TouchpadOff"},
+  {Key::KbdLightOnOff, "KbdLightOnOff"},
+  {Key::KbdBrightnessDown, "KbdBrightnessDown"},
+  {Key::KbdBrightnessUp, "KbdBrightnessUp"},
+  {Key::Mail, "Mail"},
+  {Key::MailForward, "MailForward"},
+  {Key::Save, "Save"},
+  {Key::Documents, "Documents"},
+  {Key::Battery, "Battery"},
+  {Key::Bluetooth, "Bluetooth"},
+  {Key::WLAN, "WLAN"},
+  {Key::UWB, "UWB"},
+  {Key::Next_VMode, "Next_VMode"},
+  {Key::Prev_VMode, "Prev_VMode"},
+  {Key::MonBrightnessCycle, "MonBrightnessCycle"},
+  {Key::BrightnessAuto, "BrightnessAuto"},
+  {Key::DisplayOff, "DisplayOff"},
+  {Key::WWAN, "WWAN"},
+  {Key::RFKill, "RFKill"},
+};
+
+/**
+ * @brief A textual alias accepted by `stringToKey`.
+ */
+struct NameAlias {
+  std::string_view name;
+  Key key;
+};
+
+/**
+ * @brief Helpful aliases / synonyms accepted by `stringToKey`.
+ *
+ * Aliases take precedence over canonical names that collide with them
+ * case-insensitively. Entries are matched case-insensitively, except that an
+ * exact-case match (e.g., "OE" vs "oe") is preferred when several entries
+ * collide.
+ */
+constexpr NameAlias kAliases[] = {
+  {"esc", Key::Escape},
+  {"return", Key::Enter},
+  {"spacebar", Key::Space},
+  {"space", Key::Space},
+  {"ctrl", Key::CtrlLeft},
+  {"control", Key::CtrlLeft},
+  {"shift", Key::ShiftLeft},
+  {"alt", Key::AltLeft},
+  {"super", Key::SuperLeft},
+  {"meta", Key::SuperLeft},
+  {"win", Key::SuperLeft},
+
+  // Top-row numeric aliases like "num0" -> Key::Num0
+  {"num0", Key::Num0},
+  {"num1", Key::Num1},
+  {"num2", Key::Num2},
+  {"num3", Key::Num3},
+  {"num4", Key::Num4},
+  {"num5", Key::Num5},
+  {"num6", Key::Num6},
+  {"num7", Key::Num7},
+  {"num8", Key::Num8},
+  {"num9", Key::Num9},
+
+  // Some punctuation aliases
+  {"dash", Key::Minus},
+  {"hyphen", Key::Minus},
+  {"minus", Key::Minus},
+  {"grave", Key::Grave},
+  {"backslash", Key::Backslash},
+  {"semicolon", Key::Semicolon},
+  {"apostrophe", Key::Apostrophe},
+  {"comma", Key::Comma},
+  {"period", Key::Period},
+  {"dot", Key::Period},
+  {"slash", Key::Slash},
+  {"bracketleft", Key::LeftBracket},
+  {"bracketright", Key::RightBracket},
+
+  // Single-character aliases for common symbol characters observed in inputs.
+  {"@", Key::At},
+  {"&", Key::Ampersand},
+  {"(", Key::LeftParen},
+  {")", Key::RightParen},
+  {"!", Key::Exclamation},
+  {"$", Key::Dollar},
+  {"^", Key::Caret},
+  {"*", Key::Asterisk},
+
+  // Single-character aliases for punctuation / shifted characters.
+  {" ", Key::Space},
+  {"\t", Key::Tab},
+
+  // ASCII control single-character mappings: map raw control bytes to
+  // a logical `Key` when observed as an input character.
+  {{"\0", 1}, Key::AsciiNUL},
+  {"\x01", Key::AsciiSOH},
+  {"\x02", Key::AsciiSTX},
+  {"\x03", Key::AsciiETX},
+  {"\x04", Key::AsciiEOT},
+  {"\x05", Key::AsciiENQ},
+  {"\x06", Key::AsciiACK},
+  {"\x07", Key::AsciiBell},
+  {"\x08", Key::Backspace},
+  {"\x09", Key::Tab},
+  {"\x0A", Key::Enter},
+  {"\x0B", Key::AsciiVT},
+  {"\x0C", Key::AsciiFF},
+  {"\x0D", Key::Enter},
+  {"\x0E", Key::AsciiSO},
+  {"\x0F", Key::AsciiSI},
+  {"\x10", Key::AsciiDLE},
+  {"\x11", Key::AsciiDC1},
+  {"\x12", Key::AsciiDC2},
+  {"\x13", Key::AsciiDC3},
+  {"\x14", Key::AsciiDC4},
+  {"\x15", Key::AsciiNAK},
+  {"\x16", Key::AsciiSYN},
+  {"\x17", Key::AsciiETB},
+  {"\x18", Key::AsciiCAN},
+  {"\x19", Key::AsciiEM},
+  {"\x1A", Key::AsciiSUB},
+  {"\x1B", Key::Escape},
+  {"\x1C", Key::AsciiFS},
+  {"\x1D", Key::AsciiGS},
+  {"\x1E", Key::AsciiRS},
+  {"\x1F", Key::AsciiUS},
+  {"\x7F", Key::Delete},
+
+  // Other single-character punctuation aliases that map to existing
+  // layout-dependent keys.
+  {"_", Key::Minus},
+  {"+", Key::Equal},
+  {":", Key::Semicolon},
+  {"\"", Key::Apostrophe},
+  {"?", Key::Slash},
+  {"|", Key::Backslash},
+  {"<", Key::Comma},
+  {">", Key::Period},
+  {"{", Key::LeftBracket},
+  {"}", Key::RightBracket},
+  {"~", Key::Grave},
+
+  // Helpful textual aliases for common symbols
+  {"at", Key::At},
+  {"hash", Key::Hashtag},
+  {"hashtag", Key::Hashtag},
+  {"pound", Key::Hashtag},
+  {"bang", Key::Exclamation},
+  {"exclamation", Key::Exclamation},
+  {"dollar", Key::Dollar},
+  {"percent", Key::Percent},
+  {"caret", Key::Caret},
+  {"ampersand", Key::Ampersand},
+  {"star", Key::Asterisk},
+  {"asterisk", Key::Asterisk},
+  {"lparen", Key::LeftParen},
+  {"rparen", Key::RightParen},
+  {"underscore", Key::Underscore},
+  {"plus", Key::Plus},
+  {"colon", Key::Colon},
+  {"quote", Key::Quote},
+  {"pipe", Key::Bar},
+  {"bar", Key::Bar},
+  {"lt", Key::LessThan},
+  {"gt", Key::GreaterThan},
+  {"less", Key::LessThan},
+  {"greater", Key::GreaterThan},
+  // ASCII textual aliases
+  {"nul", Key::AsciiNUL},
+  {"bell", Key::AsciiBell},
+  {"vt", Key::AsciiVT},
+  {"ff", Key::AsciiFF},
+  {"dle", Key::AsciiDLE},
+  {"sub", Key::AsciiSUB},
+  {"can", Key::AsciiCAN},
+  {"fs", Key::AsciiFS},
+  {"gs", Key::AsciiGS},
+  {"rs", Key::AsciiRS},
+  {"us", Key::AsciiUS},
+  {"del", Key::AsciiDEL},
+
+  // Numeric keypad aliases (numpadX is already present via canonical mapping,
+  // but also allow "kpX" and other X11 KP_* names that some users / systems
+  // emit).
+  {"kp0", Key::Numpad0},
+  {"kp1", Key::Numpad1},
+  {"kp2", Key::Numpad2},
+  {"kp3", Key::Numpad3},
+  {"kp4", Key::Numpad4},
+  {"kp5", Key::Numpad5},
+  {"kp6", Key::Numpad6},
+  {"kp7", Key::Numpad7},
+  {"kp8", Key::Numpad8},
+  {"kp9", Key::Numpad9},
+
+  // Common X11 / keysym aliases observed on Linux systems (lowercased).
+  // Map keyboard modifier / special names to existing logical keys.
+  {"control_l", Key::CtrlLeft},
+  {"control_r", Key::CtrlRight},
+  {"shift_l", Key::ShiftLeft},
+  {"shift_r", Key::ShiftRight},
+  {"alt_l", Key::AltLeft},
+  {"alt_r", Key::AltRight},
+  {"meta_l", Key::SuperLeft},
+  {"super_l", Key::SuperLeft},
+  {"super_r", Key::SuperRight},
+  {"hyper_l", Key::SuperLeft},
+  {"caps_lock", Key::CapsLock},
+  {"num_lock", Key::NumLock},
+  {"scroll_lock", Key::ScrollLock},
+
+  // ISO / dead-key and punctuation aliases
+  {"iso_left_tab", Key::Tab},
+  {"iso_level3_shift", Key::AltRight},
+  {"iso_level5_shift", Key::AltRight},
+  {"quotedbl", Key::Quote},
+  {"parenleft", Key::LeftParen},
+  {"parenright", Key::RightParen},
+  {"equal", Key::Equal},
+  {"question", Key::QuestionMark},
+  {"exclam", Key::Exclamation},
+  {"section", Key::Section},
+  {"degree", Key::Degree},
+  {"sterling", Key::Sterling},
+  {"plusminus", Key::PlusMinus},
+  {"dead_circumflex", Key::DeadCircumflex},
+  {"dead_diaeresis", Key::DeadDiaeresis},
+
+  // Accented / ligature aliases -> map to reasonable logical letter keys
+  {"eacute", Key::E},
+  {"egrave", Key::E},
+  {"agrave", Key::A},
+  {"ugrave", Key::U},
+  {"ccedilla", Key::C},
+  {"oe", Key::oe},
+  {"OE", Key::OE},
+  {"mu", Key::Mu},
+
+  // Misc control / text aliases
+  {"linefeed", Key::Enter},
+  {"prior", Key::PageUp},
+  {"next", Key::PageDown},
+  {"print", Key::PrintScreen},
+  {"sys_req", Key::PrintScreen},
+  {"break", Key::Pause},
+  {"cancel", Key::Cancel},
+  {"redo", Key::Redo},
+  {"undo", Key::Undo},
+  {"find", Key::Find},
+  {"sunprops", Key::SunProps},
+  {"sunfront", Key::SunFront},
+
+  // Common UX / XF86 app / hardware alias textual fallbacks
+  {"menu", Key::Menu},
+  {"copy", Key::Copy},
+  {"open", Key::Open},
+  {"paste", Key::Paste},
+  {"cut", Key::Cut},
+  {"calculator", Key::Calculator},
+  {"explorer", Key::Explorer},
+  {"phone", Key::Phone},
+  {"webcam", Key::WebCam},
+  {"mail", Key::Mail},
+  {"mailforward", Key::MailForward},
+  {"save", Key::Save},
+  {"documents", Key::Documents},
+};
+
+/**
+ * @brief Dense Key -> canonical name table (empty view for unnamed values).
+ *
+ * Enumerators that alias another key (e.g. `AsciiDEL` = `Delete`) appear
+ * later in `kCanonicalNames`; the first name listed for a value wins.
+ */
+constexpr auto kKeyNames = [] {
+  std::array<std::string_view, kKeyCount> names{};
+  for (const auto &entry : kCanonicalNames) {
+    auto &slot = names[static_cast<std::size_t>(entry.key)];
+    if (slot.empty())
+      slot = entry.name;
+  }
+  return names;
+}();
+
 /**
- * @brief Return a static vector of canonical Key -> string mappings.
+ * @brief One entry of the reverse (name -> Key) lookup table.
  *
- * The returned reference points to a function-local static vector that contains
- * canonical mappings used by `keyToString` and which is used to seed the
- * reverse lookup map in `stringToKey`.
+ * `order` records the seeding order (aliases first, then canonical names) so
+ * that among case-insensitively equal names the earliest one wins, matching
+ * the "aliases are not clobbered by canonical names" rule.
+ */
+struct ReverseEntry {
+  std::string_view name;
+  Key key;
+  std::uint16_t order;
+};
+
+constexpr bool reverseLess(const ReverseEntry &a, const ReverseEntry &b) {
+  const int c = compareNoCase(a.name, b.name);
+  return c < 0 || (c == 0 && a.order < b.order);
+}
+
+/**
+ * @brief Reverse lookup table sorted case-insensitively at compile time.
+ */
+constexpr auto kReverseNames = [] {
+  std::array<ReverseEntry, std::size(kAliases) + std::size(kCanonicalNames)>
+      entries{};
+  std::uint16_t n = 0;
+  for (const auto &alias : kAliases) {
+    entries[n] = {alias.name, alias.key, n};
+    ++n;
+  }
+  for (const auto &entry : kCanonicalNames) {
+    entries[n] = {entry.name, entry.key, n};
+    ++n;
+  }
+  std::sort(entries.begin(), entries.end(), reverseLess);
+  return entries;
+}();
+
+static_assert(kKeyNames[static_cast<std::size_t>(Key::RFKill)] == "RFKill");
+static_assert(kKeyNames[static_cast<std::size_t>(Key::Delete)] == "Delete");
+
+/**
+ * @brief Binary-search the reverse table.
  *
- * @return const std::vector<std::pair<Key, std::string>>& Reference to the
- *         static mapping vector.
+ * Among entries that compare equal case-insensitively an exact-case match is
+ * preferred (e.g., "OE" vs "oe"); otherwise the earliest-seeded entry wins.
+ *
+ * @param input Name to look up.
+ * @param out Receives the key on success.
+ * @return true if the name is present in the table.
  */
-const std::vector<std::pair<Key, std::string>> &keyStringPairs() {
-  static const std::vector<std::pair<Key, std::string>> pairs = {
-      {Key::Unknown, "Unknown"},
-      // Letters
-      {Key::A, "A"},
-      {Key::B, "B"},
-      {Key::C, "C"},
-      {Key::D, "D"},
-      {Key::E, "E"},
-      {Key::F, "F"},
-      {Key::G, "G"},
-      {Key::H, "H"},
-      {Key::I, "I"},
-      {Key::J, "J"},
-      {Key::K, "K"},
-      {Key::L, "L"},
-      {Key::M, "M"},
-      {Key::N, "N"},
-      {Key::O, "O"},
-      {Key::P, "P"},
-      {Key::Q, "Q"},
-      {Key::R, "R"},
-      {Key::S, "S"},
-      {Key::T, "T"},
-      {Key::U, "U"},
-      {Key::V, "V"},
-      {Key::W, "W"},
-      {Key::X, "X"},
-      {Key::Y, "Y"},
-      {Key::Z, "Z"},
-      // Numbers (top row)
-      {Key::Num0, "0"},
-      {Key::Num1, "1"},
-      {Key::Num2, "2"},
-      {Key::Num3, "3"},
-      {Key::Num4, "4"},
-      {Key::Num5, "5"},
-      {Key::Num6, "6"},
-      {Key::Num7, "7"},
-      {Key::Num8, "8"},
-      {Key::Num9, "9"},
-      // Function keys
-      {Key::F1, "F1"},
-      {Key::F2, "F2"},
-      {Key::F3, "F3"},
-      {Key::F4, "F4"},
-      {Key::F5, "F5"},
-      {Key::F6, "F6"},
-      {Key::F7, "F7"},
-      {Key::F8, "F8"},
-      {Key::F9, "F9"},
-      {Key::F10, "F10"},
-      {Key::F11, "F11"},
-      {Key::F12, "F12"},
-      {Key::F13, "F13"},
-      {Key::F14, "F14"},
-      {Key::F15, "F15"},
-      {Key::F16, "F16"},
-      {Key::F17, "F17"},
-      {Key::F18, "F18"},
-      {Key::F19, "F19"},
-      {Key::F20, "F20"},
-      // Control keys
-      {Key::Enter, "Enter"},
-      {Key::Escape, "Escape"},
-      {Key::Backspace, "Backspace"},
-      {Key::Tab, "Tab"},
-      {Key::Space, "Space"},
-      // Navigation
-      {Key::Left, "Left"},
-      {Key::Right, "Right"},
-      {Key::Up, "Up"},
-      {Key::Down, "Down"},
-      {Key::Home, "Home"},
-      {Key::End, "End"},
-      {Key::PageUp, "PageUp"},
-      {Key::PageDown, "PageDown"},
-      {Key::Delete, "Delete"},
-      {Key::Insert, "Insert"},
-      {Key::PrintScreen, "PrintScreen"},
-      {Key::ScrollLock, "ScrollLock"},
-      {Key::Pause, "Pause"},
-      // Numpad
-      {Key::NumpadDivide, "NumpadDivide"},
-      {Key::NumpadMultiply, "NumpadMultiply"},
-      {Key::NumpadMinus, "NumpadMinus"},
-      {Key::NumpadPlus, "NumpadPlus"},
-      {Key::NumpadEnter, "NumpadEnter"},
-      {Key::NumpadDecimal, "NumpadDecimal"},
-      {Key::Numpad0, "Numpad0"},
-      {Key::Numpad1, "Numpad1"},
-      {Key::Numpad2, "Numpad2"},
-      {Key::Numpad3, "Numpad3"},
-      {Key::Numpad4, "Numpad4"},
-      {Key::Numpad5, "Numpad5"},
-      {Key::Numpad6, "Numpad6"},
-      {Key::Numpad7, "Numpad7"},
-      {Key::Numpad8, "Numpad8"},
-      {Key::Numpad9, "Numpad9"},
-      // Modifiers
-      {Key::ShiftLeft, "ShiftLeft"},
-      {Key::ShiftRight, "ShiftRight"},
-      {Key::CtrlLeft, "CtrlLeft"},
-      {Key::CtrlRight, "CtrlRight"},
-      {Key::AltLeft, "AltLeft"},
-      {Key::AltRight, "AltRight"},
-      {Key::SuperLeft, "SuperLeft"},
-      {Key::SuperRight, "SuperRight"},
-      {Key::CapsLock, "CapsLock"},
-      {Key::NumLock, "NumLock"},
-      // Misc
-      {Key::Help, "Help"},
-      {Key::Menu, "Menu"},
-      {Key::Power, "Power"},
-      {Key::Sleep, "Sleep"},
-      {Key::Wake, "Wake"},
-      {Key::Mute, "Mute"},
-      {Key::VolumeDown, "VolumeDown"},
-      {Key::VolumeUp, "VolumeUp"},
-      {Key::MediaPlayPause, "MediaPlayPause"},
-      {Key::MediaStop, "MediaStop"},
-      {Key::MediaNext, "MediaNext"},
-      {Key::MediaPrevious, "MediaPrevious"},
-      {Key::BrightnessDown, "BrightnessDown"},
-      {Key::BrightnessUp, "BrightnessUp"},
-      {Key::Eject, "Eject"},
-      // Punctuation / layout-dependent
-      {Key::Grave, "`"},
-      {Key::Minus, "-"},
-      {Key::Equal, "="},
-      {Key::LeftBracket, "["},
-      {Key::RightBracket, "]"},
-      {Key::Backslash, "\\"},
-      {Key::Semicolon, ";"},
-      {Key::Apostrophe, "'"},
-      {Key::Comma, ","},
-      {Key::Period, "."},
-      {Key::Slash, "/"},
-      // Shifted / symbol characters (canonical textual names)
-      {Key::At, "At"},
-      {Key::Hashtag, "Hashtag"},
-      {Key::Exclamation, "Exclamation"},
-      {Key::Dollar, "Dollar"},
-      {Key::Percent, "Percent"},
-      {Key::Caret, "Caret"},
-      {Key::Ampersand, "Ampersand"},
-      {Key::Asterisk, "Asterisk"},
-      {Key::LeftParen, "LeftParen"},
-      {Key::RightParen, "RightParen"},
-      {Key::Underscore, "Underscore"},
-      {Key::Plus, "Plus"},
-      {Key::Colon, "Colon"},
-      {Key::Quote, "Quote"},
-      {Key::QuestionMark, "QuestionMark"},
-      {Key::Bar, "Bar"},
-      {Key::LessThan, "LessThan"},
-      {Key::GreaterThan, "GreaterThan"},
-      // ASCII control canonical names (C0 / DEL)
-      {Key::AsciiNUL, "NUL"},
-      {Key::AsciiSOH, "SOH"},
-      {Key::AsciiSTX, "STX"},
-      {Key::AsciiETX, "ETX"},
-      {Key::AsciiEOT, "EOT"},
-      {Key::AsciiENQ, "ENQ"},
-      {Key::AsciiACK, "ACK"},
-      {Key::AsciiBell, "Bell"},
-      {Key::AsciiVT, "VT"},
-      {Key::AsciiFF, "FF"},
-      {Key::AsciiSO, "SO"},
-      {Key::AsciiSI, "SI"},
-      {Key::AsciiDLE, "DLE"},
-      {Key::AsciiDC1, "DC1"},
-      {Key::AsciiDC2, "DC2"},
-      {Key::AsciiDC3, "DC3"},
-      {Key::AsciiDC4, "DC4"},
-      {Key::AsciiNAK, "NAK"},
-      {Key::AsciiSYN, "SYN"},
-      {Key::AsciiETB, "ETB"},
-      {Key::AsciiCAN, "CAN"},
-      {Key::AsciiEM, "EM"},
-      {Key::AsciiSUB, "SUB"},
-      {Key::AsciiFS, "FS"},
-      {Key::AsciiGS, "GS"},
-      {Key::AsciiRS, "RS"},
-      {Key::AsciiUS, "US"},
-      {Key::AsciiDEL, "DEL"},
-      // Additional canonical names for X11 / XF86 / international keys added
-      // to the Key enum so they can roundtrip via `keyToString` and seed the
-      // reverse lookup in `stringToKey`.
-      {Key::NumpadEqual, "NumpadEqual"},
-      {Key::Degree, "Degree"},
-      {Key::Sterling, "Sterling"},
-      {Key::Mu, "Mu"},
-      {Key::PlusMinus, "PlusMinus"},
-      {Key::DeadCircumflex, "DeadCircumflex"},
-      {Key::DeadDiaeresis, "DeadDiaeresis"},
-      {Key::Section, "Section"},
-      {Key::Cancel, "Cancel"},
-      {Key::Redo, "Redo"},
-      {Key::Undo, "Undo"},
-      {Key::Find, "Find"},
-      {Key::Hangul, "Hangul"},
-      {Key::HangulHanja, "HangulHanja"},
-      {Key::Katakana, "Katakana"},
-      {Key::Hiragana, "Hiragana"},
-      {Key::Henkan, "Henkan"},
-      {Key::Muhenkan, "Muhenkan"},
-      {Key::OE, "OE"},
-      {Key::oe, "oe"},
-      {Key::SunProps, "SunProps"},
-      {Key::SunFront, "SunFront"},
-      {Key::Copy, "Copy"},
-      {Key::Open, "Open"},
-      {Key::Paste, "Paste"},
-      {Key::Cut, "Cut"},
-      {Key::Calculator, "Calculator"},
-      {Key::Explorer, "Explorer"},
-      {Key::Phone, "Phone"},
-      {Key::WebCam, "WebCam"},
-      {Key::AudioRecord, "AudioRecord"},
-      {Key::AudioRewind, "AudioRewind"},
-      {Key::AudioPreset, "AudioPreset"},
-      {Key::Messenger, "Messenger"},
-      {Key::Search, "Search"},
-      {Key::Go, "Go"},
-      {Key::Finance, "Finance"},
-      {Key::Game, "Game"},
-      {Key::Shop, "Shop"},
-      {Key::HomePage, "HomePage"},
-      {Key::Reload, "Reload"},
-      {Key::Close, "Close"},
-      {Key::Send, "Send"},
-      {Key::Xfer, "Xfer"},
-      {Key::LaunchA, "LaunchA"},
-      {Key::LaunchB, "LaunchB"},
-      {Key::Launch1, "Launch1"},
-      {Key::Launch2, "Launch2"},
-      {Key::Launch3, "Launch3"},
-      {Key::Launch4, "Launch4"},
-      {Key::Launch5, "Launch5"},
-      {Key::Launch6, "Launch6"},
-      {Key::Launch7, "Launch7"},
-      {Key::Launch8, "Launch8"},
-      {Key::Launch9, "Launch9"},
-      {Key::TouchpadToggle, "TouchpadToggle"},
-      {Key::TouchpadOn, "TouchpadOn"},
-      {Key::TouchpadOff, "TouchpadOff"},
-      {Key::KbdLightOnOff, "KbdLightOnOff"},
-      {Key::KbdBrightnessDown, "KbdBrightnessDown"},
-      {Key::KbdBrightnessUp, "KbdBrightnessUp"},
-      {Key::Mail, "Mail"},
-      {Key::MailForward, "MailForward"},
-      {Key::Save, "Save"},
-      {Key::Documents, "Documents"},
-      {Key::Battery, "Battery"},
-      {Key::Bluetooth, "Bluetooth"},
-      {Key::WLAN, "WLAN"},
-      {Key::UWB, "UWB"},
-      {Key::Next_VMode, "Next_VMode"},
-      {Key::Prev_VMode, "Prev_VMode"},
-      {Key::MonBrightnessCycle, "MonBrightnessCycle"},
-      {Key::BrightnessAuto, "BrightnessAuto"},
-      {Key::DisplayOff, "DisplayOff"},
-      {Key::WWAN, "WWAN"},
-      {Key::RFKill, "RFKill"},
-  };
-  return pairs;
+constexpr bool lookupName(std::string_view input, Key &out) {
+  auto it = std::lower_bound(kReverseNames.begin(), kReverseNames.end(), input,
+                             [](const ReverseEntry &e, std::string_view v) {
+                               return compareNoCase(e.name, v) < 0;
+                             });
+  if (it == kReverseNames.end() || compareNoCase(it->name, input) != 0)
+    return false;
+  out = it->key;
+  for (; it != kReverseNames.end() && compareNoCase(it->name, input) == 0;
+       ++it) {
+    if (it->name == input) {
+      out = it->key;
+      break;
+    }
+  }
+  return true;
 }
 
 } // namespace
 
+/**
+ * @brief Return the canonical name of a `Key` without allocating.
+ *
+ * @param key Logical key enum value to convert.
+ * @return std::string_view View of a static, null-terminated name (e.g., "A",
+ *         "Enter"), or "Unknown" if the key does not have a canonical name.
+ */
+TYPR_IO_API std::string_view keyToStringView(Key key) noexcept {
+  const auto index = static_cast<std::size_t>(key);
+  if (index < kKeyNames.size() && !kKeyNames[index].empty())
+    return kKeyNames[index];
+  return "Unknown";
+}
+
 /**
  * @brief Convert a `Key` to its canonical textual representation.
  *
@@ -370,300 +744,32 @@ const std::vector<std::pair<Key, std::string>> &keyStringPairs() {
  *         Returns "Unknown" if the key does not have a canonical name.
  */
 TYPR_IO_API std::string keyToString(Key key) {
-  for (const auto &pair : keyStringPairs()) {
-    if (pair.first == key) {
-      return pair.second;
-    }
-  }
-  return {"Unknown"};
+  return std::string(keyToStringView(key));
 }
 
 /**
  * @brief Parse a textual key name into a `Key` value.
  *
- * The function accepts many aliases and single-character inputs. The reverse
- * mapping is seeded on first call and cached for subsequent invocations.
- * Comparison for textual aliases is case-insensitive when appropriate.
+ * The function accepts many aliases and single-character inputs. Known names
+ * are resolved by a case-insensitive binary search over a table generated at
+ * compile time; only unrecognized inputs fall through to the prefix
+ * heuristics below (KP_*, XF86*), which allocate a lower-cased copy.
  *
  * @param input Input textual name (e.g., "A", "esc", "@", "space").
  * @return Key Parsed `Key` value, or `Key::Unknown` for empty or unrecognized
  *         inputs.
  */
-TYPR_IO_API Key stringToKey(const std::string &input) {
-  static std::unordered_map<std::string, Key> rev;
+TYPR_IO_API Key stringToKey(std::string_view input) {
   if (input.empty()) {
     return Key::Unknown;
   }
 
-  if (rev.empty()) {
-    // Defer canonical seeding until after alias synonyms are added so that
-    // case-only aliases (e.g., "OE" vs "oe") aren't overwritten by a
-    // lowercase canonical entry. Canonical entries are inserted later using
-    // `emplace` to avoid clobbering helpful aliases.
-
-    // Helpful aliases / synonyms
-    rev.emplace("esc", Key::Escape);
-    rev.emplace("return", Key::Enter);
-    rev.emplace("spacebar", Key::Space);
-    rev.emplace("space", Key::Space);
-    rev.emplace("ctrl", Key::CtrlLeft);
-    rev.emplace("control", Key::CtrlLeft);
-    rev.emplace("shift", Key::ShiftLeft);
-    rev.emplace("alt", Key::AltLeft);
-    rev.emplace("super", Key::SuperLeft);
-    rev.emplace("meta", Key::SuperLeft);
-    rev.emplace("win", Key::SuperLeft);
-
-    // Top-row numeric aliases like \"num0\" -> Key::Num0
-    rev.emplace("num0", Key::Num0);
-    rev.emplace("num1", Key::Num1);
-    rev.emplace("num2", Key::Num2);
-    rev.emplace("num3", Key::Num3);
-    rev.emplace("num4", Key::Num4);
-    rev.emplace("num5", Key::Num5);
-    rev.emplace("num6", Key::Num6);
-    rev.emplace("num7", Key::Num7);
-    rev.emplace("num8", Key::Num8);
-    rev.emplace("num9", Key::Num9);
-
-    // Some punctuation aliases
-    rev.emplace("dash", Key::Minus);
-    rev.emplace("hyphen", Key::Minus);
-    rev.emplace("minus", Key::Minus);
-    rev.emplace("grave", Key::Grave);
-    rev.emplace("backslash", Key::Backslash);
-    rev.emplace("semicolon", Key::Semicolon);
-    rev.emplace("apostrophe", Key::Apostrophe);
-    rev.emplace("comma", Key::Comma);
-    rev.emplace("period", Key::Period);
-    rev.emplace("dot", Key::Period);
-    rev.emplace("slash", Key::Slash);
-    rev.emplace("bracketleft", Key::LeftBracket);
-    rev.emplace("bracketright", Key::RightBracket);
-
-    // Single-character aliases for common symbol characters observed in inputs.
-    rev.emplace("@", Key::At);
-    rev.emplace("&", Key::Ampersand);
-    rev.emplace("(", Key::LeftParen);
-    rev.emplace(")", Key::RightParen);
-    rev.emplace("!", Key::Exclamation);
-    rev.emplace("$", Key::Dollar);
-    rev.emplace("^", Key::Caret);
-    rev.emplace("*", Key::Asterisk);
-
-    // Single-character aliases for punctuation / shifted characters.
-    rev.emplace(" ", Key::Space);
-    rev.emplace("\t", Key::Tab);
-
-    // ASCII control single-character mappings: map raw control bytes to
-    // a logical `Key` when observed as an input character.
-    rev.emplace("\x00", Key::AsciiNUL);
-    rev.emplace("\x01", Key::AsciiSOH);
-    rev.emplace("\x02", Key::AsciiSTX);
-    rev.emplace("\x03", Key::AsciiETX);
-    rev.emplace("\x04", Key::AsciiEOT);
-    rev.emplace("\x05", Key::AsciiENQ);
-    rev.emplace("\x06", Key::AsciiACK);
-    rev.emplace("\x07", Key::AsciiBell);
-    rev.emplace("\x08", Key::Backspace);
-    rev.emplace("\x09", Key::Tab);
-    rev.emplace("\x0A", Key::Enter);
-    rev.emplace("\x0B", Key::AsciiVT);
-    rev.emplace("\x0C", Key::AsciiFF);
-    rev.emplace("\x0D", Key::Enter);
-    rev.emplace("\x0E", Key::AsciiSO);
-    rev.emplace("\x0F", Key::AsciiSI);
-    rev.emplace("\x10", Key::AsciiDLE);
-    rev.emplace("\x11", Key::AsciiDC1);
-    rev.emplace("\x12", Key::AsciiDC2);
-    rev.emplace("\x13", Key::AsciiDC3);
-    rev.emplace("\x14", Key::AsciiDC4);
-    rev.emplace("\x15", Key::AsciiNAK);
-    rev.emplace("\x16", Key::AsciiSYN);
-    rev.emplace("\x17", Key::AsciiETB);
-    rev.emplace("\x18", Key::AsciiCAN);
-    rev.emplace("\x19", Key::AsciiEM);
-    rev.emplace("\x1A", Key::AsciiSUB);
-    rev.emplace("\x1B", Key::Escape);
-    rev.emplace("\x1C", Key::AsciiFS);
-    rev.emplace("\x1D", Key::AsciiGS);
-    rev.emplace("\x1E", Key::AsciiRS);
-    rev.emplace("\x1F", Key::AsciiUS);
-    rev.emplace("\x7F", Key::Delete);
-
-    // Other single-character punctuation aliases that map to existing
-    // layout-dependent keys.
-    rev.emplace("_", Key::Minus);
-    rev.emplace("+", Key::Equal);
-    rev.emplace(":", Key::Semicolon);
-    rev.emplace("\"", Key::Apostrophe);
-    rev.emplace("?", Key::Slash);
-    rev.emplace("|", Key::Backslash);
-    rev.emplace("<", Key::Comma);
-    rev.emplace(">", Key::Period);
-    rev.emplace("{", Key::LeftBracket);
-    rev.emplace("}", Key::RightBracket);
-    rev.emplace("~", Key::Grave);
-
-    // Helpful textual aliases for common symbols (lowercased by seeding logic)
-    rev.emplace("at", Key::At);
-    rev.emplace("hash", Key::Hashtag);
-    rev.emplace("hashtag", Key::Hashtag);
-    rev.emplace("pound", Key::Hashtag);
-    rev.emplace("bang", Key::Exclamation);
-    rev.emplace("exclamation", Key::Exclamation);
-    rev.emplace("dollar", Key::Dollar);
-    rev.emplace("percent", Key::Percent);
-    rev.emplace("caret", Key::Caret);
-    rev.emplace("ampersand", Key::Ampersand);
-    rev.emplace("star", Key::Asterisk);
-    rev.emplace("asterisk", Key::Asterisk);
-    rev.emplace("lparen", Key::LeftParen);
-    rev.emplace("rparen", Key::RightParen);
-    rev.emplace("underscore", Key::Underscore);
-    rev.emplace("plus", Key::Plus);
-    rev.emplace("colon", Key::Colon);
-    rev.emplace("quote", Key::Quote);
-    rev.emplace("pipe", Key::Bar);
-    rev.emplace("bar", Key::Bar);
-    rev.emplace("lt", Key::LessThan);
-    rev.emplace("gt", Key::GreaterThan);
-    rev.emplace("less", Key::LessThan);
-    rev.emplace("greater", Key::GreaterThan);
-    // ASCII textual aliases
-    rev.emplace("nul", Key::AsciiNUL);
-    rev.emplace("bell", Key::AsciiBell);
-    rev.emplace("vt", Key::AsciiVT);
-    rev.emplace("ff", Key::AsciiFF);
-    rev.emplace("dle", Key::AsciiDLE);
-    rev.emplace("sub", Key::AsciiSUB);
-    rev.emplace("can", Key::AsciiCAN);
-    rev.emplace("fs", Key::AsciiFS);
-    rev.emplace("gs", Key::AsciiGS);
-    rev.emplace("rs", Key::AsciiRS);
-    rev.emplace("us", Key::AsciiUS);
-    rev.emplace("del", Key::AsciiDEL);
-
-    // Numeric keypad aliases (numpadX is already present via canonical mapping,
-    // but also allow \"kpX\" and other X11 KP_* names that some users / systems
-    // emit).
-    rev.emplace("kp0", Key::Numpad0);
-    rev.emplace("kp1", Key::Numpad1);
-    rev.emplace("kp2", Key::Numpad2);
-    rev.emplace("kp3", Key::Numpad3);
-    rev.emplace("kp4", Key::Numpad4);
-    rev.emplace("kp5", Key::Numpad5);
-    rev.emplace("kp6", Key::Numpad6);
-    rev.emplace("kp7", Key::Numpad7);
-    rev.emplace("kp8", Key::Numpad8);
-    rev.emplace("kp9", Key::Numpad9);
-
-    // Common X11 / keysym aliases observed on Linux systems (lowercased).
-    // Map keyboard modifier / special names to existing logical keys.
-    rev.emplace("control_l", Key::CtrlLeft);
-    rev.emplace("control_r", Key::CtrlRight);
-    rev.emplace("shift_l", Key::ShiftLeft);
-    rev.emplace("shift_r", Key::ShiftRight);
-    rev.emplace("alt_l", Key::AltLeft);
-    rev.emplace("alt_r", Key::AltRight);
-    rev.emplace("meta_l", Key::SuperLeft);
-    rev.emplace("super_l", Key::SuperLeft);
-    rev.emplace("super_r", Key::SuperRight);
-    rev.emplace("hyper_l", Key::SuperLeft);
-    rev.emplace("caps_lock", Key::CapsLock);
-    rev.emplace("num_lock", Key::NumLock);
-    rev.emplace("scroll_lock", Key::ScrollLock);
-
-    // ISO / dead-key and punctuation aliases
-    rev.emplace("iso_left_tab", Key::Tab);
-    rev.emplace("iso_level3_shift", Key::AltRight);
-    rev.emplace("iso_level5_shift", Key::AltRight);
-    rev.emplace("quotedbl", Key::Quote);
-    rev.emplace("parenleft", Key::LeftParen);
-    rev.emplace("parenright", Key::RightParen);
-    rev.emplace("equal", Key::Equal);
-    rev.emplace("question", Key::QuestionMark);
-    rev.emplace("exclam", Key::Exclamation);
-    rev.emplace("section", Key::Section);
-    rev.emplace("degree", Key::Degree);
-    rev.emplace("sterling", Key::Sterling);
-    rev.emplace("plusminus", Key::PlusMinus);
-    rev.emplace("dead_circumflex", Key::DeadCircumflex);
-    rev.emplace("dead_diaeresis", Key::DeadDiaeresis);
-
-    // Accented / ligature aliases -> map to reasonable logical letter keys
-    rev.emplace("eacute", Key::E);
-    rev.emplace("egrave", Key::E);
-    rev.emplace("agrave", Key::A);
-    rev.emplace("ugrave", Key::U);
-    rev.emplace("ccedilla", Key::C);
-    rev.emplace("oe", Key::oe);
-    rev.emplace("OE", Key::OE);
-    rev.emplace("mu", Key::Mu);
-
-    // Misc control / text aliases
-    rev.emplace("linefeed", Key::Enter);
-    rev.emplace("prior", Key::PageUp);
-    rev.emplace("next", Key::PageDown);
-    rev.emplace("print", Key::PrintScreen);
-    rev.emplace("sys_req", Key::PrintScreen);
-    rev.emplace("break", Key::Pause);
-    rev.emplace("cancel", Key::Cancel);
-    rev.emplace("redo", Key::Redo);
-    rev.emplace("undo", Key::Undo);
-    rev.emplace("find", Key::Find);
-    rev.emplace("sunprops", Key::SunProps);
-    rev.emplace("sunfront", Key::SunFront);
-
-    // Common UX / XF86 app / hardware alias textual fallbacks
-    rev.emplace("menu", Key::Menu);
-    rev.emplace("copy", Key::Copy);
-    rev.emplace("open", Key::Open);
-    rev.emplace("paste", Key::Paste);
-    rev.emplace("cut", Key::Cut);
-    rev.emplace("calculator", Key::Calculator);
-    rev.emplace("explorer", Key::Explorer);
-    rev.emplace("phone", Key::Phone);
-    rev.emplace("webcam", Key::WebCam);
-    rev.emplace("mail", Key::Mail);
-    rev.emplace("mailforward", Key::MailForward);
-    rev.emplace("save", Key::Save);
-    rev.emplace("documents", Key::Documents);
-
-    // Now seed canonical mappings (lowercased). Use `emplace` so we don't
-    // overwrite existing helpful alias entries (case-only collisions).
-    size_t seeded = 0;
-    for (const auto &pair : keyStringPairs()) {
-      std::string lower = toLower(pair.second);
-      auto [it, inserted] = rev.emplace(lower, pair.first);
-      if (inserted) {
-        ++seeded;
-      } else {
-        TYPR_IO_LOG_DEBUG("stringToKey: canonical lowercase '%s' collides with "
-                          "existing mapping - keeping existing",
-                          lower.c_str());
-      }
-    }
-    TYPR_IO_LOG_DEBUG(
-        "Seeding reverse map with %zu canonical entries (%zu inserted)",
-        keyStringPairs().size(), seeded);
-
-    // Numeric keypad textual aliases are already seeded - leave room for
-    // dynamic parsing for `KP_*` forms in the lookup logic below.
+  Key found = Key::Unknown;
+  if (lookupName(input, found)) {
+    return found;
   }
 
-  // Exact-case lookup first: prefer an exact alias match (e.g., "OE")
-  // over falling back to a case-insensitive canonical match.
-  auto itExact = rev.find(input);
-  if (itExact != rev.end()) {
-    return itExact->second;
-  }
-
-  std::string key = toLower(input);
-  auto it = rev.find(key);
-  if (it != rev.end()) {
-    return it->second;
-  }
+  std::string key = toLower(std::string(input));
 
   // Handle X11 numeric keypad (KP_*) names that may appear in input. These are
   // often emitted as 'KP_7', 'KP_Home', 'KP_Decimal', etc. Provide a
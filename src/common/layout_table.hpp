@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file layout_table.hpp
+ * @brief Internal (native key, modifiers) -> codepoint table for listeners.
+ *
+ * Translating a key event into the character it produces (`ToUnicodeEx`,
+ * `UCKeyTranslate`) is comparatively expensive and only depends on the
+ * active keyboard layout and a handful of modifiers. Listeners therefore
+ * translate every key in every modifier state once per layout and answer
+ * each event with a single indexed load, rebuilding the table when the OS
+ * reports a layout change.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <typr-io/core.hpp>
+
+namespace typr::io::detail {
+
+/**
+ * @internal
+ * @brief Combine up to two UTF-16 code units into a codepoint.
+ *
+ * @param units Code units produced by the platform translation call.
+ * @param count Number of units (<= 0 means no output).
+ * @return The codepoint, or 0 for no output or an invalid surrogate pair.
+ */
+inline char32_t utf16ToCodepoint(const uint16_t *units, int count) {
+  if (count <= 0)
+    return 0;
+  const uint32_t high = units[0];
+  if (count == 1 || high < 0xD800 || high > 0xDBFF)
+    return static_cast<char32_t>(high); // extra units beyond the first ignored
+  const uint32_t low = units[1];
+  if (low < 0xDC00 || low > 0xDFFF)
+    return 0;
+  return static_cast<char32_t>(0x10000 + ((high - 0xD800) << 10) +
+                               (low - 0xDC00));
+}
+
+/**
+ * @internal
+ * @brief Codepoint produced by each native key code under each modifier
+ * state of one keyboard layout.
+ *
+ * Only the modifiers that select a layout level are part of the state:
+ * Shift, Ctrl, Alt (Option / AltGr together with Ctrl) and CapsLock.
+ * Super never changes the produced character and is ignored.
+ *
+ * @tparam Keys Number of native key codes (key codes are `0..Keys-1`).
+ */
+template <std::size_t Keys> class LayoutCodepointTable {
+public:
+  /// Number of modifier states (Shift, Ctrl, Alt, CapsLock combinations).
+  static constexpr std::size_t kStates = 16;
+
+  static constexpr unsigned kShift = 1;
+  static constexpr unsigned kCtrl = 2;
+  static constexpr unsigned kAlt = 4;
+  static constexpr unsigned kCapsLock = 8;
+
+  /**
+   * @brief Modifier state index for `mods`.
+   */
+  static unsigned stateFor(Modifier mods) noexcept {
+    return (hasModifier(mods, Modifier::Shift) ? kShift : 0u) |
+           (hasModifier(mods, Modifier::Ctrl) ? kCtrl : 0u) |
+           (hasModifier(mods, Modifier::Alt) ? kAlt : 0u) |
+           (hasModifier(mods, Modifier::CapsLock) ? kCapsLock : 0u);
+  }
+
+  /**
+   * @brief Refill the table from `translate(keyCode, state) -> char32_t`.
+   *
+   * `translate` returns 0 when the key produces no character (or needs
+   * runtime handling, e.g. dead keys).
+   */
+  template <typename Fn> void build(Fn &&translate) {
+    for (unsigned state = 0; state < kStates; ++state) {
+      for (std::size_t key = 0; key < Keys; ++key)
+        m_codepoints[state * Keys + key] = translate(key, state);
+    }
+    m_built = true;
+  }
+
+  /**
+   * @brief Codepoint for `keyCode` under `mods`, or 0 (also for key codes
+   * outside the table and before the first `build()`).
+   */
+  [[nodiscard]] char32_t find(std::size_t keyCode, Modifier mods) const {
+    if (keyCode >= Keys)
+      return 0;
+    return m_codepoints[stateFor(mods) * Keys + keyCode];
+  }
+
+  [[nodiscard]] bool built() const { return m_built; }
+
+  void clear() {
+    m_codepoints.fill(0);
+    m_built = false;
+  }
+
+private:
+  std::array<char32_t, Keys * kStates> m_codepoints{};
+  bool m_built{false};
+};
+
+} // namespace typr::io::detail
@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file mpsc_ring.hpp
+ * @brief Internal bounded multi-producer / single-consumer lock-free ring.
+ *
+ * Classic sequence-numbered bounded queue (after D. Vyukov): every cell
+ * carries a sequence counter that tells producers whether the cell is free
+ * and the consumer whether it has been published. Producers claim cells with
+ * a CAS on the enqueue position; the single consumer advances its position
+ * without atomics RMW. Items pushed by one producer are popped in the order
+ * they were pushed.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace typr::io::detail {
+
+template <typename T> class MpscRing {
+public:
+  /**
+   * @brief Create a ring holding at least `capacity` items (rounded up to a
+   * power of two, minimum 2).
+   */
+  explicit MpscRing(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    m_mask = size - 1;
+    m_cells = std::make_unique<Cell[]>(size);
+    for (std::size_t i = 0; i < size; ++i)
+      m_cells[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  MpscRing(const MpscRing &) = delete;
+  MpscRing &operator=(const MpscRing &) = delete;
+
+  /**
+   * @brief Try to enqueue an item; safe to call from any number of threads.
+   * @return false if the ring is full (the item is left untouched).
+   */
+  bool tryPush(T &&value) {
+    std::size_t pos = m_enqueue.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = m_cells[pos & m_mask];
+      std::size_t seq = cell.seq.load(std::memory_order_acquire);
+      auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (m_enqueue.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // full
+      } else {
+        pos = m_enqueue.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Try to dequeue an item; must only be called by the consumer.
+   * @return false if the ring is empty.
+   */
+  bool tryPop(T &out) {
+    Cell &cell = m_cells[m_dequeue & m_mask];
+    std::size_t seq = cell.seq.load(std::memory_order_acquire);
+    if (seq != m_dequeue + 1)
+      return false;
+    out = std::move(cell.value);
+    cell.value = T{};
+    cell.seq.store(m_dequeue + m_mask + 1, std::memory_order_release);
+    ++m_dequeue;
+    m_dequeuedCount.store(m_dequeue, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Approximate number of queued items (exact when quiescent).
+   */
+  [[nodiscard]] std::size_t size() const {
+    std::size_t enq = m_enqueue.load(std::memory_order_acquire);
+    std::size_t deq = m_dequeuedCount.load(std::memory_order_acquire);
+    return enq > deq ? enq - deq : 0;
+  }
+
+  [[nodiscard]] std::size_t capacity() const { return m_mask + 1; }
+
+private:
+  struct Cell {
+    std::atomic<std::size_t> seq{0};
+    T value{};
+  };
+
+  std::unique_ptr<Cell[]> m_cells;
+  std::size_t m_mask{0};
+  alignas(64) std::atomic<std::size_t> m_enqueue{0};
+  alignas(64) std::size_t m_dequeue{0};
+  std::atomic<std::size_t> m_dequeuedCount{0};
+};
+
+} // namespace typr::io::detail
@@ -0,0 +1,124 @@
+/**
+ * @file pacer.cpp
+ * @brief Platform-specific absolute-deadline waits for `detail::Pacer`.
+ */
+
+#include "pacer.hpp"
+
+#include <cerrno>
+#include <thread>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||            \
+    defined(_M_IX86)
+#include <immintrin.h>
+#define TYPR_IO_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define TYPR_IO_CPU_RELAX() __asm__ __volatile__("yield")
+#elif defined(_M_ARM64)
+#define TYPR_IO_CPU_RELAX() __yield()
+#else
+#define TYPR_IO_CPU_RELAX() std::this_thread::yield()
+#endif
+
+namespace typr::io::detail {
+
+namespace {
+
+/**
+ * @internal
+ * @brief Portion of every wait that is spun rather than slept.
+ *
+ * Sized to cover typical wake-up latency: Linux timer slack defaults to
+ * 50 us, high-resolution waitable timers on Windows are good to roughly half
+ * a millisecond.
+ */
+#if defined(_WIN32)
+constexpr std::chrono::microseconds kSpinWindow{500};
+#else
+constexpr std::chrono::microseconds kSpinWindow{100};
+#endif
+
+#if defined(_WIN32)
+/**
+ * @internal
+ * @brief Per-thread waitable timer, high resolution when available
+ * (Windows 10 1803+), closed when the thread exits.
+ */
+struct WaitableTimer {
+  HANDLE handle{nullptr};
+  WaitableTimer() {
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+    handle = CreateWaitableTimerExW(nullptr, nullptr,
+                                    CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                    TIMER_ALL_ACCESS);
+#endif
+    if (!handle)
+      handle = CreateWaitableTimerW(nullptr, TRUE, nullptr);
+  }
+  ~WaitableTimer() {
+    if (handle)
+      CloseHandle(handle);
+  }
+  WaitableTimer(const WaitableTimer &) = delete;
+  WaitableTimer &operator=(const WaitableTimer &) = delete;
+};
+
+void coarseSleepUntil(PacerClock::time_point until) {
+  thread_local WaitableTimer timer;
+  auto remaining = until - PacerClock::now();
+  if (remaining <= PacerClock::duration::zero())
+    return;
+  if (!timer.handle) {
+    std::this_thread::sleep_until(until);
+    return;
+  }
+  // Negative due time = relative, in 100 ns units. Relative is fine here
+  // because the absolute deadline is re-checked by the caller's spin loop.
+  LARGE_INTEGER due;
+  due.QuadPart =
+      -static_cast<LONGLONG>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(remaining)
+              .count() /
+          100);
+  if (SetWaitableTimer(timer.handle, &due, 0, nullptr, nullptr, FALSE))
+    WaitForSingleObject(timer.handle, INFINITE);
+}
+#elif defined(__APPLE__)
+void coarseSleepUntil(PacerClock::time_point until) {
+  std::this_thread::sleep_until(until);
+}
+#else
+void coarseSleepUntil(PacerClock::time_point until) {
+  // steady_clock is CLOCK_MONOTONIC on Linux, so its epoch can be handed to
+  // clock_nanosleep directly as an absolute deadline.
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                until.time_since_epoch())
+                .count();
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+  ts.tv_nsec = static_cast<long>(ns % 1000000000);
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+         EINTR) {
+  }
+}
+#endif
+
+} // namespace
+
+void sleepUntil(PacerClock::time_point deadline) {
+  auto now = PacerClock::now();
+  if (now >= deadline)
+    return;
+  if (deadline - now > kSpinWindow)
+    coarseSleepUntil(deadline - kSpinWindow);
+  while (PacerClock::now() < deadline)
+    TYPR_IO_CPU_RELAX();
+}
+
+} // namespace typr::io::detail
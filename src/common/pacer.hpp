@@ -0,0 +1,174 @@
+#pragma once
+
+/**
+ * @file pacer.hpp
+ * @brief Internal deadline-based pacing used by the Sender backends.
+ *
+ * `std::this_thread::sleep_for()` routinely overshoots short delays (tens to
+ * hundreds of microseconds) because of timer slack and scheduler latency, and
+ * the error accumulates over a long run of key edges. `Pacer` instead keeps
+ * an absolute schedule: every wait targets `previous deadline + interval`, so
+ * time spent emitting events is absorbed and the observed rate matches the
+ * configured one. Waiting itself uses `sleepUntil()`, which sleeps on an
+ * absolute deadline and spins for the last stretch.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <chrono>
+#include <cstdint>
+
+namespace typr::io::detail {
+
+using PacerClock = std::chrono::steady_clock;
+
+/**
+ * @internal
+ * @brief Block until `deadline` with bounded overshoot.
+ *
+ * Sleeps on an absolute deadline (clock_nanosleep with TIMER_ABSTIME on
+ * POSIX, a high-resolution waitable timer on Windows) until shortly before
+ * `deadline`, then spins for the remainder. Returns immediately when the
+ * deadline has already passed.
+ *
+ * @param deadline Point in time to wait for.
+ */
+void sleepUntil(PacerClock::time_point deadline);
+
+/**
+ * @internal
+ * @brief Convert an events-per-second rate into a pacing interval.
+ * @param perSecond Rate; zero, negative or NaN yields a zero (disabled)
+ *        interval, and rates too small to represent saturate to
+ *        `nanoseconds::max()`.
+ */
+inline std::chrono::nanoseconds rateToInterval(double perSecond) {
+  if (!(perSecond > 0.0))
+    return std::chrono::nanoseconds{0};
+  const double ns = 1e9 / perSecond;
+  // max() is not exactly representable as a double; comparing against its
+  // rounded-up value keeps the cast below in range.
+  if (!(ns < static_cast<double>(std::chrono::nanoseconds::max().count())))
+    return std::chrono::nanoseconds::max();
+  return std::chrono::nanoseconds{static_cast<long long>(ns)};
+}
+
+/**
+ * @internal
+ * @brief Return `from + delay`, saturating at `PacerClock::time_point::max()`.
+ *
+ * The comparison happens in the unit of `delay`, so a caller-supplied
+ * duration far beyond the clock's range (e.g. `microseconds::max()`) never
+ * overflows on conversion to the clock's nanoseconds. A zero or negative
+ * delay yields `from`.
+ */
+template <class Rep, class Period>
+PacerClock::time_point
+deadlineAfter(PacerClock::time_point from,
+              std::chrono::duration<Rep, Period> delay) {
+  using Delay = std::chrono::duration<Rep, Period>;
+  if (delay <= Delay::zero())
+    return from;
+  const auto headroom = PacerClock::time_point::max() - from;
+  if (delay >= std::chrono::duration_cast<Delay>(headroom))
+    return PacerClock::time_point::max();
+  return from + std::chrono::duration_cast<PacerClock::duration>(delay);
+}
+
+/**
+ * @internal
+ * @brief Press and release deadlines of one tap in a fixed-rate burst.
+ */
+struct TapDeadlines {
+  PacerClock::time_point press;
+  PacerClock::time_point release;
+};
+
+/**
+ * @internal
+ * @brief Schedule tap `index` of a burst starting at `start`.
+ *
+ * Tap `i` is pressed at `start + i * interval` and released half an interval
+ * later, so presses and releases stay evenly spaced for the whole burst.
+ * Both deadlines saturate instead of overflowing.
+ */
+inline TapDeadlines tapDeadlines(PacerClock::time_point start,
+                                 std::chrono::nanoseconds interval,
+                                 uint32_t index) {
+  std::chrono::nanoseconds offset = std::chrono::nanoseconds::max();
+  if (index == 0 || interval <= std::chrono::nanoseconds::max() / index)
+    offset = interval * index;
+  const auto press = deadlineAfter(start, offset);
+  return {press, deadlineAfter(press, interval / 2)};
+}
+
+/**
+ * @internal
+ * @brief Absolute-deadline scheduler for a fixed interval.
+ *
+ * Each call to `wait()` blocks until one interval after the previous
+ * deadline. When the caller fell behind by more than a full interval (for
+ * example because it was idle between two API calls) the schedule is
+ * re-anchored to "now + interval" instead of bursting to catch up.
+ */
+class Pacer {
+public:
+  /**
+   * @brief Set the interval between consecutive deadlines.
+   * @param interval Interval; zero or negative disables waiting.
+   */
+  void setInterval(std::chrono::nanoseconds interval) {
+    m_interval = interval;
+    m_anchored = false;
+  }
+
+  /**
+   * @brief Return the configured interval.
+   */
+  [[nodiscard]] std::chrono::nanoseconds interval() const {
+    return m_interval;
+  }
+
+  /**
+   * @brief Forget the current schedule; the next `wait()` re-anchors.
+   */
+  void reset() { m_anchored = false; }
+
+  /**
+   * @brief Wait for the next deadline of the schedule.
+   */
+  void wait() {
+    if (m_interval.count() <= 0)
+      return;
+    sleepUntil(advance());
+  }
+
+  /**
+   * @brief Move the schedule to its next deadline without waiting.
+   *
+   * `wait()` is `sleepUntil(advance())`. Deadlines saturate at
+   * `PacerClock::time_point::max()`, so a saturated interval (a tiny typing
+   * rate) blocks "forever" instead of overflowing the time_point.
+   *
+   * @return The new deadline; "now" when the interval is disabled.
+   */
+  PacerClock::time_point advance() {
+    const auto now = PacerClock::now();
+    if (m_interval.count() <= 0)
+      return now;
+    if (!m_anchored || now - m_deadline > m_interval) {
+      m_deadline = deadlineAfter(now, m_interval);
+      m_anchored = true;
+    } else {
+      m_deadline = deadlineAfter(m_deadline, m_interval);
+    }
+    return m_deadline;
+  }
+
+private:
+  std::chrono::nanoseconds m_interval{0};
+  PacerClock::time_point m_deadline{};
+  bool m_anchored{false};
+};
+
+} // namespace typr::io::detail
@@ -0,0 +1,130 @@
+#pragma once
+
+/**
+ * @file rcu_cell.hpp
+ * @brief Internal read-mostly value slot with RCU-style publication.
+ *
+ * `RcuCell<T>` holds a heap-allocated `T` (typically a listener callback)
+ * that is read on an event-dispatch hot path and replaced rarely (start /
+ * stop). Readers never lock and never copy the value: they pin the current
+ * grace period, take one acquire load of the published pointer and use the
+ * value in place. Writers publish a new value with an atomic exchange, then
+ * wait for the readers of the previous grace period to drain before freeing
+ * the old value (two-counter epoch scheme, as in userspace RCU).
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace typr::io::detail {
+
+/**
+ * @internal
+ * @brief Single-value RCU slot.
+ *
+ * @tparam T Stored value type; only ever accessed through `const T&` by
+ * readers.
+ */
+template <typename T> class RcuCell {
+public:
+  RcuCell() = default;
+  ~RcuCell() { delete m_current.load(std::memory_order_relaxed); }
+
+  RcuCell(const RcuCell &) = delete;
+  RcuCell &operator=(const RcuCell &) = delete;
+
+  /**
+   * @brief Publish `value`, then free the previous value once no reader can
+   * still observe it. Must not be called from inside `visit()`.
+   */
+  void store(T value) { replace(new T(std::move(value))); }
+
+  /**
+   * @brief Clear the slot (readers see no value afterwards).
+   */
+  void reset() { replace(nullptr); }
+
+  /**
+   * @brief Invoke `fn(const T&)` on the current value, if any.
+   *
+   * Lock-free and allocation-free; the value stays alive for the duration of
+   * the call even if a writer replaces it concurrently.
+   *
+   * @return true if a value was present and `fn` was invoked.
+   */
+  template <typename Fn> bool visit(Fn &&fn) const {
+    ReadGuard guard(*this);
+    const T *value = m_current.load(std::memory_order_seq_cst);
+    if (!value)
+      return false;
+    std::forward<Fn>(fn)(*value);
+    return true;
+  }
+
+  /**
+   * @brief Whether a value is currently published.
+   */
+  [[nodiscard]] bool hasValue() const {
+    return m_current.load(std::memory_order_acquire) != nullptr;
+  }
+
+private:
+  /**
+   * @internal
+   * @brief Pins the current grace period for the lifetime of a read.
+   */
+  class ReadGuard {
+  public:
+    explicit ReadGuard(const RcuCell &cell)
+        : m_counter(
+              cell.m_readers[cell.m_epoch.load(std::memory_order_acquire) & 1]) {
+      // seq_cst so the increment is ordered before the pointer load and is
+      // visible to a writer that swapped the pointer before checking readers.
+      m_counter.fetch_add(1, std::memory_order_seq_cst);
+    }
+    ~ReadGuard() { m_counter.fetch_sub(1, std::memory_order_release); }
+
+    ReadGuard(const ReadGuard &) = delete;
+    ReadGuard &operator=(const ReadGuard &) = delete;
+
+  private:
+    std::atomic<uint32_t> &m_counter;
+  };
+
+  void replace(T *next) {
+    std::lock_guard<std::mutex> lk(m_writerMutex);
+    T *previous = m_current.exchange(next, std::memory_order_seq_cst);
+    synchronize();
+    delete previous;
+  }
+
+  /**
+   * @internal
+   * @brief Wait until every reader that may have loaded the old pointer is
+   * done.
+   *
+   * Any such reader pinned one of the two counters before the exchange, so
+   * flipping the epoch and draining each parity in turn covers it. Readers
+   * arriving after a flip pin the other counter, so a steady stream of new
+   * reads cannot starve the writer.
+   */
+  void synchronize() {
+    for (int phase = 0; phase < 2; ++phase) {
+      const uint32_t old = m_epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+      while (m_readers[old].load(std::memory_order_seq_cst) != 0)
+        std::this_thread::yield();
+    }
+  }
+
+  std::atomic<T *> m_current{nullptr};
+  mutable std::atomic<uint32_t> m_readers[2]{};
+  std::atomic<uint32_t> m_epoch{0};
+  std::mutex m_writerMutex;
+};
+
+} // namespace typr::io::detail
@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * @file spsc_ring.hpp
+ * @brief Internal bounded single-producer / single-consumer lock-free ring.
+ *
+ * Classic two-index ring for trivially copyable records: the producer owns
+ * the write index, the consumer owns the read index, and each side keeps a
+ * cached copy of the other's index so the common case touches no shared
+ * cache line. Used to hand listener events from the platform hook thread to
+ * a consumer without blocking the hook.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace typr::io::detail {
+
+template <typename T> class SpscRing {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SpscRing stores trivially copyable records");
+
+public:
+  /**
+   * @brief Create a ring holding at least `capacity` items (rounded up to a
+   * power of two, minimum 2).
+   */
+  explicit SpscRing(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    m_mask = size - 1;
+    m_items = std::make_unique<T[]>(size);
+  }
+
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  /**
+   * @brief Enqueue one item (producer thread only).
+   * @return false if the ring is full.
+   */
+  bool tryPush(const T &value) {
+    const std::size_t write = m_write.load(std::memory_order_relaxed);
+    if (write - m_readCache > m_mask) {
+      m_readCache = m_read.load(std::memory_order_acquire);
+      if (write - m_readCache > m_mask)
+        return false;
+    }
+    m_items[write & m_mask] = value;
+    m_write.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Dequeue up to `max` items into `out` (consumer thread only).
+   * @return Number of items copied.
+   */
+  std::size_t popBulk(T *out, std::size_t max) {
+    const std::size_t read = m_read.load(std::memory_order_relaxed);
+    if (m_writeCache - read < max)
+      m_writeCache = m_write.load(std::memory_order_acquire);
+    const std::size_t n = std::min(max, m_writeCache - read);
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = m_items[(read + i) & m_mask];
+    if (n)
+      m_read.store(read + n, std::memory_order_release);
+    return n;
+  }
+
+  /**
+   * @brief Approximate number of queued items (any thread).
+   */
+  [[nodiscard]] std::size_t size() const {
+    return m_write.load(std::memory_order_acquire) -
+           m_read.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] std::size_t capacity() const { return m_mask + 1; }
+
+private:
+  std::unique_ptr<T[]> m_items;
+  std::size_t m_mask{0};
+  // Producer side
+  alignas(64) std::atomic<std::size_t> m_write{0};
+  std::size_t m_readCache{0};
+  // Consumer side
+  alignas(64) std::atomic<std::size_t> m_read{0};
+  std::size_t m_writeCache{0};
+};
+
+} // namespace typr::io::detail
@@ -0,0 +1,35 @@
+/**
+ * @file stats.cpp
+ * @brief Summary helpers for typr::io::LatencyHistogram.
+ */
+
+#include <typr-io/stats.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace typr::io {
+
+double LatencyHistogram::meanNs() const noexcept {
+  return count ? static_cast<double>(totalNs) / static_cast<double>(count)
+               : 0.0;
+}
+
+uint64_t LatencyHistogram::percentileNs(double p) const noexcept {
+  if (count == 0)
+    return 0;
+  p = std::clamp(p, 0.0, 100.0);
+  // 1-based rank of the requested sample
+  const auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(
+             std::ceil(p / 100.0 * static_cast<double>(count))));
+  uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    seen += buckets[i];
+    if (seen >= rank)
+      return std::min(bucketUpperNs(i), maxNs);
+  }
+  return maxNs;
+}
+
+} // namespace typr::io
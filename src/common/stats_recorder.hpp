@@ -0,0 +1,207 @@
+#pragma once
+
+/**
+ * @file stats_recorder.hpp
+ * @brief Internal lock-free recorders behind `Listener::stats()` and
+ * `Sender::stats()`.
+ *
+ * Recording happens on the listener / injection hot paths, so every counter
+ * is a relaxed atomic: readers get a consistent-enough snapshot without the
+ * writer ever taking a lock.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <typr-io/stats.hpp>
+
+namespace typr::io::detail {
+
+/**
+ * @internal
+ * @brief Current steady_clock time in nanoseconds (the timeline of every
+ * timestamp typr-io reports).
+ */
+inline uint64_t steadyNowNs() noexcept {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/**
+ * @internal
+ * @brief Map a native event timestamp onto the steady_clock timeline.
+ *
+ * Platforms stamp input events with their own monotonic clocks. Given the
+ * event time and the current reading of that same clock (both converted to
+ * nanoseconds), the event's age is carried over to steady_clock. Timestamps
+ * from the future (clock skew) are clamped to now.
+ */
+inline uint64_t nativeToSteadyNs(uint64_t nativeEventNs,
+                                 uint64_t nativeNowNs) noexcept {
+  const uint64_t now = steadyNowNs();
+  const uint64_t age =
+      nativeNowNs > nativeEventNs ? nativeNowNs - nativeEventNs : 0;
+  return age < now ? now - age : 0;
+}
+
+/**
+ * @internal
+ * @brief Concurrent log2 histogram; `snapshot()` yields a LatencyHistogram.
+ */
+class AtomicHistogram {
+public:
+  void record(uint64_t ns) noexcept {
+    m_buckets[LatencyHistogram::bucketFor(ns)].fetch_add(
+        1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (ns > max &&
+           !m_max.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  [[nodiscard]] LatencyHistogram snapshot() const noexcept {
+    LatencyHistogram h;
+    for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i)
+      h.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    h.count = m_count.load(std::memory_order_relaxed);
+    h.totalNs = m_total.load(std::memory_order_relaxed);
+    h.maxNs = m_max.load(std::memory_order_relaxed);
+    return h;
+  }
+
+  void reset() noexcept {
+    for (auto &b : m_buckets)
+      b.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_total.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, LatencyHistogram::kBuckets> m_buckets{};
+  std::atomic<uint64_t> m_count{0};
+  std::atomic<uint64_t> m_total{0};
+  std::atomic<uint64_t> m_max{0};
+};
+
+/**
+ * @internal
+ * @brief Per-listener counters, shared by every backend.
+ */
+class ListenerStatsRecorder {
+public:
+  /**
+   * @internal
+   * @brief Clear all counters and restart the uptime clock (called on start).
+   */
+  void reset() noexcept {
+    m_events.store(0, std::memory_order_relaxed);
+    m_filtered.store(0, std::memory_order_relaxed);
+    m_hookLatency.reset();
+    m_callbackDuration.reset();
+    m_startNs.store(steadyNowNs(), std::memory_order_relaxed);
+  }
+
+  /**
+   * @internal
+   * @brief Deliver one event through `deliver()` and record its hook latency
+   * and delivery duration.
+   *
+   * @param eventNs Event timestamp on the steady_clock timeline.
+   */
+  template <typename Fn> void timed(uint64_t eventNs, Fn &&deliver) {
+    const uint64_t begin = steadyNowNs();
+    m_hookLatency.record(begin > eventNs ? begin - eventNs : 0);
+    deliver();
+    m_callbackDuration.record(steadyNowNs() - begin);
+    m_events.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @internal
+   * @brief Count one event rejected by the listener's filter.
+   */
+  void filtered() noexcept {
+    m_filtered.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] ListenerStats snapshot(uint64_t dropped) const noexcept {
+    ListenerStats s;
+    s.events = m_events.load(std::memory_order_relaxed);
+    s.droppedEvents = dropped;
+    s.filteredEvents = m_filtered.load(std::memory_order_relaxed);
+    const uint64_t start = m_startNs.load(std::memory_order_relaxed);
+    if (start != 0) {
+      s.uptimeNs = steadyNowNs() - start;
+      if (s.uptimeNs > 0)
+        s.eventsPerSecond = static_cast<double>(s.events) * 1e9 /
+                            static_cast<double>(s.uptimeNs);
+    }
+    s.hookLatency = m_hookLatency.snapshot();
+    s.callbackDuration = m_callbackDuration.snapshot();
+    return s;
+  }
+
+private:
+  std::atomic<uint64_t> m_events{0};
+  std::atomic<uint64_t> m_filtered{0};
+  std::atomic<uint64_t> m_startNs{0};
+  AtomicHistogram m_hookLatency;
+  AtomicHistogram m_callbackDuration;
+};
+
+/**
+ * @internal
+ * @brief Per-sender counters, shared by every backend.
+ */
+class SenderStatsRecorder {
+public:
+  /**
+   * @internal
+   * @brief Run one OS injection call and record its duration and outcome.
+   *
+   * @param events Number of platform input events the call submits.
+   * @param inject Callable returning whether the call succeeded.
+   * @return The result of `inject()`.
+   */
+  template <typename Fn> bool timed(std::size_t events, Fn &&inject) {
+    const uint64_t begin = steadyNowNs();
+    const bool ok = inject();
+    const uint64_t end = steadyNowNs();
+    m_injectDuration.record(end - begin);
+    m_calls.fetch_add(1, std::memory_order_relaxed);
+    m_events.fetch_add(events, std::memory_order_relaxed);
+    if (!ok)
+      m_failed.fetch_add(1, std::memory_order_relaxed);
+    m_lastInject.store(begin, std::memory_order_relaxed);
+    return ok;
+  }
+
+  [[nodiscard]] SenderStats snapshot() const noexcept {
+    SenderStats s;
+    s.injectedEvents = m_events.load(std::memory_order_relaxed);
+    s.injectCalls = m_calls.load(std::memory_order_relaxed);
+    s.failedCalls = m_failed.load(std::memory_order_relaxed);
+    s.lastInjectNs = m_lastInject.load(std::memory_order_relaxed);
+    s.injectDuration = m_injectDuration.snapshot();
+    return s;
+  }
+
+private:
+  std::atomic<uint64_t> m_events{0};
+  std::atomic<uint64_t> m_calls{0};
+  std::atomic<uint64_t> m_failed{0};
+  std::atomic<uint64_t> m_lastInject{0};
+  AtomicHistogram m_injectDuration;
+};
+
+} // namespace typr::io::detail
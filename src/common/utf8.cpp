@@ -0,0 +1,251 @@
+/**
+ * @file utf8.cpp
+ * @brief UTF-8 transcoding shared by the Sender backends.
+ *
+ * Every backend used to carry its own copy of this decoder inside
+ * `Sender::typeText(const std::string &)`; it now lives here once.
+ *
+ * The decoder validates as it goes and writes into an output sized for the
+ * worst case (one unit per input byte), which is trimmed at the end. Text
+ * injected by the Senders is mostly ASCII, so whenever the decoder sits on an
+ * ASCII byte it hands the following bytes to a vector kernel that widens
+ * whole blocks until it meets a non-ASCII byte.
+ */
+
+#include "utf8.hpp"
+
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TYPR_IO_UTF8_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TYPR_IO_UTF8_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TYPR_IO_UTF8_NEON 1
+#endif
+
+namespace typr::io::detail {
+
+namespace {
+
+constexpr char32_t kReplacement = 0xFFFD;
+
+// Widen the leading ASCII blocks of [src, src + size) into dst; returns the
+// number of bytes consumed (a multiple of the block size, possibly 0).
+#if defined(TYPR_IO_UTF8_AVX2)
+
+template <typename Unit>
+size_t widenAscii(const unsigned char *src, size_t size, Unit *dst) {
+  static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    if (_mm256_movemask_epi8(v) != 0)
+      break;
+    auto *out = reinterpret_cast<__m256i *>(dst + i);
+    if constexpr (sizeof(Unit) == 2) {
+      _mm256_storeu_si256(out,
+                          _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+      _mm256_storeu_si256(out + 1,
+                          _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+    } else {
+      for (int part = 0; part < 4; ++part) {
+        const __m128i bytes = _mm_loadl_epi64(
+            reinterpret_cast<const __m128i *>(src + i + 8 * part));
+        _mm256_storeu_si256(out + part, _mm256_cvtepu8_epi32(bytes));
+      }
+    }
+  }
+  return i;
+}
+
+#elif defined(TYPR_IO_UTF8_SSE2)
+
+template <typename Unit>
+size_t widenAscii(const unsigned char *src, size_t size, Unit *dst) {
+  static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4);
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (_mm_movemask_epi8(v) != 0)
+      break;
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+    auto *out = reinterpret_cast<__m128i *>(dst + i);
+    if constexpr (sizeof(Unit) == 2) {
+      _mm_storeu_si128(out, lo);
+      _mm_storeu_si128(out + 1, hi);
+    } else {
+      _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+      _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+      _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+      _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+    }
+  }
+  return i;
+}
+
+#elif defined(TYPR_IO_UTF8_NEON)
+
+template <typename Unit>
+size_t widenAscii(const unsigned char *src, size_t size, Unit *dst) {
+  static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const uint8x16_t v = vld1q_u8(src + i);
+    if (vmaxvq_u8(v) >= 0x80)
+      break;
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    const uint16x8_t hi = vmovl_high_u8(v);
+    if constexpr (sizeof(Unit) == 2) {
+      auto *out = reinterpret_cast<uint16_t *>(dst + i);
+      vst1q_u16(out, lo);
+      vst1q_u16(out + 8, hi);
+    } else {
+      auto *out = reinterpret_cast<uint32_t *>(dst + i);
+      vst1q_u32(out, vmovl_u16(vget_low_u16(lo)));
+      vst1q_u32(out + 4, vmovl_high_u16(lo));
+      vst1q_u32(out + 8, vmovl_u16(vget_low_u16(hi)));
+      vst1q_u32(out + 12, vmovl_high_u16(hi));
+    }
+  }
+  return i;
+}
+
+#else
+
+template <typename Unit>
+size_t widenAscii(const unsigned char *, size_t, Unit *) {
+  return 0;
+}
+
+#endif
+
+// Append one codepoint to the output cursor.
+inline void put(char32_t *&out, char32_t cp) { *out++ = cp; }
+
+inline void put(char16_t *&out, char32_t cp) {
+  if (cp <= 0xFFFF) {
+    *out++ = static_cast<char16_t>(cp);
+  } else {
+    cp -= 0x10000;
+    *out++ = static_cast<char16_t>(0xD800 | (cp >> 10));
+    *out++ = static_cast<char16_t>(0xDC00 | (cp & 0x3FF));
+  }
+}
+
+// Validating decoder shared by both output widths. Every input byte yields at
+// most one output unit (a 4-byte sequence yields two UTF-16 units), so an
+// output of utf8.size() units never overflows.
+template <typename Unit>
+std::basic_string<Unit> decode(std::string_view utf8, Utf8Errors errors) {
+  std::basic_string<Unit> result(utf8.size(), Unit{0});
+  const auto *src = reinterpret_cast<const unsigned char *>(utf8.data());
+  const size_t size = utf8.size();
+  Unit *const begin = result.data();
+  Unit *out = begin;
+
+  auto error = [&]() {
+    if (errors == Utf8Errors::Replace)
+      put(out, kReplacement);
+  };
+
+  size_t i = 0;
+  while (i < size) {
+    const unsigned char c = src[i];
+    if (c < 0x80) {
+      const size_t run = widenAscii(src + i, size - i, out);
+      if (run > 0) {
+        i += run;
+        out += run;
+        continue;
+      }
+      *out++ = static_cast<Unit>(c);
+      ++i;
+      continue;
+    }
+
+    // Expected continuation count, and the allowed range of the first
+    // continuation byte (excludes overlongs, surrogates and > U+10FFFF).
+    int need = 0;
+    unsigned char lower = 0x80;
+    unsigned char upper = 0xBF;
+    char32_t cp = 0;
+    if (c >= 0xC2 && c <= 0xDF) {
+      need = 1;
+      cp = c & 0x1F;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+      need = 2;
+      cp = c & 0x0F;
+      if (c == 0xE0)
+        lower = 0xA0;
+      else if (c == 0xED)
+        upper = 0x9F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      need = 3;
+      cp = c & 0x07;
+      if (c == 0xF0)
+        lower = 0x90;
+      else if (c == 0xF4)
+        upper = 0x8F;
+    } else {
+      // Stray continuation byte or a lead byte that never appears in UTF-8
+      error();
+      ++i;
+      continue;
+    }
+
+    ++i;
+    bool ok = true;
+    for (int k = 0; k < need; ++k) {
+      if (i >= size || src[i] < lower || src[i] > upper) {
+        // The bytes consumed so far form one maximal subpart; the current
+        // byte is decoded afresh
+        ok = false;
+        break;
+      }
+      cp = (cp << 6) | (src[i] & 0x3F);
+      lower = 0x80;
+      upper = 0xBF;
+      ++i;
+    }
+    if (ok)
+      put(out, cp);
+    else
+      error();
+  }
+
+  result.resize(static_cast<size_t>(out - begin));
+  return result;
+}
+
+} // namespace
+
+std::u32string utf8ToUtf32(std::string_view utf8, Utf8Errors errors) {
+  return decode<char32_t>(utf8, errors);
+}
+
+std::u16string utf8ToUtf16(std::string_view utf8, Utf8Errors errors) {
+  return decode<char16_t>(utf8, errors);
+}
+
+std::u16string utf32ToUtf16(std::u32string_view utf32) {
+  std::u16string result(utf32.size() * 2, u'\0');
+  char16_t *out = result.data();
+  for (char32_t cp : utf32) {
+    if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+      continue; // not a Unicode scalar value
+    put(out, cp);
+  }
+  result.resize(static_cast<size_t>(out - result.data()));
+  return result;
+}
+
+} // namespace typr::io::detail
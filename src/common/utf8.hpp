@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file utf8.hpp
+ * @brief Internal UTF-8 helpers shared by the Sender backends.
+ *
+ * These helpers are an implementation detail of typr-io and are not part of
+ * the installed public API.
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace typr::io::detail {
+
+/**
+ * @internal
+ * @brief What the decoders do with ill-formed UTF-8.
+ *
+ * Ill-formed input is split into maximal subparts (as recommended by the
+ * Unicode standard and used by WHATWG): a stray continuation byte, an invalid
+ * lead byte, an overlong or surrogate encoding, a value above U+10FFFF and a
+ * truncated sequence are each one error.
+ */
+enum class Utf8Errors : uint8_t {
+  Replace, ///< Emit U+FFFD REPLACEMENT CHARACTER for each error.
+  Skip,    ///< Drop the offending bytes.
+};
+
+/**
+ * @internal
+ * @brief Decode UTF-8 text into UTF-32 codepoints.
+ *
+ * Runs of ASCII are widened with SSE2 / AVX2 / NEON where available; the
+ * output is sized once up front.
+ *
+ * @param utf8 UTF-8 encoded input.
+ * @param errors Handling of ill-formed input.
+ * @return std::u32string Decoded codepoints.
+ */
+std::u32string utf8ToUtf32(std::string_view utf8,
+                           Utf8Errors errors = Utf8Errors::Replace);
+
+/**
+ * @internal
+ * @brief Decode UTF-8 text directly into UTF-16 code units.
+ *
+ * Used by the backends whose injection API consumes UTF-16
+ * (`CGEventKeyboardSetUnicodeString`, `KEYEVENTF_UNICODE`), so no
+ * intermediate UTF-32 string is built.
+ *
+ * @param utf8 UTF-8 encoded input.
+ * @param errors Handling of ill-formed input.
+ * @return std::u16string Code units, with surrogate pairs above U+FFFF.
+ */
+std::u16string utf8ToUtf16(std::string_view utf8,
+                           Utf8Errors errors = Utf8Errors::Replace);
+
+/**
+ * @internal
+ * @brief Encode UTF-32 codepoints as UTF-16 code units.
+ *
+ * Surrogate codepoints and values above U+10FFFF are skipped.
+ */
+std::u16string utf32ToUtf16(std::u32string_view utf32);
+
+} // namespace typr::io::detail
@@ -0,0 +1,56 @@
+#pragma once
+
+/**
+ * @file varint.hpp
+ * @brief Internal LEB128-style unsigned varints used by the recording format.
+ *
+ * Seven payload bits per byte, least significant group first, high bit set on
+ * every byte but the last. Small values (short time deltas, most key codes,
+ * ASCII codepoints) take one or two bytes.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace typr::io::detail {
+
+/// Longest encoding of a 64-bit value.
+inline constexpr std::size_t kMaxVarintBytes = 10;
+
+/**
+ * @internal
+ * @brief Encode `value` at `out` (room for `kMaxVarintBytes` required).
+ * @return Number of bytes written.
+ */
+inline std::size_t encodeVarint(uint64_t value, uint8_t *out) {
+  std::size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = static_cast<uint8_t>(value);
+  return n;
+}
+
+/**
+ * @internal
+ * @brief Decode a varint from `[in, in + size)`.
+ *
+ * @param value Receives the decoded value.
+ * @return Number of bytes consumed, or 0 if the input is truncated or longer
+ *         than `kMaxVarintBytes`.
+ */
+inline std::size_t decodeVarint(const uint8_t *in, std::size_t size,
+                                uint64_t &value) {
+  value = 0;
+  for (std::size_t n = 0; n < size && n < kMaxVarintBytes; ++n) {
+    value |= static_cast<uint64_t>(in[n] & 0x7F) << (7 * n);
+    if ((in[n] & 0x80) == 0)
+      return n + 1;
+  }
+  return 0;
+}
+
+} // namespace typr::io::detail
@@ -0,0 +1,745 @@
+/**
+ * @file xkb_layout.cpp
+ * @brief Layout detection, the shared layout cache and on-disk snapshots.
+ */
+
+#include "common/xkb_layout.hpp"
+
+#include <typr-io/log.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <linux/input.h>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+#include <xkbcommon/xkbcommon.h>
+
+namespace typr::io::detail {
+
+namespace {
+
+/**
+ * @internal
+ * @brief Process-wide xkb objects.
+ *
+ * Allocated once and intentionally never destroyed so Senders / Listeners
+ * released during static destruction never see a dead cache.
+ */
+struct XkbShared {
+  // Guards the context and every keymap / state reference count
+  std::mutex xkbMutex;
+  struct xkb_context *ctx{nullptr};
+  // Guards `layouts`; may be held while taking xkbMutex, never the reverse
+  std::mutex cacheMutex;
+  std::unordered_map<std::string, std::shared_ptr<const XkbLayout>> layouts;
+};
+
+XkbShared &shared() {
+  static auto *s = new XkbShared();
+  return *s;
+}
+
+// ---------------------------------------------------------------------------
+// Layout detection
+// ---------------------------------------------------------------------------
+
+void trim(std::string &s) {
+  const char *ws = " \t\r\n";
+  size_t a = s.find_first_not_of(ws);
+  if (a == std::string::npos) {
+    s.clear();
+    return;
+  }
+  size_t b = s.find_last_not_of(ws);
+  s = s.substr(a, b - a + 1);
+}
+
+/**
+ * @internal
+ * @brief Parse Debian/Ubuntu-style `/etc/default/keyboard`.
+ */
+XkbNames readDefaultKeyboardFile() {
+  XkbNames names;
+  std::ifstream f("/etc/default/keyboard");
+  if (!f)
+    return names;
+  std::string line;
+  while (std::getline(f, line)) {
+    // Strip comments and surrounding whitespace.
+    size_t comment = line.find('#');
+    if (comment != std::string::npos)
+      line = line.substr(0, comment);
+    trim(line);
+    if (line.empty())
+      continue;
+    size_t eq = line.find('=');
+    if (eq == std::string::npos)
+      continue;
+    std::string key = line.substr(0, eq);
+    std::string val = line.substr(eq + 1);
+    trim(key);
+    trim(val);
+    // Remove surrounding quotes if present.
+    if (val.size() >= 2 && ((val.front() == '\"' && val.back() == '\"') ||
+                            (val.front() == '\'' && val.back() == '\'')))
+      val = val.substr(1, val.size() - 2);
+    // Normalize key for comparison.
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return std::toupper(c); });
+    if (key == "XKBRULES" || key == "XKB_DEFAULT_RULES")
+      names.rules = val;
+    else if (key == "XKBMODEL" || key == "XKB_DEFAULT_MODEL")
+      names.model = val;
+    else if (key == "XKBLAYOUT" || key == "XKB_DEFAULT_LAYOUT")
+      names.layout = val;
+    else if (key == "XKBVARIANT" || key == "XKB_DEFAULT_VARIANT")
+      names.variant = val;
+    else if (key == "XKBOPTIONS" || key == "XKB_DEFAULT_OPTIONS")
+      names.options = val;
+  }
+  return names;
+}
+
+/**
+ * @internal
+ * @brief Ask the X server for its layout (heavier: spawns a shell).
+ */
+std::string querySetxkbmapLayout() {
+  FILE *pipe = popen(
+      "setxkbmap -query 2>/dev/null | grep layout | awk '{print $2}'", "r");
+  if (!pipe)
+    return {};
+  std::string layout;
+  char buffer[64];
+  if (fgets(buffer, sizeof(buffer), pipe)) {
+    layout = buffer;
+    trim(layout);
+  }
+  pclose(pipe);
+  return layout;
+}
+
+/**
+ * @internal
+ * @brief Guess a layout from the locale (LC_ALL, LC_MESSAGES, LANG).
+ */
+std::string guessLayoutFromLocale() {
+  const char *localeEnv = std::getenv("LC_ALL");
+  if (!localeEnv)
+    localeEnv = std::getenv("LC_MESSAGES");
+  if (!localeEnv)
+    localeEnv = std::getenv("LANG");
+  if (!localeEnv)
+    return {};
+
+  std::string locale(localeEnv);
+  // Trim off encoding/variants (e.g. en_US.UTF-8 -> en_US)
+  size_t dot = locale.find('.');
+  if (dot != std::string::npos)
+    locale.resize(dot);
+  size_t at = locale.find('@');
+  if (at != std::string::npos)
+    locale.resize(at);
+  // Split language and region if present (e.g. en_US)
+  std::string lang = locale;
+  std::string region;
+  size_t us = locale.find('_');
+  if (us != std::string::npos) {
+    lang = locale.substr(0, us);
+    region = locale.substr(us + 1);
+  }
+  std::transform(lang.begin(), lang.end(), lang.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  std::transform(region.begin(), region.end(), region.begin(),
+                 [](unsigned char c) { return std::toupper(c); });
+  if (lang == "c" || lang == "posix")
+    return {};
+  if (lang == "en") // Prefer GB for en_GB, otherwise default to US
+    return (region == "GB" || region == "UK") ? "gb" : "us";
+  if (lang == "pt" && region == "BR")
+    return "br";
+  if (lang == "da")
+    return "dk"; // Danish xkb uses 'dk'
+  if (lang == "sv")
+    return "se"; // Swedish xkb uses 'se'
+  // Fall back to using the language code as layout (fr, de, es, it, etc.)
+  return lang;
+}
+
+// ---------------------------------------------------------------------------
+// Keymap scanning
+// ---------------------------------------------------------------------------
+
+/**
+ * @internal
+ * @brief Resolve the keymap's modifier indices into `layout.mods`. Must be
+ * called with `xkbMutex` held.
+ */
+void resolveModMasks(XkbLayout &layout) {
+  auto maskOf = [&](const char *name) -> uint32_t {
+    const xkb_mod_index_t index = xkb_keymap_mod_get_index(layout.keymap, name);
+    return index == XKB_MOD_INVALID || index >= 32 ? 0u : (1u << index);
+  };
+  layout.mods.shift = maskOf(XKB_MOD_NAME_SHIFT);
+  layout.mods.ctrl = maskOf(XKB_MOD_NAME_CTRL);
+  layout.mods.alt = maskOf(XKB_MOD_NAME_ALT);
+  layout.mods.super = maskOf(XKB_MOD_NAME_LOGO);
+  layout.mods.capsLock = maskOf(XKB_MOD_NAME_CAPS);
+}
+
+/**
+ * @internal
+ * @brief Fill the reverse tables from a compiled keymap.
+ *
+ * Uses one unmodified and one Shift-latched state so each keycode is
+ * resolved with plain lookups instead of toggling a single state's mask
+ * back and forth. Must be called with `xkbMutex` held.
+ */
+void scanKeymap(XkbLayout &layout) {
+  struct xkb_keymap *keymap = layout.keymap;
+  struct xkb_state *plain = xkb_state_new(keymap);
+  struct xkb_state *shifted = xkb_state_new(keymap);
+  if (!plain || !shifted) {
+    TYPR_IO_LOG_ERROR("xkb layout: xkb_state_new() failed");
+    if (plain)
+      xkb_state_unref(plain);
+    if (shifted)
+      xkb_state_unref(shifted);
+    return;
+  }
+  const xkb_mod_index_t shiftMod =
+      xkb_keymap_mod_get_index(keymap, XKB_MOD_NAME_SHIFT);
+  const bool haveShift = shiftMod != XKB_MOD_INVALID;
+  if (haveShift)
+    xkb_state_update_mask(shifted, (1u << shiftMod), 0, 0, 0, 0, 0);
+
+  const xkb_keycode_t minKey = xkb_keymap_min_keycode(keymap);
+  const xkb_keycode_t maxKey = xkb_keymap_max_keycode(keymap);
+  for (xkb_keycode_t xkbKey = minKey; xkbKey <= maxKey; ++xkbKey) {
+    const int evdevCode = static_cast<int>(xkbKey) - 8; // XKB offset
+    if (evdevCode <= 0)
+      continue;
+
+    // Keysym for the Key mapping: unshifted first, then shifted (e.g. the
+    // AZERTY top row produces digits only with Shift).
+    Key mappedKey = keysymToKey(xkb_state_key_get_one_sym(plain, xkbKey));
+    if (mappedKey == Key::Unknown && haveShift)
+      mappedKey = keysymToKey(xkb_state_key_get_one_sym(shifted, xkbKey));
+    if (mappedKey != Key::Unknown) {
+      layout.keys.insert(mappedKey, evdevCode);
+      layout.codes.insert(static_cast<std::size_t>(evdevCode), mappedKey);
+    }
+
+    const uint32_t unshifted = xkb_state_key_get_utf32(plain, xkbKey);
+    if (unshifted != 0)
+      layout.chars.insert(unshifted, {evdevCode, false});
+    if (haveShift) {
+      const uint32_t upper = xkb_state_key_get_utf32(shifted, xkbKey);
+      if (upper != 0 && upper != unshifted)
+        layout.chars.insert(upper, {evdevCode, true});
+    }
+  }
+  xkb_state_unref(plain);
+  xkb_state_unref(shifted);
+}
+
+/**
+ * @internal
+ * @brief Add the layout-independent keycodes.
+ *
+ * Modifiers, navigation, function and numpad keys sit at the same physical
+ * position on every layout, so these canonical evdev codes are safe even
+ * when no keymap could be compiled. They are inserted before the keymap
+ * scan: the scan also reaches virtual keycodes (e.g. `<LVL3>`, evdev 84,
+ * which produces ISO_Level3_Shift like Right Alt does) and the first
+ * mapping of a `Key` wins.
+ */
+void addFallbackKeys(XkbLayout &layout) {
+  auto set = [&layout](Key k, int v) {
+    layout.keys.insert(k, v);
+    layout.codes.insert(static_cast<std::size_t>(v), k);
+  };
+
+  // Modifiers (always same physical keys)
+  set(Key::ShiftLeft, KEY_LEFTSHIFT);
+  set(Key::ShiftRight, KEY_RIGHTSHIFT);
+  set(Key::CtrlLeft, KEY_LEFTCTRL);
+  set(Key::CtrlRight, KEY_RIGHTCTRL);
+  set(Key::AltLeft, KEY_LEFTALT);
+  set(Key::AltRight, KEY_RIGHTALT);
+  set(Key::SuperLeft, KEY_LEFTMETA);
+  set(Key::SuperRight, KEY_RIGHTMETA);
+  set(Key::CapsLock, KEY_CAPSLOCK);
+  set(Key::NumLock, KEY_NUMLOCK);
+
+  // Navigation (layout-independent)
+  set(Key::Space, KEY_SPACE);
+  set(Key::Enter, KEY_ENTER);
+  set(Key::Tab, KEY_TAB);
+  set(Key::Backspace, KEY_BACKSPACE);
+  set(Key::Delete, KEY_DELETE);
+  set(Key::Escape, KEY_ESC);
+  set(Key::Left, KEY_LEFT);
+  set(Key::Right, KEY_RIGHT);
+  set(Key::Up, KEY_UP);
+  set(Key::Down, KEY_DOWN);
+  set(Key::Home, KEY_HOME);
+  set(Key::End, KEY_END);
+  set(Key::PageUp, KEY_PAGEUP);
+  set(Key::PageDown, KEY_PAGEDOWN);
+
+  // Function keys
+  set(Key::F1, KEY_F1);
+  set(Key::F2, KEY_F2);
+  set(Key::F3, KEY_F3);
+  set(Key::F4, KEY_F4);
+  set(Key::F5, KEY_F5);
+  set(Key::F6, KEY_F6);
+  set(Key::F7, KEY_F7);
+  set(Key::F8, KEY_F8);
+  set(Key::F9, KEY_F9);
+  set(Key::F10, KEY_F10);
+  set(Key::F11, KEY_F11);
+  set(Key::F12, KEY_F12);
+
+  // Numpad (physical position)
+  set(Key::Numpad0, KEY_KP0);
+  set(Key::Numpad1, KEY_KP1);
+  set(Key::Numpad2, KEY_KP2);
+  set(Key::Numpad3, KEY_KP3);
+  set(Key::Numpad4, KEY_KP4);
+  set(Key::Numpad5, KEY_KP5);
+  set(Key::Numpad6, KEY_KP6);
+  set(Key::Numpad7, KEY_KP7);
+  set(Key::Numpad8, KEY_KP8);
+  set(Key::Numpad9, KEY_KP9);
+  set(Key::NumpadDivide, KEY_KPSLASH);
+  set(Key::NumpadMultiply, KEY_KPASTERISK);
+  set(Key::NumpadMinus, KEY_KPMINUS);
+  set(Key::NumpadPlus, KEY_KPPLUS);
+  set(Key::NumpadEnter, KEY_KPENTER);
+  set(Key::NumpadDecimal, KEY_KPDOT);
+}
+
+/**
+ * @internal
+ * @brief Compile `names` and scan the result (cache miss path).
+ */
+std::shared_ptr<XkbLayout> compileLayout(const XkbNames &names) {
+  auto layout = std::make_shared<XkbLayout>();
+  layout->names = names;
+  addFallbackKeys(*layout);
+
+  auto orNull = [](const std::string &s) {
+    return s.empty() ? nullptr : s.c_str();
+  };
+  const struct xkb_rule_names rmlvo = {orNull(names.rules),
+                                       orNull(names.model),
+                                       orNull(names.layout),
+                                       orNull(names.variant),
+                                       orNull(names.options)};
+  {
+    XkbShared &s = shared();
+    std::lock_guard<std::mutex> lk(s.xkbMutex);
+    if (!s.ctx)
+      s.ctx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    if (!s.ctx) {
+      TYPR_IO_LOG_ERROR("xkb layout: xkb_context_new() failed");
+    } else {
+      layout->keymap = xkb_keymap_new_from_names(s.ctx, &rmlvo,
+                                                 XKB_KEYMAP_COMPILE_NO_FLAGS);
+      if (layout->keymap) {
+        resolveModMasks(*layout);
+        scanKeymap(*layout);
+      } else {
+        TYPR_IO_LOG_ERROR("xkb layout: xkb_keymap_new_from_names(%s) failed",
+                          names.key().c_str());
+      }
+    }
+  }
+  return layout;
+}
+
+// ---------------------------------------------------------------------------
+// Snapshots
+// ---------------------------------------------------------------------------
+
+// File layout (host byte order; the version is bumped on any change):
+//   SnapshotHeader, names key bytes (padded to 4), SnapshotKey[keyCount],
+//   SnapshotChar[charCount]
+constexpr char kSnapshotMagic[8] = {'T', 'Y', 'P', 'R', 'L', 'M', 'A', 'P'};
+constexpr uint32_t kSnapshotVersion = 1;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t keyLimit; // kKeyCount of the writer; Key values must line up
+  uint32_t namesSize;
+  uint32_t keyCount;
+  uint32_t charCount;
+};
+
+struct SnapshotKey {
+  uint32_t key;
+  int32_t code;
+};
+
+struct SnapshotChar {
+  uint32_t cp;
+  int32_t code;
+  uint32_t shift;
+};
+
+constexpr size_t padTo4(size_t n) { return (n + 3) & ~size_t{3}; }
+
+/**
+ * @internal
+ * @brief Snapshot file name for `names` inside `dir`.
+ */
+std::string snapshotPath(const char *dir, const XkbNames &names) {
+  std::string file = names.key();
+  for (char &c : file) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_')
+      c = '_';
+  }
+  return std::string(dir) + "/layout-" + file + ".bin";
+}
+
+} // namespace
+
+std::string XkbNames::key() const {
+  return rules + '/' + model + '/' + layout + '/' + variant + '/' + options;
+}
+
+XkbLayout::~XkbLayout() {
+  if (keymap) {
+    std::lock_guard<std::mutex> lk(shared().xkbMutex);
+    xkb_keymap_unref(keymap);
+  }
+}
+
+XkbNames systemXkbNames() {
+  // Slow sources, resolved at most once per process
+  static const XkbNames fileNames = readDefaultKeyboardFile();
+  static std::once_flag probeOnce;
+  static std::string probedLayout;
+
+  XkbNames names;
+  auto pick = [](std::string &out, const char *env,
+                 const std::string &fallback) {
+    const char *value = std::getenv(env);
+    out = (value && value[0] != '\0') ? value : fallback;
+  };
+  pick(names.rules, "XKB_DEFAULT_RULES", fileNames.rules);
+  pick(names.model, "XKB_DEFAULT_MODEL", fileNames.model);
+  pick(names.layout, "XKB_DEFAULT_LAYOUT", fileNames.layout);
+  pick(names.variant, "XKB_DEFAULT_VARIANT", fileNames.variant);
+  pick(names.options, "XKB_DEFAULT_OPTIONS", fileNames.options);
+
+  if (names.layout.empty()) {
+    std::call_once(probeOnce, [] {
+      probedLayout = querySetxkbmapLayout();
+      if (probedLayout.empty())
+        probedLayout = guessLayoutFromLocale();
+    });
+    names.layout = probedLayout;
+  }
+  // Multiple layouts (e.g. "fr,us"): the first is the active group
+  size_t comma = names.layout.find(',');
+  if (comma != std::string::npos) {
+    names.layout.resize(comma);
+    comma = names.variant.find(',');
+    if (comma != std::string::npos)
+      names.variant.resize(comma);
+  }
+  return names;
+}
+
+Key keysymToKey(uint32_t sym) {
+  // Contiguous ranges: letters (either case), top-row digits, F-keys
+  if (sym >= XKB_KEY_a && sym <= XKB_KEY_z)
+    return static_cast<Key>(static_cast<int>(Key::A) + (sym - XKB_KEY_a));
+  if (sym >= XKB_KEY_A && sym <= XKB_KEY_Z)
+    return static_cast<Key>(static_cast<int>(Key::A) + (sym - XKB_KEY_A));
+  if (sym >= XKB_KEY_0 && sym <= XKB_KEY_9)
+    return static_cast<Key>(static_cast<int>(Key::Num0) + (sym - XKB_KEY_0));
+  if (sym >= XKB_KEY_F1 && sym <= XKB_KEY_F20)
+    return static_cast<Key>(static_cast<int>(Key::F1) + (sym - XKB_KEY_F1));
+  if (sym >= XKB_KEY_KP_0 && sym <= XKB_KEY_KP_9)
+    return static_cast<Key>(static_cast<int>(Key::Numpad0) +
+                            (sym - XKB_KEY_KP_0));
+
+  switch (sym) {
+  case XKB_KEY_Return:
+    return Key::Enter;
+  case XKB_KEY_BackSpace:
+    return Key::Backspace;
+  case XKB_KEY_space:
+    return Key::Space;
+  case XKB_KEY_Tab:
+    return Key::Tab;
+  case XKB_KEY_Escape:
+    return Key::Escape;
+  case XKB_KEY_Left:
+    return Key::Left;
+  case XKB_KEY_Right:
+    return Key::Right;
+  case XKB_KEY_Up:
+    return Key::Up;
+  case XKB_KEY_Down:
+    return Key::Down;
+  case XKB_KEY_Home:
+    return Key::Home;
+  case XKB_KEY_End:
+    return Key::End;
+  case XKB_KEY_Page_Up:
+    return Key::PageUp;
+  case XKB_KEY_Page_Down:
+    return Key::PageDown;
+  case XKB_KEY_Delete:
+    return Key::Delete;
+  case XKB_KEY_Insert:
+    return Key::Insert;
+  // Modifiers
+  case XKB_KEY_Shift_L:
+    return Key::ShiftLeft;
+  case XKB_KEY_Shift_R:
+    return Key::ShiftRight;
+  case XKB_KEY_Control_L:
+    return Key::CtrlLeft;
+  case XKB_KEY_Control_R:
+    return Key::CtrlRight;
+  case XKB_KEY_Alt_L:
+    return Key::AltLeft;
+  case XKB_KEY_Alt_R:
+    return Key::AltRight;
+  case XKB_KEY_Super_L:
+    return Key::SuperLeft;
+  case XKB_KEY_Super_R:
+    return Key::SuperRight;
+  case XKB_KEY_Caps_Lock:
+    return Key::CapsLock;
+  case XKB_KEY_Num_Lock:
+    return Key::NumLock;
+  // Numpad operators
+  case XKB_KEY_KP_Divide:
+    return Key::NumpadDivide;
+  case XKB_KEY_KP_Multiply:
+    return Key::NumpadMultiply;
+  case XKB_KEY_KP_Subtract:
+    return Key::NumpadMinus;
+  case XKB_KEY_KP_Add:
+    return Key::NumpadPlus;
+  case XKB_KEY_KP_Enter:
+    return Key::NumpadEnter;
+  case XKB_KEY_KP_Decimal:
+    return Key::NumpadDecimal;
+  // Common punctuation
+  case XKB_KEY_comma:
+    return Key::Comma;
+  case XKB_KEY_period:
+    return Key::Period;
+  case XKB_KEY_slash:
+    return Key::Slash;
+  case XKB_KEY_backslash:
+    return Key::Backslash;
+  case XKB_KEY_semicolon:
+    return Key::Semicolon;
+  case XKB_KEY_apostrophe:
+    return Key::Apostrophe;
+  case XKB_KEY_minus:
+    return Key::Minus;
+  case XKB_KEY_equal:
+    return Key::Equal;
+  case XKB_KEY_grave:
+    return Key::Grave;
+  case XKB_KEY_bracketleft:
+    return Key::LeftBracket;
+  case XKB_KEY_bracketright:
+    return Key::RightBracket;
+  default:
+    break;
+  }
+
+  // Best effort for the rest (navigation keypad, media keys, ...): the
+  // keysym name through stringToKey()
+  char name[64] = {0};
+  if (xkb_keysym_get_name(sym, name, sizeof(name)) > 0)
+    return stringToKey(name);
+  return Key::Unknown;
+}
+
+std::shared_ptr<const XkbLayout> acquireXkbLayout(const XkbNames &names,
+                                                  bool needKeymap) {
+  XkbShared &s = shared();
+  const std::string key = names.key();
+  std::lock_guard<std::mutex> lk(s.cacheMutex);
+
+  auto it = s.layouts.find(key);
+  if (it != s.layouts.end() && (!needKeymap || it->second->keymap))
+    return it->second;
+
+  const char *dir = std::getenv("TYPR_IO_LAYOUT_CACHE_DIR");
+  const bool useSnapshots = dir && dir[0] != '\0';
+  if (!needKeymap && it == s.layouts.end() && useSnapshots) {
+    if (auto loaded = loadXkbLayoutSnapshot(snapshotPath(dir, names), names)) {
+      TYPR_IO_LOG_DEBUG("xkb layout: loaded snapshot for '%s'", key.c_str());
+      s.layouts[key] = loaded;
+      return loaded;
+    }
+  }
+
+  auto layout = compileLayout(names);
+  TYPR_IO_LOG_DEBUG("xkb layout: compiled '%s' (%zu keys, %zu chars)",
+                    key.c_str(), layout->keys.size(), layout->chars.size());
+  if (layout->keymap && useSnapshots)
+    saveXkbLayoutSnapshot(*layout, snapshotPath(dir, names));
+  s.layouts[key] = layout;
+  return layout;
+}
+
+void clearXkbLayoutCache() {
+  XkbShared &s = shared();
+  std::lock_guard<std::mutex> lk(s.cacheMutex);
+  s.layouts.clear();
+}
+
+struct xkb_state *newXkbState(const XkbLayout &layout) {
+  if (!layout.keymap)
+    return nullptr;
+  std::lock_guard<std::mutex> lk(shared().xkbMutex);
+  return xkb_state_new(layout.keymap);
+}
+
+void freeXkbState(struct xkb_state *state) {
+  if (!state)
+    return;
+  std::lock_guard<std::mutex> lk(shared().xkbMutex);
+  xkb_state_unref(state);
+}
+
+bool saveXkbLayoutSnapshot(const XkbLayout &layout, const std::string &path) {
+  const std::string key = layout.names.key();
+  std::vector<SnapshotKey> keys;
+  keys.reserve(layout.keys.size());
+  layout.keys.forEach([&keys](Key k, int code) {
+    keys.push_back({static_cast<uint32_t>(k), code});
+  });
+  std::vector<SnapshotChar> chars;
+  chars.reserve(layout.chars.size());
+  layout.chars.forEach([&chars](char32_t cp, const CharKey &ck) {
+    chars.push_back({static_cast<uint32_t>(cp), ck.code, ck.shift ? 1u : 0u});
+  });
+
+  SnapshotHeader header{};
+  std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+  header.version = kSnapshotVersion;
+  header.keyLimit = static_cast<uint32_t>(kKeyCount);
+  header.namesSize = static_cast<uint32_t>(key.size());
+  header.keyCount = static_cast<uint32_t>(keys.size());
+  header.charCount = static_cast<uint32_t>(chars.size());
+
+  std::vector<char> buf(sizeof(header) + padTo4(key.size()) +
+                        keys.size() * sizeof(SnapshotKey) +
+                        chars.size() * sizeof(SnapshotChar));
+  char *p = buf.data();
+  std::memcpy(p, &header, sizeof(header));
+  p += sizeof(header);
+  std::memcpy(p, key.data(), key.size());
+  p += padTo4(key.size());
+  if (!keys.empty())
+    std::memcpy(p, keys.data(), keys.size() * sizeof(SnapshotKey));
+  p += keys.size() * sizeof(SnapshotKey);
+  if (!chars.empty())
+    std::memcpy(p, chars.data(), chars.size() * sizeof(SnapshotChar));
+
+  // Write a private temp file and rename it into place so concurrent
+  // readers only ever map a complete snapshot.
+  const std::string tmp = path + ".tmp." + std::to_string(getpid());
+  FILE *f = std::fopen(tmp.c_str(), "wb");
+  if (!f) {
+    TYPR_IO_LOG_DEBUG("xkb layout: cannot write snapshot %s: %s", tmp.c_str(),
+                      std::strerror(errno));
+    return false;
+  }
+  const bool written = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+  const bool closed = std::fclose(f) == 0;
+  if (!written || !closed || std::rename(tmp.c_str(), path.c_str()) != 0) {
+    TYPR_IO_LOG_DEBUG("xkb layout: failed to store snapshot %s", path.c_str());
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<XkbLayout> loadXkbLayoutSnapshot(const std::string &path,
+                                                 const XkbNames &names) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+  struct stat st{};
+  if (fstat(fd, &st) != 0 ||
+      st.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+    close(fd);
+    return nullptr;
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return nullptr;
+
+  std::shared_ptr<XkbLayout> layout;
+  const char *base = static_cast<const char *>(map);
+  SnapshotHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  const std::string key = names.key();
+  const size_t keysOffset = sizeof(header) + padTo4(header.namesSize);
+  const size_t charsOffset =
+      keysOffset + size_t{header.keyCount} * sizeof(SnapshotKey);
+  const size_t expected =
+      charsOffset + size_t{header.charCount} * sizeof(SnapshotChar);
+
+  if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) == 0 &&
+      header.version == kSnapshotVersion && header.keyLimit == kKeyCount &&
+      header.namesSize == key.size() && expected == size &&
+      std::memcmp(base + sizeof(header), key.data(), key.size()) == 0) {
+    layout = std::make_shared<XkbLayout>();
+    layout->names = names;
+    for (uint32_t i = 0; i < header.keyCount; ++i) {
+      SnapshotKey e;
+      std::memcpy(&e, base + keysOffset + i * sizeof(e), sizeof(e));
+      if (e.key < kKeyCount && e.code >= 0) {
+        layout->keys.insert(static_cast<Key>(e.key), e.code);
+        layout->codes.insert(static_cast<std::size_t>(e.code),
+                             static_cast<Key>(e.key));
+      }
+    }
+    for (uint32_t i = 0; i < header.charCount; ++i) {
+      SnapshotChar e;
+      std::memcpy(&e, base + charsOffset + i * sizeof(e), sizeof(e));
+      if (e.cp <= 0x10FFFF)
+        layout->chars.insert(static_cast<char32_t>(e.cp),
+                             {e.code, e.shift != 0});
+    }
+  } else {
+    TYPR_IO_LOG_DEBUG("xkb layout: ignoring stale or invalid snapshot %s",
+                      path.c_str());
+  }
+  munmap(map, size);
+  return layout;
+}
+
+} // namespace typr::io::detail
@@ -0,0 +1,193 @@
+#pragma once
+
+/**
+ * @file xkb_layout.hpp
+ * @brief Internal process-wide cache of compiled xkb layouts (Linux).
+ *
+ * Detecting the active layout (which may shell out to `setxkbmap`),
+ * compiling an xkb keymap and scanning it into reverse lookup tables costs
+ * tens of milliseconds. Every Sender and Listener in a process needs the same
+ * result, so it is computed once per set of RMLVO names and shared through a
+ * reference-counted, immutable `XkbLayout`.
+ *
+ * When `TYPR_IO_LAYOUT_CACHE_DIR` is set, the Sender tables are additionally
+ * snapshotted to `<dir>/layout-<names>.bin` and later processes mmap the
+ * snapshot instead of compiling the keymap at all. Delete the directory to
+ * invalidate it after changing the system layout.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "common/key_table.hpp"
+
+struct xkb_keymap;
+struct xkb_state;
+
+namespace typr::io::detail {
+
+/**
+ * @internal
+ * @brief xkb rule names (RMLVO); empty fields use the xkb defaults.
+ */
+struct XkbNames {
+  std::string rules;
+  std::string model;
+  std::string layout;
+  std::string variant;
+  std::string options;
+
+  /**
+   * @internal
+   * @brief Stable cache key, e.g. "evdev/pc105/fr/oss/".
+   */
+  [[nodiscard]] std::string key() const;
+
+  bool operator==(const XkbNames &) const = default;
+};
+
+/**
+ * @internal
+ * @brief Evdev keycode producing a character, and whether Shift is needed.
+ */
+struct CharKey {
+  int code{-1};
+  bool shift{false};
+};
+
+/**
+ * @internal
+ * @brief Keymap modifier bits for the `Modifier` flags.
+ *
+ * Resolved once per keymap so a listener can turn one
+ * `xkb_state_serialize_mods()` result into a `Modifier` with mask tests
+ * instead of a name lookup per modifier and event. A modifier the keymap
+ * does not define keeps a zero mask and never matches.
+ */
+struct XkbModMasks {
+  uint32_t shift{0};
+  uint32_t ctrl{0};
+  uint32_t alt{0};
+  uint32_t super{0};
+  uint32_t capsLock{0};
+
+  /**
+   * @internal
+   * @brief `Modifier` flags active in a serialized xkb modifier mask.
+   */
+  [[nodiscard]] Modifier toModifier(uint32_t active) const noexcept {
+    Modifier mods = Modifier::None;
+    if (active & shift)
+      mods |= Modifier::Shift;
+    if (active & ctrl)
+      mods |= Modifier::Ctrl;
+    if (active & alt)
+      mods |= Modifier::Alt;
+    if (active & super)
+      mods |= Modifier::Super;
+    if (active & capsLock)
+      mods |= Modifier::CapsLock;
+    return mods;
+  }
+};
+
+/// Evdev keycodes covered by `XkbLayout::codes` (`KEY_CNT`).
+inline constexpr std::size_t kEvdevCodeCount = 0x300;
+
+/**
+ * @internal
+ * @brief One compiled layout, shared read-only by every Sender / Listener.
+ *
+ * `keymap` is null when the layout was loaded from an on-disk snapshot or
+ * when compilation failed; the tables then hold the snapshot contents or the
+ * layout-independent fallback keycodes respectively.
+ *
+ * `codes` is built in the same keymap scan as `keys`, so the Listener
+ * resolves the `Key` of an evdev event with one indexed load. It has an
+ * entry for every mapped keycode, while `keys` keeps one keycode per `Key`.
+ */
+struct XkbLayout {
+  XkbNames names;
+  struct xkb_keymap *keymap{nullptr};
+  XkbModMasks mods;              ///< Modifier bits of `keymap` (if any).
+  KeyTable<int, -1> keys;        ///< Logical Key -> evdev keycode.
+  CodepointTable<CharKey> chars; ///< Codepoint -> evdev keycode (+ Shift).
+  /// Evdev keycode -> logical Key.
+  CodeKeyTable<kEvdevCodeCount> codes;
+
+  XkbLayout() = default;
+  ~XkbLayout();
+  XkbLayout(const XkbLayout &) = delete;
+  XkbLayout &operator=(const XkbLayout &) = delete;
+};
+
+/**
+ * @internal
+ * @brief Map an xkb keysym to the logical `Key` it stands for.
+ *
+ * The one keysym translation used for every layout table: letters, digits,
+ * function, numpad, modifier, navigation and punctuation keysyms directly,
+ * anything else through its keysym name and `stringToKey()`.
+ */
+Key keysymToKey(uint32_t sym);
+
+/**
+ * @internal
+ * @brief Names of the active system layout.
+ *
+ * `XKB_DEFAULT_*` environment variables are consulted on every call; the
+ * slower fallbacks (`/etc/default/keyboard`, `setxkbmap -query`, locale
+ * heuristics) run once per process.
+ */
+XkbNames systemXkbNames();
+
+/**
+ * @internal
+ * @brief Return the shared layout for `names`, building it on first use.
+ *
+ * @param names Layout to compile.
+ * @param needKeymap Whether the caller needs `keymap` (the Listener does,
+ *        the Sender only uses the tables and accepts a snapshot).
+ * @return Never null; on xkb failure the layout holds the fallback tables.
+ */
+std::shared_ptr<const XkbLayout> acquireXkbLayout(const XkbNames &names,
+                                                  bool needKeymap);
+
+/**
+ * @internal
+ * @brief Drop the cache's own references (tests); layouts still held by a
+ * Sender or Listener stay alive until released.
+ */
+void clearXkbLayoutCache();
+
+/**
+ * @internal
+ * @brief Create / destroy an xkb_state for a shared keymap.
+ *
+ * xkbcommon reference counts are not atomic, so every ref/unref on a shared
+ * keymap goes through these helpers.
+ */
+struct xkb_state *newXkbState(const XkbLayout &layout);
+void freeXkbState(struct xkb_state *state);
+
+/**
+ * @internal
+ * @brief Write the layout tables to `path` (atomically, via rename).
+ */
+bool saveXkbLayoutSnapshot(const XkbLayout &layout, const std::string &path);
+
+/**
+ * @internal
+ * @brief mmap a snapshot written by `saveXkbLayoutSnapshot()`.
+ *
+ * @return The loaded layout, or null if the file is missing, malformed, of
+ *         another format version, or was written for different names.
+ */
+std::shared_ptr<XkbLayout> loadXkbLayoutSnapshot(const std::string &path,
+                                                 const XkbNames &names);
+
+} // namespace typr::io::detail
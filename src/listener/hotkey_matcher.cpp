@@ -0,0 +1,356 @@
+/**
+ * @file hotkey_matcher.cpp
+ * @brief Platform-independent implementation of typr::io::HotkeyMatcher.
+ *
+ * Registrations live in an ordered map guarded by a mutex. The compiled trie
+ * belongs to the thread that feeds events: writers only flag the map dirty,
+ * and the next `feed()` rebuilds the trie under the mutex before matching.
+ * A burst of registrations therefore costs one compilation, and the
+ * steady-state path is a single hash lookup with no locking.
+ */
+
+#include <typr-io/hotkey.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <typr-io/log.hpp>
+
+#include "common/stats_recorder.hpp"
+
+namespace typr::io {
+
+namespace {
+
+// Modifiers that take part in matching; lock states are ignored
+constexpr uint8_t kChordModMask = static_cast<uint8_t>(Modifier::Shift) |
+                                  static_cast<uint8_t>(Modifier::Ctrl) |
+                                  static_cast<uint8_t>(Modifier::Alt) |
+                                  static_cast<uint8_t>(Modifier::Super);
+
+bool isModifierKey(Key key) {
+  switch (key) {
+  case Key::ShiftLeft:
+  case Key::ShiftRight:
+  case Key::CtrlLeft:
+  case Key::CtrlRight:
+  case Key::AltLeft:
+  case Key::AltRight:
+  case Key::SuperLeft:
+  case Key::SuperRight:
+  case Key::CapsLock:
+  case Key::NumLock:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+    s.remove_prefix(1);
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+    s.remove_suffix(1);
+  return s;
+}
+
+std::optional<Modifier> modifierFromName(std::string_view name) {
+  std::string lower(name);
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  if (lower == "ctrl" || lower == "control")
+    return Modifier::Ctrl;
+  if (lower == "shift")
+    return Modifier::Shift;
+  if (lower == "alt" || lower == "option" || lower == "opt")
+    return Modifier::Alt;
+  if (lower == "super" || lower == "cmd" || lower == "command" ||
+      lower == "win" || lower == "meta")
+    return Modifier::Super;
+  return std::nullopt;
+}
+
+} // namespace
+
+/**
+ * @internal
+ * @brief Pimpl for HotkeyMatcher: registrations, compiled trie and the
+ * feeding thread's match state.
+ */
+struct HotkeyMatcher::Impl {
+  struct Registration {
+    std::vector<Chord> sequence;
+    std::shared_ptr<const Handler> handler;
+  };
+
+  struct Node {
+    // Hotkeys completing at this node, in registration order
+    std::vector<std::pair<Id, std::shared_ptr<const Handler>>> handlers;
+    bool hasChildren{false};
+  };
+
+  static uint64_t edgeKey(uint32_t node, Key key, uint8_t mods) {
+    return (static_cast<uint64_t>(node) << 24) |
+           (static_cast<uint64_t>(static_cast<uint16_t>(key)) << 8) | mods;
+  }
+
+  // --- Writer side (any thread, under `mutex`) ---
+  mutable std::mutex mutex;
+  std::map<Id, Registration> registrations;
+  Id nextId{1};
+  std::atomic<bool> dirty{false};
+  std::atomic<uint64_t> stepTimeoutNs{1'000'000'000};
+
+  // --- Feeding thread only ---
+  std::vector<Node> nodes{Node{}}; // nodes[0] is the root
+  std::unordered_map<uint64_t, uint32_t> edges;
+  uint32_t state{0};
+  uint64_t lastStepNs{0};
+
+  Id add(std::span<const Chord> sequence, Handler handler) {
+    if (sequence.empty())
+      return 0;
+    for (const Chord &chord : sequence)
+      if (chord.key == Key::Unknown || isModifierKey(chord.key))
+        return 0;
+
+    Registration reg;
+    reg.sequence.reserve(sequence.size());
+    for (const Chord &chord : sequence)
+      reg.sequence.push_back(Chord{
+          static_cast<Modifier>(static_cast<uint8_t>(chord.mods) &
+                                kChordModMask),
+          chord.key});
+    reg.handler = std::make_shared<const Handler>(std::move(handler));
+
+    std::lock_guard<std::mutex> lk(mutex);
+    Id id = nextId++;
+    if (nextId == 0)
+      nextId = 1;
+    registrations.emplace(id, std::move(reg));
+    dirty.store(true, std::memory_order_release);
+    return id;
+  }
+
+  bool remove(Id id) {
+    std::lock_guard<std::mutex> lk(mutex);
+    if (registrations.erase(id) == 0)
+      return false;
+    dirty.store(true, std::memory_order_release);
+    return true;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lk(mutex);
+    registrations.clear();
+    dirty.store(true, std::memory_order_release);
+  }
+
+  /**
+   * @internal
+   * @brief Rebuild the trie from the registrations (feeding thread).
+   */
+  void compile() {
+    std::lock_guard<std::mutex> lk(mutex);
+    dirty.store(false, std::memory_order_relaxed);
+
+    std::size_t chords = 0;
+    for (const auto &[id, reg] : registrations)
+      chords += reg.sequence.size();
+
+    nodes.assign(1, Node{});
+    nodes.reserve(chords + 1);
+    edges.clear();
+    edges.reserve(chords);
+    for (const auto &[id, reg] : registrations) {
+      uint32_t node = 0;
+      for (const Chord &chord : reg.sequence) {
+        const auto [it, inserted] = edges.try_emplace(
+            edgeKey(node, chord.key, static_cast<uint8_t>(chord.mods)),
+            static_cast<uint32_t>(nodes.size()));
+        if (inserted) {
+          nodes[node].hasChildren = true;
+          nodes.emplace_back();
+        }
+        node = it->second;
+      }
+      nodes[node].handlers.emplace_back(id, reg.handler);
+    }
+    // Node indices changed; a sequence in progress cannot carry over
+    state = 0;
+    TYPR_IO_LOG_DEBUG("HotkeyMatcher: compiled %zu hotkeys into %zu nodes",
+                      registrations.size(), nodes.size());
+  }
+
+  const uint32_t *step(uint32_t from, Key key, uint8_t mods) const {
+    auto it = edges.find(edgeKey(from, key, mods));
+    return it != edges.end() ? &it->second : nullptr;
+  }
+
+  bool feed(const Listener::Event &event) {
+    if (!event.pressed || isModifierKey(event.key))
+      return false;
+    if (dirty.load(std::memory_order_acquire))
+      compile();
+
+    const uint64_t now =
+        event.timestampNs ? event.timestampNs : detail::steadyNowNs();
+    const uint64_t timeout = stepTimeoutNs.load(std::memory_order_relaxed);
+    if (state != 0 && timeout != 0 && now - lastStepNs > timeout)
+      state = 0;
+
+    const uint8_t mods = static_cast<uint8_t>(event.mods) & kChordModMask;
+    const uint32_t *next = step(state, event.key, mods);
+    if (!next && state != 0) {
+      // Not a continuation: the press may start another hotkey
+      state = 0;
+      next = step(0, event.key, mods);
+    }
+    if (!next)
+      return false;
+
+    const uint32_t reached = *next;
+    state = nodes[reached].hasChildren ? reached : 0;
+    lastStepNs = now;
+
+    // Handlers may register or remove hotkeys; that only marks the map
+    // dirty, so the node stays valid while we iterate.
+    const Node &node = nodes[reached];
+    for (const auto &[id, handler] : node.handlers) {
+      if (*handler)
+        (*handler)(id);
+    }
+    return !node.handlers.empty();
+  }
+};
+
+HotkeyMatcher::HotkeyMatcher() : m_impl(std::make_unique<Impl>()) {}
+HotkeyMatcher::~HotkeyMatcher() = default;
+HotkeyMatcher::HotkeyMatcher(HotkeyMatcher &&) noexcept = default;
+HotkeyMatcher &HotkeyMatcher::operator=(HotkeyMatcher &&) noexcept = default;
+
+HotkeyMatcher::Id HotkeyMatcher::add(std::span<const Chord> sequence,
+                                     Handler handler) {
+  return m_impl ? m_impl->add(sequence, std::move(handler)) : 0;
+}
+
+HotkeyMatcher::Id HotkeyMatcher::add(Chord chord, Handler handler) {
+  return add(std::span<const Chord>(&chord, 1), std::move(handler));
+}
+
+HotkeyMatcher::Id HotkeyMatcher::add(std::string_view spec, Handler handler) {
+  auto sequence = parse(spec);
+  if (!sequence) {
+    TYPR_IO_LOG_WARN("HotkeyMatcher: cannot parse hotkey '%.*s'",
+                     static_cast<int>(spec.size()), spec.data());
+    return 0;
+  }
+  return add(std::span<const Chord>(*sequence), std::move(handler));
+}
+
+bool HotkeyMatcher::remove(Id id) { return m_impl && m_impl->remove(id); }
+
+void HotkeyMatcher::clear() {
+  if (m_impl)
+    m_impl->clear();
+}
+
+std::size_t HotkeyMatcher::size() const {
+  if (!m_impl)
+    return 0;
+  std::lock_guard<std::mutex> lk(m_impl->mutex);
+  return m_impl->registrations.size();
+}
+
+void HotkeyMatcher::setStepTimeout(std::chrono::milliseconds timeout) {
+  if (!m_impl)
+    return;
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::max(timeout, std::chrono::milliseconds::zero()))
+                      .count();
+  m_impl->stepTimeoutNs.store(static_cast<uint64_t>(ns),
+                              std::memory_order_relaxed);
+}
+
+std::chrono::milliseconds HotkeyMatcher::stepTimeout() const {
+  if (!m_impl)
+    return std::chrono::milliseconds::zero();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::nanoseconds(
+          m_impl->stepTimeoutNs.load(std::memory_order_relaxed)));
+}
+
+bool HotkeyMatcher::feed(const Listener::Event &event) {
+  return m_impl && m_impl->feed(event);
+}
+
+void HotkeyMatcher::reset() {
+  if (m_impl)
+    m_impl->state = 0;
+}
+
+bool HotkeyMatcher::attach(Listener &listener,
+                           Listener::EventCallback forward) {
+  // Matching state belongs to one feeding thread
+  if (!m_impl || listener.concurrentCallbacks())
+    return false;
+  // The callback holds the Impl, which stays put when the matcher moves
+  Impl *impl = m_impl.get();
+  ListenerFilter filter;
+  if (!forward) {
+    filter.releases = false;
+    filter.needCodepoint = false;
+  }
+  return listener.start(
+      Listener::EventCallback(
+          [impl, forward = std::move(forward)](const Listener::Event &event) {
+            impl->feed(event);
+            if (forward)
+              forward(event);
+          }),
+      filter);
+}
+
+std::optional<std::vector<HotkeyMatcher::Chord>>
+HotkeyMatcher::parse(std::string_view spec) {
+  std::vector<Chord> sequence;
+  for (;;) {
+    const std::size_t comma = spec.find(',');
+    std::string_view chordText = trim(spec.substr(0, comma));
+    if (chordText.empty())
+      return std::nullopt;
+
+    Chord chord;
+    for (;;) {
+      const std::size_t plus = chordText.find('+');
+      const std::string_view name = trim(chordText.substr(0, plus));
+      if (name.empty())
+        return std::nullopt;
+      if (plus == std::string_view::npos) {
+        chord.key = stringToKey(name);
+        if (chord.key == Key::Unknown || isModifierKey(chord.key))
+          return std::nullopt;
+        break;
+      }
+      const auto mod = modifierFromName(name);
+      if (!mod)
+        return std::nullopt;
+      chord.mods |= *mod;
+      chordText.remove_prefix(plus + 1);
+    }
+    sequence.push_back(chord);
+
+    if (comma == std::string_view::npos)
+      return sequence;
+    spec.remove_prefix(comma + 1);
+  }
+}
+
+} // namespace typr::io
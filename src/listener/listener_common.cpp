@@ -0,0 +1,65 @@
+/**
+ * @file listener_common.cpp
+ * @brief Platform-independent parts of typr::io::Listener.
+ *
+ * Each backend implements `start(EventCallback, const ListenerFilter &)`
+ * and applies the filter on its platform thread; this file layers the
+ * classic four-argument callback and queued delivery on top of it.
+ * `startQueued()` starts the backend with a callback that only appends the
+ * event to a single-producer ring; consumers drain the ring in batches with
+ * `poll()`.
+ */
+
+#include "listener/listener_queue.hpp"
+
+#include <mutex>
+#include <utility>
+
+#include <typr-io/log.hpp>
+
+namespace typr::io {
+
+bool Listener::start(Callback cb, const ListenerFilter &filter) {
+  if (!cb)
+    return start(EventCallback{}, filter);
+  return start(EventCallback{[cb = std::move(cb)](const Event &event) {
+                 cb(event.codepoint, event.key, event.mods, event.pressed);
+               }},
+               filter);
+}
+
+bool Listener::startQueued(std::size_t capacity,
+                           const ListenerFilter &filter) {
+  if (!m_impl || isListening())
+    return false;
+  // The ring has a single producer
+  if (concurrentCallbacks()) {
+    TYPR_IO_LOG_ERROR("Listener::startQueued: callbacks are parallel; "
+                      "queued delivery needs serialized callbacks");
+    return false;
+  }
+
+  // The backend thread is stopped here, so the previous queue (if any) has
+  // no producer and can be replaced.
+  m_queue = std::make_unique<Queue>(capacity);
+  Queue *queue = m_queue.get();
+  bool ok = start(
+      EventCallback{[queue](const Event &event) { queue->push(event); }},
+      filter);
+  TYPR_IO_LOG_DEBUG("Listener::startQueued(capacity=%zu) result=%u",
+                    queue->ring.capacity(), static_cast<unsigned>(ok));
+  return ok;
+}
+
+std::size_t Listener::poll(std::span<Event> out) {
+  if (!m_queue || out.empty())
+    return 0;
+  std::lock_guard<std::mutex> lk(m_queue->consumerMutex);
+  return m_queue->ring.popBulk(out.data(), out.size());
+}
+
+uint64_t Listener::droppedEvents() const {
+  return m_queue ? m_queue->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace typr::io
@@ -6,30 +6,42 @@
  * low-level input events into logical keys and Unicode codepoints using
  * xkbcommon. The implementation is responsible for device discovery,
  * event translation, and invoking the public Listener callback on observed
- * events. This file is only compiled on Linux targets.
+ * events. Every udev seat and device node from `ListenerOptions` is served
+ * by its own worker thread and libinput context. This file is only
+ * compiled on Linux targets.
  */
 #if defined(__linux__)
 
 #include <typr-io/listener.hpp>
 #include <typr-io/log.hpp>
 
+#include "common/rcu_cell.hpp"
+#include "common/stats_recorder.hpp"
+#include "common/xkb_layout.hpp"
+#include "listener/listener_queue.hpp"
+
 #include <algorithm>
 #include <atomic>
 #include <cctype>
 #include <cerrno>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <array>
 #include <fcntl.h>
-#include <fstream>
 #include <libinput.h>
 #include <libudev.h>
+#include <linux/input-event-codes.h>
+#include <memory>
 #include <mutex>
 #include <poll.h>
 #include <string>
+#include <sys/eventfd.h>
 #include <thread>
 #include <unistd.h>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <xkbcommon/xkbcommon-keysyms.h>
 #include <xkbcommon/xkbcommon.h>
 
@@ -81,6 +93,9 @@ static const struct libinput_interface kInterface = {
     .close_restricted = close_restricted,
 };
 
+/// Retry interval for a `ListenerOptions::devices` node that is missing.
+constexpr int kReopenIntervalMs = 500;
+
 } // namespace
 
 /**
@@ -88,593 +103,603 @@ static const struct libinput_interface kInterface = {
  * @brief PIMPL implementation for `typr::io::Listener`.
  *
  * This structure encapsulates the platform-specific state required to
- * implement the Listener, including the worker thread that polls libinput,
- * internal synchronization primitives and the callback forwarding bridge.
+ * implement the Listener: one `Worker` per seat or device node selected by
+ * `ListenerOptions`, and the callback, filter, statistics and device
+ * registry the workers share.
  *
  * These members and methods are internal implementation details and are not
  * part of the public API; they may change without notice.
  */
 struct Listener::Impl {
-  Impl() = default;
+  explicit Impl(const ListenerOptions &opts) : options(opts) {
+    if (options.seats.empty() && options.devices.empty())
+      options.seats.emplace_back("seat0");
+  }
   ~Impl() { stop(); }
 
   /**
    * @internal
-   * @brief Start the implementation worker thread and store the callback.
+   * @brief One libinput context (a udev seat or a single device node), its
+   * xkb state and the thread polling it.
    *
-   * The provided callback is stored under `cbMutex` to avoid races with the
-   * worker thread. This method starts a background thread which performs
-   * device discovery and event processing; it waits briefly for the worker to
-   * report readiness and returns whether initialization succeeded.
-   *
-   * @param cb Callback that will be invoked for each observed event.
-   * @return true on success and when the worker becomes ready.
+   * Workers never wait on each other: device enumeration, hotplug and a
+   * missing device node only ever block the worker that owns them.
    */
-  bool start(Callback cb) {
-    std::lock_guard<std::mutex> lk(cbMutex);
-    if (running.load())
-      return false;
-
-    callback = std::move(cb);
-    running.store(true);
-    ready.store(false);
-    worker = std::thread(&Impl::threadMain, this);
+  struct Worker {
+    enum State : int { kStarting, kReady, kFailed };
 
-    // Wait (up to ~200ms) for initialization
-    for (int i = 0; i < 40; ++i) {
-      if (!running.load())
-        return false;
-      if (ready.load())
-        return true;
-      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    Worker(Impl &impl, std::string seatName, std::string devicePath)
+        : owner(impl), seat(std::move(seatName)), path(std::move(devicePath)) {
     }
-    bool ok = ready.load();
-    TYPR_IO_LOG_DEBUG("Listener (Linux/libinput): start result=%u",
-                      static_cast<unsigned>(ok));
-    return ok;
-  }
-
-  /**
-   * @internal
-   * @brief Stop the worker thread and clear the stored callback.
-   *
-   * Safe to call from any thread. If a worker is running it will be asked to
-   * stop and joined; the callback pointer is cleared under `cbMutex` to prevent
-   * further invocations.
-   */
-  void stop() {
-    if (!running.load())
-      return;
 
-    running.store(false);
-    if (worker.joinable())
-      worker.join();
-
-    // Clear callback under lock
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      callback = nullptr;
+    /// Seat name or device node, for logs and `ListenerDevice::seat`.
+    const std::string &label() const { return path.empty() ? seat : path; }
+
+    /**
+     * @internal
+     * @brief Worker thread main: initialize, poll until stopped, clean up.
+     */
+    void run() {
+      if (!init()) {
+        cleanup();
+        state.store(kFailed);
+        owner.workerExited();
+        return;
+      }
+      state.store(kReady);
+      TYPR_IO_LOG_INFO("Listener (Linux/libinput): monitoring %s",
+                       label().c_str());
+      loop();
+      cleanup();
+      owner.workerExited();
     }
 
-    TYPR_IO_LOG_INFO("Listener (Linux/libinput): stopped");
-  }
-
-  /**
-   * @internal
-   * @brief Query whether the implementation's worker thread is active.
-   * @return true when the worker thread is running.
-   */
-  bool isRunning() const { return running.load(); }
+    /**
+     * @internal
+     * @brief Create the libinput context and xkb state.
+     *
+     * A device node that cannot be opened yet does not fail the worker; it
+     * is retried from `loop()` until it appears.
+     */
+    bool init() {
+      if (path.empty()) {
+        udev = udev_new();
+        if (!udev) {
+          TYPR_IO_LOG_ERROR("Listener (Linux/libinput): udev_new() failed");
+          return false;
+        }
+        li = libinput_udev_create_context(&kInterface, nullptr, udev);
+        if (!li) {
+          TYPR_IO_LOG_ERROR("Listener (Linux/libinput): "
+                            "libinput_udev_create_context() failed");
+          return false;
+        }
+        if (libinput_udev_assign_seat(li, seat.c_str()) < 0) {
+          TYPR_IO_LOG_ERROR(
+              "Listener (Linux/libinput): libinput_udev_assign_seat(%s) "
+              "failed. Are you in the 'input' group or running with "
+              "necessary privileges?",
+              seat.c_str());
+          return false;
+        }
+      } else {
+        li = libinput_path_create_context(&kInterface, nullptr);
+        if (!li) {
+          TYPR_IO_LOG_ERROR("Listener (Linux/libinput): "
+                            "libinput_path_create_context() failed");
+          return false;
+        }
+        if (!addPathDevice())
+          TYPR_IO_LOG_WARN("Listener (Linux/libinput): cannot open %s yet; "
+                           "retrying every %d ms",
+                           path.c_str(), kReopenIntervalMs);
+      }
 
-private:
-  /**
-   * @internal
-   * @brief Worker thread main loop.
-   *
-   * Initializes udev/libinput/xkb state, performs device enumeration, and
-   * enters the event loop. Events are translated into logical `Key` values and
-   * Unicode codepoints which are forwarded to the user-provided callback.
-   *
-   * This method runs on a dedicated background thread and must not be invoked
-   * directly by user code.
-   */
-  void threadMain() {
-    struct udev *udev = udev_new();
-    if (!udev) {
-      TYPR_IO_LOG_ERROR("Listener (Linux/libinput): udev_new() failed");
-      running.store(false);
-      ready.store(false);
-      return;
+      xkbState = detail::newXkbState(*owner.xkbLayout);
+      if (!xkbState) {
+        TYPR_IO_LOG_ERROR("Listener (Linux/libinput): no usable xkb keymap "
+                          "for '%s'",
+                          owner.xkbLayout->names.key().c_str());
+        return false;
+      }
+      refreshModifiers();
+      return true;
     }
 
-    li = libinput_udev_create_context(&kInterface, nullptr, udev);
-    if (!li) {
-      TYPR_IO_LOG_ERROR(
-          "Listener (Linux/libinput): libinput_udev_create_context() failed");
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
-      return;
+    void cleanup() {
+      detail::freeXkbState(xkbState);
+      xkbState = nullptr;
+      pathDevice = nullptr;
+      if (li) {
+        libinput_unref(li);
+        li = nullptr;
+      }
+      if (udev) {
+        udev_unref(udev);
+        udev = nullptr;
+      }
     }
 
-    if (libinput_udev_assign_seat(li, "seat0") < 0) {
-      TYPR_IO_LOG_ERROR(
-          "Listener (Linux/libinput): libinput_udev_assign_seat() failed. "
-          "Are you in the 'input' group or running with necessary privileges?");
-      libinput_unref(li);
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
-      return;
+    bool addPathDevice() {
+      pathDevice = libinput_path_add_device(li, path.c_str());
+      return pathDevice != nullptr;
     }
 
-    // Initialize xkbcommon context / keymap / state for translating keycodes
-    xkbCtx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-    if (!xkbCtx) {
-      TYPR_IO_LOG_ERROR("Listener (Linux/libinput): xkb_context_new() failed");
-      libinput_unref(li);
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
-      return;
-    }
-    // Try to initialize XKB keymap names from environment variables or a
-    // system configuration file (/etc/default/keyboard). This helps ensure the
-    // keymap used for translating evdev keycodes matches the user's actual
-    // layout (e.g. non-QWERTY layouts).
-    std::string rulesStr, modelStr, layoutStr, variantStr, optionsStr;
-
-    // First consult common environment variables that various
-    // systems/compositors set for XKB.
-    if (const char *env = std::getenv("XKB_DEFAULT_RULES"))
-      rulesStr = env;
-    if (const char *env = std::getenv("XKB_DEFAULT_MODEL"))
-      modelStr = env;
-    if (const char *env = std::getenv("XKB_DEFAULT_LAYOUT"))
-      layoutStr = env;
-    if (const char *env = std::getenv("XKB_DEFAULT_VARIANT"))
-      variantStr = env;
-    if (const char *env = std::getenv("XKB_DEFAULT_OPTIONS"))
-      optionsStr = env;
-
-    // Fallback: parse Debian/Ubuntu-style /etc/default/keyboard if some pieces
-    // of information are missing. This file often contains the active layout
-    // information for local consoles and can supplement the environment.
-    if (rulesStr.empty() || modelStr.empty() || layoutStr.empty() ||
-        variantStr.empty() || optionsStr.empty()) {
-      std::ifstream f("/etc/default/keyboard");
-      if (f) {
-        std::string line;
-        while (std::getline(f, line)) {
-          // Strip comments and surrounding whitespace.
-          size_t comment = line.find('#');
-          if (comment != std::string::npos)
-            line = line.substr(0, comment);
-          auto trim = [](std::string &s) {
-            const char *ws = " \t\r\n";
-            size_t a = s.find_first_not_of(ws);
-            if (a == std::string::npos) {
-              s.clear();
-              return;
-            }
-            size_t b = s.find_last_not_of(ws);
-            s = s.substr(a, b - a + 1);
-          };
-          trim(line);
-          if (line.empty())
-            continue;
-          size_t eq = line.find('=');
-          if (eq == std::string::npos)
+    /**
+     * @internal
+     * @brief Block until libinput has events or stop() signals `wakeFd`.
+     *
+     * There is no timeout, so an idle worker never wakes up, except while
+     * its device node is missing and is retried every `kReopenIntervalMs`.
+     */
+    void loop() {
+      struct pollfd pfds[2] = {
+          {.fd = libinput_get_fd(li), .events = POLLIN, .revents = 0},
+          {.fd = owner.wakeFd, .events = POLLIN, .revents = 0},
+      };
+
+      // Drain anything queued during device enumeration
+      dispatchEvents();
+
+      while (owner.running.load()) {
+        const bool waitingForDevice = !path.empty() && !pathDevice;
+        int ret = ::poll(pfds, 2, waitingForDevice ? kReopenIntervalMs : -1);
+        if (ret < 0) {
+          if (errno == EINTR)
             continue;
-          std::string key = line.substr(0, eq);
-          std::string val = line.substr(eq + 1);
-          trim(key);
-          trim(val);
-          // Remove surrounding quotes if present.
-          if (val.size() >= 2 && ((val.front() == '\"' && val.back() == '\"') ||
-                                  (val.front() == '\'' && val.back() == '\'')))
-            val = val.substr(1, val.size() - 2);
-          // Normalize key for comparison.
-          std::transform(key.begin(), key.end(), key.begin(),
-                         [](unsigned char c) { return std::toupper(c); });
-          if (key == "XKBRULES" || key == "XKB_DEFAULT_RULES")
-            rulesStr = val;
-          else if (key == "XKBMODEL" || key == "XKB_DEFAULT_MODEL")
-            modelStr = val;
-          else if (key == "XKBLAYOUT" || key == "XKB_DEFAULT_LAYOUT")
-            layoutStr = val;
-          else if (key == "XKBVARIANT" || key == "XKB_DEFAULT_VARIANT")
-            variantStr = val;
-          else if (key == "XKBOPTIONS" || key == "XKB_DEFAULT_OPTIONS")
-            optionsStr = val;
+          TYPR_IO_LOG_ERROR("Listener (Linux/libinput): poll() failed: %s",
+                            std::strerror(errno));
+          break;
         }
-      }
-    }
-    // If layout still missing, try to heuristically guess it from locale
-    // environment variables (LC_ALL, LC_MESSAGES, LANG). This provides a
-    // reasonable fallback on systems where XKB defaults are not available.
-    if (layoutStr.empty()) {
-      const char *localeEnv = std::getenv("LC_ALL");
-      if (!localeEnv)
-        localeEnv = std::getenv("LC_MESSAGES");
-      if (!localeEnv)
-        localeEnv = std::getenv("LANG");
-      if (localeEnv) {
-        std::string locale(localeEnv);
-        // Trim off encoding/variants (e.g. en_US.UTF-8 -> en_US)
-        size_t dot = locale.find('.');
-        if (dot != std::string::npos)
-          locale.resize(dot);
-        size_t at = locale.find('@');
-        if (at != std::string::npos)
-          locale.resize(at);
-        // Split language and region if present (e.g. en_US)
-        std::string lang = locale;
-        std::string region;
-        size_t us = locale.find('_');
-        if (us != std::string::npos) {
-          lang = locale.substr(0, us);
-          region = locale.substr(us + 1);
+        if (ret == 0) {
+          if (addPathDevice()) {
+            TYPR_IO_LOG_INFO("Listener (Linux/libinput): opened %s",
+                             path.c_str());
+            dispatchEvents();
+          }
+          continue;
         }
-        std::transform(lang.begin(), lang.end(), lang.begin(),
-                       [](unsigned char c) { return std::tolower(c); });
-        std::transform(region.begin(), region.end(), region.begin(),
-                       [](unsigned char c) { return std::toupper(c); });
-        // Common heuristics:
-        if (lang == "en") {
-          // Prefer GB for en_GB, otherwise default to US
-          if (region == "GB" || region == "UK")
-            layoutStr = "gb";
-          else
-            layoutStr = "us";
-        } else if (lang == "pt" && region == "BR") {
-          layoutStr = "br";
-        } else if (lang == "da") {
-          layoutStr = "dk"; // Danish xkb uses 'dk'
-        } else if (lang == "sv") {
-          layoutStr = "se"; // Swedish xkb uses 'se'
-        } else if (!lang.empty()) {
-          // Fall back to using the language code as layout (fr, de, es, it,
-          // etc.)
-          layoutStr = lang;
+        if (pfds[1].revents)
+          break;
+        if (pfds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+          TYPR_IO_LOG_ERROR("Listener (Linux/libinput): libinput fd error on "
+                            "%s (revents=0x%x)",
+                            label().c_str(),
+                            static_cast<unsigned>(pfds[0].revents));
+          break;
         }
-        TYPR_IO_LOG_DEBUG("Listener (Linux/libinput): guessed layout from "
-                          "locale: %s",
-                          layoutStr.c_str());
+        if (pfds[0].revents & POLLIN)
+          dispatchEvents();
       }
     }
 
-    struct xkb_rule_names names = {nullptr, nullptr, nullptr, nullptr, nullptr};
-    std::string dbg;
-    if (!rulesStr.empty()) {
-      names.rules = rulesStr.c_str();
-      dbg += "rules=" + rulesStr + " ";
-    }
-    if (!modelStr.empty()) {
-      names.model = modelStr.c_str();
-      dbg += "model=" + modelStr + " ";
-    }
-    if (!layoutStr.empty()) {
-      names.layout = layoutStr.c_str();
-      dbg += "layout=" + layoutStr + " ";
-    }
-    if (!variantStr.empty()) {
-      names.variant = variantStr.c_str();
-      dbg += "variant=" + variantStr + " ";
-    }
-    if (!optionsStr.empty()) {
-      names.options = optionsStr.c_str();
-      dbg += "options=" + optionsStr + " ";
-    }
-    if (!dbg.empty()) {
-      TYPR_IO_LOG_DEBUG("Listener (Linux/libinput): xkb names: %s",
-                        dbg.c_str());
+    /**
+     * @internal
+     * @brief Let libinput read its fd, track hotplugged keyboards and
+     * forward every queued key event.
+     */
+    void dispatchEvents() {
+      libinput_dispatch(li);
+      struct libinput_event *ev;
+      while ((ev = libinput_get_event(li))) {
+        switch (libinput_event_get_type(ev)) {
+        case LIBINPUT_EVENT_KEYBOARD_KEY:
+          handleKeyEvent(libinput_event_get_keyboard_event(ev),
+                         deviceId(libinput_event_get_device(ev)));
+          break;
+        case LIBINPUT_EVENT_DEVICE_ADDED:
+          deviceAdded(libinput_event_get_device(ev));
+          break;
+        case LIBINPUT_EVENT_DEVICE_REMOVED:
+          deviceRemoved(libinput_event_get_device(ev));
+          break;
+        default:
+          break;
+        }
+        libinput_event_destroy(ev);
+      }
     }
 
-    xkbKeymap =
-        xkb_keymap_new_from_names(xkbCtx, &names, XKB_KEYMAP_COMPILE_NO_FLAGS);
-    if (!xkbKeymap) {
-      TYPR_IO_LOG_ERROR(
-          "Listener (Linux/libinput): xkb_keymap_new_from_names() failed");
-      xkb_context_unref(xkbCtx);
-      libinput_unref(li);
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
-      return;
+    static uint16_t deviceId(struct libinput_device *dev) {
+      return dev ? static_cast<uint16_t>(reinterpret_cast<uintptr_t>(
+                       libinput_device_get_user_data(dev)))
+                 : 0;
     }
-    xkbState = xkb_state_new(xkbKeymap);
-    if (!xkbState) {
-      TYPR_IO_LOG_ERROR("Listener (Linux/libinput): xkb_state_new() failed");
-      xkb_keymap_unref(xkbKeymap);
-      xkb_context_unref(xkbCtx);
-      libinput_unref(li);
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
-      return;
+
+    void deviceAdded(struct libinput_device *dev) {
+      if (!dev ||
+          !libinput_device_has_capability(dev, LIBINPUT_DEVICE_CAP_KEYBOARD))
+        return;
+      const char *name = libinput_device_get_name(dev);
+      std::string node =
+          path.empty() ? std::string("/dev/input/") +
+                             libinput_device_get_sysname(dev)
+                       : path;
+      const uint16_t id =
+          owner.registerDevice(name ? name : "", std::move(node), label());
+      // The id rides along as user data, so key events resolve it directly
+      libinput_device_set_user_data(
+          dev, reinterpret_cast<void *>(static_cast<uintptr_t>(id)));
     }
 
-    ready.store(true);
-    TYPR_IO_LOG_INFO("Listener (Linux/libinput): Monitoring started");
-
-    int fd = libinput_get_fd(li);
-    struct pollfd pfd = {.fd = fd, .events = POLLIN, .revents = 0};
-
-    while (running.load()) {
-      int ret = poll(&pfd, 1, 100);
-      if (ret > 0 && (pfd.revents & POLLIN)) {
-        libinput_dispatch(li);
-        struct libinput_event *ev;
-        while ((ev = libinput_get_event(li))) {
-          enum libinput_event_type t = libinput_event_get_type(ev);
-          if (t == LIBINPUT_EVENT_KEYBOARD_KEY) {
-            handleKeyEvent(libinput_event_get_keyboard_event(ev));
-          }
-          libinput_event_destroy(ev);
-        }
+    void deviceRemoved(struct libinput_device *dev) {
+      if (!dev)
+        return;
+      owner.unregisterDevice(deviceId(dev));
+      if (dev == pathDevice) {
+        pathDevice = nullptr;
+        TYPR_IO_LOG_WARN("Listener (Linux/libinput): %s removed; waiting for "
+                         "it to return",
+                         path.c_str());
       }
-      // small sleep if poll timed out or no events - helps on idle loops
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
-    // Cleanup
-    if (xkbState) {
-      xkb_state_unref(xkbState);
-      xkbState = nullptr;
-    }
-    if (xkbKeymap) {
-      xkb_keymap_unref(xkbKeymap);
-      xkbKeymap = nullptr;
-    }
-    if (xkbCtx) {
-      xkb_context_unref(xkbCtx);
-      xkbCtx = nullptr;
+    void handleKeyEvent(struct libinput_event_keyboard *kev, uint16_t device) {
+      if (!kev)
+        return;
+
+      uint32_t keycode = libinput_event_keyboard_get_key(kev);
+      bool pressed = libinput_event_keyboard_get_key_state(kev) ==
+                     LIBINPUT_KEY_STATE_PRESSED;
+
+      // libinput provides evdev keycodes; xkbcommon expects keycodes offset
+      // by 8
+      xkb_keycode_t xkbKey = static_cast<xkb_keycode_t>(keycode + 8);
+
+      // Update xkb state; rejected events must still reach it so the
+      // modifier and lock state stays right for the events that follow. The
+      // Modifier flags only change when the effective mods do.
+      const auto changed = xkb_state_update_key(
+          xkbState, xkbKey, pressed ? XKB_KEY_DOWN : XKB_KEY_UP);
+      if (changed & XKB_STATE_MODS_EFFECTIVE)
+        refreshModifiers();
+
+      // Key from the layout's keycode table, then drop uninteresting keys
+      // before translating
+      const ListenerFilter &filter = owner.filter;
+      const Key mapped = owner.xkbLayout->codes.find(keycode);
+      // The press stashes the codepoint for its release, so the key decides
+      // whether translation is needed and the edge is checked afterwards
+      if (!filter.wantsKey(mapped)) {
+        owner.stats.filtered();
+        return;
+      }
+
+      // Determine the unicode codepoint (best-effort)
+      char32_t codepoint = 0;
+      if (!filter.needCodepoint) {
+        // Consumer only wants keys and modifiers: skip translation
+      } else if (keycode >= pendingCodepoints.size()) {
+        // Outside the evdev key range: no slot to carry the press codepoint
+      } else if (pressed) {
+        // Compute codepoint for this key on press. Only stash printable
+        // characters (non-control). Control characters (e.g.,
+        // Enter/Backspace) should not be delivered as a non-zero cp; they
+        // are handled via Key.
+        char32_t cp = static_cast<char32_t>(
+            xkb_keysym_to_utf32(xkb_state_key_get_one_sym(xkbState, xkbKey)));
+        // Treat as printable if >= 0x20 and not DEL (0x7F). This is a
+        // simple, conservative heuristic that covers typical keyboard input.
+        // Anything else clears the slot so no stale codepoint remains for
+        // this key.
+        pendingCodepoints[keycode] = (cp >= 0x20 && cp != 0x7F) ? cp : 0;
+      } else {
+        // Deliver any codepoint we previously computed at press time for
+        // this key. This ensures callbacks observing only key-release events
+        // still receive the character that was generated when the key was
+        // pressed.
+        codepoint = std::exchange(pendingCodepoints[keycode], 0);
+      }
+      if (!filter.acceptsKey(mapped, pressed)) {
+        owner.stats.filtered();
+        return;
+      }
+
+      const Modifier mods = currentMods;
+      if (!filter.acceptsMods(mods)) {
+        owner.stats.filtered();
+        return;
+      }
+
+      // libinput stamps events with CLOCK_MONOTONIC, which is steady_clock's
+      // clock on Linux, so the timestamp carries over as-is.
+      uint64_t eventNs = libinput_event_keyboard_get_time_usec(kev) * 1000u;
+      if (eventNs == 0)
+        eventNs = detail::steadyNowNs();
+      owner.deliver(Event{codepoint, mapped, mods, pressed, eventNs, device});
+
+      // Debug logging
+      TYPR_IO_LOG_DEBUG("Listener (Linux/libinput) %s: device=%u evdev=%u "
+                        "key=%s cp=%u mods=0x%02x",
+                        pressed ? "press" : "release",
+                        static_cast<unsigned>(device), keycode,
+                        keyToStringView(mapped).data(),
+                        static_cast<unsigned>(codepoint),
+                        static_cast<int>(static_cast<uint8_t>(mods)));
     }
-    if (li) {
-      libinput_unref(li);
-      li = nullptr;
+
+    /**
+     * @internal
+     * @brief Recompute `currentMods` from the effective xkb modifier mask.
+     */
+    void refreshModifiers() {
+      currentMods = owner.xkbLayout->mods.toModifier(
+          xkb_state_serialize_mods(xkbState, XKB_STATE_MODS_EFFECTIVE));
     }
-    udev_unref(udev);
 
-    ready.store(false);
-  }
+    Impl &owner;
+    const std::string seat; // udev seat (udev backend), or empty
+    const std::string path; // device node (path backend), or empty
+    std::thread thread;
+    std::atomic<int> state{kStarting};
+
+    // Worker thread only
+    struct udev *udev = nullptr;
+    struct libinput *li = nullptr;
+    struct libinput_device *pathDevice = nullptr; // null while missing
+    struct xkb_state *xkbState = nullptr;
+    // Modifier flags of this worker's xkb state
+    Modifier currentMods{Modifier::None};
+    // Store unicode codepoints computed at key-press time so they can be
+    // delivered on key-release events (0 = none), indexed by evdev keycode.
+    std::array<char32_t, KEY_CNT> pendingCodepoints{};
+  };
 
-  void handleKeyEvent(struct libinput_event_keyboard *kev) {
-    if (!kev)
-      return;
-
-    uint32_t keycode = libinput_event_keyboard_get_key(kev);
-    bool pressed = libinput_event_keyboard_get_key_state(kev) ==
-                   LIBINPUT_KEY_STATE_PRESSED;
-
-    // libinput provides evdev keycodes; xkbcommon expects keycodes offset by 8
-    xkb_keycode_t xkbKey = static_cast<xkb_keycode_t>(keycode + 8);
-
-    // Update xkb state
-    xkb_state_update_key(xkbState, xkbKey, pressed ? XKB_KEY_DOWN : XKB_KEY_UP);
-
-    // Determine keysym and unicode codepoint (best-effort)
-    xkb_keysym_t sym = xkb_state_key_get_one_sym(xkbState, xkbKey);
-    char32_t codepoint = 0;
-    if (pressed) {
-      // Compute codepoint for this key on press. Only stash printable
-      // characters (non-control). Control characters (e.g., Enter/Backspace)
-      // should not be delivered as a non-zero cp; they are handled via Key.
-      char32_t cp = static_cast<char32_t>(xkb_keysym_to_utf32(sym));
-      // Treat as printable if >= 0x20 and not DEL (0x7F). This is a simple,
-      // conservative heuristic that covers typical keyboard input.
-      if (cp >= 0x20 && cp != 0x7F) {
-        pendingCodepoints[keycode] = cp;
-      } else {
-        // Ensure no stale mapping remains for this key
-        auto it = pendingCodepoints.find(keycode);
-        if (it != pendingCodepoints.end())
-          pendingCodepoints.erase(it);
-      }
-    } else {
-      // Deliver any codepoint we previously computed at press time for this
-      // key. This ensures callbacks observing only key-release events still
-      // receive the character that was generated when the key was pressed.
-      auto it = pendingCodepoints.find(keycode);
-      if (it != pendingCodepoints.end()) {
-        codepoint = it->second;
-        pendingCodepoints.erase(it);
-      } else {
-        codepoint = 0;
+  /**
+   * @internal
+   * @brief Start one worker per seat / device node and store the callback.
+   *
+   * The provided callback is published through an RCU cell so the workers
+   * can read it without locking; `startMutex` serializes start() and
+   * stop(). Waits briefly for every worker to report readiness; if any
+   * fails (or they do not all become ready in time) all are stopped again.
+   *
+   * @param cb Callback that will be invoked for each observed event.
+   * @param eventFilter Events to deliver; installed before the workers start.
+   * @return true when every worker became ready.
+   */
+  bool start(EventCallback cb, const ListenerFilter &eventFilter) {
+    std::lock_guard<std::mutex> lk(startMutex);
+    if (running.load())
+      return false;
+
+    // Reap workers that exited on their own (e.g. after an fd error)
+    joinWorkers();
+
+    if (wakeFd < 0) {
+      wakeFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      if (wakeFd < 0) {
+        TYPR_IO_LOG_ERROR("Listener (Linux/libinput): eventfd() failed: %s",
+                          std::strerror(errno));
+        return false;
       }
     }
 
-    // Map keysym -> Key
-    Key mapped = mapKeysymToKey(sym);
-
-    // Extract modifiers via xkb state
-    Modifier mods = Modifier::None;
-    if (xkb_state_mod_name_is_active(xkbState, XKB_MOD_NAME_SHIFT,
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::Shift;
-    if (xkb_state_mod_name_is_active(xkbState, XKB_MOD_NAME_CTRL,
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::Ctrl;
-    if (xkb_state_mod_name_is_active(xkbState, XKB_MOD_NAME_ALT,
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::Alt;
-    if (xkb_state_mod_name_is_active(xkbState, XKB_MOD_NAME_LOGO,
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::Super;
-    // CapsLock is typically exposed as the "Lock" modifier name
-    if (xkb_state_mod_name_is_active(xkbState, "Lock",
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::CapsLock;
-
-    // Copy/dispatch callback under lock
-    Callback cbCopy;
+    // Translate keycodes with the shared keymap for the system layout
+    // (compiled once per process, see common/xkb_layout.hpp); every worker
+    // only owns its own xkb_state.
+    xkbLayout = detail::acquireXkbLayout(detail::systemXkbNames(), true);
+    TYPR_IO_LOG_DEBUG("Listener (Linux/libinput): xkb names: %s",
+                      xkbLayout->names.key().c_str());
+
+    callback.store(std::move(cb));
+    filter = eventFilter;
+    stats.reset();
     {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      cbCopy = callback;
+      std::lock_guard<std::mutex> dk(devicesMutex);
+      deviceList.clear();
     }
-    if (cbCopy)
-      cbCopy(codepoint, mapped, mods, pressed);
+    for (const std::string &seat : options.seats)
+      workers.push_back(std::make_unique<Worker>(*this, seat, std::string()));
+    for (const std::string &node : options.devices)
+      workers.push_back(std::make_unique<Worker>(*this, std::string(), node));
+    serializeDelivery = workers.size() > 1 && !concurrentCallbacks();
 
-    // Debug logging
-    {
-      std::string kname = keyToString(mapped);
-      TYPR_IO_LOG_DEBUG("Listener (Linux/libinput) %s: evdev=%u keysym=%u "
-                        "key=%s cp=%u mods=0x%02x",
-                        pressed ? "press" : "release", keycode,
-                        static_cast<unsigned>(sym), kname.c_str(),
-                        static_cast<unsigned>(codepoint),
-                        static_cast<int>(static_cast<uint8_t>(mods)));
+    activeWorkers.store(workers.size());
+    running.store(true);
+    for (auto &w : workers)
+      w->thread = std::thread(&Worker::run, w.get());
+
+    // Wait (up to ~200ms) for initialization
+    int state = Worker::kStarting;
+    for (int i = 0; i < 40; ++i) {
+      state = workersState();
+      if (state != Worker::kStarting)
+        break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
+    const bool ok = state == Worker::kReady;
+    if (!ok)
+      stopLocked();
+    TYPR_IO_LOG_DEBUG("Listener (Linux/libinput): start result=%u "
+                      "(workers=%zu)",
+                      static_cast<unsigned>(ok), options.seats.size() +
+                                                     options.devices.size());
+    return ok;
+  }
+
+  /**
+   * @internal
+   * @brief Stop the workers and clear the stored callback.
+   *
+   * Safe to call from any thread. Running workers are woken through
+   * `wakeFd` and joined (workers that already exited are still joined); the
+   * callback is then cleared to prevent further invocations.
+   */
+  void stop() {
+    std::lock_guard<std::mutex> lk(startMutex);
+    stopLocked();
   }
 
-  Key mapKeysymToKey(xkb_keysym_t sym) {
-    // Quick alphabetic mapping (lowercase and uppercase)
-    if (sym >= XKB_KEY_a && sym <= XKB_KEY_z) {
-      return static_cast<Key>(static_cast<int>(Key::A) + (sym - XKB_KEY_a));
+  /**
+   * @internal
+   * @brief Query whether any worker thread is active.
+   * @return true while at least one worker is running.
+   */
+  bool isRunning() const { return running.load(); }
+
+  std::vector<ListenerDevice> devices() const {
+    std::lock_guard<std::mutex> lk(devicesMutex);
+    return deviceList;
+  }
+
+  // Workers may invoke the callback at the same time (see start())
+  bool concurrentCallbacks() const {
+    return options.parallelCallbacks &&
+           options.seats.size() + options.devices.size() > 1;
+  }
+
+  // Delivery counters; read by Listener::stats() from any thread
+  detail::ListenerStatsRecorder stats;
+
+private:
+  void stopLocked() {
+    const bool wasRunning = running.exchange(false);
+    if (wakeFd >= 0) {
+      uint64_t one = 1;
+      ssize_t n;
+      do {
+        n = ::write(wakeFd, &one, sizeof(one));
+      } while (n < 0 && errno == EINTR);
     }
-    if (sym >= XKB_KEY_A && sym <= XKB_KEY_Z) {
-      return static_cast<Key>(static_cast<int>(Key::A) + (sym - XKB_KEY_A));
+    joinWorkers();
+    if (wakeFd >= 0) {
+      ::close(wakeFd);
+      wakeFd = -1;
     }
 
-    // Top-row numbers
-    if (sym >= XKB_KEY_0 && sym <= XKB_KEY_9) {
-      return static_cast<Key>(static_cast<int>(Key::Num0) + (sym - XKB_KEY_0));
+    callback.reset();
+    xkbLayout.reset();
+
+    if (wasRunning)
+      TYPR_IO_LOG_INFO("Listener (Linux/libinput): stopped");
+  }
+
+  void joinWorkers() {
+    for (auto &w : workers) {
+      if (w->thread.joinable())
+        w->thread.join();
     }
+    workers.clear();
+  }
 
-    // Function keys
-    if (sym >= XKB_KEY_F1 && sym <= XKB_KEY_F20) {
-      return static_cast<Key>(static_cast<int>(Key::F1) + (sym - XKB_KEY_F1));
+  /**
+   * @internal
+   * @brief Combined start-up state: failed if any worker failed, ready once
+   * all are.
+   */
+  int workersState() const {
+    int combined = Worker::kReady;
+    for (const auto &w : workers) {
+      const int s = w->state.load();
+      if (s == Worker::kFailed)
+        return Worker::kFailed;
+      if (s == Worker::kStarting)
+        combined = Worker::kStarting;
     }
+    return combined;
+  }
+
+  /**
+   * @internal
+   * @brief Called by each worker as it exits; the last one clears `running`.
+   */
+  void workerExited() {
+    if (activeWorkers.fetch_sub(1) == 1)
+      running.store(false);
+  }
 
-    // Direct mappings for common control keys
-    switch (sym) {
-    case XKB_KEY_Return:
-      return Key::Enter;
-    case XKB_KEY_BackSpace:
-      return Key::Backspace;
-    case XKB_KEY_space:
-      return Key::Space;
-    case XKB_KEY_Tab:
-      return Key::Tab;
-    case XKB_KEY_Escape:
-      return Key::Escape;
-    case XKB_KEY_Left:
-      return Key::Left;
-    case XKB_KEY_Right:
-      return Key::Right;
-    case XKB_KEY_Up:
-      return Key::Up;
-    case XKB_KEY_Down:
-      return Key::Down;
-    case XKB_KEY_Home:
-      return Key::Home;
-    case XKB_KEY_End:
-      return Key::End;
-    case XKB_KEY_Page_Up:
-      return Key::PageUp;
-    case XKB_KEY_Page_Down:
-      return Key::PageDown;
-    case XKB_KEY_Delete:
-      return Key::Delete;
-    case XKB_KEY_Insert:
-      return Key::Insert;
-    // Numpad
-    case XKB_KEY_KP_Divide:
-      return Key::NumpadDivide;
-    case XKB_KEY_KP_Multiply:
-      return Key::NumpadMultiply;
-    case XKB_KEY_KP_Subtract:
-      return Key::NumpadMinus;
-    case XKB_KEY_KP_Add:
-      return Key::NumpadPlus;
-    case XKB_KEY_KP_Enter:
-      return Key::NumpadEnter;
-    case XKB_KEY_KP_Decimal:
-      return Key::NumpadDecimal;
-    case XKB_KEY_KP_0:
-      return Key::Numpad0;
-    case XKB_KEY_KP_1:
-      return Key::Numpad1;
-    case XKB_KEY_KP_2:
-      return Key::Numpad2;
-    case XKB_KEY_KP_3:
-      return Key::Numpad3;
-    case XKB_KEY_KP_4:
-      return Key::Numpad4;
-    case XKB_KEY_KP_5:
-      return Key::Numpad5;
-    case XKB_KEY_KP_6:
-      return Key::Numpad6;
-    case XKB_KEY_KP_7:
-      return Key::Numpad7;
-    case XKB_KEY_KP_8:
-      return Key::Numpad8;
-    case XKB_KEY_KP_9:
-      return Key::Numpad9;
-    // Common punctuation
-    case XKB_KEY_comma:
-      return Key::Comma;
-    case XKB_KEY_period:
-      return Key::Period;
-    case XKB_KEY_slash:
-      return Key::Slash;
-    case XKB_KEY_backslash:
-      return Key::Backslash;
-    case XKB_KEY_semicolon:
-      return Key::Semicolon;
-    case XKB_KEY_apostrophe:
-      return Key::Apostrophe;
-    case XKB_KEY_minus:
-      return Key::Minus;
-    case XKB_KEY_equal:
-      return Key::Equal;
-    case XKB_KEY_grave:
-      return Key::Grave;
-    case XKB_KEY_bracketleft:
-      return Key::LeftBracket;
-    case XKB_KEY_bracketright:
-      return Key::RightBracket;
-    default:
-      break;
+  /**
+   * @internal
+   * @brief Hand one event to the callback (any worker thread).
+   *
+   * Deliveries from several workers are serialized unless the caller opted
+   * into `ListenerOptions::parallelCallbacks`; a single worker never locks.
+   */
+  void deliver(const Event &event) {
+    if (serializeDelivery) {
+      std::lock_guard<std::mutex> lk(deliveryMutex);
+      dispatch(event);
+    } else {
+      dispatch(event);
     }
+  }
 
-    // Try to map using the keysym name -> stringToKey as a best-effort fallback
-    char name[64] = {0};
-    if (xkb_keysym_get_name(sym, name, sizeof(name)) > 0) {
-      Key mapped = stringToKey(std::string(name));
-      if (mapped != Key::Unknown)
-        return mapped;
+  void dispatch(const Event &event) {
+    // Dispatch in place: no std::function copy per event
+    stats.timed(event.timestampNs, [&]() {
+      callback.visit([&](const EventCallback &cb) {
+        if (cb)
+          cb(event);
+      });
+    });
+  }
+
+  /**
+   * @internal
+   * @brief Id for a keyboard that appeared; a node seen before keeps its id.
+   * @return The id, or 0 once the 16-bit id space is exhausted.
+   */
+  uint16_t registerDevice(std::string name, std::string node,
+                          const std::string &seat) {
+    std::lock_guard<std::mutex> lk(devicesMutex);
+    for (ListenerDevice &d : deviceList) {
+      if (d.node == node) {
+        d.name = std::move(name);
+        d.connected = true;
+        return d.id;
+      }
     }
+    if (deviceList.size() >= UINT16_MAX)
+      return 0;
+    ListenerDevice d;
+    d.id = static_cast<uint16_t>(deviceList.size() + 1);
+    d.name = std::move(name);
+    d.node = std::move(node);
+    d.seat = seat;
+    d.connected = true;
+    TYPR_IO_LOG_INFO("Listener (Linux/libinput): device %u '%s' (%s) on %s",
+                     static_cast<unsigned>(d.id), d.name.c_str(),
+                     d.node.c_str(), d.seat.c_str());
+    deviceList.push_back(std::move(d));
+    return deviceList.back().id;
+  }
 
-    return Key::Unknown;
+  void unregisterDevice(uint16_t id) {
+    std::lock_guard<std::mutex> lk(devicesMutex);
+    if (id != 0 && id <= deviceList.size())
+      deviceList[id - 1].connected = false;
   }
 
-  std::thread worker;
+  ListenerOptions options;
+  std::vector<std::unique_ptr<Worker>> workers;
+  int wakeFd{-1}; // eventfd signalled by stop() to unblock every worker
   std::atomic_bool running{false};
-  std::atomic_bool ready{false};
-  std::mutex cbMutex;
-  Callback callback;
-
-  // Store unicode codepoints computed at key-press time so they can be
-  // delivered on key-release events.
-  std::unordered_map<uint32_t, char32_t> pendingCodepoints;
-
-  struct libinput *li = nullptr;
-  struct xkb_context *xkbCtx = nullptr;
-  struct xkb_keymap *xkbKeymap = nullptr;
-  struct xkb_state *xkbState = nullptr;
+  std::atomic<std::size_t> activeWorkers{0};
+  std::mutex startMutex;
+  detail::RcuCell<EventCallback> callback;
+
+  // Written by start() before the workers are spawned, then only read
+  ListenerFilter filter;
+  bool serializeDelivery{false};
+  std::shared_ptr<const detail::XkbLayout> xkbLayout;
+
+  std::mutex deliveryMutex;
+  mutable std::mutex devicesMutex;
+  std::vector<ListenerDevice> deviceList;
 };
 
 // Public wrappers
-Listener::Listener() : m_impl(std::make_unique<Impl>()) {}
+Listener::Listener() : Listener(ListenerOptions{}) {}
+Listener::Listener(const ListenerOptions &options)
+    : m_impl(std::make_unique<Impl>(options)) {}
 Listener::~Listener() { stop(); }
 Listener::Listener(Listener &&) noexcept = default;
 Listener &Listener::operator=(Listener &&) noexcept = default;
 
-bool Listener::start(Callback cb) {
+bool Listener::start(EventCallback cb, const ListenerFilter &filter) {
   TYPR_IO_LOG_DEBUG("Listener::start() called (Linux/libinput)");
-  return m_impl ? m_impl->start(std::move(cb)) : false;
+  return m_impl ? m_impl->start(std::move(cb), filter) : false;
 }
 
 void Listener::stop() {
@@ -688,6 +713,18 @@ bool Listener::isListening() const {
   return m_impl ? m_impl->isRunning() : false;
 }
 
+ListenerStats Listener::stats() const {
+  return m_impl ? m_impl->stats.snapshot(droppedEvents()) : ListenerStats{};
+}
+
+std::vector<ListenerDevice> Listener::devices() const {
+  return m_impl ? m_impl->devices() : std::vector<ListenerDevice>{};
+}
+
+bool Listener::concurrentCallbacks() const {
+  return m_impl && m_impl->concurrentCallbacks();
+}
+
 } // namespace typr::io
 
 #endif // __linux__
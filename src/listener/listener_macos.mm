@@ -2,9 +2,15 @@
 
 #include <typr-io/listener.hpp>
 
+#include "common/layout_table.hpp"
+#include "common/rcu_cell.hpp"
+#include "common/stats_recorder.hpp"
+#include "listener/listener_queue.hpp"
+
 #import <Foundation/Foundation.h>
 #include <ApplicationServices/ApplicationServices.h>
 #include <Carbon/Carbon.h>
+#include <mach/mach_time.h>
 #include <typr-io/log.hpp>
 #include <cstdio>
 #include <cstdlib>
@@ -14,6 +20,7 @@
 #include <mutex>
 #include <unordered_map>
 #include <array>
+#include <bitset>
 
 namespace typr::io {
 
@@ -49,18 +56,28 @@ static bool output_debug_enabled() {
 struct Listener::Impl {
   Impl() : running(false), eventTap(nullptr), runLoopSource(nullptr), runLoop(nullptr) {
     initKeyMap();
+    // Input source switches are announced on the distributed center; the
+    // tables are rebuilt lazily by the tap thread on its next event.
+    CFNotificationCenterAddObserver(
+        CFNotificationCenterGetDistributedCenter(), this, &Impl::layoutChangedCallback,
+        kTISNotifySelectedKeyboardInputSourceChanged, nullptr,
+        CFNotificationSuspensionBehaviorDeliverImmediately);
   }
 
   ~Impl() {
+    CFNotificationCenterRemoveObserver(CFNotificationCenterGetDistributedCenter(), this,
+                                       kTISNotifySelectedKeyboardInputSourceChanged, nullptr);
     stop();
   }
 
-  bool start(Callback cb) {
-    std::lock_guard<std::mutex> lk(cbMutex);
+  bool start(EventCallback cb, const ListenerFilter &eventFilter) {
+    std::lock_guard<std::mutex> lk(startMutex);
     if (running.load())
       return false;
     TYPR_IO_LOG_INFO("Listener (macOS): start requested");
-    callback = std::move(cb);
+    callback.store(std::move(cb));
+    filter = eventFilter;
+    stats.reset();
     running.store(true);
     ready.store(false);
     worker = std::thread([this]() { threadMain(); });
@@ -103,20 +120,25 @@ struct Listener::Impl {
       runLoopSource = nullptr;
     }
     runLoop = nullptr;
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      callback = nullptr;
-    }
+    callback.reset();
     TYPR_IO_LOG_INFO("Listener (macOS): stopped");
   }
 
   bool isRunning() const { return running.load(); }
 
+  // Delivery counters; read by Listener::stats() from any thread
+  detail::ListenerStatsRecorder stats;
+
 private:
   // Thread main installs an event tap and runs a CFRunLoop to receive events.
   void threadMain() {
-    // Create an event mask for key down + key up
-    CGEventMask mask = CGEventMaskBit(kCGEventKeyDown) | CGEventMaskBit(kCGEventKeyUp);
+    // Only ask for the edges the filter can deliver. Presses are still
+    // needed when releases want the codepoint cached at press time.
+    CGEventMask mask = 0;
+    if (filter.presses || (filter.releases && filter.needCodepoint))
+      mask |= CGEventMaskBit(kCGEventKeyDown);
+    if (filter.releases)
+      mask |= CGEventMaskBit(kCGEventKeyUp);
 
     // Try to create an event tap on the session level. If this fails, the
     // system likely blocked input monitoring (or another error occurred).
@@ -159,6 +181,14 @@ private:
     runLoop = nullptr;
   }
 
+  // Input source change notification (any thread): flag the tables stale
+  static void layoutChangedCallback(CFNotificationCenterRef, void *observer, CFNotificationName,
+                                    const void *, CFDictionaryRef) {
+    auto *self = static_cast<Impl *>(observer);
+    if (self)
+      self->layoutDirty.store(true, std::memory_order_release);
+  }
+
   // Event tap callback (invoked on the run loop thread)
   static CGEventRef eventTapCallback(CGEventTapProxy proxy, CGEventType type, CGEventRef event, void *userInfo) {
     Impl *self = reinterpret_cast<Impl *>(userInfo);
@@ -178,29 +208,9 @@ private:
     bool pressed = (type == kCGEventKeyDown);
     CGKeyCode keyCode = static_cast<CGKeyCode>(CGEventGetIntegerValueField(event, kCGKeyboardEventKeycode));
 
-    // Unicode extraction - macOS gives us UTF-16 UniChar sequences
-    std::array<UniChar, 4> uniBuf{};
-    UniCharCount actualLen = 0;
-    CGEventKeyboardGetUnicodeString(event, static_cast<UniCharCount>(uniBuf.size()), &actualLen, uniBuf.data());
-
-    char32_t codepoint = 0;
-    if (actualLen > 0) {
-      if (actualLen == 1) {
-        codepoint = static_cast<char32_t>(uniBuf[0]);
-      } else if (actualLen == 2) {
-        // Combine surrogate pair
-        uint32_t high = static_cast<uint32_t>(uniBuf[0]);
-        uint32_t low = static_cast<uint32_t>(uniBuf[1]);
-        if ((0xD800 <= high && high <= 0xDBFF) && (0xDC00 <= low && low <= 0xDFFF)) {
-          codepoint = 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
-        } else {
-          codepoint = 0; // invalid surrogate pair; drop
-        }
-      } else {
-        // More complex output - take first char for simplicity
-        codepoint = static_cast<char32_t>(uniBuf[0]);
-      }
-    }
+    // Rebuild the translation tables only after the input source changed
+    if (self->layoutDirty.exchange(false, std::memory_order_acq_rel))
+      self->initKeyMap();
 
     // Map CGKeyCode to our Key enum
     Key mapped = Key::Unknown;
@@ -213,6 +223,39 @@ private:
     CGEventFlags flags = CGEventGetFlags(event);
     Modifier mods = flagsToModifier(flags);
 
+    // Return uninteresting events straight to the system: the tap is on the
+    // input path, so it must stay cheap. A rejected dead key still arms the
+    // composition of the next key when characters are wanted.
+    const ListenerFilter &filter = self->filter;
+    if (!filter.wantsKey(mapped) ||
+        (!filter.acceptsKey(mapped, pressed) &&
+         !(pressed && filter.releases && filter.needCodepoint))) {
+      if (pressed && filter.needCodepoint && !isModifierKey(mapped))
+        self->deadKeyPending = self->isDeadKey(keyCode, mods);
+      self->stats.filtered();
+      return event;
+    }
+
+    // Resolve the character from the per-layout table. Keys the table cannot
+    // answer (no output, dead keys and the key completing a dead key
+    // sequence) fall back to the string macOS attached to the event.
+    char32_t codepoint = 0;
+    if (filter.needCodepoint) {
+      codepoint = self->layoutTable.find(keyCode, mods);
+      bool composing = false;
+      if (pressed && !isModifierKey(mapped)) {
+        composing = self->deadKeyPending;
+        self->deadKeyPending = self->isDeadKey(keyCode, mods);
+      }
+      if (codepoint == 0 || composing) {
+        // macOS gives us UTF-16 UniChar sequences
+        std::array<UniChar, 4> uniBuf{};
+        UniCharCount actualLen = 0;
+        CGEventKeyboardGetUnicodeString(event, static_cast<UniCharCount>(uniBuf.size()), &actualLen, uniBuf.data());
+        codepoint = detail::utf16ToCodepoint(uniBuf.data(), static_cast<int>(actualLen));
+      }
+    }
+
     // Treat Enter and Backspace as control keys (non-printable). If we pass a
     // non-zero codepoint for these keys the test callback will append that
     // control character into the observed string rather than handling the
@@ -250,11 +293,11 @@ private:
         auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - rtIt->second);
         if (elapsed < kReleaseDebounceMs && sigIt->second.first == codepoint && sigIt->second.second == mods) {
           if (output_debug_enabled()) {
-            std::string kname = "Unknown";
+            std::string_view kname = "Unknown";
             auto kIt = self->cgKeyToKey.find(keyCode);
-            if (kIt != self->cgKeyToKey.end()) kname = keyToString(kIt->second);
+            if (kIt != self->cgKeyToKey.end()) kname = keyToStringView(kIt->second);
             TYPR_IO_LOG_DEBUG("Listener (macOS): ignoring duplicate release (same cp+mods) for keycode=%u key=%s cp=%u mods=%u",
-                              (unsigned)keyCode, kname.c_str(), (unsigned)codepoint, (unsigned)mods);
+                              (unsigned)keyCode, kname.data(), (unsigned)codepoint, (unsigned)mods);
           }
           // Update timestamp & signature so subsequent quick duplicates remain debounced.
           self->lastReleaseTime[keyCode] = now;
@@ -286,22 +329,21 @@ private:
 
 
 
-    // Invoke user callback outside the lock
-    Callback cbCopy;
-    {
-      std::lock_guard<std::mutex> lk(self->cbMutex);
-      cbCopy = self->callback;
-    }
-    if (cbCopy) {
-      cbCopy(static_cast<char32_t>(codepoint), mapped, mods, pressed);
+    if (!filter.acceptsKey(mapped, pressed) || !filter.acceptsMods(mods)) {
+      self->stats.filtered();
+      return event;
     }
 
+    // Invoke user callback in place (lock-free, no std::function copy)
+    self->invokeCallback(static_cast<char32_t>(codepoint), mapped, mods,
+                         pressed, eventTimestampNs(event));
+
     {
-      std::string kname = "Unknown";
+      std::string_view kname = "Unknown";
       auto kIt = self->cgKeyToKey.find(keyCode);
-      if (kIt != self->cgKeyToKey.end()) kname = keyToString(kIt->second);
+      if (kIt != self->cgKeyToKey.end()) kname = keyToStringView(kIt->second);
       TYPR_IO_LOG_DEBUG("Listener (macOS) %s: keycode=%u key=%s cp=%u mods=%u",
-                       pressed ? "press" : "release", (unsigned)keyCode, kname.c_str(),
+                       pressed ? "press" : "release", (unsigned)keyCode, kname.data(),
                        (unsigned)codepoint, (unsigned)mods);
     }
 
@@ -309,10 +351,70 @@ private:
     return event;
   }
 
+  static bool isModifierKey(Key key) {
+    switch (key) {
+    case Key::ShiftLeft:
+    case Key::ShiftRight:
+    case Key::CtrlLeft:
+    case Key::CtrlRight:
+    case Key::AltLeft:
+    case Key::AltRight:
+    case Key::SuperLeft:
+    case Key::SuperRight:
+    case Key::CapsLock:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  bool isDeadKey(CGKeyCode keyCode, Modifier mods) const {
+    if (keyCode >= kLayoutKeys)
+      return false;
+    return deadKeys.test(LayoutTable::stateFor(mods) * kLayoutKeys + keyCode);
+  }
+
+  // Translate every key in every layout-relevant modifier state once, so
+  // the tap callback answers events with a table lookup.
+  void buildLayoutTable(const UCKeyboardLayout *keyboardLayout) {
+    deadKeys.reset();
+    deadKeyPending = false;
+    layoutTable.build([&](std::size_t keyCode, unsigned state) -> char32_t {
+      // UCKeyTranslate takes the Carbon modifier mask shifted right by 8
+      UInt32 modifierKeyState = 0;
+      if (state & LayoutTable::kShift)
+        modifierKeyState |= shiftKey >> 8;
+      if (state & LayoutTable::kCtrl)
+        modifierKeyState |= controlKey >> 8;
+      if (state & LayoutTable::kAlt)
+        modifierKeyState |= optionKey >> 8;
+      if (state & LayoutTable::kCapsLock)
+        modifierKeyState |= alphaLock >> 8;
+
+      UInt32 deadKeyState = 0;
+      std::array<UniChar, 4> unicodeString{};
+      UniCharCount actualStringLength = 0;
+      OSStatus status = UCKeyTranslate(
+          keyboardLayout, static_cast<UInt16>(keyCode), kUCKeyActionDown, modifierKeyState,
+          LMGetKbdType(), 0, &deadKeyState, static_cast<UInt32>(unicodeString.size()),
+          &actualStringLength, unicodeString.data());
+      if (status != noErr)
+        return 0;
+      if (deadKeyState != 0) {
+        deadKeys.set(state * kLayoutKeys + keyCode);
+        return 0;
+      }
+      return detail::utf16ToCodepoint(unicodeString.data(), static_cast<int>(actualStringLength));
+    });
+  }
+
   // Build a reverse mapping CGKeyCode -> Key using the same discovery logic
-  // used by the InputBackend on macOS.
+  // used by the InputBackend on macOS, plus the codepoint table.
   void initKeyMap() {
     cgKeyToKey.clear();
+    layoutTable.clear();
+    deadKeys.reset();
+    deadKeyPending = false;
 
     TISInputSourceRef currentKeyboard = TISCopyCurrentKeyboardInputSource();
     if (currentKeyboard == nullptr) {
@@ -378,6 +480,7 @@ private:
       }
     }
 
+    buildLayoutTable(keyboardLayout);
     CFRelease(currentKeyboard);
 
     // Add canonical fallbacks for keys that may not be covered by layout scan
@@ -473,23 +576,46 @@ private:
     setIfMissing(Key::Slash, kVK_ANSI_Slash);
   }
 
-  // Safely invoke user callback
-  void invokeCallback(char32_t cp, Key k, Modifier mods, bool pressed) {
-    Callback cbCopy;
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      cbCopy = callback;
-    }
-    if (cbCopy) {
-      cbCopy(cp, k, mods, pressed);
-    }
+  // CGEventGetTimestamp() is in mach_absolute_time() units (nanoseconds on
+  // Intel, timebase ticks on Apple silicon); carry the event's age over to
+  // steady_clock.
+  static uint64_t eventTimestampNs(CGEventRef event) {
+    static const mach_timebase_info_data_t timebase = []() {
+      mach_timebase_info_data_t tb{};
+      mach_timebase_info(&tb);
+      if (tb.denom == 0)
+        tb.numer = tb.denom = 1;
+      return tb;
+    }();
+    auto toNs = [](uint64_t ticks) {
+      return static_cast<uint64_t>(static_cast<__uint128_t>(ticks) *
+                                   timebase.numer / timebase.denom);
+    };
+    const uint64_t ts = CGEventGetTimestamp(event);
+    if (ts == 0)
+      return detail::steadyNowNs();
+    return detail::nativeToSteadyNs(toNs(ts), toNs(mach_absolute_time()));
+  }
+
+  // Safely invoke user callback and record delivery stats
+  void invokeCallback(char32_t cp, Key k, Modifier mods, bool pressed,
+                      uint64_t eventNs) {
+    const Event ev{cp, k, mods, pressed, eventNs};
+    stats.timed(eventNs, [&]() {
+      callback.visit([&](const EventCallback &cb) {
+        if (cb)
+          cb(ev);
+      });
+    });
   }
 
   std::thread worker;
   std::atomic_bool running;
   std::atomic<bool> ready{false};
-  Callback callback;
-  std::mutex cbMutex;
+  detail::RcuCell<EventCallback> callback;
+  std::mutex startMutex;
+  // Written by start() before the tap thread is spawned, read only by it
+  ListenerFilter filter;
 
   // CF / CG resources on the run loop thread
   CFMachPortRef eventTap;
@@ -499,6 +625,15 @@ private:
   // Reverse mapping
   std::unordered_map<CGKeyCode, Key> cgKeyToKey;
 
+  // (keycode, modifiers) -> codepoint for the current input source; owned by
+  // the tap thread once started, rebuilt when layoutDirty is raised.
+  static constexpr std::size_t kLayoutKeys = 128;
+  using LayoutTable = detail::LayoutCodepointTable<kLayoutKeys>;
+  LayoutTable layoutTable;
+  std::bitset<kLayoutKeys * LayoutTable::kStates> deadKeys;
+  bool deadKeyPending{false};
+  std::atomic<bool> layoutDirty{false};
+
   // Last-seen unicode codepoint for keycodes (press -> release fallback).
   // Some macOS configurations produce keyup events without a Unicode string
   // while the corresponding keydown contained the character. We cache the
@@ -514,11 +649,12 @@ private:
 
 // OutputListener public wrappers
 Listener::Listener() : m_impl(std::make_unique<Impl>()) {}
+Listener::Listener(const ListenerOptions &) : Listener() {}
 Listener::~Listener() { stop(); }
 Listener::Listener(Listener &&) noexcept = default;
 Listener &Listener::operator=(Listener &&) noexcept = default;
-bool Listener::start(Callback cb) {
-  return m_impl ? m_impl->start(std::move(cb)) : false;
+bool Listener::start(EventCallback cb, const ListenerFilter &filter) {
+  return m_impl ? m_impl->start(std::move(cb), filter) : false;
 }
 void Listener::stop() {
   if (m_impl)
@@ -527,6 +663,13 @@ void Listener::stop() {
 bool Listener::isListening() const {
   return m_impl ? m_impl->isRunning() : false;
 }
+ListenerStats Listener::stats() const {
+  return m_impl ? m_impl->stats.snapshot(droppedEvents()) : ListenerStats{};
+}
+std::vector<ListenerDevice> Listener::devices() const { return {}; }
+
+// One event tap thread delivers every event
+bool Listener::concurrentCallbacks() const { return false; }
 
 } // namespace backend
 
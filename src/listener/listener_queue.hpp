@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ * @file listener_queue.hpp
+ * @brief Internal state behind `Listener::startQueued()` / `Listener::poll()`.
+ *
+ * Queued delivery is platform-independent: it is layered on top of the
+ * backend's regular callback path, so every backend only needs this header
+ * for the complete `Listener::Queue` type (its destructor is instantiated in
+ * the backend's `Listener` special members).
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include <typr-io/listener.hpp>
+
+#include "common/spsc_ring.hpp"
+
+namespace typr::io {
+
+/**
+ * @internal
+ * @brief Event ring plus overflow accounting for queued delivery.
+ *
+ * The platform thread is the only producer. `poll()` may be called from any
+ * thread; `consumerMutex` keeps the ring's consumer side single-threaded.
+ */
+struct Listener::Queue {
+  explicit Queue(std::size_t capacity) : ring(capacity) {}
+
+  /**
+   * @internal
+   * @brief Record one event (platform thread only); never blocks.
+   */
+  void push(const Event &event) {
+    if (!ring.tryPush(event))
+      dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  detail::SpscRing<Event> ring;
+  std::atomic<uint64_t> dropped{0};
+  std::mutex consumerMutex;
+};
+
+} // namespace typr::io
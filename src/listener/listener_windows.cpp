@@ -1,11 +1,18 @@
 /**
  * @file listener_windows.cpp
- * @brief Windows (WH_KEYBOARD_LL) implementation of the Listener.
+ * @brief Windows (WH_KEYBOARD_LL / Raw Input) implementation of the Listener.
  *
- * Uses a low-level keyboard hook (WH_KEYBOARD_LL) to observe global keyboard
- * activity, translate virtual keys and produced characters into logical
+ * By default a low-level keyboard hook (WH_KEYBOARD_LL) observes global
+ * keyboard activity. With `ListenerOptions::rawInput` the worker instead
+ * owns a message-only window registered for keyboard Raw Input with
+ * RIDEV_INPUTSINK, and drains pending input in batches through
+ * `GetRawInputBuffer`. Raw Input is never on the system's delivery path, so
+ * a slow callback cannot delay keys reaching other applications, and each
+ * event carries the keyboard it came from.
+ *
+ * Both paths translate virtual keys and produced characters into logical
  * `Key` values and Unicode codepoints where possible, and forward events to
- * the public `Listener` callback. Callback invocations occur on the hook
+ * the public `Listener` callback. Callback invocations occur on the worker
  * thread and therefore must be thread-safe and avoid long/blocking work.
  *
  * Notes:
@@ -21,14 +28,24 @@
 #include <typr-io/listener.hpp>
 
 #include <Windows.h>
+
+#include "common/layout_table.hpp"
+#include "common/rcu_cell.hpp"
+#include "common/stats_recorder.hpp"
+#include "listener/listener_queue.hpp"
+
+#include <array>
 #include <atomic>
+#include <bitset>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <typr-io/log.hpp>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace typr::io {
@@ -86,49 +103,117 @@ bool isExtendedKeyForVK(WORD vk) {
  */
 static bool output_debug_enabled() { return ::typr::io::log::debugEnabled(); }
 
+// Window class of the message-only window receiving Raw Input
+constexpr wchar_t kRawInputClass[] = L"typr-io raw input listener";
+
+// Initial GetRawInputBuffer buffer, in 8-byte words (about 64 keyboard
+// records); it doubles on demand up to kMaxRawBufferWords.
+constexpr std::size_t kRawBufferWords = 64 * sizeof(RAWINPUT) / 8;
+constexpr std::size_t kMaxRawBufferWords = 64 * kRawBufferWords;
+
+/**
+ * @internal
+ * @brief Keyboard payload of a record returned by `GetRawInputBuffer`.
+ *
+ * A 32-bit process on 64-bit Windows receives the buffer in the 64-bit
+ * layout, where the payload follows an 8-byte aligned header.
+ */
+const RAWKEYBOARD &rawKeyboard(const RAWINPUT *raw) {
+#ifndef _WIN64
+  static const bool wow64 = [] {
+    BOOL value = FALSE;
+    return IsWow64Process(GetCurrentProcess(), &value) && value;
+  }();
+  if (wow64)
+    return *reinterpret_cast<const RAWKEYBOARD *>(
+        reinterpret_cast<const BYTE *>(&raw->data) + 8);
+#endif
+  return raw->data.keyboard;
+}
+
+/**
+ * @internal
+ * @brief Interface path of a Raw Input device as UTF-8 (empty on failure).
+ */
+std::string rawDeviceName(HANDLE device) {
+  UINT chars = 0;
+  if (GetRawInputDeviceInfoW(device, RIDI_DEVICENAME, nullptr, &chars) != 0 ||
+      chars == 0)
+    return {};
+  std::wstring wide(chars, L'\0');
+  if (GetRawInputDeviceInfoW(device, RIDI_DEVICENAME, wide.data(), &chars) ==
+      static_cast<UINT>(-1))
+    return {};
+  wide.resize(wcsnlen(wide.c_str(), wide.size()));
+  const int wideLen = static_cast<int>(wide.size());
+  const int bytes = WideCharToMultiByte(CP_UTF8, 0, wide.data(), wideLen,
+                                        nullptr, 0, nullptr, nullptr);
+  std::string out(static_cast<std::size_t>(bytes > 0 ? bytes : 0), '\0');
+  if (bytes > 0)
+    WideCharToMultiByte(CP_UTF8, 0, wide.data(), wideLen, out.data(), bytes,
+                        nullptr, nullptr);
+  return out;
+}
+
 } // namespace
 
 /**
  * @internal
- * @brief Pimpl for `typr::io::Listener` (Windows / hook-based backend).
+ * @brief Pimpl for `typr::io::Listener` (Windows hook and Raw Input
+ * backends).
  *
  * This structure manages the platform-specific pieces required for the
- * Windows listener: hook installation, the hook worker thread, VK -> Key
- * discovery and state used to translate low-level events into logical keys
- * and Unicode codepoints that are forwarded to the caller's callback.
+ * Windows listener: hook or Raw Input registration, the worker thread,
+ * VK -> Key discovery and state used to translate low-level events into
+ * logical keys and Unicode codepoints that are forwarded to the caller's
+ * callback.
  *
  * Instances are owned by the public `Listener` facade and are not intended
  * to be manipulated directly by consumers.
  */
 struct Listener::Impl {
-  Impl() { initKeyMap(); }
+  explicit Impl(const ListenerOptions &options) : rawInput(options.rawInput) {
+    switchLayout(foregroundLayout());
+  }
   ~Impl() { stop(); }
 
   /**
    * @internal
    * @brief Start the Windows listener.
    *
-   * Installs the low-level keyboard hook on a dedicated thread and stores the
-   * provided callback. This function waits briefly for the hook to be
-   * installed and returns whether the implementation reported readiness.
+   * Installs the low-level keyboard hook (or registers for Raw Input) on a
+   * dedicated thread and stores the provided callback. This function waits
+   * briefly for the thread to become ready and returns whether the
+   * implementation reported readiness.
    *
    * @param cb Callback invoked for each observed key event. The callback may
    *           be called from the hook thread and therefore must be thread-safe.
+   * @param eventFilter Events to deliver; installed before the hook thread
+   *           starts.
    * @return true if the listener started successfully and the hook became
    * ready.
    */
-  bool start(Callback cb) {
+  bool start(EventCallback cb, const ListenerFilter &eventFilter) {
     if (running.load())
       return false;
+    // Reap a worker that exited on its own after a failed start
+    if (worker.joinable())
+      worker.join();
+    callback.store(std::move(cb));
+    filter = eventFilter;
+    stats.reset();
+    deviceIds.clear();
     {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      callback = std::move(cb);
+      std::lock_guard<std::mutex> lk(deviceMutex);
+      deviceList.clear();
     }
     running.store(true);
     // Mark not-ready until the hook is actually installed.
     ready.store(false);
-    TYPR_IO_LOG_INFO("Listener (Windows): start requested");
-    worker = std::thread(&Impl::threadMain, this);
+    TYPR_IO_LOG_INFO("Listener (Windows): start requested (%s)",
+                     rawInput ? "raw input" : "hook");
+    worker = std::thread(
+        rawInput ? &Impl::threadMainRawInput : &Impl::threadMain, this);
 
     // Wait briefly for the hook to be installed (or to fail). This allows
     // startListening to return an accurate success/failure result.
@@ -166,6 +251,7 @@ struct Listener::Impl {
 
     if (worker.joinable())
       worker.join();
+    callback.reset();
     TYPR_IO_LOG_INFO("Listener (Windows): stopped");
   }
 
@@ -176,20 +262,31 @@ struct Listener::Impl {
    */
   bool isRunning() const { return running.load(); }
 
+  /**
+   * @internal
+   * @brief Keyboards seen by the Raw Input backend since the last start.
+   */
+  std::vector<ListenerDevice> devices() const {
+    std::lock_guard<std::mutex> lk(deviceMutex);
+    return deviceList;
+  }
+
+  // Delivery counters; read by Listener::stats() from any thread
+  detail::ListenerStatsRecorder stats;
+
   /**
    * @internal
    * @brief Discover and initialize the mapping from virtual-key (VK) codes
    * to logical `Key` values.
    *
-   * This procedure queries the active keyboard layout to map printable
+   * This procedure queries `layout` to map printable
    * characters to logical keys, and inserts sensible fallbacks for common
    * control, navigation and modifier keys so the listener can provide a
    * consistent mapping across Windows systems.
    */
-  void initKeyMap() {
+  void initKeyMap(HKL layout) {
     vkToKey.clear();
 
-    HKL layout = GetKeyboardLayout(0);
     BYTE keyState[256]{}; // assume all keys up
     wchar_t buf[4];
     static constexpr int kMaxScanCode = 128;
@@ -198,8 +295,8 @@ struct Listener::Impl {
       if (vk == 0)
         continue;
       int ret = ToUnicodeEx(vk, sc, keyState, buf,
-                            static_cast<int>(sizeof(buf) / sizeof(buf[0])), 0,
-                            layout);
+                            static_cast<int>(sizeof(buf) / sizeof(buf[0])),
+                            0x4, layout);
       if (ret > 0) {
         wchar_t first = buf[0];
         std::string mappedKeyString;
@@ -322,14 +419,31 @@ struct Listener::Impl {
 
 private:
   // Thread/Hook plumbing
+  const bool rawInput;
   std::thread worker;
   std::atomic<bool> running{false};
   std::atomic<DWORD> threadId{0};
   HHOOK hook{nullptr};
 
-  // User callback
-  Callback callback;
-  std::mutex cbMutex;
+  // Raw Input plumbing (worker thread only). The backend has no system key
+  // state to query, so it tracks held keys and CapsLock itself, and caches
+  // the codepoint of each press for its release.
+  HWND rawWindow{nullptr};
+  std::vector<uint64_t> rawBuffer;
+  std::bitset<256> keyDown;
+  bool capsLockOn{false};
+  std::array<char32_t, 256> rawPressCp{};
+
+  // Raw Input device handle -> Event::device id (worker thread only), and
+  // the registry behind devices(), indexed by id - 1.
+  std::unordered_map<HANDLE, uint16_t> deviceIds;
+  mutable std::mutex deviceMutex;
+  std::vector<ListenerDevice> deviceList;
+
+  // User callback, read lock-free by the hook thread
+  detail::RcuCell<EventCallback> callback;
+  // Written by start() before the hook thread is spawned, read only by it
+  ListenerFilter filter;
 
   // Hook readiness handshake - set to true once the hook is successfully
   // installed and the listener is active.
@@ -338,6 +452,11 @@ private:
   // Reverse map VK -> Key
   std::unordered_map<WORD, Key> vkToKey;
 
+  // Layout the tables below were built for, and the (VK, modifiers) ->
+  // codepoint translation of that layout. Hook thread only (after start).
+  HKL activeLayout{nullptr};
+  detail::LayoutCodepointTable<256> layoutTable;
+
   // Debounce & release handling (works on the hook thread only).
   // - Record the last codepoint seen on press to use as a fallback on release
   //   when the release event lacks a unicode output.
@@ -400,58 +519,41 @@ private:
     if (!kbd)
       return;
 
+    // KBDLLHOOKSTRUCT::time is GetTickCount() milliseconds; carry the
+    // event's age over to steady_clock (unsigned subtraction handles the
+    // 49.7-day wrap).
+    const DWORD ageMs = GetTickCount() - kbd->time;
+    const uint64_t eventNs =
+        detail::nativeToSteadyNs(0, static_cast<uint64_t>(ageMs) * 1000000u);
+
+    // Rebuild the translation tables only when the foreground layout changed
+    const HKL layout = foregroundLayout();
+    if (layout != activeLayout)
+      switchLayout(layout);
+
     WORD vk = static_cast<WORD>(kbd->vkCode);
     Key mappedKey = Key::Unknown;
     auto it = vkToKey.find(vk);
     if (it != vkToKey.end())
       mappedKey = it->second;
 
-    // Determine Unicode character (simple BMP handling). ToUnicodeEx can
-    // return 1 or 2 WCHARs (surrogate pair), or negative for dead keys.
-    BYTE keyboardState[256];
-    if (!GetKeyboardState(keyboardState)) {
-      // Fall back: no keyboard state; still report key with no codepoint.
-      invokeCallback(0, mappedKey, deriveModifiers(), pressed);
+    // Drop uninteresting events before touching modifier state or the
+    // layout table. A rejected press is kept when its release wants the
+    // codepoint the press caches below.
+    if (!filter.wantsKey(mappedKey) ||
+        (!filter.acceptsKey(mappedKey, pressed) &&
+         !(pressed && filter.releases && filter.needCodepoint))) {
+      stats.filtered();
       return;
     }
 
-    wchar_t wbuf[4]{0};
-    HKL layout = GetKeyboardLayout(0);
-    // Use scan code from the hook; use ToUnicodeEx to get the Unicode output.
-    int ret = ToUnicodeEx(vk, kbd->scanCode, keyboardState, wbuf,
-                          static_cast<int>(sizeof(wbuf) / sizeof(wbuf[0])), 0,
-                          layout);
-
-    char32_t codepoint = 0;
-    if (ret > 0) {
-      if (ret == 1) {
-        codepoint = static_cast<char32_t>(wbuf[0]);
-      } else if (ret == 2) {
-        // Combine surrogate pair
-        uint32_t high = static_cast<uint32_t>(wbuf[0]);
-        uint32_t low = static_cast<uint32_t>(wbuf[1]);
-        // Validate surrogates minimally
-        if ((0xD800 <= high && high <= 0xDBFF) &&
-            (0xDC00 <= low && low <= 0xDFFF)) {
-          codepoint = 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
-        } else {
-          codepoint = 0; // invalid surrogate sequence
-        }
-      } else {
-        // More than 2 chars -> ignore extras, take first for simplicity
-        codepoint = static_cast<char32_t>(wbuf[0]);
-      }
-    } else {
-      // ret == 0 or negative (dead key): no produced character for this
-      // simple listener. We ignore dead-key composition for now.
-      codepoint = 0;
-    }
-
-    // Capture modifiers once and reuse them
+    // Capture modifiers once and reuse them; the character then comes
+    // from the table instead of a GetKeyboardState + ToUnicodeEx round trip
     Modifier mods = deriveModifiers();
+    char32_t codepoint = filter.needCodepoint ? layoutTable.find(vk, mods) : 0;
 
     // Map to textual key name for logging
-    std::string keyName = keyToString(mappedKey);
+    std::string_view keyName = keyToStringView(mappedKey);
 
     // Treat Enter and Backspace as control keys (non-printable). If we pass a
     // non-zero codepoint for these keys the consumer callback will append that
@@ -511,7 +613,7 @@ private:
           if (output_debug_enabled()) {
             TYPR_IO_LOG_DEBUG("Listener (Windows): ignoring duplicate release "
                               "(same cp+mods) for vk=%u key=%s cp=%u mods=%u",
-                              static_cast<unsigned>(vk), keyName.c_str(),
+                              static_cast<unsigned>(vk), keyName.data(),
                               static_cast<unsigned>(codepoint),
                               static_cast<unsigned>(mods));
           }
@@ -536,16 +638,90 @@ private:
       lastPressCp.erase(vk);
     }
 
-    invokeCallback(codepoint, mappedKey, mods, pressed);
+    if (!filter.acceptsKey(mappedKey, pressed) || !filter.acceptsMods(mods)) {
+      stats.filtered();
+      return;
+    }
+    invokeCallback(codepoint, mappedKey, mods, pressed, eventNs, 0);
 
     TYPR_IO_LOG_DEBUG(
         "Listener (Windows) %s: vk=%u sc=%u flags=%u key=%s cp=%u mods=%u",
         pressed ? "press" : "release", static_cast<unsigned>(vk),
         static_cast<unsigned>(kbd->scanCode), static_cast<unsigned>(kbd->flags),
-        keyName.c_str(), static_cast<unsigned>(codepoint),
+        keyName.data(), static_cast<unsigned>(codepoint),
         static_cast<unsigned>(mods));
   }
 
+  /**
+   * @internal
+   * @brief Keyboard layout of the thread owning the foreground window.
+   *
+   * Layouts are per thread and the hook thread has no window of its own to
+   * receive WM_INPUTLANGCHANGE, so the layout the user is typing with is
+   * read from the foreground thread. This is a cheap handle comparison on
+   * the hot path; the expensive translation only reruns when it changes.
+   */
+  static HKL foregroundLayout() {
+    HWND foreground = GetForegroundWindow();
+    DWORD tid =
+        foreground ? GetWindowThreadProcessId(foreground, nullptr) : 0;
+    return GetKeyboardLayout(tid);
+  }
+
+  /**
+   * @internal
+   * @brief Make `layout` the active layout: rebuild the VK -> Key map and
+   * the (VK, modifiers) -> codepoint table for it.
+   */
+  void switchLayout(HKL layout) {
+    TYPR_IO_LOG_DEBUG("Listener (Windows): keyboard layout changed to %p",
+                      static_cast<void *>(layout));
+    activeLayout = layout;
+    initKeyMap(layout);
+    buildLayoutTable(layout);
+  }
+
+  /**
+   * @internal
+   * @brief Translate every VK under every modifier state of `layout`.
+   *
+   * `ToUnicodeEx` runs on a synthetic keyboard state with flag 0x4, which
+   * leaves the system's dead-key buffer untouched (Windows 10 1607+). Dead
+   * keys store no character, as with the per-event translation before.
+   */
+  void buildLayoutTable(HKL layout) {
+    using Table = detail::LayoutCodepointTable<256>;
+    static constexpr UINT kNoStateChange = 0x4;
+    layoutTable.build([layout](std::size_t vk, unsigned state) -> char32_t {
+      BYTE keyState[256]{};
+      if (state & Table::kShift)
+        keyState[VK_SHIFT] = keyState[VK_LSHIFT] = 0x80;
+      if (state & Table::kCtrl)
+        keyState[VK_CONTROL] = keyState[VK_LCONTROL] = 0x80;
+      if (state & Table::kAlt)
+        keyState[VK_MENU] = keyState[VK_LMENU] = 0x80;
+      if (state & Table::kCapsLock)
+        keyState[VK_CAPITAL] = 0x01;
+
+      const UINT sc =
+          MapVirtualKeyEx(static_cast<UINT>(vk), MAPVK_VK_TO_VSC, layout);
+      wchar_t wbuf[4]{0};
+      int ret = ToUnicodeEx(static_cast<UINT>(vk), sc, keyState, wbuf,
+                            static_cast<int>(sizeof(wbuf) / sizeof(wbuf[0])),
+                            kNoStateChange, layout);
+      if (ret < 0) {
+        // Dead key: flush it so older systems that ignore flag 0x4 do not
+        // carry it into the next translation.
+        ToUnicodeEx(static_cast<UINT>(vk), sc, keyState, wbuf,
+                    static_cast<int>(sizeof(wbuf) / sizeof(wbuf[0])),
+                    kNoStateChange, layout);
+        return 0;
+      }
+      return detail::utf16ToCodepoint(reinterpret_cast<const uint16_t *>(wbuf),
+                                      ret);
+    });
+  }
+
   /**
    * @internal
    * @brief Derive the current modifier bitmask via Win32 `GetKeyState`.
@@ -574,23 +750,26 @@ private:
    * @internal
    * @brief Safely invoke the user-provided callback.
    *
-   * Copies the stored callback under `cbMutex` and then invokes it outside
-   * the lock to avoid holding internal mutexes while calling user code.
+   * Invokes the callback published in the RCU cell in place, without taking
+   * a lock or copying the std::function, so no internal mutex is held while
+   * calling user code.
    *
    * @param cp Unicode codepoint produced by the event (0 if none).
    * @param k Logical Key for the event.
    * @param mods Modifier bitmask at time of event.
    * @param pressed True for key press, false for release.
+   * @param eventNs Event timestamp on the steady_clock timeline.
+   * @param device Source device id (0 if unknown).
    */
-  void invokeCallback(char32_t cp, Key k, Modifier mods, bool pressed) {
-    Callback cbCopy;
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      cbCopy = callback;
-    }
-    if (cbCopy) {
-      cbCopy(cp, k, mods, pressed);
-    }
+  void invokeCallback(char32_t cp, Key k, Modifier mods, bool pressed,
+                      uint64_t eventNs, uint16_t device) {
+    const Event event{cp, k, mods, pressed, eventNs, device};
+    stats.timed(eventNs, [&]() {
+      callback.visit([&](const EventCallback &cb) {
+        if (cb)
+          cb(event);
+      });
+    });
   }
 
   /**
@@ -639,6 +818,311 @@ private:
     threadId.store(0);
     ready.store(false);
   }
+
+  /**
+   * @internal
+   * @brief Window procedure of the Raw Input window.
+   *
+   * Input is normally drained in batches by `drainRawInput()`; a WM_INPUT
+   * that still reaches the window is handled one record at a time.
+   */
+  static LRESULT CALLBACK rawInputWindowProc(HWND hwnd, UINT msg,
+                                             WPARAM wParam, LPARAM lParam) {
+    auto *inst =
+        reinterpret_cast<Impl *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+    if (inst && msg == WM_INPUT) {
+      RAWINPUT raw;
+      UINT size = sizeof(raw);
+      if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT,
+                          &raw, &size, sizeof(RAWINPUTHEADER)) !=
+              static_cast<UINT>(-1) &&
+          raw.header.dwType == RIM_TYPEKEYBOARD)
+        inst->handleRawKeyboard(raw.header.hDevice, raw.data.keyboard,
+                                detail::steadyNowNs());
+    } else if (inst && msg == WM_INPUT_DEVICE_CHANGE) {
+      inst->deviceChanged(reinterpret_cast<HANDLE>(lParam),
+                          wParam == GIDC_ARRIVAL);
+      return 0;
+    }
+    return DefWindowProcW(hwnd, msg, wParam, lParam);
+  }
+
+  /**
+   * @internal
+   * @brief Read every pending Raw Input record and dispatch the keyboard
+   * ones.
+   *
+   * The foreground layout is checked and the timestamp taken once per call
+   * rather than per event.
+   */
+  void drainRawInput() {
+    const HKL layout = foregroundLayout();
+    if (layout != activeLayout)
+      switchLayout(layout);
+    const uint64_t nowNs = detail::steadyNowNs();
+
+    for (;;) {
+      UINT size = static_cast<UINT>(rawBuffer.size() * sizeof(uint64_t));
+      auto *raw = reinterpret_cast<RAWINPUT *>(rawBuffer.data());
+      const UINT count = GetRawInputBuffer(raw, &size, sizeof(RAWINPUTHEADER));
+      if (count == static_cast<UINT>(-1)) {
+        if (GetLastError() == ERROR_INSUFFICIENT_BUFFER &&
+            rawBuffer.size() < kMaxRawBufferWords) {
+          rawBuffer.resize(rawBuffer.size() * 2);
+          continue;
+        }
+        TYPR_IO_LOG_ERROR("Listener (Windows): GetRawInputBuffer failed "
+                          "(error %lu)",
+                          GetLastError());
+        return;
+      }
+      if (count == 0)
+        return;
+      for (UINT i = 0; i < count; ++i) {
+        if (raw->header.dwType == RIM_TYPEKEYBOARD)
+          handleRawKeyboard(raw->header.hDevice, rawKeyboard(raw), nowNs);
+        raw = NEXTRAWINPUTBLOCK(raw);
+      }
+    }
+  }
+
+  /**
+   * @internal
+   * @brief Translate one Raw Input keyboard record and deliver it.
+   *
+   * Raw Input reports the generic VK_SHIFT/VK_CONTROL/VK_MENU; they are
+   * resolved to their left/right variants so the same tables as the hook
+   * apply. Modifiers are those held before this event, like `GetKeyState`
+   * in the hook.
+   */
+  void handleRawKeyboard(HANDLE device, const RAWKEYBOARD &kb,
+                         uint64_t eventNs) {
+    // 0xFF is a keyboard overrun; E0 2A / E0 36 are the fake shifts that
+    // wrap navigation keys while NumLock is on.
+    const bool e0 = (kb.Flags & RI_KEY_E0) != 0;
+    if (kb.VKey == 0xFF || kb.VKey >= 256 ||
+        (e0 && (kb.MakeCode == 0x2A || kb.MakeCode == 0x36)))
+      return;
+    const bool pressed = (kb.Flags & RI_KEY_BREAK) == 0;
+
+    WORD vk = kb.VKey;
+    if (vk == VK_SHIFT)
+      vk = static_cast<WORD>(MapVirtualKeyW(kb.MakeCode, MAPVK_VSC_TO_VK_EX));
+    else if (vk == VK_CONTROL)
+      vk = e0 ? VK_RCONTROL : VK_LCONTROL;
+    else if (vk == VK_MENU)
+      vk = e0 ? VK_RMENU : VK_LMENU;
+    if (vk == 0 || vk >= 256)
+      return;
+
+    Key mappedKey = Key::Unknown;
+    if (vk == VK_RETURN && e0) {
+      mappedKey = Key::NumpadEnter;
+    } else {
+      auto it = vkToKey.find(vk);
+      if (it != vkToKey.end())
+        mappedKey = it->second;
+    }
+
+    const Modifier mods = rawModifiers();
+    if (pressed && vk == VK_CAPITAL && !keyDown.test(vk))
+      capsLockOn = !capsLockOn;
+    keyDown.set(vk, pressed);
+
+    // Same early filtering as the hook: keep a rejected press whose release
+    // wants the codepoint cached below.
+    if (!filter.wantsKey(mappedKey) ||
+        (!filter.acceptsKey(mappedKey, pressed) &&
+         !(pressed && filter.releases && filter.needCodepoint))) {
+      stats.filtered();
+      return;
+    }
+
+    char32_t codepoint = 0;
+    if (pressed) {
+      if (filter.needCodepoint && mappedKey != Key::Enter &&
+          mappedKey != Key::Backspace && mappedKey != Key::NumpadEnter)
+        codepoint = layoutTable.find(vk, mods);
+      rawPressCp[vk] = codepoint;
+    } else {
+      codepoint = std::exchange(rawPressCp[vk], 0);
+    }
+
+    if (!filter.acceptsKey(mappedKey, pressed) || !filter.acceptsMods(mods)) {
+      stats.filtered();
+      return;
+    }
+    invokeCallback(codepoint, mappedKey, mods, pressed, eventNs,
+                   deviceId(device));
+
+    TYPR_IO_LOG_DEBUG(
+        "Listener (Windows) raw %s: vk=%u sc=%u flags=%u key=%s cp=%u mods=%u",
+        pressed ? "press" : "release", static_cast<unsigned>(vk),
+        static_cast<unsigned>(kb.MakeCode), static_cast<unsigned>(kb.Flags),
+        keyToStringView(mappedKey).data(), static_cast<unsigned>(codepoint),
+        static_cast<unsigned>(mods));
+  }
+
+  /**
+   * @internal
+   * @brief Modifier bitmask from the keys the Raw Input backend saw held.
+   */
+  Modifier rawModifiers() const {
+    Modifier mods = Modifier::None;
+    if (keyDown.test(VK_LSHIFT) || keyDown.test(VK_RSHIFT))
+      mods = mods | Modifier::Shift;
+    if (keyDown.test(VK_LCONTROL) || keyDown.test(VK_RCONTROL))
+      mods = mods | Modifier::Ctrl;
+    if (keyDown.test(VK_LMENU) || keyDown.test(VK_RMENU))
+      mods = mods | Modifier::Alt;
+    if (keyDown.test(VK_LWIN) || keyDown.test(VK_RWIN))
+      mods = mods | Modifier::Super;
+    if (capsLockOn)
+      mods = mods | Modifier::CapsLock;
+    return mods;
+  }
+
+  /**
+   * @internal
+   * @brief Id of a Raw Input device, registering it on first sight.
+   *
+   * Injected input has no device handle and maps to 0. A device that comes
+   * back on the same interface path keeps its id.
+   */
+  uint16_t deviceId(HANDLE device) {
+    if (!device)
+      return 0;
+    auto it = deviceIds.find(device);
+    if (it != deviceIds.end())
+      return it->second;
+
+    std::string node = rawDeviceName(device);
+    std::lock_guard<std::mutex> lk(deviceMutex);
+    uint16_t id = 0;
+    for (ListenerDevice &d : deviceList) {
+      if (!node.empty() && d.node == node) {
+        d.connected = true;
+        id = d.id;
+        break;
+      }
+    }
+    if (id == 0 && deviceList.size() < 0xFFFF) {
+      ListenerDevice d;
+      d.id = static_cast<uint16_t>(deviceList.size() + 1);
+      d.node = std::move(node);
+      d.connected = true;
+      id = d.id;
+      TYPR_IO_LOG_INFO("Listener (Windows): keyboard %u: %s",
+                       static_cast<unsigned>(id), d.node.c_str());
+      deviceList.push_back(std::move(d));
+    }
+    deviceIds.emplace(device, id);
+    return id;
+  }
+
+  /**
+   * @internal
+   * @brief Track WM_INPUT_DEVICE_CHANGE arrivals and removals.
+   */
+  void deviceChanged(HANDLE device, bool arrived) {
+    if (arrived) {
+      deviceId(device);
+      return;
+    }
+    auto it = deviceIds.find(device);
+    if (it == deviceIds.end())
+      return;
+    const uint16_t id = it->second;
+    deviceIds.erase(it);
+    if (id == 0)
+      return;
+    std::lock_guard<std::mutex> lk(deviceMutex);
+    deviceList[id - 1].connected = false;
+    TYPR_IO_LOG_INFO("Listener (Windows): keyboard %u removed",
+                     static_cast<unsigned>(id));
+  }
+
+  /**
+   * @internal
+   * @brief Worker thread main for the Raw Input backend.
+   *
+   * Creates a message-only window, registers it for keyboard input from
+   * every application (RIDEV_INPUTSINK) plus device notifications, and
+   * drains input whenever the queue signals it until WM_QUIT is received.
+   */
+  void threadMainRawInput() {
+    const HINSTANCE instance = GetModuleHandleW(nullptr);
+    WNDCLASSEXW wc{};
+    wc.cbSize = sizeof(wc);
+    wc.lpfnWndProc = &Impl::rawInputWindowProc;
+    wc.hInstance = instance;
+    wc.lpszClassName = kRawInputClass;
+    if (!RegisterClassExW(&wc) &&
+        GetLastError() != ERROR_CLASS_ALREADY_EXISTS) {
+      TYPR_IO_LOG_ERROR("Listener (Windows): RegisterClassExW failed");
+      running.store(false);
+      return;
+    }
+    rawWindow = CreateWindowExW(0, kRawInputClass, L"", 0, 0, 0, 0, 0,
+                                HWND_MESSAGE, nullptr, instance, nullptr);
+    if (!rawWindow) {
+      TYPR_IO_LOG_ERROR("Listener (Windows): CreateWindowExW failed");
+      running.store(false);
+      return;
+    }
+    // The window gave this thread a message queue; stop() can post WM_QUIT
+    threadId.store(GetCurrentThreadId());
+    SetWindowLongPtrW(rawWindow, GWLP_USERDATA,
+                      reinterpret_cast<LONG_PTR>(this));
+
+    RAWINPUTDEVICE rid{};
+    rid.usUsagePage = 0x01; // Generic desktop
+    rid.usUsage = 0x06;     // Keyboard
+    rid.dwFlags = RIDEV_INPUTSINK | RIDEV_DEVNOTIFY;
+    rid.hwndTarget = rawWindow;
+    if (!RegisterRawInputDevices(&rid, 1, sizeof(rid))) {
+      TYPR_IO_LOG_ERROR("Listener (Windows): RegisterRawInputDevices failed "
+                        "(error %lu)",
+                        GetLastError());
+      DestroyWindow(rawWindow);
+      rawWindow = nullptr;
+      threadId.store(0);
+      running.store(false);
+      return;
+    }
+
+    rawBuffer.assign(kRawBufferWords, 0);
+    keyDown.reset();
+    rawPressCp.fill(0);
+    capsLockOn = (GetKeyState(VK_CAPITAL) & 0x0001) != 0;
+    ready.store(true);
+    TYPR_IO_LOG_INFO("Listener (Windows): raw input registered");
+
+    MSG msg;
+    bool quit = false;
+    while (!quit && running.load()) {
+      MsgWaitForMultipleObjectsEx(0, nullptr, INFINITE, QS_ALLINPUT,
+                                  MWMO_INPUTAVAILABLE);
+      drainRawInput();
+      while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
+        if (msg.message == WM_QUIT) {
+          quit = true;
+          break;
+        }
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
+      }
+    }
+
+    // Cleanup
+    rid.dwFlags = RIDEV_REMOVE;
+    rid.hwndTarget = nullptr;
+    RegisterRawInputDevices(&rid, 1, sizeof(rid));
+    DestroyWindow(rawWindow);
+    rawWindow = nullptr;
+    threadId.store(0);
+    ready.store(false);
+  }
 };
 
 // Static instance pointer definition
@@ -646,14 +1130,17 @@ std::atomic<Listener::Impl *> Listener::Impl::s_instance{nullptr};
 
 // OutputListener public API wrappers
 
-TYPR_IO_API Listener::Listener() : m_impl(std::make_unique<Impl>()) {}
+TYPR_IO_API Listener::Listener() : Listener(ListenerOptions{}) {}
+TYPR_IO_API Listener::Listener(const ListenerOptions &options)
+    : m_impl(std::make_unique<Impl>(options)) {}
 TYPR_IO_API Listener::~Listener() { stop(); }
 TYPR_IO_API Listener::Listener(Listener &&) noexcept = default;
 TYPR_IO_API Listener &Listener::operator=(Listener &&) noexcept = default;
 
-TYPR_IO_API bool Listener::start(Callback cb) {
+TYPR_IO_API bool Listener::start(EventCallback cb,
+                                 const ListenerFilter &filter) {
   TYPR_IO_LOG_DEBUG("Listener::start() called (Windows)");
-  return m_impl ? m_impl->start(std::move(cb)) : false;
+  return m_impl ? m_impl->start(std::move(cb), filter) : false;
 }
 
 TYPR_IO_API void Listener::stop() {
@@ -667,6 +1154,17 @@ TYPR_IO_API bool Listener::isListening() const {
   return m_impl ? m_impl->isRunning() : false;
 }
 
+TYPR_IO_API ListenerStats Listener::stats() const {
+  return m_impl ? m_impl->stats.snapshot(droppedEvents()) : ListenerStats{};
+}
+
+TYPR_IO_API std::vector<ListenerDevice> Listener::devices() const {
+  return m_impl ? m_impl->devices() : std::vector<ListenerDevice>{};
+}
+
+// Both backends deliver every event from their single worker thread
+TYPR_IO_API bool Listener::concurrentCallbacks() const { return false; }
+
 } // namespace typr::io
 
 #endif // _WIN32
@@ -0,0 +1,344 @@
+/**
+ * @file recorder.cpp
+ * @brief Platform-independent implementation of typr::io::Recorder and
+ * typr::io::RecordingReader.
+ *
+ * The Recorder sits on the listener's platform thread, so `record()` does
+ * nothing but push the event into a single-producer ring. A writer thread
+ * drains the ring in batches, encodes the records into a byte buffer and
+ * hands the buffer to the stream in large chunks. The writer sleeps on a
+ * C++20 atomic wait while idle; the producer only pays for a wake-up when
+ * the writer is actually asleep.
+ */
+
+#include <typr-io/recorder.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <typr-io/log.hpp>
+#include <typr-io/sender.hpp>
+
+#include "common/pacer.hpp"
+#include "common/spsc_ring.hpp"
+#include "common/stats_recorder.hpp"
+#include "common/varint.hpp"
+
+namespace typr::io {
+
+namespace {
+
+constexpr char kMagic[7] = {'T', 'Y', 'P', 'R', 'R', 'E', 'C'};
+constexpr uint8_t kFormatVersion = 1;
+constexpr std::size_t kHeaderSize = sizeof(kMagic) + 1;
+
+// Largest encoded record: three varints and the modifier byte
+constexpr std::size_t kMaxRecordBytes = 3 * detail::kMaxVarintBytes + 1;
+
+} // namespace
+
+/**
+ * @internal
+ * @brief Pimpl for Recorder: ring, encoder state and writer thread.
+ */
+struct Recorder::Impl {
+  static constexpr std::size_t kBatch = 256;
+  static constexpr std::size_t kFlushBytes = 64 * 1024;
+
+  std::ostream &out;
+  detail::SpscRing<Listener::Event> ring;
+
+  std::atomic<uint64_t> recorded{0};
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<bool> stopped{false};
+  std::atomic<uint32_t> producing{0}; // record() calls in flight
+
+  // Writer wake-up channel (value carries no meaning) and its sleep flag
+  std::atomic<uint32_t> wakeups{0};
+  std::atomic<bool> writerIdle{false};
+  std::thread writer;
+
+  // Writer thread only (and stop(), once the writer has exited)
+  std::vector<uint8_t> buffer;
+  uint64_t lastNs;
+
+  Impl(std::ostream &stream, std::size_t capacity)
+      : out(stream), ring(capacity), lastNs(detail::steadyNowNs()) {
+    buffer.reserve(kFlushBytes + kBatch * kMaxRecordBytes);
+    out.write(kMagic, sizeof(kMagic));
+    out.put(static_cast<char>(kFormatVersion));
+    writer = std::thread([this]() { run(); });
+  }
+
+  ~Impl() { stop(); }
+
+  Impl(const Impl &) = delete;
+  Impl &operator=(const Impl &) = delete;
+
+  void record(const Listener::Event &event) {
+    // Announced before the flag check; stop() sets the flag before waiting
+    // for announced calls, so an event pushed here is drained by stop()
+    producing.fetch_add(1);
+    if (stopped.load() || !ring.tryPush(event)) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      producing.fetch_sub(1, std::memory_order_release);
+      return;
+    }
+    recorded.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in run(): either the writer sees the event before
+    // sleeping or we see it asleep and wake it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerIdle.load(std::memory_order_relaxed)) {
+      wakeups.fetch_add(1, std::memory_order_release);
+      wakeups.notify_one();
+    }
+    producing.fetch_sub(1, std::memory_order_release);
+  }
+
+  void stop() {
+    if (stopped.exchange(true))
+      return;
+    while (producing.load(std::memory_order_acquire) != 0)
+      std::this_thread::yield();
+    wakeups.fetch_add(1, std::memory_order_release);
+    wakeups.notify_one();
+    if (writer.joinable())
+      writer.join();
+    // The writer may have finished its last drain before a racing record()
+    // pushed; with the writer gone this thread is the only consumer
+    drain();
+    flushBuffer();
+    out.flush();
+    TYPR_IO_LOG_INFO("Recorder: stopped (recorded=%llu dropped=%llu)",
+                     static_cast<unsigned long long>(recorded.load()),
+                     static_cast<unsigned long long>(dropped.load()));
+  }
+
+  void encode(const Listener::Event &event) {
+    const uint64_t ts = event.timestampNs ? event.timestampNs
+                                          : detail::steadyNowNs();
+    // Out-of-order timestamps (different devices) are recorded as 0 deltas.
+    // Advancing by whole microseconds keeps the sub-microsecond remainder, so
+    // rounding never accumulates over a long session.
+    const uint64_t deltaUs = ts > lastNs ? (ts - lastNs) / 1000 : 0;
+    lastNs += deltaUs * 1000;
+
+    uint8_t record[kMaxRecordBytes];
+    std::size_t n = detail::encodeVarint(deltaUs, record);
+    n += detail::encodeVarint(static_cast<uint16_t>(event.key), record + n);
+    record[n++] = static_cast<uint8_t>(event.mods);
+    n += detail::encodeVarint((static_cast<uint64_t>(event.codepoint) << 1) |
+                                  (event.pressed ? 1u : 0u),
+                              record + n);
+    buffer.insert(buffer.end(), record, record + n);
+  }
+
+  void flushBuffer() {
+    if (buffer.empty())
+      return;
+    out.write(reinterpret_cast<const char *>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+  }
+
+  void drain() {
+    std::array<Listener::Event, kBatch> batch;
+    while (std::size_t n = ring.popBulk(batch.data(), batch.size())) {
+      for (std::size_t i = 0; i < n; ++i)
+        encode(batch[i]);
+      if (buffer.size() >= kFlushBytes)
+        flushBuffer();
+    }
+  }
+
+  void run() {
+    for (;;) {
+      const uint32_t seen = wakeups.load(std::memory_order_acquire);
+      drain();
+      if (stopped.load(std::memory_order_acquire)) {
+        drain();
+        flushBuffer();
+        out.flush();
+        return;
+      }
+      // Idle: hand what we have to the stream before sleeping
+      flushBuffer();
+      out.flush();
+      writerIdle.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (ring.size() == 0 && !stopped.load(std::memory_order_acquire))
+        wakeups.wait(seen, std::memory_order_acquire);
+      writerIdle.store(false, std::memory_order_relaxed);
+    }
+  }
+};
+
+Recorder::Recorder(std::ostream &out, std::size_t capacity)
+    : m_impl(std::make_unique<Impl>(out, capacity)) {}
+Recorder::~Recorder() = default;
+Recorder::Recorder(Recorder &&) noexcept = default;
+Recorder &Recorder::operator=(Recorder &&) noexcept = default;
+
+void Recorder::record(const Listener::Event &event) {
+  if (m_impl)
+    m_impl->record(event);
+}
+
+bool Recorder::attach(Listener &listener, Listener::EventCallback forward) {
+  // record() has a single producer
+  if (!m_impl || listener.concurrentCallbacks())
+    return false;
+  // The callback holds the Impl, which stays put when the Recorder moves
+  Impl *impl = m_impl.get();
+  return listener.start(Listener::EventCallback(
+      [impl, forward = std::move(forward)](const Listener::Event &event) {
+        impl->record(event);
+        if (forward)
+          forward(event);
+      }));
+}
+
+void Recorder::stop() {
+  if (m_impl)
+    m_impl->stop();
+}
+
+uint64_t Recorder::recordedEvents() const {
+  return m_impl ? m_impl->recorded.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t Recorder::droppedEvents() const {
+  return m_impl ? m_impl->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+/**
+ * @internal
+ * @brief Pimpl for RecordingReader: buffered decoding from the stream.
+ */
+struct RecordingReader::Impl {
+  static constexpr std::size_t kChunk = 64 * 1024;
+
+  std::istream &in;
+  std::vector<uint8_t> buffer;
+  std::size_t pos{0};
+  bool ok{false};
+  uint64_t timeNs{0};
+
+  explicit Impl(std::istream &stream) : in(stream) {
+    char header[kHeaderSize];
+    if (in.read(header, kHeaderSize) &&
+        std::memcmp(header, kMagic, sizeof(kMagic)) == 0 &&
+        static_cast<uint8_t>(header[sizeof(kMagic)]) == kFormatVersion)
+      ok = true;
+    else
+      TYPR_IO_LOG_WARN("RecordingReader: missing or unsupported header");
+  }
+
+  // Make sure at least one whole record is buffered (unless at EOF)
+  void fill() {
+    if (buffer.size() - pos >= kMaxRecordBytes || !in)
+      return;
+    buffer.erase(buffer.begin(),
+                 buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+    pos = 0;
+    const std::size_t keep = buffer.size();
+    buffer.resize(keep + kChunk);
+    in.read(reinterpret_cast<char *>(buffer.data() + keep), kChunk);
+    buffer.resize(keep + static_cast<std::size_t>(in.gcount()));
+  }
+
+  std::optional<Listener::Event> next() {
+    if (!ok)
+      return std::nullopt;
+    fill();
+    if (pos == buffer.size())
+      return std::nullopt; // clean end of stream
+
+    const uint8_t *p = buffer.data() + pos;
+    const std::size_t avail = buffer.size() - pos;
+    std::size_t used = 0;
+    uint64_t deltaUs = 0, key = 0, cpPressed = 0;
+    std::size_t n = detail::decodeVarint(p, avail, deltaUs);
+    if (n != 0) {
+      used += n;
+      n = detail::decodeVarint(p + used, avail - used, key);
+    }
+    if (n != 0 && used + n < avail) {
+      used += n;
+      const uint8_t mods = p[used++];
+      n = detail::decodeVarint(p + used, avail - used, cpPressed);
+      if (n != 0 && key <= UINT16_MAX && (cpPressed >> 1) <= 0x10FFFF) {
+        used += n;
+        pos += used;
+        timeNs += deltaUs * 1000;
+        Listener::Event event;
+        event.codepoint = static_cast<char32_t>(cpPressed >> 1);
+        event.key = static_cast<Key>(key);
+        event.mods = static_cast<Modifier>(mods);
+        event.pressed = (cpPressed & 1u) != 0;
+        event.timestampNs = timeNs;
+        return event;
+      }
+    }
+    TYPR_IO_LOG_WARN("RecordingReader: malformed record at byte offset %zu",
+                     pos);
+    ok = false;
+    return std::nullopt;
+  }
+};
+
+RecordingReader::RecordingReader(std::istream &in)
+    : m_impl(std::make_unique<Impl>(in)) {}
+RecordingReader::~RecordingReader() = default;
+RecordingReader::RecordingReader(RecordingReader &&) noexcept = default;
+RecordingReader &
+RecordingReader::operator=(RecordingReader &&) noexcept = default;
+
+bool RecordingReader::valid() const { return m_impl && m_impl->ok; }
+
+std::optional<Listener::Event> RecordingReader::next() {
+  return m_impl ? m_impl->next() : std::nullopt;
+}
+
+bool RecordingReader::replay(Sender &sender, double speed) {
+  if (!m_impl || !(speed > 0.0))
+    return false;
+
+  bool allOk = true;
+  bool anchored = false;
+  uint64_t firstNs = 0;
+  detail::PacerClock::time_point start{};
+  while (auto event = m_impl->next()) {
+    if (!anchored) {
+      firstNs = event->timestampNs;
+      start = detail::PacerClock::now();
+      anchored = true;
+    }
+    // A tiny speed can push the offset past the nanosecond range; saturate
+    // before the cast and let deadlineAfter() saturate the time_point
+    const double offsetNs =
+        static_cast<double>(event->timestampNs - firstNs) / speed;
+    const auto offset =
+        offsetNs < static_cast<double>(std::chrono::nanoseconds::max().count())
+            ? std::chrono::nanoseconds(static_cast<long long>(offsetNs))
+            : std::chrono::nanoseconds::max();
+    detail::sleepUntil(detail::deadlineAfter(start, offset));
+
+    if (event->key != Key::Unknown) {
+      allOk &= event->pressed ? sender.keyDown(event->key)
+                              : sender.keyUp(event->key);
+    } else if (event->pressed && event->codepoint != 0) {
+      allOk &= sender.typeCharacter(event->codepoint);
+    }
+  }
+  return allOk && m_impl->ok;
+}
+
+} // namespace typr::io
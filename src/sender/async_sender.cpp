@@ -0,0 +1,256 @@
+/**
+ * @file async_sender.cpp
+ * @brief Platform-independent implementation of typr::io::AsyncSender.
+ *
+ * The AsyncSender wraps a regular `Sender` (and therefore whichever backend
+ * `Sender::Impl` was compiled in) and drives it from a dedicated worker
+ * thread. Submissions go through a bounded MPSC lock-free ring; the worker
+ * sleeps on a C++20 atomic wait when the ring is empty, and producers that
+ * use the blocking `submit()` sleep on a second counter, bumped whenever the
+ * worker takes a batch out of the ring, while it is full.
+ */
+
+#include <typr-io/async_sender.hpp>
+
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <utility>
+
+#include <typr-io/log.hpp>
+
+#include "common/mpsc_ring.hpp"
+
+namespace typr::io {
+
+namespace {
+
+/**
+ * @internal
+ * @brief One queued batch and the promise that reports its completion.
+ */
+struct Task {
+  AsyncSender::Job job;
+  std::promise<bool> promise;
+};
+
+/**
+ * @internal
+ * @brief Return a future that is already completed with `value`.
+ */
+std::future<bool> readyFuture(bool value) {
+  std::promise<bool> p;
+  p.set_value(value);
+  return p.get_future();
+}
+
+} // namespace
+
+/**
+ * @internal
+ * @brief Pimpl for AsyncSender.
+ *
+ * Owns the wrapped Sender, the submission ring and the worker thread. The
+ * `submitted` / `consumed` counters only serve as wake-up channels for
+ * `std::atomic::wait`; their absolute values carry no meaning.
+ */
+struct AsyncSender::Impl {
+  Sender sender;
+  BackendType backend;
+  Capabilities caps;
+  bool ready;
+
+  detail::MpscRing<Task> ring;
+  std::atomic<uint32_t> submitted{0};
+  std::atomic<uint32_t> consumed{0};
+  std::atomic<bool> stopping{false};
+  std::thread worker;
+
+  explicit Impl(std::size_t capacity)
+      : backend(sender.type()), caps(sender.capabilities()),
+        ready(sender.isReady()), ring(capacity) {
+    worker = std::thread([this]() { run(); });
+    TYPR_IO_LOG_INFO("AsyncSender: worker started (capacity=%zu ready=%u)",
+                     ring.capacity(), static_cast<unsigned>(ready));
+  }
+
+  ~Impl() {
+    stopping.store(true, std::memory_order_release);
+    submitted.fetch_add(1, std::memory_order_release);
+    submitted.notify_one();
+    if (worker.joinable())
+      worker.join();
+    TYPR_IO_LOG_INFO("AsyncSender: worker stopped");
+  }
+
+  Impl(const Impl &) = delete;
+  Impl &operator=(const Impl &) = delete;
+
+  /**
+   * @internal
+   * @brief Run a batch and fulfil its promise with the result or exception.
+   */
+  void execute(Task &task) {
+    try {
+      bool ok = task.job ? task.job(sender) : false;
+      task.promise.set_value(ok);
+    } catch (...) {
+      task.promise.set_exception(std::current_exception());
+    }
+    task = Task{};
+  }
+
+  /**
+   * @internal
+   * @brief Take the next batch out of the ring.
+   *
+   * Blocked producers are woken as soon as the slot is free, not when the
+   * batch completes, so one long `holdFor()` / `repeat()` job does not stall
+   * them while the ring has room.
+   */
+  bool pop(Task &task) {
+    if (!ring.tryPop(task))
+      return false;
+    consumed.fetch_add(1, std::memory_order_release);
+    consumed.notify_all();
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Worker loop: drain the ring, then sleep until the next submit.
+   *
+   * On shutdown the ring is drained one final time so every future handed
+   * out before destruction completes.
+   */
+  void run() {
+    Task task;
+    for (;;) {
+      uint32_t seen = submitted.load(std::memory_order_acquire);
+      while (pop(task))
+        execute(task);
+      if (stopping.load(std::memory_order_acquire)) {
+        while (pop(task))
+          execute(task);
+        return;
+      }
+      submitted.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+  /**
+   * @internal
+   * @brief Publish a task and wake the worker.
+   * @return false if the ring is full (the task is left untouched).
+   */
+  bool push(Task &task) {
+    if (!ring.tryPush(std::move(task)))
+      return false;
+    submitted.fetch_add(1, std::memory_order_release);
+    submitted.notify_one();
+    return true;
+  }
+};
+
+AsyncSender::AsyncSender(std::size_t queueCapacity)
+    : m_impl(std::make_unique<Impl>(queueCapacity)) {}
+AsyncSender::~AsyncSender() = default;
+AsyncSender::AsyncSender(AsyncSender &&) noexcept = default;
+AsyncSender &AsyncSender::operator=(AsyncSender &&) noexcept = default;
+
+BackendType AsyncSender::type() const {
+  return m_impl ? m_impl->backend : BackendType::Unknown;
+}
+
+Capabilities AsyncSender::capabilities() const {
+  return m_impl ? m_impl->caps : Capabilities{};
+}
+
+bool AsyncSender::isReady() const { return m_impl && m_impl->ready; }
+
+std::future<bool> AsyncSender::submit(Job job) {
+  if (!m_impl)
+    return readyFuture(false);
+
+  Task task{std::move(job), {}};
+  std::future<bool> fut = task.promise.get_future();
+  for (;;) {
+    uint32_t seen = m_impl->consumed.load(std::memory_order_acquire);
+    if (m_impl->push(task))
+      return fut;
+    // Full: sleep until the worker frees a slot, then retry
+    m_impl->consumed.wait(seen, std::memory_order_acquire);
+  }
+}
+
+std::optional<std::future<bool>> AsyncSender::trySubmit(Job job) {
+  if (!m_impl)
+    return readyFuture(false);
+
+  Task task{std::move(job), {}};
+  std::future<bool> fut = task.promise.get_future();
+  if (!m_impl->push(task))
+    return std::nullopt;
+  return fut;
+}
+
+std::size_t AsyncSender::queueDepth() const {
+  return m_impl ? m_impl->ring.size() : 0;
+}
+
+std::size_t AsyncSender::queueCapacity() const {
+  return m_impl ? m_impl->ring.capacity() : 0;
+}
+
+SenderStats AsyncSender::stats() const {
+  // The recorder is atomic, so reading it off the worker thread is safe
+  return m_impl ? m_impl->sender.stats() : SenderStats{};
+}
+
+std::future<bool> AsyncSender::keyDown(Key key) {
+  return submit([key](Sender &s) { return s.keyDown(key); });
+}
+
+std::future<bool> AsyncSender::keyUp(Key key) {
+  return submit([key](Sender &s) { return s.keyUp(key); });
+}
+
+std::future<bool> AsyncSender::tap(Key key) {
+  return submit([key](Sender &s) { return s.tap(key); });
+}
+
+std::future<bool> AsyncSender::holdFor(Key key,
+                                       std::chrono::microseconds duration) {
+  return submit(
+      [key, duration](Sender &s) { return s.holdFor(key, duration); });
+}
+
+std::future<bool> AsyncSender::repeat(Key key, uint32_t count,
+                                      double perSecond) {
+  return submit([key, count, perSecond](Sender &s) {
+    return s.repeat(key, count, perSecond);
+  });
+}
+
+std::future<bool> AsyncSender::combo(Modifier mods, Key key) {
+  return submit([mods, key](Sender &s) { return s.combo(mods, key); });
+}
+
+std::future<bool> AsyncSender::typeText(std::u32string text) {
+  return submit(
+      [text = std::move(text)](Sender &s) { return s.typeText(text); });
+}
+
+std::future<bool> AsyncSender::typeText(std::string utf8Text) {
+  return submit([text = std::move(utf8Text)](Sender &s) {
+    return s.typeText(text);
+  });
+}
+
+std::future<bool> AsyncSender::typeTextBulk(std::string utf8Text) {
+  return submit([text = std::move(utf8Text)](Sender &s) {
+    return s.typeTextBulk(text);
+  });
+}
+
+} // namespace typr::io
@@ -0,0 +1,139 @@
+/**
+ * @file key_sequence.cpp
+ * @brief Backend-independent part of `KeySequence`: building the step list.
+ *
+ * Compiling the steps into native events is done by each Sender backend in
+ * `Sender::play()` (see `sender/sequence_cache.hpp`).
+ */
+
+#include <typr-io/key_sequence.hpp>
+
+#include "common/utf8.hpp"
+
+#include <atomic>
+#include <limits>
+#include <utility>
+
+namespace typr::io {
+
+namespace {
+
+uint64_t nextSequenceId() {
+  static std::atomic<uint64_t> counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace
+
+KeySequence::KeySequence() : m_id(nextSequenceId()) {}
+
+KeySequence::KeySequence(const KeySequence &other)
+    : m_steps(other.m_steps), m_text(other.m_text), m_id(nextSequenceId()) {}
+
+KeySequence &KeySequence::operator=(const KeySequence &other) {
+  if (this != &other) {
+    m_steps = other.m_steps;
+    m_text = other.m_text;
+    ++m_revision;
+  }
+  return *this;
+}
+
+// A moved-to sequence keeps the source's identity and revision, so programs
+// compiled for it stay valid; the source starts over as a new sequence.
+KeySequence::KeySequence(KeySequence &&other) noexcept
+    : m_steps(std::move(other.m_steps)), m_text(std::move(other.m_text)),
+      m_id(other.m_id), m_revision(other.m_revision) {
+  other.m_steps.clear();
+  other.m_text.clear();
+  other.m_id = nextSequenceId();
+  other.m_revision = 0;
+}
+
+KeySequence &KeySequence::operator=(KeySequence &&other) noexcept {
+  if (this != &other) {
+    m_steps = std::move(other.m_steps);
+    m_text = std::move(other.m_text);
+    m_id = other.m_id;
+    m_revision = other.m_revision;
+    other.m_steps.clear();
+    other.m_text.clear();
+    other.m_id = nextSequenceId();
+    other.m_revision = 0;
+  }
+  return *this;
+}
+
+KeySequence &KeySequence::append(const Step &step) {
+  m_steps.push_back(step);
+  ++m_revision;
+  return *this;
+}
+
+KeySequence &KeySequence::keyDown(Key key) {
+  return append({.kind = StepKind::KeyDown, .key = key});
+}
+
+KeySequence &KeySequence::keyUp(Key key) {
+  return append({.kind = StepKind::KeyUp, .key = key});
+}
+
+KeySequence &KeySequence::tap(Key key) { return keyDown(key).keyUp(key); }
+
+KeySequence &KeySequence::combo(Modifier mods, Key key) {
+  static constexpr std::pair<Modifier, Key> kModifierKeys[] = {
+      {Modifier::Shift, Key::ShiftLeft},
+      {Modifier::Ctrl, Key::CtrlLeft},
+      {Modifier::Alt, Key::AltLeft},
+      {Modifier::Super, Key::SuperLeft},
+  };
+  for (const auto &[mod, modKey] : kModifierKeys) {
+    if (hasModifier(mods, mod))
+      keyDown(modKey);
+  }
+  tap(key);
+  for (const auto &[mod, modKey] : kModifierKeys) {
+    if (hasModifier(mods, mod))
+      keyUp(modKey);
+  }
+  return *this;
+}
+
+KeySequence &KeySequence::typeText(std::u32string_view text) {
+  if (text.empty())
+    return *this;
+  // Step offsets are 32-bit; a single sequence never holds 4 G codepoints
+  const auto offset = static_cast<uint32_t>(m_text.size());
+  m_text.append(text);
+  return append({.kind = StepKind::Text,
+                 .textOffset = offset,
+                 .textLength = static_cast<uint32_t>(text.size())});
+}
+
+KeySequence &KeySequence::typeText(std::string_view utf8Text) {
+  return typeText(detail::utf8ToUtf32(utf8Text));
+}
+
+KeySequence &KeySequence::delay(std::chrono::microseconds duration) {
+  if (duration.count() <= 0)
+    return *this;
+  const auto maxUs = std::numeric_limits<uint32_t>::max();
+  const auto us = duration.count() > maxUs ? maxUs : duration.count();
+  return append(
+      {.kind = StepKind::Delay, .delayUs = static_cast<uint32_t>(us)});
+}
+
+void KeySequence::clear() {
+  m_steps.clear();
+  m_text.clear();
+  ++m_revision;
+}
+
+std::u32string_view KeySequence::textOf(const Step &step) const {
+  if (step.kind != StepKind::Text ||
+      static_cast<size_t>(step.textOffset) + step.textLength > m_text.size())
+    return {};
+  return std::u32string_view(m_text).substr(step.textOffset, step.textLength);
+}
+
+} // namespace typr::io
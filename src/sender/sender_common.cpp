@@ -0,0 +1,50 @@
+/**
+ * @file sender_common.cpp
+ * @brief Platform-independent parts of typr::io::Sender.
+ *
+ * Each backend implements the individual key edges; this file layers timed
+ * holds and repeat bursts on top of them. Every edge is scheduled on an
+ * absolute deadline measured from the first press, so injection cost does
+ * not accumulate into drift and the calling thread sleeps exactly once per
+ * edge instead of polling. These calls run on the caller's thread;
+ * `AsyncSender` moves them to its worker.
+ */
+
+#include <typr-io/sender.hpp>
+
+#include "common/pacer.hpp"
+
+namespace typr::io {
+
+bool Sender::holdFor(Key key, std::chrono::microseconds duration) {
+  const auto pressedAt = detail::PacerClock::now();
+  if (!keyDown(key))
+    return false;
+  detail::sleepUntil(detail::deadlineAfter(pressedAt, duration));
+  return keyUp(key);
+}
+
+bool Sender::repeat(Key key, uint32_t count, double perSecond) {
+  const std::chrono::nanoseconds interval = detail::rateToInterval(perSecond);
+  if (interval.count() <= 0) {
+    for (uint32_t i = 0; i < count; ++i) {
+      if (!tap(key))
+        return false;
+    }
+    return true;
+  }
+
+  const auto start = detail::PacerClock::now();
+  for (uint32_t i = 0; i < count; ++i) {
+    const detail::TapDeadlines edges = detail::tapDeadlines(start, interval, i);
+    detail::sleepUntil(edges.press);
+    if (!keyDown(key))
+      return false;
+    detail::sleepUntil(edges.release);
+    if (!keyUp(key))
+      return false;
+  }
+  return true;
+}
+
+} // namespace typr::io
@@ -1,13 +1,24 @@
 #ifdef __APPLE__
 
+#include <typr-io/key_sequence.hpp>
 #include <typr-io/sender.hpp>
 
+#include "common/key_table.hpp"
+#include "common/pacer.hpp"
+#include "common/stats_recorder.hpp"
+#include "common/utf8.hpp"
+#include "sender/sequence_cache.hpp"
+
 #include <ApplicationServices/ApplicationServices.h>
 #include <Carbon/Carbon.h>
 #import <Foundation/Foundation.h>
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <mach/mach_time.h>
 #include <thread>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <typr-io/log.hpp>
 
 namespace typr::io {
@@ -39,25 +50,133 @@ CGEventFlags modifierToFlags(Modifier mod) {
 } // namespace
 
 struct Sender::Impl {
-  // Unicode and UTF-16 surrogate pair constants
-  static constexpr char32_t kUnicodeMaxBMP = 0xFFFF;
-  static constexpr char32_t kUnicodeMax = 0x10FFFF;
-  static constexpr char32_t kUnicodeSurrogateOffset = 0x10000;
-  static constexpr char32_t kUnicodeHighSurrogateBase = 0xD800;
-  static constexpr char32_t kUnicodeLowSurrogateBase = 0xDC00;
-  static constexpr char32_t kUnicodeSurrogateMask = 0x3FF;
+  // UTF-16 high surrogate range start (chunks never end on one)
+  static constexpr char16_t kUnicodeHighSurrogateBase = 0xD800;
+  // Most UTF-16 units CGEventKeyboardSetUnicodeString carries in one event
+  static constexpr size_t kMaxCharsPerEvent = 20;
   CGEventSourceRef eventSource{nullptr};
+
+  // Keyboard events created once and mutated in place before each post, so
+  // injection does not allocate a CGEvent per key edge or text chunk. Key
+  // events are kept per (keycode, direction) because CoreGraphics derives
+  // the event type (KeyDown/KeyUp/FlagsChanged) from the keycode at
+  // creation; only their flags change afterwards. The two text events carry
+  // keycode 0, no modifier flags and the Unicode string of each chunk.
+  // CGEventPost copies the event, so reposting the same object is safe.
+  class EventPool {
+  public:
+    static constexpr size_t kKeyCodes = 128;
+
+    EventPool() = default;
+    explicit EventPool(CGEventSourceRef source) : m_source(source) {
+      for (bool down : {true, false}) {
+        CGEventRef event = CGEventCreateKeyboardEvent(source, 0, down);
+        if (event != nullptr) {
+          CGEventSetFlags(event, 0);
+        }
+        m_text[down ? 0 : 1] = event;
+      }
+    }
+    EventPool(EventPool &&other) noexcept
+        : m_source(std::exchange(other.m_source, nullptr)),
+          m_keys(std::exchange(other.m_keys, {})),
+          m_text(std::exchange(other.m_text, {})) {}
+    EventPool &operator=(EventPool &&other) noexcept {
+      if (this != &other) {
+        release();
+        m_source = std::exchange(other.m_source, nullptr);
+        m_keys = std::exchange(other.m_keys, {});
+        m_text = std::exchange(other.m_text, {});
+      }
+      return *this;
+    }
+    EventPool(const EventPool &) = delete;
+    EventPool &operator=(const EventPool &) = delete;
+    ~EventPool() { release(); }
+
+    // Pooled event for a key edge, created on first use; nullptr if the
+    // keycode is outside the pool or creation failed.
+    CGEventRef key(CGKeyCode keyCode, bool down) {
+      if (keyCode >= kKeyCodes) {
+        return nullptr;
+      }
+      CGEventRef &slot = m_keys[(static_cast<size_t>(keyCode) * 2) + (down ? 0 : 1)];
+      if (slot == nullptr) {
+        slot = CGEventCreateKeyboardEvent(m_source, keyCode, down);
+      }
+      return slot;
+    }
+
+    [[nodiscard]] CGEventRef text(bool down) const { return m_text[down ? 0 : 1]; }
+
+  private:
+    void release() {
+      for (CGEventRef &event : m_keys) {
+        if (event != nullptr) {
+          CFRelease(event);
+          event = nullptr;
+        }
+      }
+      for (CGEventRef &event : m_text) {
+        if (event != nullptr) {
+          CFRelease(event);
+          event = nullptr;
+        }
+      }
+    }
+
+    CGEventSourceRef m_source{nullptr}; // owned by Impl
+    std::array<CGEventRef, kKeyCodes * 2> m_keys{};
+    std::array<CGEventRef, 2> m_text{};
+  };
+  // Mutable because the posting helpers are const
+  mutable EventPool events;
   Modifier currentMods{Modifier::None};
   static constexpr uint32_t kDefaultKeyDelayUs = 1000;
   uint32_t keyDelayUs{kDefaultKeyDelayUs};
   bool ready{false};
 
   // Map from our Key enum to macOS keycodes
-  std::unordered_map<Key, CGKeyCode> keyMap;
+  detail::KeyTable<CGKeyCode, UINT16_MAX> keyMap;
+
+  // Absolute-deadline pacing for key edges and (optionally) typed characters
+  detail::Pacer keyPacer;
+  detail::Pacer charPacer;
+  double charsPerSecond{0.0};
+
+  // Injection counters; read by Sender::stats(). Mutable because the
+  // posting helpers are const.
+  mutable detail::SenderStatsRecorder stats;
+
+  // A KeySequence compiled to prebuilt CGEvents. `segments` split the events
+  // at the sequence's delay steps; each segment is posted back to back and
+  // followed by its delay.
+  struct SequenceProgram {
+    struct Segment {
+      size_t end{0};       // one past the segment's last event
+      uint32_t delayUs{0}; // wait after posting the segment
+    };
+    std::vector<CGEventRef> events;
+    std::vector<Segment> segments;
+    bool complete{true}; // false if a key had no mapping or an event failed
+
+    SequenceProgram() = default;
+    SequenceProgram(SequenceProgram &&) noexcept = default;
+    SequenceProgram &operator=(SequenceProgram &&) noexcept = delete;
+    SequenceProgram(const SequenceProgram &) = delete;
+    SequenceProgram &operator=(const SequenceProgram &) = delete;
+    ~SequenceProgram() {
+      for (CGEventRef event : events) {
+        CFRelease(event);
+      }
+    }
+  };
+  detail::SequenceCache<SequenceProgram> sequences;
 
   Impl()
       : eventSource(CGEventSourceCreate(kCGEventSourceStateHIDSystemState)),
-        ready(AXIsProcessTrustedWithOptions(nullptr) != 0U) {
+        events(eventSource), ready(AXIsProcessTrustedWithOptions(nullptr) != 0U) {
+    keyPacer.setInterval(std::chrono::microseconds(keyDelayUs));
     initKeyMap();
     TYPR_IO_LOG_INFO("Sender (macOS): Impl created; ready=%u", static_cast<unsigned>(ready));
     TYPR_IO_LOG_DEBUG("Sender (macOS): eventSource=%p", eventSource);
@@ -74,9 +193,12 @@ struct Sender::Impl {
   Impl &operator=(const Impl &) = delete;
 
   Impl(Impl &&other) noexcept
-      : eventSource(other.eventSource), currentMods(other.currentMods),
+      : eventSource(other.eventSource), events(std::move(other.events)),
+        currentMods(other.currentMods),
         keyDelayUs(other.keyDelayUs), ready(other.ready),
-        keyMap(std::move(other.keyMap)) {
+        keyMap(std::move(other.keyMap)), keyPacer(other.keyPacer),
+        charPacer(other.charPacer), charsPerSecond(other.charsPerSecond),
+        sequences(std::move(other.sequences)) {
     other.eventSource = nullptr;
     other.currentMods = Modifier::None;
     other.keyDelayUs = 0;
@@ -87,6 +209,7 @@ struct Sender::Impl {
     if (this == &other) {
       return *this;
     }
+    events = std::move(other.events);
     if (eventSource != nullptr) {
       CFRelease(eventSource);
     }
@@ -95,6 +218,10 @@ struct Sender::Impl {
     keyDelayUs = other.keyDelayUs;
     ready = other.ready;
     keyMap = std::move(other.keyMap);
+    keyPacer = other.keyPacer;
+    charPacer = other.charPacer;
+    charsPerSecond = other.charsPerSecond;
+    sequences = std::move(other.sequences);
 
     other.eventSource = nullptr;
     other.currentMods = Modifier::None;
@@ -158,18 +285,14 @@ struct Sender::Impl {
 
         Key mappedKeyEnum = stringToKey(mappedKeyString);
         if (mappedKeyEnum != Key::Unknown) {
-          if (keyMap.find(mappedKeyEnum) == keyMap.end()) {
-            keyMap[mappedKeyEnum] = static_cast<CGKeyCode>(keyCode);
-          }
+          keyMap.insert(mappedKeyEnum, static_cast<CGKeyCode>(keyCode));
         }
       }
     }
 
     // Fallback explicit mappings for common non-printable keys / modifiers
     auto setIfMissing = [this](Key keyToSet, CGKeyCode code) {
-      if (this->keyMap.find(keyToSet) == this->keyMap.end()) {
-        this->keyMap[keyToSet] = code;
-      }
+      this->keyMap.insert(keyToSet, code);
     };
 
     // Common keys
@@ -256,98 +379,210 @@ struct Sender::Impl {
   }
 
   [[nodiscard]] CGKeyCode macKeyCodeFor(Key key) const {
-    auto keyMapIt = keyMap.find(key);
-    static constexpr CGKeyCode kInvalidKeyCode = UINT16_MAX;
-    if (keyMapIt != keyMap.end())
-      return keyMapIt->second;
-    TYPR_IO_LOG_DEBUG("Sender (macOS): macKeyCodeFor(key=%s) -> invalid", keyToString(key).c_str());
-    return kInvalidKeyCode;
+    CGKeyCode code = keyMap.find(key);
+    if (code == keyMap.kInvalid)
+      TYPR_IO_LOG_DEBUG("Sender (macOS): macKeyCodeFor(key=%s) -> invalid", keyToStringView(key).data());
+    return code;
   }
 
   bool sendKey(Key key, bool down) const {
     CGKeyCode keyCode = macKeyCodeFor(key);
     static constexpr CGKeyCode kInvalidKeyCode = UINT16_MAX;
     if (keyCode == kInvalidKeyCode) {
-      TYPR_IO_LOG_DEBUG("Sender (macOS): sendKey - no mapping for key=%s", keyToString(key).c_str());
+      TYPR_IO_LOG_DEBUG("Sender (macOS): sendKey - no mapping for key=%s", keyToStringView(key).data());
       return false;
     }
 
-    CGEventRef event = CGEventCreateKeyboardEvent(eventSource, keyCode, down);
+    // Keycodes outside the pool fall back to a one-off event
+    CGEventRef pooled = events.key(keyCode, down);
+    CGEventRef event =
+        pooled != nullptr ? pooled : CGEventCreateKeyboardEvent(eventSource, keyCode, down);
     if (event == nullptr) {
-      TYPR_IO_LOG_ERROR("Sender (macOS): CGEventCreateKeyboardEvent returned null for key=%s", keyToString(key).c_str());
+      TYPR_IO_LOG_ERROR("Sender (macOS): CGEventCreateKeyboardEvent returned null for key=%s", keyToStringView(key).data());
       return false;
     }
 
     // Apply current modifier state
     CGEventSetFlags(event, modifierToFlags(currentMods));
-    CGEventPost(kCGHIDEventTap, event);
-    CFRelease(event);
-    TYPR_IO_LOG_DEBUG("Sender (macOS): sendKey key=%s keycode=%u down=%u", keyToString(key).c_str(), static_cast<unsigned>(keyCode), static_cast<unsigned>(down));
+    stats.timed(1, [&]() {
+      post(event);
+      return true;
+    });
+    if (pooled == nullptr) {
+      CFRelease(event);
+    }
+    TYPR_IO_LOG_DEBUG("Sender (macOS): sendKey key=%s keycode=%u down=%u", keyToStringView(key).data(), static_cast<unsigned>(keyCode), static_cast<unsigned>(down));
     return true;
   }
 
-  [[nodiscard]] bool typeUnicode(const std::u32string &text) const {
+  [[nodiscard]] bool typeUnicode(std::u32string_view text) const {
     TYPR_IO_LOG_DEBUG("Sender (macOS): typeUnicode called len=%zu", text.size());
-    if (text.empty()) {
-      return true;
-    }
+    return typeUtf16(detail::utf32ToUtf16(text));
+  }
 
-    // Convert to UTF-16
-    std::vector<UniChar> utf16;
-    for (char32_t codepoint : text) {
-      if (codepoint <= kUnicodeMaxBMP) {
-        utf16.push_back(static_cast<UniChar>(codepoint));
-      } else if (codepoint <= kUnicodeMax) {
-        char32_t codepointTmp = codepoint - kUnicodeSurrogateOffset;
-        utf16.push_back(
-            static_cast<UniChar>(kUnicodeHighSurrogateBase |
-                                 (static_cast<uint32_t>(codepointTmp) >> 10)));
-        utf16.push_back(static_cast<UniChar>(
-            kUnicodeLowSurrogateBase |
-            (static_cast<uint32_t>(codepointTmp) & kUnicodeSurrogateMask)));
+  // Post a pooled event stamped with the current time (a reused event would
+  // otherwise keep the timestamp of its creation)
+  static void post(CGEventRef event) {
+    CGEventSetTimestamp(event, mach_absolute_time());
+    CGEventPost(kCGHIDEventTap, event);
+  }
+
+  // Invoke fn(units, length) for each chunk of `utf16`: as long as one event
+  // allows, but never ending on a high surrogate
+  template <typename Fn> static void forEachUnicodeChunk(std::u16string_view utf16, Fn &&fn) {
+    size_t chunkLength = 0;
+    for (size_t index = 0; index < utf16.size(); index += chunkLength) {
+      chunkLength = std::min(kMaxCharsPerEvent, utf16.size() - index);
+      if (chunkLength == kMaxCharsPerEvent &&
+          (utf16[index + chunkLength - 1] & 0xFC00) == kUnicodeHighSurrogateBase) {
+        --chunkLength;
       }
+      // UniChar and char16_t are both 16-bit code units
+      fn(reinterpret_cast<const UniChar *>(utf16.data() + index), chunkLength);
     }
+  }
 
-    // macOS limit: 20 characters per event
-    static constexpr size_t kMaxCharsPerEvent = 20;
+  // Post UTF-16 text in CGEventKeyboardSetUnicodeString-sized chunks through
+  // the two pooled text events
+  [[nodiscard]] bool typeUtf16(const std::u16string &utf16) const {
+    if (utf16.empty()) {
+      return true;
+    }
 
-    for (size_t utf16Index = 0; utf16Index < utf16.size();
-         utf16Index += kMaxCharsPerEvent) {
-      size_t chunkLength =
-          std::min(kMaxCharsPerEvent, utf16.size() - utf16Index);
+    CGEventRef eventDown = events.text(true);
+    CGEventRef eventUp = events.text(false);
+    if ((eventDown == nullptr) || (eventUp == nullptr)) {
+      TYPR_IO_LOG_ERROR("Sender (macOS): typeUnicode has no CGEvents to post");
+      return false;
+    }
+
+    forEachUnicodeChunk(utf16, [&](const UniChar *units, size_t chunkLength) {
+      CGEventKeyboardSetUnicodeString(eventDown, chunkLength, units);
+      CGEventKeyboardSetUnicodeString(eventUp, chunkLength, units);
+      stats.timed(2, [&]() {
+        post(eventDown);
+        post(eventUp);
+        return true;
+      });
+      TYPR_IO_LOG_DEBUG("Sender (macOS): posted unicode chunk length=%zu", chunkLength);
+    });
+    TYPR_IO_LOG_DEBUG("Sender (macOS): typeUnicode completed");
+    return true;
+  }
 
-      CGEventRef eventDown = CGEventCreateKeyboardEvent(eventSource, 0, true);
-      CGEventRef eventUp = CGEventCreateKeyboardEvent(eventSource, 0, false);
-      if ((eventDown == nullptr) || (eventUp == nullptr)) {
-        if (eventDown != nullptr) {
-          CFRelease(eventDown);
+  // Compile a KeySequence into CGEvents. Key events carry the modifier flags
+  // the sequence itself has pressed up to that point; text is split into
+  // CGEventKeyboardSetUnicodeString-sized chunks like typeUtf16().
+  [[nodiscard]] SequenceProgram compileSequence(const KeySequence &sequence) const {
+    SequenceProgram program;
+    Modifier mods = Modifier::None;
+    for (const KeySequence::Step &step : sequence.steps()) {
+      switch (step.kind) {
+      case KeySequence::StepKind::KeyDown:
+      case KeySequence::StepKind::KeyUp: {
+        const bool down = step.kind == KeySequence::StepKind::KeyDown;
+        const CGKeyCode keyCode = macKeyCodeFor(step.key);
+        if (keyCode == keyMap.kInvalid) {
+          program.complete = false;
+          break;
         }
-        if (eventUp != nullptr) {
-          CFRelease(eventUp);
+        const Modifier flag = modifierFor(step.key);
+        if (flag != Modifier::None) {
+          mods = down ? (mods | flag)
+                      : static_cast<Modifier>(static_cast<unsigned int>(mods) &
+                                              ~static_cast<unsigned int>(flag));
         }
-        TYPR_IO_LOG_ERROR("Sender (macOS): typeUnicode failed to create CGEvents for chunk");
-        return false;
+        CGEventRef event = CGEventCreateKeyboardEvent(eventSource, keyCode, down);
+        if (event == nullptr) {
+          program.complete = false;
+          break;
+        }
+        CGEventSetFlags(event, modifierToFlags(mods));
+        program.events.push_back(event);
+        break;
+      }
+      case KeySequence::StepKind::Text: {
+        const std::u16string utf16 = detail::utf32ToUtf16(sequence.textOf(step));
+        forEachUnicodeChunk(utf16, [&](const UniChar *units, size_t chunkLength) {
+          for (bool down : {true, false}) {
+            CGEventRef event = CGEventCreateKeyboardEvent(eventSource, 0, down);
+            if (event == nullptr) {
+              program.complete = false;
+              continue;
+            }
+            CGEventKeyboardSetUnicodeString(event, chunkLength, units);
+            program.events.push_back(event);
+          }
+        });
+        break;
       }
+      case KeySequence::StepKind::Delay:
+        program.segments.push_back({program.events.size(), step.delayUs});
+        break;
+      }
+    }
+    if (program.segments.empty() || program.segments.back().end != program.events.size()) {
+      program.segments.push_back({program.events.size(), 0});
+    }
+    return program;
+  }
 
-      CGEventKeyboardSetUnicodeString(eventDown, chunkLength,
-                                      &utf16[utf16Index]);
-      CGEventKeyboardSetUnicodeString(eventUp, chunkLength, &utf16[utf16Index]);
+  // Play a sequence from its cached program
+  bool playSequence(const KeySequence &sequence) {
+    const SequenceProgram &program =
+        sequences.get(sequence, [this](const KeySequence &seq) { return compileSequence(seq); });
+    size_t begin = 0;
+    for (const SequenceProgram::Segment &segment : program.segments) {
+      if (segment.end > begin) {
+        stats.timed(segment.end - begin, [&]() {
+          for (size_t i = begin; i < segment.end; ++i) {
+            post(program.events[i]);
+          }
+          return true;
+        });
+      }
+      begin = segment.end;
+      if (segment.delayUs > 0) {
+        detail::sleepUntil(detail::PacerClock::now() + std::chrono::microseconds(segment.delayUs));
+      }
+    }
+    return program.complete;
+  }
 
-      CGEventPost(kCGHIDEventTap, eventDown);
-      CGEventPost(kCGHIDEventTap, eventUp);
-      TYPR_IO_LOG_DEBUG("Sender (macOS): posted unicode chunk length=%zu", chunkLength);
+  static Modifier modifierFor(Key key) {
+    switch (key) {
+    case Key::ShiftLeft:
+    case Key::ShiftRight:
+      return Modifier::Shift;
+    case Key::CtrlLeft:
+    case Key::CtrlRight:
+      return Modifier::Ctrl;
+    case Key::AltLeft:
+    case Key::AltRight:
+      return Modifier::Alt;
+    case Key::SuperLeft:
+    case Key::SuperRight:
+      return Modifier::Super;
+    default:
+      return Modifier::None;
+    }
+  }
 
-      CFRelease(eventDown);
-      CFRelease(eventUp);
+  // Type one character at a time on the typing-rate schedule
+  bool typeUnicodePaced(std::u32string_view text) {
+    bool allOk = true;
+    for (char32_t codepoint : text) {
+      allOk &= typeUnicode(std::u32string_view(&codepoint, 1));
+      charPacer.wait();
     }
-    TYPR_IO_LOG_DEBUG("Sender (macOS): typeUnicode completed");
-    return true;
+    return allOk;
   }
 
-  void delay() const {
+  // Wait for the next key-delay deadline (see detail::Pacer)
+  void delay() {
     if (keyDelayUs > 0) {
       TYPR_IO_LOG_DEBUG("Sender (macOS): delay %u us", keyDelayUs);
-      std::this_thread::sleep_for(std::chrono::microseconds(keyDelayUs));
+      keyPacer.wait();
     }
   }
 };
@@ -355,6 +590,8 @@ struct Sender::Impl {
 Sender::Sender() : m_impl(std::make_unique<Impl>()) {
   TYPR_IO_LOG_INFO("Sender (macOS): constructed, ready=%u", static_cast<unsigned>(isReady()));
 }
+// CGEventPost has no device to share, so there is nothing to configure
+Sender::Sender(const SenderOptions &) : Sender() {}
 Sender::~Sender() = default;
 Sender::Sender(Sender &&) noexcept = default;
 Sender &Sender::operator=(Sender &&) noexcept = default;
@@ -394,7 +631,7 @@ bool Sender::requestPermissions() {
 }
 
 bool Sender::keyDown(Key key) {
-  TYPR_IO_LOG_DEBUG("Sender::keyDown(%s)", keyToString(key).c_str());
+  TYPR_IO_LOG_DEBUG("Sender::keyDown(%s)", keyToStringView(key).data());
   // Update modifier state if pressing a modifier
   switch (key) {
   case Key::ShiftLeft:
@@ -417,12 +654,12 @@ bool Sender::keyDown(Key key) {
     break;
   }
   bool ok = m_impl->sendKey(key, true);
-  TYPR_IO_LOG_DEBUG("Sender::keyDown(%s) result=%u", keyToString(key).c_str(), static_cast<unsigned>(ok));
+  TYPR_IO_LOG_DEBUG("Sender::keyDown(%s) result=%u", keyToStringView(key).data(), static_cast<unsigned>(ok));
   return ok;
 }
 
 bool Sender::keyUp(Key key) {
-  TYPR_IO_LOG_DEBUG("Sender::keyUp(%s)", keyToString(key).c_str());
+  TYPR_IO_LOG_DEBUG("Sender::keyUp(%s)", keyToStringView(key).data());
   bool result = m_impl->sendKey(key, false);
   // Update modifier state if releasing a modifier
   switch (key) {
@@ -453,18 +690,18 @@ bool Sender::keyUp(Key key) {
   default:
     break;
   }
-  TYPR_IO_LOG_DEBUG("Sender::keyUp(%s) result=%u", keyToString(key).c_str(), static_cast<unsigned>(result));
+  TYPR_IO_LOG_DEBUG("Sender::keyUp(%s) result=%u", keyToStringView(key).data(), static_cast<unsigned>(result));
   return result;
 }
 
 bool Sender::tap(Key key) {
-  TYPR_IO_LOG_DEBUG("Sender::tap(%s)", keyToString(key).c_str());
+  TYPR_IO_LOG_DEBUG("Sender::tap(%s)", keyToStringView(key).data());
   if (!keyDown(key)) {
     return false;
   }
   m_impl->delay();
   bool ok = keyUp(key);
-  TYPR_IO_LOG_DEBUG("Sender::tap(%s) result=%u", keyToString(key).c_str(), static_cast<unsigned>(ok));
+  TYPR_IO_LOG_DEBUG("Sender::tap(%s) result=%u", keyToStringView(key).data(), static_cast<unsigned>(ok));
   return ok;
 }
 
@@ -512,7 +749,7 @@ bool Sender::releaseAllModifiers() {
 }
 
 bool Sender::combo(Modifier mods, Key key) {
-  TYPR_IO_LOG_DEBUG("Sender::combo(mods=%u key=%s)", static_cast<unsigned>(mods), keyToString(key).c_str());
+  TYPR_IO_LOG_DEBUG("Sender::combo(mods=%u key=%s)", static_cast<unsigned>(mods), keyToStringView(key).data());
   if (!holdModifier(mods)) {
     return false;
   }
@@ -524,81 +761,47 @@ bool Sender::combo(Modifier mods, Key key) {
   return tapResult;
 }
 
-bool Sender::typeText(const std::u32string &text) {
+bool Sender::typeText(std::u32string_view text) {
   TYPR_IO_LOG_DEBUG("Sender::typeText (utf32) called with %zu codepoints", text.size());
+  if (m_impl->charsPerSecond > 0.0) {
+    return m_impl->typeUnicodePaced(text);
+  }
   return m_impl->typeUnicode(text);
 }
 
-bool Sender::typeText(const std::string &utf8Text) {
+bool Sender::typeText(std::string_view utf8Text) {
   TYPR_IO_LOG_DEBUG("Sender::typeText (utf8) called len=%zu", utf8Text.size());
-  std::u32string utf32;
-  size_t utf8Index = 0;
-  static constexpr unsigned char kUtf8Mask6 = 0x3F;
-  static constexpr unsigned char kUtf8Mask5 = 0x1F;
-  static constexpr unsigned char kUtf8Mask4 = 0x0F;
-  static constexpr unsigned char kUtf8Mask3 = 0x07;
-  static constexpr unsigned char kUtf8Mask7 = 0x80;
-  static constexpr unsigned char kUtf8Mask8 = 0xC0;
-  static constexpr unsigned char kUtf8Mask9 = 0xE0;
-  static constexpr unsigned char kUtf8Mask10 = 0xF0;
-  static constexpr unsigned char kUtf8Mask11 = 0xF8;
-  static constexpr unsigned int kUtf8Shift6 = 6;
-  static constexpr unsigned int kUtf8Shift12 = 12;
-  static constexpr unsigned int kUtf8Shift18 = 18;
-
-  while (utf8Index < utf8Text.size()) {
-    char32_t decodedCodepoint = 0;
-    auto utf8Char = static_cast<unsigned char>(utf8Text[utf8Index]);
-    if ((utf8Char & kUtf8Mask7) == 0) {
-      decodedCodepoint = utf8Char;
-      utf8Index += 1;
-    } else if ((utf8Char & kUtf8Mask9) == kUtf8Mask8) {
-      decodedCodepoint = (utf8Char & kUtf8Mask5) << kUtf8Shift6;
-      if (utf8Index + 1 < utf8Text.size()) {
-        decodedCodepoint |= (utf8Text[utf8Index + 1] & 0x3F);
-      }
-      utf8Index += 2;
-    } else if ((utf8Char & kUtf8Mask10) == kUtf8Mask9) {
-      decodedCodepoint = (utf8Char & kUtf8Mask4) << kUtf8Shift12;
-      if (utf8Index + 1 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 1]) & kUtf8Mask6)
-            << kUtf8Shift6;
-      }
-      if (utf8Index + 2 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 2]) & kUtf8Mask6);
-      }
-      utf8Index += 3;
-    } else if ((utf8Char & kUtf8Mask11) == kUtf8Mask10) {
-      decodedCodepoint = (utf8Char & kUtf8Mask3) << kUtf8Shift18;
-      if (utf8Index + 1 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 1]) & kUtf8Mask6)
-            << kUtf8Shift12;
-      }
-      if (utf8Index + 2 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 2]) & kUtf8Mask6)
-            << kUtf8Shift6;
-      }
-      if (utf8Index + 3 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 3]) & kUtf8Mask6);
-      }
-      utf8Index += 4;
-    } else {
-      utf8Index += 1;
-      continue;
-    }
-    utf32.push_back(decodedCodepoint);
+  if (m_impl->charsPerSecond > 0.0) {
+    return m_impl->typeUnicodePaced(detail::utf8ToUtf32(utf8Text));
+  }
+  // Decode straight to the UTF-16 CGEventKeyboardSetUnicodeString consumes
+  return m_impl->typeUtf16(detail::utf8ToUtf16(utf8Text));
+}
+
+bool Sender::typeTextBulk(std::u32string_view text) {
+  TYPR_IO_LOG_DEBUG("Sender::typeTextBulk (utf32) called with %zu codepoints", text.size());
+  if (m_impl->charsPerSecond > 0.0) {
+    return m_impl->typeUnicodePaced(text);
+  }
+  return m_impl->typeUnicode(text);
+}
+
+bool Sender::typeTextBulk(std::string_view utf8Text) {
+  TYPR_IO_LOG_DEBUG("Sender::typeTextBulk (utf8) called len=%zu", utf8Text.size());
+  if (m_impl->charsPerSecond > 0.0) {
+    return m_impl->typeUnicodePaced(detail::utf8ToUtf32(utf8Text));
   }
-  return typeText(utf32);
+  return m_impl->typeUtf16(detail::utf8ToUtf16(utf8Text));
 }
 
 bool Sender::typeCharacter(char32_t codepoint) {
   TYPR_IO_LOG_DEBUG("Sender::typeCharacter(codepoint=%u)", static_cast<unsigned>(codepoint));
-  return typeText(std::u32string(1, codepoint));
+  return typeText(std::u32string_view(&codepoint, 1));
+}
+
+bool Sender::play(const KeySequence &sequence) {
+  TYPR_IO_LOG_DEBUG("Sender::play called with %zu steps", sequence.steps().size());
+  return m_impl->playSequence(sequence);
 }
 
 void Sender::flush() {
@@ -609,6 +812,22 @@ void Sender::flush() {
 void Sender::setKeyDelay(uint32_t delayUs) {
   TYPR_IO_LOG_DEBUG("Sender::setKeyDelay(%u)", delayUs);
   m_impl->keyDelayUs = delayUs;
+  m_impl->keyPacer.setInterval(std::chrono::microseconds(delayUs));
+}
+
+void Sender::setTypingRate(double charsPerSecond) {
+  TYPR_IO_LOG_DEBUG("Sender::setTypingRate(%f)", charsPerSecond);
+  m_impl->charsPerSecond = charsPerSecond > 0.0 ? charsPerSecond : 0.0;
+  m_impl->charPacer.setInterval(detail::rateToInterval(charsPerSecond));
+}
+
+void Sender::setFrameCoalescing(bool enabled) {
+  TYPR_IO_LOG_DEBUG("Sender::setFrameCoalescing(%u)", static_cast<unsigned>(enabled));
+  // CGEventPost has no event-frame concept; nothing to coalesce
+}
+
+SenderStats Sender::stats() const {
+  return m_impl ? m_impl->stats.snapshot() : SenderStats{};
 }
 
 } // namespace typr::io
@@ -5,62 +5,91 @@
  * @brief Linux/uinput implementation for typr::io::Sender.
  *
  * Uses the Linux uinput subsystem to create a virtual keyboard device and
- * emit EV_KEY events. The implementation is layout-aware and uses xkbcommon
- * to detect the active keyboard layout and translate characters to keycodes
- * where possible. This file is compiled only when the uinput backend is
+ * emit EV_KEY events. The implementation is layout-aware: characters and
+ * keys are translated to keycodes through the process-wide xkb layout cache
+ * (`common/xkb_layout.hpp`). This file is compiled only when the uinput backend is
  * selected (non-X11 builds).
  */
 
+#include <typr-io/key_sequence.hpp>
 #include <typr-io/sender.hpp>
 
-#include <algorithm>
+#include "common/key_table.hpp"
+#include "common/pacer.hpp"
+#include "common/stats_recorder.hpp"
+#include "common/utf8.hpp"
+#include "common/xkb_layout.hpp"
+#include "sender/sequence_cache.hpp"
+
+#include <array>
+#include <bitset>
 #include <chrono>
-#include <cstdio>
-#include <cstdlib>
 #include <cstring>
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <fstream>
 #include <linux/input.h>
 #include <linux/uinput.h>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <sys/ioctl.h>
 #include <thread>
 #include <typr-io/log.hpp>
 #include <unistd.h>
-#include <unordered_map>
-#include <xkbcommon/xkbcommon.h>
+#include <vector>
 
 namespace typr::io {
 
+namespace {
+
 /**
  * @internal
- * @brief Pimpl for Sender (uinput backend).
- *
- * Manages the uinput device file descriptor, XKB context/keymap/state, and
- * layout-aware mappings from logical `Key` values and Unicode characters to
- * evdev keycodes. These members and methods are internal implementation
- * details and are not part of the public API.
+ * @brief One uinput virtual keyboard, owned by a single Sender or shared by
+ * several through the device pool.
  */
-struct Sender::Impl {
+struct UinputDevice {
   int fd{-1};
-  Modifier currentMods{Modifier::None};
-  uint32_t keyDelayUs{1000};
-
-  // Layout-aware mappings: character/Key -> (evdev keycode, needs shift)
-  std::unordered_map<Key, int> keyMap;
-  std::unordered_map<char32_t, std::pair<int, bool>> charToKeycode;
-
-  // XKB context for layout detection
-  struct xkb_context *xkbCtx{nullptr};
-  struct xkb_keymap *xkbKeymap{nullptr};
-  struct xkb_state *xkbState{nullptr};
+  std::chrono::steady_clock::time_point created;
+
+  // Serializes writes so frames of different Senders never interleave; also
+  // guards `holders`.
+  std::mutex writeMutex;
+  // Shared devices only: number of Senders holding each key down. The kernel
+  // sees a press when the first holder presses and a release when the last
+  // one releases, so one Sender releasing Shift never cancels the Shift
+  // another Sender is holding.
+  std::array<uint16_t, KEY_CNT> holders{};
+
+  // Upper bound on waiting for udev to announce a new device; this was the
+  // fixed settle delay before the readiness check existed.
+  static constexpr std::chrono::milliseconds kReadyTimeout{100};
+
+  UinputDevice() = default;
+  ~UinputDevice() {
+    if (fd >= 0) {
+      ioctl(fd, UI_DEV_DESTROY);
+      close(fd);
+      TYPR_IO_LOG_INFO("Sender (uinput): device destroyed (fd=%d)", fd);
+    }
+  }
+  UinputDevice(const UinputDevice &) = delete;
+  UinputDevice &operator=(const UinputDevice &) = delete;
 
-  Impl() {
+  /**
+   * @internal
+   * @brief Open /dev/uinput and create the virtual keyboard.
+   *
+   * Returns as soon as the device exists; call `waitUntilReady()` before the
+   * first write.
+   */
+  bool create() {
     fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
     if (fd < 0) {
       TYPR_IO_LOG_ERROR("Sender (uinput): failed to open /dev/uinput: %s",
                         strerror(errno));
-      return;
+      return false;
     }
 
     ioctl(fd, UI_SET_EVBIT, EV_KEY);
@@ -80,508 +109,508 @@ struct Sender::Impl {
 
     ioctl(fd, UI_DEV_SETUP, &usetup);
     ioctl(fd, UI_DEV_CREATE);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-    initXkb();
-    initKeyMap();
-
-    TYPR_IO_LOG_INFO(
-        "Sender (uinput): device initialized fd=%d keymap_entries=%zu "
-        "char_entries=%zu",
-        fd, keyMap.size(), charToKeycode.size());
+    created = std::chrono::steady_clock::now();
+    return true;
   }
 
-  ~Impl() {
-    if (xkbState)
-      xkb_state_unref(xkbState);
-    if (xkbKeymap)
-      xkb_keymap_unref(xkbKeymap);
-    if (xkbCtx)
-      xkb_context_unref(xkbCtx);
+  /**
+   * @internal
+   * @brief Block until the device is announced, at most `kReadyTimeout`
+   * after creation.
+   */
+  void waitUntilReady() {
+    if (!waitForUdev(created + kReadyTimeout))
+      std::this_thread::sleep_until(created + kReadyTimeout);
+  }
 
-    if (fd >= 0) {
-      ioctl(fd, UI_DEV_DESTROY);
-      close(fd);
-      TYPR_IO_LOG_INFO("Sender (uinput): device destroyed (fd=%d)", fd);
+  /**
+   * @internal
+   * @brief Wait until udev has announced the freshly created device.
+   *
+   * Compositors and other libinput clients discover the device through the
+   * udev "add" event; anything written before they open it is lost. udev
+   * stores the device's database entry right before broadcasting that
+   * event, so instead of a fixed sleep this polls (1 ms steps) for the
+   * device's event node and, when udev is running, its database entry.
+   *
+   * @param deadline Give up (and report the device as ready) at this time.
+   * @return false when the kernel cannot name the device (`UI_GET_SYSNAME`
+   *         needs Linux 3.15); the caller then falls back to a fixed delay.
+   */
+  bool waitForUdev(std::chrono::steady_clock::time_point deadline) {
+#ifdef UI_GET_SYSNAME
+    char sysname[64] = {0};
+    if (ioctl(fd, UI_GET_SYSNAME(sizeof(sysname)), sysname) < 0)
+      return false;
+    const std::string sysDir =
+        std::string("/sys/devices/virtual/input/") + sysname;
+    const bool udevRunning = access("/run/udev/control", F_OK) == 0;
+
+    std::string udevEntry;
+    while (true) {
+      if (udevEntry.empty())
+        udevEntry = udevEntryFor(sysDir);
+      if (!udevEntry.empty() &&
+          (!udevRunning || access(udevEntry.c_str(), F_OK) == 0))
+        return true;
+      if (std::chrono::steady_clock::now() >= deadline) {
+        TYPR_IO_LOG_DEBUG("Sender (uinput): %s not announced by udev in time",
+                          sysname);
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+#else
+    (void)deadline;
+    return false;
+#endif
   }
 
-  Impl(const Impl &) = delete;
-  Impl &operator=(const Impl &) = delete;
-  Impl(Impl &&other) noexcept
-      : fd(other.fd), currentMods(other.currentMods),
-        keyDelayUs(other.keyDelayUs), keyMap(std::move(other.keyMap)),
-        charToKeycode(std::move(other.charToKeycode)), xkbCtx(other.xkbCtx),
-        xkbKeymap(other.xkbKeymap), xkbState(other.xkbState) {
-    other.fd = -1;
-    other.xkbCtx = nullptr;
-    other.xkbKeymap = nullptr;
-    other.xkbState = nullptr;
+  /**
+   * @internal
+   * @brief Path of the udev database entry for the event node under
+   * `sysDir` (e.g. "/run/udev/data/c13:67"), or empty if it has none yet.
+   */
+  static std::string udevEntryFor(const std::string &sysDir) {
+    DIR *dir = opendir(sysDir.c_str());
+    if (!dir)
+      return {};
+    std::string node;
+    while (struct dirent *entry = readdir(dir)) {
+      if (std::strncmp(entry->d_name, "event", 5) == 0) {
+        node = entry->d_name;
+        break;
+      }
+    }
+    closedir(dir);
+    if (node.empty())
+      return {};
+
+    std::ifstream devFile(sysDir + "/" + node + "/dev");
+    std::string majorMinor;
+    if (!(devFile >> majorMinor))
+      return {};
+    return "/run/udev/data/c" + majorMinor;
   }
 
-  Impl &operator=(Impl &&other) noexcept {
-    if (this == &other)
-      return *this;
-
-    if (xkbState)
-      xkb_state_unref(xkbState);
-    if (xkbKeymap)
-      xkb_keymap_unref(xkbKeymap);
-    if (xkbCtx)
-      xkb_context_unref(xkbCtx);
-    if (fd >= 0) {
-      ioctl(fd, UI_DEV_DESTROY);
-      close(fd);
+  /**
+   * @internal
+   * @brief Write a contiguous run of events with a single write().
+   *
+   * Retries on EINTR and continues after short writes. Callers sharing the
+   * device hold `writeMutex`.
+   */
+  bool writeAll(const struct input_event *events, size_t count) {
+    const auto *data = reinterpret_cast<const char *>(events);
+    size_t remaining = count * sizeof(struct input_event);
+    while (remaining > 0) {
+      ssize_t n = write(fd, data, remaining);
+      if (n < 0) {
+        if (errno == EINTR)
+          continue;
+        TYPR_IO_LOG_ERROR("Sender (uinput): write() of %zu events failed: %s",
+                          count, strerror(errno));
+        return false;
+      }
+      data += n;
+      remaining -= static_cast<size_t>(n);
     }
-
-    fd = other.fd;
-    currentMods = other.currentMods;
-    keyDelayUs = other.keyDelayUs;
-    keyMap = std::move(other.keyMap);
-    charToKeycode = std::move(other.charToKeycode);
-    xkbCtx = other.xkbCtx;
-    xkbKeymap = other.xkbKeymap;
-    xkbState = other.xkbState;
-
-    other.fd = -1;
-    other.xkbCtx = nullptr;
-    other.xkbKeymap = nullptr;
-    other.xkbState = nullptr;
-    return *this;
+    return true;
   }
+};
 
+/**
+ * @internal
+ * @brief Process-wide pool of shared uinput devices.
+ *
+ * Slots hold weak references: a device lives as long as some Sender uses
+ * it and is destroyed with its last user.
+ */
+class UinputDevicePool {
+public:
   /**
    * @internal
-   * @brief Initialize xkbcommon context, keymap and state for layout
-   * translation.
+   * @brief Attach to the least-used of the first `poolSize` slots, creating
+   * the slot's device if it has none.
    *
-   * This routine attempts to create an `xkb_context`, detect the active
-   * keyboard layout (via `detectKeyboardLayout`), and then compile and install
-   * a corresponding `xkb_keymap` and `xkb_state`. On any failure the function
-   * logs an error and returns without a usable xkb state.
+   * @return The shared device, or null if it could not be created.
    */
-  void initXkb() {
-    xkbCtx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-    if (!xkbCtx) {
-      TYPR_IO_LOG_ERROR("Sender (uinput): xkb_context_new() failed");
-      return;
+  std::shared_ptr<UinputDevice> acquire(size_t poolSize) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_slots.size() < poolSize)
+      m_slots.resize(poolSize);
+
+    size_t best = 0;
+    long bestUsers = -1;
+    for (size_t i = 0; i < poolSize; ++i) {
+      const long users = m_slots[i].use_count();
+      if (bestUsers < 0 || users < bestUsers) {
+        best = i;
+        bestUsers = users;
+      }
     }
+    if (auto device = m_slots[best].lock())
+      return device;
+
+    auto device = std::make_shared<UinputDevice>();
+    if (!device->create())
+      return nullptr;
+    device->waitUntilReady();
+    TYPR_IO_LOG_INFO("Sender (uinput): shared device %zu/%zu created fd=%d",
+                     best + 1, poolSize, device->fd);
+    m_slots[best] = device;
+    return device;
+  }
 
-    // Try to detect the actual keyboard layout
-    struct xkb_rule_names names = {nullptr, nullptr, nullptr, nullptr, nullptr};
-    std::string detectedLayout = detectKeyboardLayout();
+private:
+  std::mutex m_mutex;
+  std::vector<std::weak_ptr<UinputDevice>> m_slots;
+};
 
-    if (!detectedLayout.empty()) {
-      names.layout = detectedLayout.c_str();
-      TYPR_IO_LOG_INFO("Sender (uinput): detected layout '%s'",
-                       detectedLayout.c_str());
-    }
+UinputDevicePool &devicePool() {
+  // Never destroyed so Senders released during static destruction are safe
+  static auto *pool = new UinputDevicePool();
+  return *pool;
+}
 
-    xkbKeymap = xkb_keymap_new_from_names(
-        xkbCtx, detectedLayout.empty() ? nullptr : &names,
-        XKB_KEYMAP_COMPILE_NO_FLAGS);
+} // namespace
 
-    if (!xkbKeymap) {
-      TYPR_IO_LOG_ERROR("Sender (uinput): xkb_keymap_new_from_names() failed");
-      return;
-    }
+/**
+ * @internal
+ * @brief Pimpl for Sender (uinput backend).
+ *
+ * Manages the uinput device (owned, or shared through the device pool) and
+ * the shared, layout-aware mappings from logical `Key` values and Unicode
+ * characters to evdev keycodes. These members and methods are internal
+ * implementation details and are not part of the public API.
+ */
+struct Sender::Impl {
+  int fd{-1}; // `device->fd`, or -1 without a usable device
+  Modifier currentMods{Modifier::None};
+  uint32_t keyDelayUs{1000};
 
-    xkbState = xkb_state_new(xkbKeymap);
-    if (!xkbState) {
-      TYPR_IO_LOG_ERROR("Sender (uinput): xkb_state_new() failed");
-    }
-  }
+  std::shared_ptr<UinputDevice> device;
+  bool sharedDevice{false};
+  // Shared devices only: keys this Sender holds down, counted once each in
+  // `device->holders`, plus scratch space for the filtered write.
+  std::bitset<KEY_CNT> heldKeys;
+  std::vector<struct input_event> sharedFrame;
+
+  // Event frame buffer: input_events accumulate here and are written to the
+  // device with a single write() when the frame is closed by SYN_REPORT.
+  std::vector<struct input_event> frame;
+  // When enabled (and keyDelayUs == 0), consecutive key edges of one public
+  // operation share a SYN frame instead of each getting their own.
+  bool coalesceFrames{false};
+  // Nesting depth of public operations; the outermost one closes the frame.
+  int frameDepth{0};
+
+  // Absolute-deadline pacing: per edge (keyDelayUs) and, when a typing rate
+  // is configured, per typed character.
+  detail::Pacer keyPacer;
+  detail::Pacer charPacer;
+  double charsPerSecond{0.0};
+
+  // Injection counters; read by Sender::stats()
+  detail::SenderStatsRecorder stats;
+
+  // Layout-aware mappings (Key / character -> evdev keycode), shared with
+  // every other Sender and Listener using the same layout. Never null.
+  std::shared_ptr<const detail::XkbLayout> layout;
 
   /**
    * @internal
-   * @brief Detect the keyboard layout to be used for xkb initialization.
+   * @brief A `KeySequence` compiled to SYN-terminated input_event frames.
    *
-   * Detection strategy:
-   *  1) Use the `XKB_DEFAULT_LAYOUT` environment variable if present.
-   *  2) Parse `/etc/default/keyboard` for Debian/Ubuntu systems as a fallback.
-   *  3) Return an empty string when no layout information can be determined.
-   *
-   * @return Detected layout name (e.g., "us", "fr"), or an empty string if not
-   *         determinable.
+   * `segments` split the event stream at the sequence's delay steps: each
+   * segment is written with one write() and followed by its delay.
    */
-  std::string detectKeyboardLayout() {
-    // 1. Check XKB_DEFAULT_LAYOUT environment variable
-    const char *envLayout = std::getenv("XKB_DEFAULT_LAYOUT");
-    if (envLayout && envLayout[0] != '\0') {
-      TYPR_IO_LOG_DEBUG("Sender (uinput): layout from XKB_DEFAULT_LAYOUT: %s",
-                        envLayout);
-      return envLayout;
-    }
+  struct SequenceProgram {
+    struct Segment {
+      size_t end{0};       // one past the segment's last event
+      uint32_t delayUs{0}; // wait after writing the segment
+    };
+    std::vector<struct input_event> events;
+    std::vector<Segment> segments;
+    bool complete{true}; // false if a key or character had no mapping
+  };
+  detail::SequenceCache<SequenceProgram> sequences;
 
-    // 2. Try to read /etc/default/keyboard (Debian/Ubuntu)
-    std::ifstream kbdFile("/etc/default/keyboard");
-    if (kbdFile.is_open()) {
-      std::string line;
-      while (std::getline(kbdFile, line)) {
-        // Look for XKBLAYOUT="fr" or XKBLAYOUT=fr
-        if (line.find("XKBLAYOUT") != std::string::npos) {
-          size_t eqPos = line.find('=');
-          if (eqPos != std::string::npos) {
-            std::string value = line.substr(eqPos + 1);
-            // Remove quotes and whitespace
-            value.erase(std::remove(value.begin(), value.end(), '"'),
-                        value.end());
-            value.erase(std::remove(value.begin(), value.end(), '\''),
-                        value.end());
-            value.erase(std::remove(value.begin(), value.end(), ' '),
-                        value.end());
-            // Handle multiple layouts (e.g., "fr,us") - take first
-            size_t commaPos = value.find(',');
-            if (commaPos != std::string::npos) {
-              value = value.substr(0, commaPos);
-            }
-            if (!value.empty()) {
-              TYPR_IO_LOG_DEBUG(
-                  "Sender (uinput): layout from /etc/default/keyboard: %s",
-                  value.c_str());
-              return value;
-            }
-          }
-        }
-      }
-    }
+  explicit Impl(const SenderOptions &options) {
+    frame.reserve(16);
+    keyPacer.setInterval(std::chrono::microseconds(keyDelayUs));
 
-    // 3. Try localectl or setxkbmap -query via popen (optional, heavier)
-    FILE *pipe = popen(
-        "setxkbmap -query 2>/dev/null | grep layout | awk '{print $2}'", "r");
-    if (pipe) {
-      char buffer[64];
-      if (fgets(buffer, sizeof(buffer), pipe)) {
-        std::string layout(buffer);
-        // Remove trailing newline
-        layout.erase(std::remove(layout.begin(), layout.end(), '\n'),
-                     layout.end());
-        // Handle multiple layouts
-        size_t commaPos = layout.find(',');
-        if (commaPos != std::string::npos) {
-          layout = layout.substr(0, commaPos);
-        }
-        pclose(pipe);
-        if (!layout.empty()) {
-          TYPR_IO_LOG_DEBUG("Sender (uinput): layout from setxkbmap: %s",
-                            layout.c_str());
-          return layout;
-        }
+    if (options.sharedDevicePool > 0) {
+      layout = detail::acquireXkbLayout(detail::systemXkbNames(), false);
+      device = devicePool().acquire(options.sharedDevicePool);
+      sharedDevice = true;
+    } else {
+      device = std::make_shared<UinputDevice>();
+      if (device->create()) {
+        // Resolve the layout (usually a cache hit) while udev announces
+        // the device, then wait for the announcement to complete.
+        layout = detail::acquireXkbLayout(detail::systemXkbNames(), false);
+        device->waitUntilReady();
       } else {
-        pclose(pipe);
+        device.reset();
       }
     }
 
-    // 4. Check LANG/LC_ALL for hints (fallback heuristic)
-    const char *lang = std::getenv("LANG");
-    if (lang) {
-      std::string langStr(lang);
-      if (langStr.find("fr_") == 0)
-        return "fr";
-      if (langStr.find("de_") == 0)
-        return "de";
-      if (langStr.find("es_") == 0)
-        return "es";
-      if (langStr.find("it_") == 0)
-        return "it";
-      if (langStr.find("pt_") == 0)
-        return "pt";
-      if (langStr.find("ru_") == 0)
-        return "ru";
-      if (langStr.find("zh_") == 0)
-        return "zh";
-      if (langStr.find("ja_") == 0)
-        return "ja";
-      if (langStr.find("ko_") == 0)
-        return "ko";
-      // Add more as needed
-    }
-
-    TYPR_IO_LOG_DEBUG(
-        "Sender (uinput): could not detect layout, using system default");
-    return "";
-  }
-
-  void initKeyMap() {
-    keyMap.clear();
-    charToKeycode.clear();
-
-    if (!xkbKeymap || !xkbState) {
-      initFallbackKeyMap();
+    if (!device || device->fd < 0) {
+      device.reset();
+      layout = std::make_shared<const detail::XkbLayout>();
       return;
     }
+    fd = device->fd;
 
-    // Scan all keycodes and build reverse mapping:
-    // For each keycode, check what character it produces (unshifted and
-    // shifted)
-    xkb_keycode_t minKey = xkb_keymap_min_keycode(xkbKeymap);
-    xkb_keycode_t maxKey = xkb_keymap_max_keycode(xkbKeymap);
+    TYPR_IO_LOG_INFO(
+        "Sender (uinput): device initialized fd=%d shared=%u layout='%s' "
+        "keymap_entries=%zu char_entries=%zu",
+        fd, static_cast<unsigned>(sharedDevice),
+        layout->names.layout.c_str(), layout->keys.size(),
+        layout->chars.size());
+  }
 
-    for (xkb_keycode_t xkbKey = minKey; xkbKey <= maxKey; ++xkbKey) {
-      int evdevCode = static_cast<int>(xkbKey) - 8; // XKB offset
-      if (evdevCode <= 0)
-        continue;
+  ~Impl() { releaseDevice(); }
 
-      // Get UTF-32 for unshifted state
-      uint32_t unshifted = xkb_state_key_get_utf32(xkbState, xkbKey);
-
-      // Get keysym for Key enum mapping (try unshifted, then shifted as a
-      // fallback)
-      xkb_keysym_t sym = xkb_state_key_get_one_sym(xkbState, xkbKey);
-      Key mappedKey = keysymToKey(sym);
-
-      // If the unshifted keysym didn't map (e.g. French AZERTY where top-row
-      // produces symbols unshifted and digits when shifted), try mapping the
-      // shifted keysym which may represent the logical key we're looking for.
-      if (mappedKey == Key::Unknown) {
-        xkb_mod_index_t shiftMod =
-            xkb_keymap_mod_get_index(xkbKeymap, XKB_MOD_NAME_SHIFT);
-        if (shiftMod != XKB_MOD_INVALID) {
-          xkb_state_update_mask(xkbState, (1u << shiftMod), 0, 0, 0, 0, 0);
-          xkb_keysym_t shiftedSym = xkb_state_key_get_one_sym(xkbState, xkbKey);
-          mappedKey = keysymToKey(shiftedSym);
-          // Reset state back to no modifiers
-          xkb_state_update_mask(xkbState, 0, 0, 0, 0, 0, 0);
-        }
-      }
+  Impl(const Impl &) = delete;
+  Impl &operator=(const Impl &) = delete;
+  Impl(Impl &&other) noexcept
+      : fd(other.fd), currentMods(other.currentMods),
+        keyDelayUs(other.keyDelayUs), device(std::move(other.device)),
+        sharedDevice(other.sharedDevice), heldKeys(other.heldKeys),
+        frame(std::move(other.frame)), coalesceFrames(other.coalesceFrames),
+        frameDepth(other.frameDepth), keyPacer(other.keyPacer),
+        charPacer(other.charPacer), charsPerSecond(other.charsPerSecond),
+        layout(other.layout), sequences(std::move(other.sequences)) {
+    other.fd = -1;
+    other.heldKeys.reset();
+  }
 
-      if (mappedKey != Key::Unknown && keyMap.find(mappedKey) == keyMap.end()) {
-        keyMap[mappedKey] = evdevCode;
-      }
+  Impl &operator=(Impl &&other) noexcept {
+    if (this == &other)
+      return *this;
 
-      // Store character -> keycode mapping (unshifted)
-      if (unshifted != 0 &&
-          charToKeycode.find(unshifted) == charToKeycode.end()) {
-        charToKeycode[unshifted] = {evdevCode, false};
-      }
+    releaseDevice();
 
-      // Now check shifted state
-      xkb_mod_index_t shiftMod =
-          xkb_keymap_mod_get_index(xkbKeymap, XKB_MOD_NAME_SHIFT);
-      if (shiftMod != XKB_MOD_INVALID) {
-        xkb_state_update_mask(xkbState, (1u << shiftMod), 0, 0, 0, 0, 0);
-        uint32_t shifted = xkb_state_key_get_utf32(xkbState, xkbKey);
+    fd = other.fd;
+    currentMods = other.currentMods;
+    keyDelayUs = other.keyDelayUs;
+    device = std::move(other.device);
+    sharedDevice = other.sharedDevice;
+    heldKeys = other.heldKeys;
+    frame = std::move(other.frame);
+    coalesceFrames = other.coalesceFrames;
+    frameDepth = other.frameDepth;
+    keyPacer = other.keyPacer;
+    charPacer = other.charPacer;
+    charsPerSecond = other.charsPerSecond;
+    layout = other.layout;
+    sequences = std::move(other.sequences);
 
-        if (shifted != 0 && shifted != unshifted &&
-            charToKeycode.find(shifted) == charToKeycode.end()) {
-          charToKeycode[shifted] = {evdevCode, true};
-        }
+    other.fd = -1;
+    other.heldKeys.reset();
+    return *this;
+  }
 
-        // Reset state
-        xkb_state_update_mask(xkbState, 0, 0, 0, 0, 0, 0);
+  /**
+   * @internal
+   * @brief Detach from the device.
+   *
+   * An owned device is destroyed (the kernel releases its keys). On a shared
+   * device the keys this Sender still holds are released first so they do
+   * not stay stuck for the other users.
+   */
+  void releaseDevice() {
+    if (device && sharedDevice && heldKeys.any()) {
+      frame.clear();
+      for (size_t code = 0; code < heldKeys.size(); ++code) {
+        if (heldKeys.test(code))
+          emit(EV_KEY, static_cast<int>(code), 0);
       }
+      sync();
     }
+    device.reset();
+    fd = -1;
+  }
 
-    // Add fallback mappings for special keys
-    initFallbackKeyMap();
-
-    TYPR_IO_LOG_DEBUG(
-        "Sender (uinput): initKeyMap populated %zu key entries, %zu char "
-        "entries",
-        keyMap.size(), charToKeycode.size());
+  /**
+   * @internal
+   * @brief Append a raw input_event to the pending event frame.
+   *
+   * Events are not written immediately: they accumulate in `frame` until the
+   * frame is closed by `sync()`, so that a whole SYN_REPORT group reaches the
+   * kernel with a single write() syscall.
+   *
+   * @param type Event type (e.g., EV_KEY, EV_SYN).
+   * @param code Event code (e.g., key code).
+   * @param val Event value (press/release/value).
+   */
+  void emit(int type, int code, int val) {
+    struct input_event ev{};
+    ev.type = static_cast<unsigned short>(type);
+    ev.code = static_cast<unsigned short>(code);
+    ev.value = val;
+    frame.push_back(ev);
   }
 
   /**
    * @internal
-   * @brief Map an xkb keysym to a logical `Key` enum value.
+   * @brief Write a contiguous run of complete frames to the uinput device.
    *
-   * This helper attempts efficient mappings for common contiguous ranges:
-   * - ASCII letters (a-z, A-Z) map to `Key::A`..`Key::Z`
-   * - Digits (0-9) map to `Key::Num0`..`Key::Num9`
-   * - Function keys (F1..F20) map to `Key::F1`..`Key::F20`
+   * An owned device gets the events as-is in a single write(). On a shared
+   * device the write happens under the device lock, so frames of different
+   * Senders never interleave, and key edges are first reconciled with the
+   * other users (`filterShared()`).
    *
-   * When a keysym does not fall into those ranges, the function falls back to
-   * an explicit switch that covers common control keys, punctuation and other
-   * symbol keysyms. If no mapping exists the function returns `Key::Unknown`.
+   * @param events First event to write.
+   * @param count Number of events.
+   * @return true if every event was written; false otherwise.
+   */
+  bool writeEvents(const struct input_event *events, size_t count) {
+    if (fd < 0)
+      return false;
+    if (!sharedDevice) {
+      return stats.timed(count,
+                         [&]() { return device->writeAll(events, count); });
+    }
+    std::lock_guard<std::mutex> lk(device->writeMutex);
+    filterShared(events, count);
+    if (sharedFrame.empty())
+      return true;
+    return stats.timed(sharedFrame.size(), [&]() {
+      return device->writeAll(sharedFrame.data(), sharedFrame.size());
+    });
+  }
+
+  /**
+   * @internal
+   * @brief Copy `events` into `sharedFrame`, keeping only the key edges that
+   * change the shared device's state.
    *
-   * @param sym xkb keysym to translate.
-   * @return Key Mapped logical key, or `Key::Unknown` if unmapped.
+   * A press reaches the kernel only when this Sender is the first holder of
+   * the key and a release only when it is the last one; edges for keys this
+   * Sender does not hold (or already holds) are dropped. Frames left empty
+   * lose their SYN_REPORT. Called with `device->writeMutex` held.
    */
-  Key keysymToKey(xkb_keysym_t sym) {
-    if (sym >= XKB_KEY_a && sym <= XKB_KEY_z)
-      return static_cast<Key>(static_cast<int>(Key::A) + (sym - XKB_KEY_a));
-    if (sym >= XKB_KEY_A && sym <= XKB_KEY_Z)
-      return static_cast<Key>(static_cast<int>(Key::A) + (sym - XKB_KEY_A));
-    if (sym >= XKB_KEY_0 && sym <= XKB_KEY_9)
-      return static_cast<Key>(static_cast<int>(Key::Num0) + (sym - XKB_KEY_0));
-    if (sym >= XKB_KEY_F1 && sym <= XKB_KEY_F20)
-      return static_cast<Key>(static_cast<int>(Key::F1) + (sym - XKB_KEY_F1));
-
-    switch (sym) {
-    case XKB_KEY_Return:
-      return Key::Enter;
-    case XKB_KEY_BackSpace:
-      return Key::Backspace;
-    case XKB_KEY_space:
-      return Key::Space;
-    case XKB_KEY_Tab:
-      return Key::Tab;
-    case XKB_KEY_Escape:
-      return Key::Escape;
-    case XKB_KEY_Left:
-      return Key::Left;
-    case XKB_KEY_Right:
-      return Key::Right;
-    case XKB_KEY_Up:
-      return Key::Up;
-    case XKB_KEY_Down:
-      return Key::Down;
-    case XKB_KEY_Home:
-      return Key::Home;
-    case XKB_KEY_End:
-      return Key::End;
-    case XKB_KEY_Page_Up:
-      return Key::PageUp;
-    case XKB_KEY_Page_Down:
-      return Key::PageDown;
-    case XKB_KEY_Delete:
-      return Key::Delete;
-    case XKB_KEY_Insert:
-      return Key::Insert;
-    case XKB_KEY_Shift_L:
-      return Key::ShiftLeft;
-    case XKB_KEY_Shift_R:
-      return Key::ShiftRight;
-    case XKB_KEY_Control_L:
-      return Key::CtrlLeft;
-    case XKB_KEY_Control_R:
-      return Key::CtrlRight;
-    case XKB_KEY_Alt_L:
-      return Key::AltLeft;
-    case XKB_KEY_Alt_R:
-      return Key::AltRight;
-    case XKB_KEY_Super_L:
-      return Key::SuperLeft;
-    case XKB_KEY_Super_R:
-      return Key::SuperRight;
-    case XKB_KEY_Caps_Lock:
-      return Key::CapsLock;
-    case XKB_KEY_Num_Lock:
-      return Key::NumLock;
-    default:
-      return Key::Unknown;
+  void filterShared(const struct input_event *events, size_t count) {
+    sharedFrame.clear();
+    size_t frameStart = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const struct input_event &ev = events[i];
+      if (ev.type == EV_KEY && ev.code < KEY_CNT && ev.value != 2) {
+        uint16_t &holders = device->holders[ev.code];
+        if (ev.value != 0) {
+          if (heldKeys.test(ev.code))
+            continue;
+          heldKeys.set(ev.code);
+          if (holders++ > 0)
+            continue;
+        } else {
+          if (!heldKeys.test(ev.code))
+            continue;
+          heldKeys.reset(ev.code);
+          if (--holders > 0)
+            continue;
+        }
+      } else if (ev.type == EV_SYN && ev.code == SYN_REPORT) {
+        if (sharedFrame.size() == frameStart)
+          continue;
+        sharedFrame.push_back(ev);
+        frameStart = sharedFrame.size();
+        continue;
+      }
+      sharedFrame.push_back(ev);
     }
   }
 
   /**
    * @internal
-   * @brief Populate `keyMap` with conservative fallback keycodes when XKB
-   *        layout information is unavailable.
+   * @brief Write all pending events to the uinput device in one syscall.
    *
-   * This helper installs sensible, layout-independent mappings for common
-   * modifier, navigation, function and numpad keys (typically based on
-   * physical positions or canonical evdev defaults). It is used as a fallback
-   * when the XKB `keymap` / `state` are not present so the uinput backend can
-   * still inject basic keys reliably.
+   * The frame buffer is cleared in every case so a failing device cannot
+   * grow it unbounded.
    *
-   * The function is intentionally conservative and only sets values that are
-   * safe across a wide range of layouts; it prefers physical key semantics
-   * over layout-dependent shifted/unshifted characters.
+   * @return true if every pending event was written; false otherwise.
    */
-  void initFallbackKeyMap() {
-    auto set = [this](Key k, int v) {
-      if (keyMap.find(k) == keyMap.end())
-        keyMap[k] = v;
-    };
+  bool writeFrame() {
+    if (frame.empty())
+      return true;
+    bool ok = writeEvents(frame.data(), frame.size());
+    frame.clear();
+    return ok;
+  }
 
-    // Modifiers (always same physical keys)
-    set(Key::ShiftLeft, KEY_LEFTSHIFT);
-    set(Key::ShiftRight, KEY_RIGHTSHIFT);
-    set(Key::CtrlLeft, KEY_LEFTCTRL);
-    set(Key::CtrlRight, KEY_RIGHTCTRL);
-    set(Key::AltLeft, KEY_LEFTALT);
-    set(Key::AltRight, KEY_RIGHTALT);
-    set(Key::SuperLeft, KEY_LEFTMETA);
-    set(Key::SuperRight, KEY_RIGHTMETA);
-    set(Key::CapsLock, KEY_CAPSLOCK);
-    set(Key::NumLock, KEY_NUMLOCK);
-
-    // Navigation (layout-independent)
-    set(Key::Space, KEY_SPACE);
-    set(Key::Enter, KEY_ENTER);
-    set(Key::Tab, KEY_TAB);
-    set(Key::Backspace, KEY_BACKSPACE);
-    set(Key::Delete, KEY_DELETE);
-    set(Key::Escape, KEY_ESC);
-    set(Key::Left, KEY_LEFT);
-    set(Key::Right, KEY_RIGHT);
-    set(Key::Up, KEY_UP);
-    set(Key::Down, KEY_DOWN);
-    set(Key::Home, KEY_HOME);
-    set(Key::End, KEY_END);
-    set(Key::PageUp, KEY_PAGEUP);
-    set(Key::PageDown, KEY_PAGEDOWN);
-
-    // Function keys
-    set(Key::F1, KEY_F1);
-    set(Key::F2, KEY_F2);
-    set(Key::F3, KEY_F3);
-    set(Key::F4, KEY_F4);
-    set(Key::F5, KEY_F5);
-    set(Key::F6, KEY_F6);
-    set(Key::F7, KEY_F7);
-    set(Key::F8, KEY_F8);
-    set(Key::F9, KEY_F9);
-    set(Key::F10, KEY_F10);
-    set(Key::F11, KEY_F11);
-    set(Key::F12, KEY_F12);
-
-    // Numpad (physical position)
-    set(Key::Numpad0, KEY_KP0);
-    set(Key::Numpad1, KEY_KP1);
-    set(Key::Numpad2, KEY_KP2);
-    set(Key::Numpad3, KEY_KP3);
-    set(Key::Numpad4, KEY_KP4);
-    set(Key::Numpad5, KEY_KP5);
-    set(Key::Numpad6, KEY_KP6);
-    set(Key::Numpad7, KEY_KP7);
-    set(Key::Numpad8, KEY_KP8);
-    set(Key::Numpad9, KEY_KP9);
-    set(Key::NumpadDivide, KEY_KPSLASH);
-    set(Key::NumpadMultiply, KEY_KPASTERISK);
-    set(Key::NumpadMinus, KEY_KPMINUS);
-    set(Key::NumpadPlus, KEY_KPPLUS);
-    set(Key::NumpadEnter, KEY_KPENTER);
-    set(Key::NumpadDecimal, KEY_KPDOT);
+  /**
+   * @internal
+   * @brief Close the current frame with SYN_REPORT and write it out.
+   *
+   * This ensures that any previously emitted EV_KEY/EV_REL/EV_ABS events are
+   * delivered as an atomic group to the input subsystem.
+   */
+  bool sync() {
+    emit(EV_SYN, SYN_REPORT, 0);
+    return writeFrame();
   }
 
   /**
    * @internal
-   * @brief Emit a raw input_event to the uinput device.
+   * @brief Close the current frame if it holds any events.
+   */
+  bool closeFrame() { return frame.empty() ? true : sync(); }
+
+  /**
+   * @internal
+   * @brief Whether key edges may currently share a SYN frame.
    *
-   * This helper constructs an `input_event` and writes it directly to the
-   * uinput device file descriptor. It is a low-level primitive used by
-   * higher-level helpers to synthesize key and synchronization events.
+   * Coalescing only applies when it was requested and no inter-key delay is
+   * configured; with a delay every edge must be observable on its own.
+   */
+  bool coalescing() const { return coalesceFrames && keyDelayUs == 0; }
+
+  /**
+   * @internal
+   * @brief True if the open frame already carries an edge for `evdevCode`.
    *
-   * @param type Event type (e.g., EV_KEY, EV_SYN).
-   * @param code Event code (e.g., key code).
-   * @param val Event value (press/release/value).
+   * A press and a release of the same key must never share a frame, so a
+   * second edge for the same code forces the frame to be closed first.
    */
-  void emit(int type, int code, int val) {
-    struct input_event ev{};
-    ev.type = static_cast<unsigned short>(type);
-    ev.code = static_cast<unsigned short>(code);
-    ev.value = val;
-    write(fd, &ev, sizeof(ev));
+  bool frameHasKey(int evdevCode) const {
+    for (const auto &ev : frame) {
+      if (ev.type == EV_KEY && ev.code == evdevCode)
+        return true;
+    }
+    return false;
   }
 
   /**
    * @internal
-   * @brief Emit a synchronization report (SYN_REPORT) to flush pending events.
+   * @brief RAII scope grouping the edges of one public operation.
    *
-   * This ensures that any previously emitted EV_KEY/EV_REL/EV_ABS events are
-   * delivered as an atomic group to the input subsystem.
+   * While coalescing, frames stay open across `sendKey()` calls and are
+   * closed when the outermost scope ends, so e.g. `combo()` emits
+   * "Ctrl↓ C↓" and "C↑ Ctrl↑" as two frames.
    */
-  void sync() { emit(EV_SYN, SYN_REPORT, 0); }
+  struct FrameScope {
+    Impl &impl;
+    explicit FrameScope(Impl &i) : impl(i) { ++impl.frameDepth; }
+    ~FrameScope() {
+      if (--impl.frameDepth == 0)
+        impl.closeFrame();
+    }
+    FrameScope(const FrameScope &) = delete;
+    FrameScope &operator=(const FrameScope &) = delete;
+  };
 
   /**
    * @internal
    * @brief Send a key event for the given evdev keycode.
    *
-   * Wraps `emit(EV_KEY, ...)` and follows with a `sync()` to ensure timely
-   * delivery. The function is resilient to a missing device or invalid key
-   * code and returns false in those cases.
+   * Appends the EV_KEY edge to the pending frame. By default the frame is
+   * closed right away (EV_KEY + SYN_REPORT in one write); when coalescing
+   * the frame is left open for the next edge of the same operation. The
+   * function is resilient to a missing device or invalid key code and returns
+   * false in those cases.
    *
    * @param evdevCode evdev keycode to send (e.g., KEY_A).
    * @param down true for key press, false for key release.
@@ -590,16 +619,22 @@ struct Sender::Impl {
   bool sendKey(int evdevCode, bool down) {
     if (fd < 0 || evdevCode < 0)
       return false;
+    if (!coalescing() || frameDepth == 0) {
+      emit(EV_KEY, evdevCode, down ? 1 : 0);
+      return sync();
+    }
+    bool ok = true;
+    if (frameHasKey(evdevCode))
+      ok = sync();
     emit(EV_KEY, evdevCode, down ? 1 : 0);
-    sync();
-    return true;
+    return ok;
   }
 
   /**
    * @internal
    * @brief Send a key event for a logical `Key` by looking up its evdev code.
    *
-   * Performs a lookup in the layout-aware `keyMap` and forwards to `sendKey`.
+   * Performs a lookup in the shared layout table and forwards to `sendKey`.
    * If no mapping is present, a debug log entry is emitted and the function
    * returns false.
    *
@@ -608,71 +643,290 @@ struct Sender::Impl {
    * @return true on success, false when mapping is missing or send fails.
    */
   bool sendKeyByKey(Key key, bool down) {
-    auto it = keyMap.find(key);
-    if (it == keyMap.end()) {
+    int code = layout->keys.find(key);
+    if (code == detail::KeyTable<int, -1>::kInvalid) {
       TYPR_IO_LOG_DEBUG("Sender (uinput): no mapping for key=%s",
-                        keyToString(key).c_str());
+                        keyToStringView(key).data());
       return false;
     }
-    return sendKey(it->second, down);
+    return sendKey(code, down);
   }
 
   /**
    * @internal
    * @brief Type a single Unicode codepoint using layout-derived keycodes.
    *
-   * Looks up the provided codepoint in `charToKeycode`, optionally holds
-   * shift if the character requires it, emits press/release for the resolved
-   * evdev keycode, and synchronizes the event stream.
+   * Looks up the provided codepoint in the shared layout table, optionally holds
+   * shift if the character requires it, and emits press/release for the
+   * resolved evdev keycode. Each edge is already framed by `sendKey()`.
    *
    * @param cp Unicode codepoint (UTF-32).
    * @return true on success, false when no mapping exists.
    */
   bool typeCodepoint(char32_t cp) {
-    auto it = charToKeycode.find(cp);
-    if (it == charToKeycode.end()) {
+    const detail::CharKey *mapped = layout->chars.find(cp);
+    if (!mapped) {
       TYPR_IO_LOG_DEBUG("Sender (uinput): no mapping for codepoint U+%04X",
                         static_cast<unsigned>(cp));
       return false;
     }
 
-    int evdevCode = it->second.first;
-    bool needsShift = it->second.second;
+    int evdevCode = mapped->code;
+    bool needsShift = mapped->shift;
 
+    // With a typing rate the character as a whole is paced, not its edges
+    const bool edgeDelays = !ratePaced();
+    FrameScope scope(*this);
     if (needsShift) {
       sendKey(KEY_LEFTSHIFT, true);
-      delay();
+      if (edgeDelays)
+        delay();
     }
 
     sendKey(evdevCode, true);
-    delay();
+    if (edgeDelays)
+      delay();
     sendKey(evdevCode, false);
 
     if (needsShift) {
-      delay();
+      if (edgeDelays)
+        delay();
       sendKey(KEY_LEFTSHIFT, false);
     }
-
-    sync();
     return true;
   }
 
   /**
    * @internal
-   * @brief Sleep for the configured key delay interval.
+   * @brief Maximum number of SYN frames written per bulk write().
    *
-   * Sleeps for `keyDelayUs` microseconds when a non-zero delay is configured.
-   * This small helper centralizes the delay logic used by tap/combo and
-   * character injection helpers.
+   * evdev clients buffer a limited number of events per device; handing the
+   * kernel a whole paste at once would overflow slow readers (SYN_DROPPED),
+   * so bulk plans are written in bounded batches.
+   */
+  static constexpr size_t kBulkFramesPerWrite = 16;
+
+  /**
+   * @internal
+   * @brief Type a whole string from a pre-planned event stream.
+   *
+   * The text is first compiled into a flat list of SYN-terminated frames
+   * (one frame per key press, including any Shift transition, and one per
+   * release). Shift is only toggled when consecutive characters differ in
+   * their shift requirement, so runs of uppercase letters hold it once.
+   * The plan is then written in batches of `kBulkFramesPerWrite` frames and
+   * the key delay is applied between batches rather than between edges. With
+   * a typing rate configured, each batch is one character and batches are
+   * paced at that rate instead.
+   *
+   * Characters without a mapping are skipped and reported via the return
+   * value. If the caller already holds Shift it is left untouched.
+   *
+   * @param text Codepoints to type.
+   * @return true if every codepoint was mapped and written; false otherwise.
+   */
+  bool typeBulk(std::u32string_view text) {
+    if (fd < 0)
+      return false;
+
+    closeFrame();
+
+    const bool callerShift = hasModifier(currentMods, Modifier::Shift);
+    bool shiftDown = callerShift;
+    bool allOk = true;
+
+    // Worst case per character: Shift edge + key down + SYN, key up + SYN
+    frame.reserve(text.size() * 5 + 2);
+    std::vector<size_t> frameEnds; // event index one past each SYN_REPORT
+    frameEnds.reserve(text.size() * 2 + 1);
+    auto endFrame = [this, &frameEnds]() {
+      emit(EV_SYN, SYN_REPORT, 0);
+      frameEnds.push_back(frame.size());
+    };
+
+    for (char32_t cp : text) {
+      const detail::CharKey *mapped = layout->chars.find(cp);
+      if (!mapped) {
+        TYPR_IO_LOG_DEBUG("Sender (uinput): no mapping for codepoint U+%04X",
+                          static_cast<unsigned>(cp));
+        allOk = false;
+        continue;
+      }
+      const int evdevCode = mapped->code;
+      const bool needsShift = mapped->shift || callerShift;
+
+      if (needsShift != shiftDown) {
+        emit(EV_KEY, KEY_LEFTSHIFT, needsShift ? 1 : 0);
+        shiftDown = needsShift;
+      }
+      emit(EV_KEY, evdevCode, 1);
+      endFrame();
+      emit(EV_KEY, evdevCode, 0);
+      endFrame();
+    }
+    if (shiftDown && !callerShift) {
+      emit(EV_KEY, KEY_LEFTSHIFT, 0);
+      endFrame();
+    }
+
+    // Emit the plan in bounded batches, one write() per batch. A character
+    // is a press frame plus a release frame, so rate pacing uses batches of 2.
+    const size_t framesPerBatch = ratePaced() ? 2 : kBulkFramesPerWrite;
+    size_t begin = 0;
+    for (size_t f = framesPerBatch - 1; begin < frame.size();
+         f += framesPerBatch) {
+      size_t end = f < frameEnds.size() ? frameEnds[f] : frame.size();
+      if (!writeEvents(frame.data() + begin, end - begin)) {
+        allOk = false;
+        break;
+      }
+      begin = end;
+      if (begin < frame.size())
+        charDelay();
+    }
+    frame.clear();
+    if (frame.capacity() > 4096) {
+      frame.shrink_to_fit();
+      frame.reserve(16);
+    }
+    return allOk;
+  }
+
+  /**
+   * @internal
+   * @brief Compile a `KeySequence` into input_event frames.
+   *
+   * Every key edge gets its own frame; text is planned like `typeBulk()`,
+   * toggling Shift only between characters that differ in their shift
+   * requirement. Shift held by an earlier KeyDown step of the sequence is
+   * left alone.
+   */
+  SequenceProgram compileSequence(const KeySequence &sequence) const {
+    SequenceProgram program;
+    auto push = [&program](int type, int code, int val) {
+      struct input_event ev{};
+      ev.type = static_cast<unsigned short>(type);
+      ev.code = static_cast<unsigned short>(code);
+      ev.value = val;
+      program.events.push_back(ev);
+    };
+    auto edge = [&push](int code, bool down) {
+      push(EV_KEY, code, down ? 1 : 0);
+      push(EV_SYN, SYN_REPORT, 0);
+    };
+
+    int heldShifts = 0;
+    for (const KeySequence::Step &step : sequence.steps()) {
+      switch (step.kind) {
+      case KeySequence::StepKind::KeyDown:
+      case KeySequence::StepKind::KeyUp: {
+        const bool down = step.kind == KeySequence::StepKind::KeyDown;
+        const int code = layout->keys.find(step.key);
+        if (code == detail::KeyTable<int, -1>::kInvalid) {
+          program.complete = false;
+          break;
+        }
+        if (step.key == Key::ShiftLeft || step.key == Key::ShiftRight)
+          heldShifts += down ? 1 : -1;
+        edge(code, down);
+        break;
+      }
+      case KeySequence::StepKind::Text: {
+        const bool callerShift = heldShifts > 0;
+        bool shiftDown = callerShift;
+        for (char32_t cp : sequence.textOf(step)) {
+          const detail::CharKey *mapped = layout->chars.find(cp);
+          if (!mapped) {
+            program.complete = false;
+            continue;
+          }
+          const bool needsShift = mapped->shift || callerShift;
+          if (needsShift != shiftDown) {
+            push(EV_KEY, KEY_LEFTSHIFT, needsShift ? 1 : 0);
+            shiftDown = needsShift;
+          }
+          edge(mapped->code, true);
+          edge(mapped->code, false);
+        }
+        if (shiftDown && !callerShift)
+          edge(KEY_LEFTSHIFT, false);
+        break;
+      }
+      case KeySequence::StepKind::Delay:
+        program.segments.push_back({program.events.size(), step.delayUs});
+        break;
+      }
+    }
+    if (program.segments.empty() ||
+        program.segments.back().end != program.events.size())
+      program.segments.push_back({program.events.size(), 0});
+    return program;
+  }
+
+  /**
+   * @internal
+   * @brief Play a sequence from its cached program.
+   */
+  bool playSequence(const KeySequence &sequence) {
+    if (fd < 0)
+      return false;
+    closeFrame();
+    const SequenceProgram &program = sequences.get(
+        sequence, [this](const KeySequence &seq) { return compileSequence(seq); });
+
+    bool ok = program.complete;
+    size_t begin = 0;
+    for (const SequenceProgram::Segment &segment : program.segments) {
+      if (segment.end > begin &&
+          !writeEvents(program.events.data() + begin, segment.end - begin))
+        return false;
+      begin = segment.end;
+      if (segment.delayUs > 0)
+        detail::sleepUntil(detail::PacerClock::now() +
+                           std::chrono::microseconds(segment.delayUs));
+    }
+    return ok;
+  }
+
+  /**
+   * @internal
+   * @brief Wait for the next key-delay deadline.
+   *
+   * Waits on the absolute `keyPacer` schedule (one `keyDelayUs` interval
+   * after the previous deadline) when a non-zero delay is configured. This
+   * small helper centralizes the delay logic used by tap/combo and character
+   * injection helpers.
    */
   void delay() {
     if (keyDelayUs > 0)
-      std::this_thread::sleep_for(std::chrono::microseconds(keyDelayUs));
+      keyPacer.wait();
+  }
+
+  /**
+   * @internal
+   * @brief True when text is paced per character (`setTypingRate()`).
+   */
+  bool ratePaced() const { return charsPerSecond > 0.0; }
+
+  /**
+   * @internal
+   * @brief Wait between two typed characters.
+   *
+   * Uses the per-character schedule when a typing rate is configured and the
+   * regular key delay otherwise.
+   */
+  void charDelay() {
+    if (ratePaced())
+      charPacer.wait();
+    else
+      delay();
   }
 };
 
 // Public interface implementation
-Sender::Sender() : m_impl(std::make_unique<Impl>()) {}
+Sender::Sender() : Sender(SenderOptions{}) {}
+Sender::Sender(const SenderOptions &options)
+    : m_impl(std::make_unique<Impl>(options)) {}
 Sender::~Sender() = default;
 Sender::Sender(Sender &&) noexcept = default;
 Sender &Sender::operator=(Sender &&) noexcept = default;
@@ -682,7 +936,7 @@ BackendType Sender::type() const { return BackendType::LinuxUInput; }
 Capabilities Sender::capabilities() const {
   return {
       .canInjectKeys = (m_impl && m_impl->fd >= 0),
-      .canInjectText = (m_impl && !m_impl->charToKeycode.empty()),
+      .canInjectText = (m_impl && !m_impl->layout->chars.empty()),
       .canSimulateHID = true,
       .supportsKeyRepeat = true,
       .needsAccessibilityPerm = false,
@@ -760,6 +1014,9 @@ bool Sender::keyUp(Key key) {
 }
 
 bool Sender::tap(Key key) {
+  if (!m_impl)
+    return false;
+  Impl::FrameScope scope(*m_impl);
   if (!keyDown(key))
     return false;
   m_impl->delay();
@@ -771,6 +1028,9 @@ Modifier Sender::activeModifiers() const {
 }
 
 bool Sender::holdModifier(Modifier mod) {
+  if (!m_impl)
+    return false;
+  Impl::FrameScope scope(*m_impl);
   bool ok = true;
   if (hasModifier(mod, Modifier::Shift))
     ok &= keyDown(Key::ShiftLeft);
@@ -784,6 +1044,9 @@ bool Sender::holdModifier(Modifier mod) {
 }
 
 bool Sender::releaseModifier(Modifier mod) {
+  if (!m_impl)
+    return false;
+  Impl::FrameScope scope(*m_impl);
   bool ok = true;
   if (hasModifier(mod, Modifier::Shift))
     ok &= keyUp(Key::ShiftLeft);
@@ -802,6 +1065,9 @@ bool Sender::releaseAllModifiers() {
 }
 
 bool Sender::combo(Modifier mods, Key key) {
+  if (!m_impl)
+    return false;
+  Impl::FrameScope scope(*m_impl);
   if (!holdModifier(mods))
     return false;
   m_impl->delay();
@@ -811,74 +1077,76 @@ bool Sender::combo(Modifier mods, Key key) {
   return ok;
 }
 
-bool Sender::typeText(const std::u32string &text) {
+bool Sender::typeText(std::u32string_view text) {
   if (!m_impl)
     return false;
 
+  Impl::FrameScope scope(*m_impl);
   bool allOk = true;
   for (char32_t cp : text) {
     if (!m_impl->typeCodepoint(cp)) {
       allOk = false;
     }
-    m_impl->delay();
+    m_impl->charDelay();
   }
   return allOk;
 }
 
-bool Sender::typeText(const std::string &utf8Text) {
-  // Convert UTF-8 to UTF-32
-  std::u32string utf32;
-  size_t i = 0;
-  while (i < utf8Text.size()) {
-    char32_t cp = 0;
-    auto c = static_cast<unsigned char>(utf8Text[i]);
-    if ((c & 0x80) == 0) {
-      cp = c;
-      i += 1;
-    } else if ((c & 0xE0) == 0xC0) {
-      cp = (c & 0x1F) << 6;
-      if (i + 1 < utf8Text.size())
-        cp |= (utf8Text[i + 1] & 0x3F);
-      i += 2;
-    } else if ((c & 0xF0) == 0xE0) {
-      cp = (c & 0x0F) << 12;
-      if (i + 1 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 1]) & 0x3F) << 6;
-      if (i + 2 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 2]) & 0x3F);
-      i += 3;
-    } else if ((c & 0xF8) == 0xF0) {
-      cp = (c & 0x07) << 18;
-      if (i + 1 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 1]) & 0x3F) << 12;
-      if (i + 2 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 2]) & 0x3F) << 6;
-      if (i + 3 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 3]) & 0x3F);
-      i += 4;
-    } else {
-      i += 1;
-      continue;
-    }
-    utf32.push_back(cp);
-  }
-  return typeText(utf32);
+bool Sender::typeText(std::string_view utf8Text) {
+  return typeText(detail::utf8ToUtf32(utf8Text));
+}
+
+bool Sender::typeTextBulk(std::u32string_view text) {
+  if (!m_impl)
+    return false;
+  return m_impl->typeBulk(text);
+}
+
+bool Sender::typeTextBulk(std::string_view utf8Text) {
+  return typeTextBulk(detail::utf8ToUtf32(utf8Text));
 }
 
 bool Sender::typeCharacter(char32_t codepoint) {
   if (!m_impl)
     return false;
-  return m_impl->typeCodepoint(codepoint);
+  bool ok = m_impl->typeCodepoint(codepoint);
+  if (m_impl->ratePaced())
+    m_impl->charPacer.wait();
+  return ok;
+}
+
+bool Sender::play(const KeySequence &sequence) {
+  return m_impl ? m_impl->playSequence(sequence) : false;
 }
 
 void Sender::flush() {
   if (m_impl)
-    m_impl->sync();
+    m_impl->closeFrame();
 }
 
 void Sender::setKeyDelay(uint32_t delayUs) {
-  if (m_impl)
-    m_impl->keyDelayUs = delayUs;
+  if (!m_impl)
+    return;
+  m_impl->keyDelayUs = delayUs;
+  m_impl->keyPacer.setInterval(std::chrono::microseconds(delayUs));
+}
+
+void Sender::setTypingRate(double charsPerSecond) {
+  if (!m_impl)
+    return;
+  m_impl->charsPerSecond = charsPerSecond > 0.0 ? charsPerSecond : 0.0;
+  m_impl->charPacer.setInterval(detail::rateToInterval(charsPerSecond));
+}
+
+void Sender::setFrameCoalescing(bool enabled) {
+  if (!m_impl)
+    return;
+  m_impl->closeFrame();
+  m_impl->coalesceFrames = enabled;
+}
+
+SenderStats Sender::stats() const {
+  return m_impl ? m_impl->stats.snapshot() : SenderStats{};
 }
 
 } // namespace typr::io
@@ -10,11 +10,22 @@
 #ifdef _WIN32
 
 #include <Windows.h>
+
+#include <typr-io/key_sequence.hpp>
+
+#include "common/key_table.hpp"
+#include "common/pacer.hpp"
+#include "common/stats_recorder.hpp"
+#include "common/utf8.hpp"
+#include "sender/sequence_cache.hpp"
+
+#include <array>
 #include <chrono>
 #include <thread>
+#include <utility>
+#include <vector>
 #include <typr-io/log.hpp>
 #include <typr-io/sender.hpp>
-#include <unordered_map>
 
 namespace typr::io {
 
@@ -74,11 +85,52 @@ struct Sender::Impl {
   Modifier currentMods{Modifier::None};
   uint32_t keyDelayUs{1000}; // 1ms default
   bool ready{true};
-  HKL layout{nullptr};
-  std::unordered_map<Key, WORD> keyMap;
+  HKL layout{nullptr};              // Layout the tables below were built for
+  detail::KeyTable<WORD, 0> keyMap; // Key -> VK (0 = unmapped)
+  std::array<WORD, 256> scanCodes{}; // VK -> scancode for `layout`
+
+  // Modifier keys pressed by holdModifier() and combo(), in press order
+  static constexpr std::array<std::pair<Modifier, Key>, 4> kModifierKeys{{
+      {Modifier::Shift, Key::ShiftLeft},
+      {Modifier::Ctrl, Key::CtrlLeft},
+      {Modifier::Alt, Key::AltLeft},
+      {Modifier::Super, Key::SuperLeft},
+  }};
+
+  // Edges collected by the composed operations and submitted with one
+  // SendInput call (reused to avoid an allocation per call)
+  std::vector<INPUT> batch;
+
+  // Absolute-deadline pacing for key edges and (optionally) typed characters
+  detail::Pacer keyPacer;
+  detail::Pacer charPacer;
+  double charsPerSecond{0.0};
+
+  // Injection counters; read by Sender::stats()
+  detail::SenderStatsRecorder stats;
+
+  /**
+   * @internal
+   * @brief A `KeySequence` compiled to `INPUT` structures.
+   *
+   * `segments` split the inputs at the sequence's delay steps: each segment
+   * is one `SendInput` call followed by its delay.
+   */
+  struct SequenceProgram {
+    struct Segment {
+      size_t end{0};       // one past the segment's last input
+      uint32_t delayUs{0}; // wait after sending the segment
+    };
+    std::vector<INPUT> inputs;
+    std::vector<Segment> segments;
+    bool complete{true}; // false if a key had no mapping
+  };
+  detail::SequenceCache<SequenceProgram> sequences;
 
-  Impl() : layout(GetKeyboardLayout(0)) {
+  Impl() : layout(foregroundLayout()) {
+    keyPacer.setInterval(std::chrono::microseconds(keyDelayUs));
     initKeyMap();
+    buildScanCodes();
     TYPR_IO_LOG_INFO("Sender (Windows): Impl created; ready=%u",
                      static_cast<unsigned>(ready));
   }
@@ -125,18 +177,13 @@ struct Sender::Impl {
         }
         Key mapped = stringToKey(mappedKeyString);
         if (mapped != Key::Unknown) {
-          if (keyMap.find(mapped) == keyMap.end()) {
-            keyMap[mapped] = static_cast<WORD>(vk);
-          }
+          keyMap.insert(mapped, static_cast<WORD>(vk));
         }
       }
     }
 
     // Fallback explicit mappings for common non-printable keys / modifiers
-    auto setIfMissing = [this](Key k, WORD v) {
-      if (this->keyMap.find(k) == this->keyMap.end())
-        this->keyMap[k] = v;
-    };
+    auto setIfMissing = [this](Key k, WORD v) { this->keyMap.insert(k, v); };
 
     // Common keys
     setIfMissing(Key::Space, VK_SPACE);
@@ -259,9 +306,79 @@ struct Sender::Impl {
    * @param key Logical `Key` to translate.
    * @return WORD Virtual-key code, or 0 if no mapping is present.
    */
-  WORD winVkFor(Key key) const {
-    auto it = keyMap.find(key);
-    return (it != keyMap.end()) ? it->second : 0;
+  WORD winVkFor(Key key) const { return keyMap.find(key); }
+
+  /**
+   * @internal
+   * @brief Cache the scancode of every virtual-key code for `layout`, so
+   * injection does not call `MapVirtualKeyW` per edge.
+   */
+  void buildScanCodes() {
+    for (UINT vk = 0; vk < scanCodes.size(); ++vk)
+      scanCodes[vk] =
+          static_cast<WORD>(MapVirtualKeyExW(vk, MAPVK_VK_TO_VSC, layout));
+  }
+
+  /**
+   * @internal
+   * @brief Keyboard layout of the thread owning the foreground window.
+   *
+   * Layouts are per thread and injected input is translated with the layout
+   * of the window that receives it, so that is the layout the tables must
+   * match (as in the Windows Listener). A handle comparison is cheap enough
+   * to run per injection call.
+   */
+  static HKL foregroundLayout() {
+    HWND foreground = GetForegroundWindow();
+    DWORD tid =
+        foreground ? GetWindowThreadProcessId(foreground, nullptr) : 0;
+    return GetKeyboardLayout(tid);
+  }
+
+  /**
+   * @internal
+   * @brief Rebuild the layout-dependent tables when the foreground layout
+   * changed since they were built.
+   *
+   * The VK and scancode tables and the compiled sequences (which embed
+   * scancodes) are all keyed on `layout`, so a layout switch by the user
+   * never leaves the Sender injecting stale scancodes.
+   */
+  void syncLayout() {
+    const HKL current = foregroundLayout();
+    if (current == layout)
+      return;
+    layout = current;
+    keyMap.clear();
+    initKeyMap();
+    buildScanCodes();
+    sequences.clear();
+    TYPR_IO_LOG_INFO("Sender (Windows): keyboard layout changed; tables "
+                     "rebuilt (%zu keys)",
+                     keyMap.size());
+  }
+
+  /**
+   * @internal
+   * @brief Build the scancode `INPUT` for a virtual-key edge.
+   *
+   * @param vk Virtual-key code (non-zero).
+   * @param down True for key-down; false for key-up.
+   */
+  INPUT keyInput(WORD vk, bool down) const {
+    INPUT input{};
+    input.type = INPUT_KEYBOARD;
+    input.ki.wVk = vk;
+    input.ki.wScan = vk < scanCodes.size() ? scanCodes[vk] : 0;
+    input.ki.dwFlags = KEYEVENTF_SCANCODE;
+
+    if (isExtendedKey(vk)) {
+      input.ki.dwFlags |= KEYEVENTF_EXTENDEDKEY;
+    }
+    if (!down) {
+      input.ki.dwFlags |= KEYEVENTF_KEYUP;
+    }
+    return input;
   }
 
   /**
@@ -279,98 +396,249 @@ struct Sender::Impl {
    *         failure or when the key has no known mapping.
    */
   bool sendKey(Key key, bool down) {
+    syncLayout();
     WORD vk = winVkFor(key);
     if (vk == 0) {
       TYPR_IO_LOG_DEBUG("Sender (Windows): no mapping for key=%s",
-                        keyToString(key).c_str());
+                        keyToStringView(key).data());
       return false;
     }
 
-    INPUT input{};
-    input.type = INPUT_KEYBOARD;
-    input.ki.wVk = vk;
-    input.ki.wScan = MapVirtualKeyW(vk, MAPVK_VK_TO_VSC);
-    input.ki.dwFlags = KEYEVENTF_SCANCODE;
-
-    if (isExtendedKey(vk)) {
-      input.ki.dwFlags |= KEYEVENTF_EXTENDEDKEY;
-    }
-    if (!down) {
-      input.ki.dwFlags |= KEYEVENTF_KEYUP;
-    }
-
-    BOOL ok = SendInput(1, &input, sizeof(INPUT)) > 0;
+    INPUT input = keyInput(vk, down);
+    BOOL ok = stats.timed(1, [&]() {
+      return SendInput(1, &input, sizeof(INPUT)) > 0;
+    });
     if (!ok) {
       TYPR_IO_LOG_ERROR("Sender (Windows): SendInput failed for vk=%u key=%s",
-                        static_cast<unsigned>(vk), keyToString(key).c_str());
+                        static_cast<unsigned>(vk), keyToStringView(key).data());
     } else {
       TYPR_IO_LOG_DEBUG("Sender (Windows): sendKey vk=%u key=%s down=%u",
-                        static_cast<unsigned>(vk), keyToString(key).c_str(),
+                        static_cast<unsigned>(vk), keyToStringView(key).data(),
                         static_cast<unsigned>(down));
     }
     return ok;
   }
 
+  /**
+   * @internal
+   * @brief Append the edge of `key` to `batch`.
+   * @return false (appending nothing) when the key has no known mapping.
+   */
+  bool appendKey(Key key, bool down) {
+    syncLayout();
+    const WORD vk = winVkFor(key);
+    if (vk == 0) {
+      TYPR_IO_LOG_DEBUG("Sender (Windows): no mapping for key=%s",
+                        keyToStringView(key).data());
+      return false;
+    }
+    batch.push_back(keyInput(vk, down));
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Submit `batch` with a single `SendInput` call and clear it.
+   *
+   * Windows inserts the whole array into the input stream at once, so no
+   * other input can land between its edges.
+   *
+   * @return true if every input was queued.
+   */
+  bool sendBatch() {
+    if (batch.empty())
+      return true;
+    const UINT count = static_cast<UINT>(batch.size());
+    const bool sent = stats.timed(count, [&]() {
+      return SendInput(count, batch.data(), sizeof(INPUT)) == count;
+    });
+    if (!sent)
+      TYPR_IO_LOG_ERROR("Sender (Windows): SendInput failed for %u inputs",
+                        static_cast<unsigned>(count));
+    batch.clear();
+    return sent;
+  }
+
+  /**
+   * @internal
+   * @brief Update `currentMods` for a press or release of `key`.
+   */
+  void trackModifier(Key key, bool down) {
+    Modifier flag = Modifier::None;
+    switch (key) {
+    case Key::ShiftLeft:
+    case Key::ShiftRight:
+      flag = Modifier::Shift;
+      break;
+    case Key::CtrlLeft:
+    case Key::CtrlRight:
+      flag = Modifier::Ctrl;
+      break;
+    case Key::AltLeft:
+    case Key::AltRight:
+      flag = Modifier::Alt;
+      break;
+    case Key::SuperLeft:
+    case Key::SuperRight:
+      flag = Modifier::Super;
+      break;
+    default:
+      return;
+    }
+    currentMods = down ? (currentMods | flag)
+                       : static_cast<Modifier>(
+                             static_cast<uint8_t>(currentMods) &
+                             ~static_cast<uint8_t>(flag));
+  }
+
   /**
    * @internal
    * @brief Type a sequence of Unicode codepoints using Win32 synthetic events.
    *
-   * This helper converts each UTF-32 codepoint to UTF-16 (handling surrogate
-   * pairs when necessary) and synthesizes the corresponding keyboard input
-   * events via `SendInput`. It assembles `INPUT` structures for each codepoint
-   * including the key-down / key-up pairs required to generate Unicode
-   * characters through the system's input pipeline.
+   * Converts the codepoints to UTF-16 (surrogate pairs above U+FFFF) and
+   * hands them to `typeUtf16()`.
    *
    * @param text UTF-32 string containing codepoints to type.
    * @return true on success; false if an error occurred while sending input.
    */
-  bool typeUnicode(const std::u32string &text) {
+  bool typeUnicode(std::u32string_view text) {
     TYPR_IO_LOG_DEBUG("Sender::typeUnicode called with %zu codepoints",
                       text.size());
-    if (text.empty())
+    return typeUtf16(detail::utf32ToUtf16(text));
+  }
+
+  /**
+   * @internal
+   * @brief Type UTF-16 code units using Win32 synthetic events.
+   *
+   * Assembles the key-down / key-up `KEYEVENTF_UNICODE` pair for every code
+   * unit and submits them in a single `SendInput` call.
+   *
+   * @param utf16 UTF-16 code units to type.
+   * @return true on success; false if an error occurred while sending input.
+   */
+  bool typeUtf16(const std::u16string &utf16) {
+    if (utf16.empty())
       return true;
 
-    std::vector<INPUT> inputs;
-    inputs.reserve(text.size() * 4); // Worst case: surrogate pairs + up/down
+    std::vector<INPUT> inputs(utf16.size() * 2);
+    for (size_t i = 0; i < utf16.size(); ++i) {
+      INPUT &down = inputs[2 * i];
+      down.type = INPUT_KEYBOARD;
+      down.ki.wScan = static_cast<WORD>(utf16[i]);
+      down.ki.dwFlags = KEYEVENTF_UNICODE;
 
-    for (char32_t cp : text) {
-      // Convert to UTF-16
-      wchar_t utf16[2];
-      int len = 0;
-
-      if (cp <= 0xFFFF) {
-        utf16[0] = static_cast<wchar_t>(cp);
-        len = 1;
-      } else if (cp <= 0x10FFFF) {
-        cp -= 0x10000;
-        utf16[0] = static_cast<wchar_t>(0xD800 | (cp >> 10));
-        utf16[1] = static_cast<wchar_t>(0xDC00 | (cp & 0x3FF));
-        len = 2;
-      } else {
-        continue; // Invalid codepoint
-      }
+      INPUT &up = inputs[2 * i + 1];
+      up = down;
+      up.ki.dwFlags |= KEYEVENTF_KEYUP;
+    }
 
-      for (int i = 0; i < len; ++i) {
-        INPUT down{}, up{};
-        down.type = INPUT_KEYBOARD;
-        down.ki.wScan = utf16[i];
-        down.ki.dwFlags = KEYEVENTF_UNICODE;
+    return stats.timed(inputs.size(), [&]() {
+      return SendInput(static_cast<UINT>(inputs.size()), inputs.data(),
+                       sizeof(INPUT)) > 0;
+    });
+  }
 
-        up = down;
-        up.ki.dwFlags |= KEYEVENTF_KEYUP;
+  /**
+   * @internal
+   * @brief Compile a `KeySequence`: keys become scancode inputs, text becomes
+   * `KEYEVENTF_UNICODE` key-down / key-up pairs.
+   */
+  SequenceProgram compileSequence(const KeySequence &sequence) const {
+    SequenceProgram program;
+    for (const KeySequence::Step &step : sequence.steps()) {
+      switch (step.kind) {
+      case KeySequence::StepKind::KeyDown:
+      case KeySequence::StepKind::KeyUp: {
+        const WORD vk = winVkFor(step.key);
+        if (vk == 0) {
+          program.complete = false;
+          break;
+        }
+        program.inputs.push_back(
+            keyInput(vk, step.kind == KeySequence::StepKind::KeyDown));
+        break;
+      }
+      case KeySequence::StepKind::Text:
+        for (char16_t unit : detail::utf32ToUtf16(sequence.textOf(step))) {
+          INPUT down{};
+          down.type = INPUT_KEYBOARD;
+          down.ki.wScan = static_cast<WORD>(unit);
+          down.ki.dwFlags = KEYEVENTF_UNICODE;
+          INPUT up = down;
+          up.ki.dwFlags |= KEYEVENTF_KEYUP;
+          program.inputs.push_back(down);
+          program.inputs.push_back(up);
+        }
+        break;
+      case KeySequence::StepKind::Delay:
+        program.segments.push_back({program.inputs.size(), step.delayUs});
+        break;
+      }
+    }
+    if (program.segments.empty() ||
+        program.segments.back().end != program.inputs.size())
+      program.segments.push_back({program.inputs.size(), 0});
+    return program;
+  }
 
-        inputs.push_back(down);
-        inputs.push_back(up);
+  /**
+   * @internal
+   * @brief Play a sequence from its cached program.
+   */
+  bool playSequence(const KeySequence &sequence) {
+    syncLayout();
+    const SequenceProgram &program = sequences.get(
+        sequence, [this](const KeySequence &seq) { return compileSequence(seq); });
+
+    size_t begin = 0;
+    for (const SequenceProgram::Segment &segment : program.segments) {
+      if (segment.end > begin) {
+        const UINT count = static_cast<UINT>(segment.end - begin);
+        // SendInput takes a non-const array but does not modify it
+        INPUT *inputs = const_cast<INPUT *>(program.inputs.data() + begin);
+        const bool sent = stats.timed(count, [&]() {
+          return SendInput(count, inputs, sizeof(INPUT)) == count;
+        });
+        if (!sent) {
+          TYPR_IO_LOG_ERROR("Sender (Windows): SendInput failed for sequence");
+          return false;
+        }
       }
+      begin = segment.end;
+      if (segment.delayUs > 0)
+        detail::sleepUntil(detail::PacerClock::now() +
+                           std::chrono::microseconds(segment.delayUs));
     }
+    return program.complete;
+  }
 
-    return SendInput(static_cast<UINT>(inputs.size()), inputs.data(),
-                     sizeof(INPUT)) > 0;
+  /**
+   * @internal
+   * @brief Type text one character at a time on the typing-rate schedule.
+   *
+   * Used instead of the single batched `typeUnicode()` call when
+   * `setTypingRate()` is active.
+   *
+   * @param text UTF-32 string containing codepoints to type.
+   * @return true if every character was sent; false otherwise.
+   */
+  bool typeUnicodePaced(std::u32string_view text) {
+    bool allOk = true;
+    for (char32_t cp : text) {
+      allOk &= typeUnicode(std::u32string_view(&cp, 1));
+      charPacer.wait();
+    }
+    return allOk;
   }
 
+  /**
+   * @internal
+   * @brief Wait for the next key-delay deadline (see `detail::Pacer`).
+   */
   void delay() {
     if (keyDelayUs > 0) {
-      std::this_thread::sleep_for(std::chrono::microseconds(keyDelayUs));
+      keyPacer.wait();
     }
   }
 };
@@ -379,6 +647,8 @@ TYPR_IO_API Sender::Sender() : m_impl(std::make_unique<Impl>()) {
   TYPR_IO_LOG_INFO("Sender (Windows): constructed, ready=%u",
                    static_cast<unsigned>(isReady()));
 }
+// SendInput has no device to share, so there is nothing to configure
+TYPR_IO_API Sender::Sender(const SenderOptions &) : Sender() {}
 TYPR_IO_API Sender::~Sender() = default;
 TYPR_IO_API Sender::Sender(Sender &&) noexcept = default;
 TYPR_IO_API Sender &Sender::operator=(Sender &&) noexcept = default;
@@ -406,68 +676,31 @@ TYPR_IO_API bool Sender::isReady() const { return m_impl->ready; }
 TYPR_IO_API bool Sender::requestPermissions() { return true; }
 
 TYPR_IO_API bool Sender::keyDown(Key key) {
-  TYPR_IO_LOG_DEBUG("Sender::keyDown %s", keyToString(key).c_str());
+  TYPR_IO_LOG_DEBUG("Sender::keyDown %s", keyToStringView(key).data());
   // Update modifier state when a modifier key is pressed
-  switch (key) {
-  case Key::ShiftLeft:
-  case Key::ShiftRight:
-    m_impl->currentMods = m_impl->currentMods | Modifier::Shift;
-    break;
-  case Key::CtrlLeft:
-  case Key::CtrlRight:
-    m_impl->currentMods = m_impl->currentMods | Modifier::Ctrl;
-    break;
-  case Key::AltLeft:
-  case Key::AltRight:
-    m_impl->currentMods = m_impl->currentMods | Modifier::Alt;
-    break;
-  case Key::SuperLeft:
-  case Key::SuperRight:
-    m_impl->currentMods = m_impl->currentMods | Modifier::Super;
-    break;
-  default:
-    break;
-  }
+  m_impl->trackModifier(key, true);
   return m_impl->sendKey(key, true);
 }
 
 TYPR_IO_API bool Sender::keyUp(Key key) {
-  TYPR_IO_LOG_DEBUG("Sender::keyUp %s", keyToString(key).c_str());
+  TYPR_IO_LOG_DEBUG("Sender::keyUp %s", keyToStringView(key).data());
   bool result = m_impl->sendKey(key, false);
   // Update modifier state when a modifier key is released
-  switch (key) {
-  case Key::ShiftLeft:
-  case Key::ShiftRight:
-    m_impl->currentMods =
-        static_cast<Modifier>(static_cast<uint8_t>(m_impl->currentMods) &
-                              ~static_cast<uint8_t>(Modifier::Shift));
-    break;
-  case Key::CtrlLeft:
-  case Key::CtrlRight:
-    m_impl->currentMods =
-        static_cast<Modifier>(static_cast<uint8_t>(m_impl->currentMods) &
-                              ~static_cast<uint8_t>(Modifier::Ctrl));
-    break;
-  case Key::AltLeft:
-  case Key::AltRight:
-    m_impl->currentMods =
-        static_cast<Modifier>(static_cast<uint8_t>(m_impl->currentMods) &
-                              ~static_cast<uint8_t>(Modifier::Alt));
-    break;
-  case Key::SuperLeft:
-  case Key::SuperRight:
-    m_impl->currentMods =
-        static_cast<Modifier>(static_cast<uint8_t>(m_impl->currentMods) &
-                              ~static_cast<uint8_t>(Modifier::Super));
-    break;
-  default:
-    break;
-  }
+  m_impl->trackModifier(key, false);
   return result;
 }
 
 TYPR_IO_API bool Sender::tap(Key key) {
-  TYPR_IO_LOG_DEBUG("Sender::tap %s", keyToString(key).c_str());
+  TYPR_IO_LOG_DEBUG("Sender::tap %s", keyToStringView(key).data());
+  if (m_impl->keyDelayUs == 0) {
+    // Without a delay both edges go out in one SendInput call
+    Impl &impl = *m_impl;
+    impl.batch.clear();
+    if (!impl.appendKey(key, true))
+      return false;
+    impl.appendKey(key, false);
+    return impl.sendBatch();
+  }
   if (!keyDown(key))
     return false;
   m_impl->delay();
@@ -478,38 +711,34 @@ TYPR_IO_API Modifier Sender::activeModifiers() const {
   return m_impl->currentMods;
 }
 
+// The modifier edges are sent back to back with no delay between them, so
+// they always share one SendInput call
 TYPR_IO_API bool Sender::holdModifier(Modifier mod) {
+  Impl &impl = *m_impl;
+  impl.batch.clear();
   bool allModifiersPressed = true;
-  if (hasModifier(mod, Modifier::Shift)) {
-    allModifiersPressed &= keyDown(Key::ShiftLeft);
-  }
-  if (hasModifier(mod, Modifier::Ctrl)) {
-    allModifiersPressed &= keyDown(Key::CtrlLeft);
-  }
-  if (hasModifier(mod, Modifier::Alt)) {
-    allModifiersPressed &= keyDown(Key::AltLeft);
-  }
-  if (hasModifier(mod, Modifier::Super)) {
-    allModifiersPressed &= keyDown(Key::SuperLeft);
+  for (const auto &[flag, key] : Impl::kModifierKeys) {
+    if (!hasModifier(mod, flag))
+      continue;
+    impl.trackModifier(key, true);
+    allModifiersPressed &= impl.appendKey(key, true);
   }
-  return allModifiersPressed;
+  const bool sent = impl.sendBatch();
+  return sent && allModifiersPressed;
 }
 
 TYPR_IO_API bool Sender::releaseModifier(Modifier mod) {
+  Impl &impl = *m_impl;
+  impl.batch.clear();
   bool allModifiersReleased = true;
-  if (hasModifier(mod, Modifier::Shift)) {
-    allModifiersReleased &= keyUp(Key::ShiftLeft);
-  }
-  if (hasModifier(mod, Modifier::Ctrl)) {
-    allModifiersReleased &= keyUp(Key::CtrlLeft);
-  }
-  if (hasModifier(mod, Modifier::Alt)) {
-    allModifiersReleased &= keyUp(Key::AltLeft);
-  }
-  if (hasModifier(mod, Modifier::Super)) {
-    allModifiersReleased &= keyUp(Key::SuperLeft);
+  for (const auto &[flag, key] : Impl::kModifierKeys) {
+    if (!hasModifier(mod, flag))
+      continue;
+    allModifiersReleased &= impl.appendKey(key, false);
+    impl.trackModifier(key, false);
   }
-  return allModifiersReleased;
+  const bool sent = impl.sendBatch();
+  return sent && allModifiersReleased;
 }
 
 TYPR_IO_API bool Sender::releaseAllModifiers() {
@@ -518,6 +747,28 @@ TYPR_IO_API bool Sender::releaseAllModifiers() {
 }
 
 TYPR_IO_API bool Sender::combo(Modifier mods, Key key) {
+  if (m_impl->keyDelayUs == 0) {
+    // Modifiers, key and releases in one SendInput call, so user typing
+    // cannot interleave with the chord. Nothing is sent if a key is unmapped.
+    Impl &impl = *m_impl;
+    impl.batch.clear();
+    bool mapped = true;
+    for (const auto &[flag, modKey] : Impl::kModifierKeys)
+      if (hasModifier(mods, flag))
+        mapped &= impl.appendKey(modKey, true);
+    mapped &= impl.appendKey(key, true) && impl.appendKey(key, false);
+    for (const auto &[flag, modKey] : Impl::kModifierKeys)
+      if (hasModifier(mods, flag))
+        mapped &= impl.appendKey(modKey, false);
+    if (!mapped) {
+      impl.batch.clear();
+      return false;
+    }
+    for (const auto &[flag, modKey] : Impl::kModifierKeys)
+      if (hasModifier(mods, flag))
+        impl.trackModifier(modKey, false);
+    return impl.sendBatch();
+  }
   if (!holdModifier(mods))
     return false;
   m_impl->delay();
@@ -527,56 +778,40 @@ TYPR_IO_API bool Sender::combo(Modifier mods, Key key) {
   return ok;
 }
 
-TYPR_IO_API bool Sender::typeText(const std::u32string &text) {
+TYPR_IO_API bool Sender::typeText(std::u32string_view text) {
   TYPR_IO_LOG_DEBUG("Sender::typeText (utf32) called with %zu codepoints",
                     text.size());
+  if (m_impl->charsPerSecond > 0.0)
+    return m_impl->typeUnicodePaced(text);
   return m_impl->typeUnicode(text);
 }
 
-TYPR_IO_API bool Sender::typeText(const std::string &utf8Text) {
-  // Convert UTF-8 to UTF-32
-  std::u32string utf32;
-  size_t i = 0;
-  while (i < utf8Text.size()) {
-    char32_t cp = 0;
-    unsigned char c = utf8Text[i];
-
-    if ((c & 0x80) == 0) {
-      cp = c;
-      i += 1;
-    } else if ((c & 0xE0) == 0xC0) {
-      cp = (c & 0x1F) << 6;
-      if (i + 1 < utf8Text.size())
-        cp |= (utf8Text[i + 1] & 0x3F);
-      i += 2;
-    } else if ((c & 0xF0) == 0xE0) {
-      cp = (c & 0x0F) << 12;
-      if (i + 1 < utf8Text.size())
-        cp |= (utf8Text[i + 1] & 0x3F) << 6;
-      if (i + 2 < utf8Text.size())
-        cp |= (utf8Text[i + 2] & 0x3F);
-      i += 3;
-    } else if ((c & 0xF8) == 0xF0) {
-      cp = (c & 0x07) << 18;
-      if (i + 1 < utf8Text.size())
-        cp |= (utf8Text[i + 1] & 0x3F) << 12;
-      if (i + 2 < utf8Text.size())
-        cp |= (utf8Text[i + 2] & 0x3F) << 6;
-      if (i + 3 < utf8Text.size())
-        cp |= (utf8Text[i + 3] & 0x3F);
-      i += 4;
-    } else {
-      i += 1;
-      continue;
-    }
+TYPR_IO_API bool Sender::typeText(std::string_view utf8Text) {
+  if (m_impl->charsPerSecond > 0.0)
+    return m_impl->typeUnicodePaced(detail::utf8ToUtf32(utf8Text));
+  // Decode straight to the UTF-16 that KEYEVENTF_UNICODE consumes
+  return m_impl->typeUtf16(detail::utf8ToUtf16(utf8Text));
+}
 
-    utf32.push_back(cp);
-  }
-  return typeText(utf32);
+TYPR_IO_API bool Sender::typeTextBulk(std::u32string_view text) {
+  if (m_impl->charsPerSecond > 0.0)
+    return m_impl->typeUnicodePaced(text);
+  // typeUnicode already submits the whole string in a single SendInput call
+  return m_impl->typeUnicode(text);
+}
+
+TYPR_IO_API bool Sender::typeTextBulk(std::string_view utf8Text) {
+  if (m_impl->charsPerSecond > 0.0)
+    return m_impl->typeUnicodePaced(detail::utf8ToUtf32(utf8Text));
+  return m_impl->typeUtf16(detail::utf8ToUtf16(utf8Text));
 }
 
 TYPR_IO_API bool Sender::typeCharacter(char32_t codepoint) {
-  return typeText(std::u32string(1, codepoint));
+  return typeText(std::u32string_view(&codepoint, 1));
+}
+
+TYPR_IO_API bool Sender::play(const KeySequence &sequence) {
+  return m_impl->playSequence(sequence);
 }
 
 TYPR_IO_API void Sender::flush() {
@@ -585,6 +820,21 @@ TYPR_IO_API void Sender::flush() {
 
 TYPR_IO_API void Sender::setKeyDelay(uint32_t delayUs) {
   m_impl->keyDelayUs = delayUs;
+  m_impl->keyPacer.setInterval(std::chrono::microseconds(delayUs));
+}
+
+TYPR_IO_API void Sender::setTypingRate(double charsPerSecond) {
+  m_impl->charsPerSecond = charsPerSecond > 0.0 ? charsPerSecond : 0.0;
+  m_impl->charPacer.setInterval(detail::rateToInterval(charsPerSecond));
+}
+
+TYPR_IO_API void Sender::setFrameCoalescing(bool enabled) {
+  // SendInput has no event-frame concept; nothing to coalesce
+  (void)enabled;
+}
+
+TYPR_IO_API SenderStats Sender::stats() const {
+  return m_impl ? m_impl->stats.snapshot() : SenderStats{};
 }
 
 } // namespace typr::io
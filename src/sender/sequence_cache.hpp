@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file sequence_cache.hpp
+ * @brief Internal per-Sender cache of compiled `KeySequence` programs.
+ *
+ * Each backend compiles a sequence into its own native representation
+ * (`input_event` frames, `INPUT` arrays, prebuilt `CGEventRef`s). The cache
+ * keeps the programs of the most recently played sequences, keyed by
+ * `KeySequence::id()` and validated against `KeySequence::revision()`, so a
+ * hot replay skips compilation entirely.
+ *
+ * Like the Sender that owns it, the cache is not thread-safe.
+ *
+ * This header is an implementation detail and not part of the public API.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <typr-io/key_sequence.hpp>
+
+namespace typr::io::detail {
+
+/**
+ * @internal
+ * @brief Small least-recently-played cache of compiled programs.
+ *
+ * @tparam Program Backend program type, built by the `compile` callback.
+ */
+template <typename Program> class SequenceCache {
+public:
+  static constexpr std::size_t kCapacity = 16;
+
+  /**
+   * @brief Program for `sequence`, compiling it on a miss or when the
+   * sequence changed since it was compiled.
+   *
+   * @param compile `Program(const KeySequence &)` callable.
+   * @return Reference valid until the next `get()` or `clear()`.
+   */
+  template <typename Compile>
+  const Program &get(const KeySequence &sequence, Compile &&compile) {
+    ++m_clock;
+    Entry *victim = &m_entries[0];
+    for (Entry &entry : m_entries) {
+      if (entry.program && entry.id == sequence.id()) {
+        if (entry.revision != sequence.revision()) {
+          entry.program = std::make_unique<Program>(compile(sequence));
+          entry.revision = sequence.revision();
+        }
+        entry.lastUse = m_clock;
+        return *entry.program;
+      }
+      if (!entry.program || (victim->program && entry.lastUse < victim->lastUse))
+        victim = &entry;
+    }
+    victim->program = std::make_unique<Program>(compile(sequence));
+    victim->id = sequence.id();
+    victim->revision = sequence.revision();
+    victim->lastUse = m_clock;
+    return *victim->program;
+  }
+
+  /**
+   * @brief Drop every program (e.g. after the keymap changed).
+   */
+  void clear() {
+    for (Entry &entry : m_entries)
+      entry.program.reset();
+  }
+
+private:
+  struct Entry {
+    uint64_t id{0};
+    uint64_t revision{0};
+    uint64_t lastUse{0};
+    std::unique_ptr<Program> program;
+  };
+
+  std::array<Entry, kCapacity> m_entries{};
+  uint64_t m_clock{0};
+};
+
+} // namespace typr::io::detail
@@ -0,0 +1,391 @@
+// typr-io loopback harness
+//
+// Injects known key sequences through typr::io::Sender and observes them
+// through typr::io::Listener on the same machine, then reports:
+//   - end-to-end latency (p50 / p99 / p999 / max): from the Sender's OS
+//     injection call to the OS timestamp of the observed event, and to its
+//     delivery to the listener callback;
+//   - the highest keystroke rate, from a sweep, that completes without loss
+//     or reordering;
+//   - the active backends, so runs on different machines/backends can be
+//     compared line by line (see --json).
+//
+// The injected taps reach whatever window has focus. Run it from a terminal
+// you do not mind typing into, or pass harmless keys with --keys.
+
+#include <typr-io/listener.hpp>
+#include <typr-io/log.hpp>
+#include <typr-io/sender.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using typr::io::Key;
+using typr::io::Listener;
+using typr::io::Sender;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t nowNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now().time_since_epoch())
+          .count());
+}
+
+const char *backendName(typr::io::BackendType type) {
+  switch (type) {
+  case typr::io::BackendType::Windows:
+    return "windows";
+  case typr::io::BackendType::MacOS:
+    return "macos";
+  case typr::io::BackendType::LinuxLibinput:
+    return "linux-libinput";
+  case typr::io::BackendType::LinuxUInput:
+    return "linux-uinput";
+  default:
+    return "unknown";
+  }
+}
+
+struct Options {
+  std::vector<Key> keys;
+  int latencyKeys{500};
+  double latencyRate{100.0};
+  int sweepKeys{1000};
+  std::vector<double> sweepRates{250, 500, 1000, 2000, 4000, 8000, 0};
+  int settleMs{500};
+  bool json{false};
+};
+
+/**
+ * @brief One press observed by the listener.
+ */
+struct Observed {
+  Key key;
+  uint64_t eventNs;   // OS timestamp (steady_clock timeline)
+  uint64_t deliverNs; // when the callback ran
+};
+
+/**
+ * @brief Lock-free press recorder fed from the listener thread.
+ *
+ * Slots are reserved up front; the listener thread is the only writer and
+ * publishes each slot with a release store of `count`.
+ */
+class Recorder {
+public:
+  explicit Recorder(std::size_t capacity) : m_slots(capacity) {}
+
+  void record(const Listener::Event &ev) {
+    if (!ev.pressed || !m_armed.load(std::memory_order_acquire))
+      return;
+    const std::size_t i = m_count.load(std::memory_order_relaxed);
+    if (i >= m_slots.size())
+      return;
+    m_slots[i] = Observed{ev.key, ev.timestampNs, nowNs()};
+    m_count.store(i + 1, std::memory_order_release);
+  }
+
+  void arm() {
+    m_count.store(0, std::memory_order_release);
+    m_armed.store(true, std::memory_order_release);
+  }
+
+  std::vector<Observed> disarm() {
+    m_armed.store(false, std::memory_order_release);
+    const std::size_t n = m_count.load(std::memory_order_acquire);
+    return {m_slots.begin(), m_slots.begin() + static_cast<long>(n)};
+  }
+
+  std::size_t count() const { return m_count.load(std::memory_order_acquire); }
+
+private:
+  std::vector<Observed> m_slots;
+  std::atomic<std::size_t> m_count{0};
+  std::atomic<bool> m_armed{false};
+};
+
+struct RunResult {
+  double rate{0.0};     // requested keys/s (0 = unpaced)
+  double achieved{0.0}; // injected keys/s
+  std::size_t sent{0};
+  std::size_t observed{0};
+  std::size_t reordered{0};
+  std::vector<uint64_t> osLatencyNs;       // inject -> OS event timestamp
+  std::vector<uint64_t> deliveryLatencyNs; // inject -> callback
+};
+
+/**
+ * @brief Tap `count` keys from `keys` at `rate` keys/s and match the
+ * observed presses against what was sent.
+ */
+RunResult runOnce(Sender &sender, Recorder &recorder,
+                  const std::vector<Key> &keys, int count, double rate,
+                  int settleMs) {
+  RunResult r;
+  r.rate = rate;
+  std::vector<uint64_t> sentNs;
+  sentNs.reserve(static_cast<std::size_t>(count));
+
+  recorder.arm();
+  const auto interval =
+      rate > 0 ? std::chrono::nanoseconds(static_cast<int64_t>(1e9 / rate))
+               : std::chrono::nanoseconds(0);
+  const auto begin = Clock::now();
+  auto next = begin;
+  for (int i = 0; i < count; ++i) {
+    if (rate > 0) {
+      std::this_thread::sleep_until(next);
+      next += interval;
+    }
+    const Key k = keys[static_cast<std::size_t>(i) % keys.size()];
+    sender.keyDown(k);
+    // Time of the OS injection call for the press edge
+    sentNs.push_back(sender.stats().lastInjectNs);
+    sender.keyUp(k);
+  }
+  const double elapsed =
+      std::chrono::duration<double>(Clock::now() - begin).count();
+  r.sent = static_cast<std::size_t>(count);
+  r.achieved = elapsed > 0 ? count / elapsed : 0.0;
+
+  // Wait for stragglers, stopping early once everything has arrived
+  const auto deadline = Clock::now() + std::chrono::milliseconds(settleMs);
+  while (recorder.count() < r.sent && Clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  const std::vector<Observed> seen = recorder.disarm();
+  r.observed = seen.size();
+  const std::size_t n = std::min(seen.size(), sentNs.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    if (seen[i].key != keys[i % keys.size()]) {
+      ++r.reordered;
+      continue;
+    }
+    if (seen[i].eventNs >= sentNs[i])
+      r.osLatencyNs.push_back(seen[i].eventNs - sentNs[i]);
+    if (seen[i].deliverNs >= sentNs[i])
+      r.deliveryLatencyNs.push_back(seen[i].deliverNs - sentNs[i]);
+  }
+  return r;
+}
+
+uint64_t percentile(std::vector<uint64_t> &v, double p) {
+  if (v.empty())
+    return 0;
+  std::sort(v.begin(), v.end());
+  std::size_t idx = static_cast<std::size_t>(p / 100.0 * (v.size() - 1) + 0.5);
+  return v[std::min(idx, v.size() - 1)];
+}
+
+void printLatency(const char *label, std::vector<uint64_t> &v, bool json,
+                  bool last) {
+  const double us = 1e-3;
+  uint64_t p50 = percentile(v, 50), p99 = percentile(v, 99),
+           p999 = percentile(v, 99.9), max = v.empty() ? 0 : v.back();
+  if (json) {
+    std::printf("    \"%s\": {\"samples\": %zu, \"p50_us\": %.1f, "
+                "\"p99_us\": %.1f, \"p999_us\": %.1f, \"max_us\": %.1f}%s\n",
+                label, v.size(), p50 * us, p99 * us, p999 * us, max * us,
+                last ? "" : ",");
+  } else {
+    std::printf("  %-22s n=%-6zu p50=%8.1fus p99=%8.1fus p999=%8.1fus "
+                "max=%8.1fus\n",
+                label, v.size(), p50 * us, p99 * us, p999 * us, max * us);
+  }
+}
+
+bool parseKeys(const std::string &list, std::vector<Key> &out) {
+  out.clear();
+  std::size_t pos = 0;
+  while (pos <= list.size()) {
+    std::size_t comma = list.find(',', pos);
+    std::string name = list.substr(pos, comma == std::string::npos
+                                            ? std::string::npos
+                                            : comma - pos);
+    if (!name.empty()) {
+      Key k = typr::io::stringToKey(name);
+      if (k == Key::Unknown) {
+        std::cerr << "Unknown key: " << name << "\n";
+        return false;
+      }
+      out.push_back(k);
+    }
+    if (comma == std::string::npos)
+      break;
+    pos = comma + 1;
+  }
+  return !out.empty();
+}
+
+bool parseRates(const std::string &list, std::vector<double> &out) {
+  out.clear();
+  std::size_t pos = 0;
+  while (pos < list.size()) {
+    std::size_t comma = list.find(',', pos);
+    out.push_back(std::atof(list.substr(pos, comma - pos).c_str()));
+    if (comma == std::string::npos)
+      break;
+    pos = comma + 1;
+  }
+  return !out.empty();
+}
+
+void printUsage() {
+  std::cout
+      << "Usage: typr_io_loopback [options]\n"
+      << "  --keys <A,B,...>     : keys to tap in rotation (default a-z)\n"
+      << "  --latency-keys <N>   : taps for the latency run (default 500)\n"
+      << "  --latency-rate <k/s> : pace of the latency run (default 100)\n"
+      << "  --sweep-keys <N>     : taps per sweep step (default 1000)\n"
+      << "  --sweep <r1,r2,...>  : keys/s per sweep step, 0 = unpaced\n"
+      << "                         (default 250,500,1000,2000,4000,8000,0)\n"
+      << "  --settle <ms>        : wait for late events (default 500)\n"
+      << "  --json               : print machine-readable results\n"
+      << "  --help               : show this help\n"
+      << "\nInjected keys go to the focused window.\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  for (char c = 'A'; c <= 'Z'; ++c)
+    opt.keys.push_back(typr::io::stringToKey(std::string(1, c)));
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        std::cerr << arg << " requires an argument\n";
+        std::exit(1);
+      }
+      return argv[++i];
+    };
+    if (arg == "--help") {
+      printUsage();
+      return 0;
+    } else if (arg == "--keys") {
+      if (!parseKeys(value(), opt.keys))
+        return 1;
+    } else if (arg == "--latency-keys") {
+      opt.latencyKeys = std::max(1, std::atoi(value().c_str()));
+    } else if (arg == "--latency-rate") {
+      opt.latencyRate = std::atof(value().c_str());
+    } else if (arg == "--sweep-keys") {
+      opt.sweepKeys = std::max(1, std::atoi(value().c_str()));
+    } else if (arg == "--sweep") {
+      if (!parseRates(value(), opt.sweepRates))
+        return 1;
+    } else if (arg == "--settle") {
+      opt.settleMs = std::max(0, std::atoi(value().c_str()));
+    } else if (arg == "--json") {
+      opt.json = true;
+    } else {
+      std::cerr << "Unknown option: " << arg << "\n";
+      printUsage();
+      return 1;
+    }
+  }
+
+  Sender sender;
+  if (!sender.isReady() || !sender.capabilities().canInjectKeys) {
+    std::cerr << "Sender is not ready (missing uinput access or platform "
+                 "permissions)\n";
+    return 2;
+  }
+  sender.setKeyDelay(0);
+
+  const std::size_t capacity =
+      static_cast<std::size_t>(std::max(opt.latencyKeys, opt.sweepKeys)) * 2;
+  Recorder recorder(capacity);
+  Listener listener;
+  if (!listener.start(Listener::EventCallback{
+          [&recorder](const Listener::Event &ev) { recorder.record(ev); }})) {
+    std::cerr << "Listener could not be started (missing permissions?)\n";
+    return 2;
+  }
+  TYPR_IO_LOG_INFO("loopback: sender=%s keys=%zu", backendName(sender.type()),
+                   opt.keys.size());
+  // Let the listener finish device discovery before measuring
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  RunResult latency = runOnce(sender, recorder, opt.keys, opt.latencyKeys,
+                              opt.latencyRate, opt.settleMs);
+
+  std::vector<RunResult> sweep;
+  double maxSustained = -1.0;
+  for (double rate : opt.sweepRates) {
+    RunResult r =
+        runOnce(sender, recorder, opt.keys, opt.sweepKeys, rate, opt.settleMs);
+    if (r.observed == r.sent && r.reordered == 0)
+      maxSustained = std::max(maxSustained, r.achieved);
+    sweep.push_back(std::move(r));
+  }
+
+  const typr::io::ListenerStats lstats = listener.stats();
+  listener.stop();
+
+  if (opt.json) {
+    std::printf("{\n  \"sender_backend\": \"%s\",\n", backendName(sender.type()));
+    std::printf("  \"latency\": {\n    \"rate\": %.0f, \"sent\": %zu, "
+                "\"observed\": %zu, \"reordered\": %zu,\n",
+                latency.rate, latency.sent, latency.observed,
+                latency.reordered);
+    printLatency("inject_to_os_event", latency.osLatencyNs, true, false);
+    printLatency("inject_to_callback", latency.deliveryLatencyNs, true, true);
+    std::printf("  },\n  \"sweep\": [\n");
+    for (std::size_t i = 0; i < sweep.size(); ++i) {
+      const RunResult &r = sweep[i];
+      std::printf("    {\"rate\": %.0f, \"achieved\": %.0f, \"sent\": %zu, "
+                  "\"observed\": %zu, \"reordered\": %zu}%s\n",
+                  r.rate, r.achieved, r.sent, r.observed, r.reordered,
+                  i + 1 < sweep.size() ? "," : "");
+    }
+    std::printf("  ],\n  \"max_sustained_keys_per_sec\": %.0f,\n",
+                std::max(0.0, maxSustained));
+    std::printf("  \"listener_callback_p99_ns\": %llu\n}\n",
+                static_cast<unsigned long long>(
+                    lstats.callbackDuration.percentileNs(99.0)));
+  } else {
+    std::printf("typr-io loopback (sender backend: %s)\n\n",
+                backendName(sender.type()));
+    std::printf("Latency run: %zu taps at %.0f keys/s, %zu observed, "
+                "%zu out of order\n",
+                latency.sent, latency.rate, latency.observed,
+                latency.reordered);
+    printLatency("inject -> OS event", latency.osLatencyNs, false, false);
+    printLatency("inject -> callback", latency.deliveryLatencyNs, false, false);
+
+    std::printf("\nThroughput sweep (%d taps per step):\n", opt.sweepKeys);
+    std::printf("  %10s %10s %8s %8s %9s\n", "requested", "achieved",
+                "sent", "seen", "reorder");
+    for (const RunResult &r : sweep) {
+      std::printf("  %10s %10.0f %8zu %8zu %9zu%s\n",
+                  r.rate > 0 ? std::to_string(static_cast<int>(r.rate)).c_str()
+                             : "unpaced",
+                  r.achieved, r.sent, r.observed, r.reordered,
+                  (r.observed == r.sent && r.reordered == 0) ? "" : "  LOSS");
+    }
+    if (maxSustained >= 0)
+      std::printf("\nMax sustained rate without loss/reordering: %.0f "
+                  "keys/s\n",
+                  maxSustained);
+    else
+      std::printf("\nEvery sweep step lost or reordered events\n");
+    std::printf("Listener callback p99: %.1f us\n",
+                lstats.callbackDuration.percentileNs(99.0) * 1e-3);
+  }
+  return 0;
+}
@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <typr-io/async_sender.hpp>
+
+// These tests only submit jobs that do not inject input, so they exercise the
+// queue and worker regardless of whether the platform backend is usable.
+
+TEST_CASE("AsyncSender - futures report job results", "[async_sender]") {
+  typr::io::AsyncSender async(8);
+
+  auto ok = async.submit([](typr::io::Sender &) { return true; });
+  auto fail = async.submit([](typr::io::Sender &) { return false; });
+  auto thrown = async.submit([](typr::io::Sender &) -> bool {
+    throw std::runtime_error("boom");
+  });
+
+  REQUIRE(ok.get() == true);
+  REQUIRE(fail.get() == false);
+  REQUIRE_THROWS_AS(thrown.get(), std::runtime_error);
+}
+
+TEST_CASE("AsyncSender - per-producer ordering", "[async_sender]") {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 500;
+
+  // Only the worker thread touches `seen`; the futures order the final read.
+  std::vector<std::vector<int>> seen(kProducers);
+  std::vector<std::future<bool>> last(kProducers);
+  {
+    typr::io::AsyncSender async(64);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+      producers.emplace_back([&, p]() {
+        std::future<bool> f;
+        for (int i = 0; i < kPerProducer; ++i) {
+          f = async.submit([&seen, p, i](typr::io::Sender &) {
+            seen[p].push_back(i);
+            return true;
+          });
+        }
+        last[p] = std::move(f);
+      });
+    }
+    for (auto &t : producers)
+      t.join();
+    for (auto &f : last)
+      REQUIRE(f.get());
+  }
+
+  for (const auto &s : seen) {
+    REQUIRE(s.size() == static_cast<size_t>(kPerProducer));
+    for (int i = 0; i < kPerProducer; ++i)
+      REQUIRE(s[static_cast<size_t>(i)] == i);
+  }
+}
+
+TEST_CASE("AsyncSender - backpressure and queue depth", "[async_sender]") {
+  typr::io::AsyncSender async(2);
+  REQUIRE(async.queueCapacity() == 2);
+
+  std::promise<void> gate;
+  std::shared_future<void> opened = gate.get_future().share();
+  std::promise<void> started;
+
+  // Occupy the worker so further submissions stay queued
+  auto blocker = async.submit([&](typr::io::Sender &) {
+    started.set_value();
+    opened.wait();
+    return true;
+  });
+  started.get_future().wait();
+
+  auto a = async.trySubmit([](typr::io::Sender &) { return true; });
+  auto b = async.trySubmit([](typr::io::Sender &) { return true; });
+  REQUIRE(a.has_value());
+  REQUIRE(b.has_value());
+  REQUIRE(async.queueDepth() == 2);
+
+  auto c = async.trySubmit([](typr::io::Sender &) { return true; });
+  REQUIRE_FALSE(c.has_value());
+
+  gate.set_value();
+  REQUIRE(blocker.get());
+  REQUIRE(a->get());
+  REQUIRE(b->get());
+  REQUIRE(async.queueDepth() == 0);
+}
+
+TEST_CASE("AsyncSender - blocked submit wakes when a slot frees",
+          "[async_sender]") {
+  typr::io::AsyncSender async(2);
+  REQUIRE(async.queueCapacity() == 2);
+
+  std::promise<void> firstGate;
+  std::shared_future<void> firstOpened = firstGate.get_future().share();
+  std::promise<void> longGate;
+  std::shared_future<void> longOpened = longGate.get_future().share();
+  std::promise<void> started;
+
+  auto first = async.submit([&](typr::io::Sender &) {
+    started.set_value();
+    firstOpened.wait();
+    return true;
+  });
+  started.get_future().wait();
+
+  // Fill the ring: a long job (think holdFor / repeat) and a quick one
+  auto slow = async.submit([&](typr::io::Sender &) {
+    longOpened.wait();
+    return true;
+  });
+  auto quick = async.submit([](typr::io::Sender &) { return true; });
+  REQUIRE(async.queueDepth() == 2);
+
+  // This producer blocks on the full ring
+  std::future<std::future<bool>> blocked = std::async(
+      std::launch::async, [&async]() {
+        return async.submit([](typr::io::Sender &) { return true; });
+      });
+  REQUIRE(blocked.wait_for(std::chrono::milliseconds(50)) ==
+          std::future_status::timeout);
+
+  // Once the worker takes the long job out of the ring a slot is free; the
+  // producer must get it while that job is still running
+  firstGate.set_value();
+  REQUIRE(blocked.wait_for(std::chrono::seconds(5)) ==
+          std::future_status::ready);
+  REQUIRE(slow.wait_for(std::chrono::milliseconds(0)) ==
+          std::future_status::timeout);
+
+  longGate.set_value();
+  REQUIRE(first.get());
+  REQUIRE(slow.get());
+  REQUIRE(quick.get());
+  REQUIRE(blocked.get().get());
+}
+
+TEST_CASE("AsyncSender - destruction drains queued jobs", "[async_sender]") {
+  std::vector<std::future<bool>> futures;
+  int ran = 0;
+  {
+    typr::io::AsyncSender async(16);
+    for (int i = 0; i < 10; ++i) {
+      futures.push_back(async.submit([&ran](typr::io::Sender &) {
+        ++ran;
+        return true;
+      }));
+    }
+  }
+  REQUIRE(ran == 10);
+  for (auto &f : futures)
+    REQUIRE(f.get());
+}
+
+TEST_CASE("AsyncSender - holdFor and repeat run on the worker",
+          "[async_sender]") {
+  using typr::io::Key;
+  typr::io::AsyncSender async(8);
+
+  // Key::Unknown has no mapping on any backend, so nothing is injected
+  REQUIRE_FALSE(
+      async.holdFor(Key::Unknown, std::chrono::milliseconds(5)).get());
+  REQUIRE_FALSE(async.repeat(Key::Unknown, 3, 100.0).get());
+  REQUIRE_FALSE(async.repeat(Key::Unknown, 3, 0.0).get());
+
+  // An empty burst succeeds without touching the backend
+  REQUIRE(async.repeat(Key::Unknown, 0, 100.0).get());
+}
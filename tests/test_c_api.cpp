@@ -2,6 +2,7 @@
 
 #include <cstring>
 #include <string>
+#include <thread>
 
 #include <typr-io/c_api.h>
 
@@ -37,6 +38,11 @@ TEST_CASE("typr-io C API - key/string conversion", "[c_api]") {
   REQUIRE(unk_s != nullptr);
   REQUIRE(std::string(unk_s) == "Unknown");
   typr_io_free_string(unk_s);
+
+  /* Non-allocating names */
+  REQUIRE(std::string(typr_io_key_name(k)) == "A");
+  REQUIRE(std::string(typr_io_key_name(unk)) == "Unknown");
+  REQUIRE(typr_io_key_name(k) == typr_io_key_name(k));
 }
 
 TEST_CASE("typr-io C API - sender creation and error handling", "[c_api]") {
@@ -69,6 +75,45 @@ TEST_CASE("typr-io C API - sender creation and error handling", "[c_api]") {
   typr_io_free_string(err);
   typr_io_clear_last_error();
 
+  /* The bulk variant validates its arguments the same way. */
+  ok = typr_io_sender_type_text_bulk_utf8(NULL, "abc");
+  REQUIRE(ok == false);
+  err = typr_io_get_last_error();
+  REQUIRE(err != nullptr);
+  REQUIRE(std::string(err).find("sender") != std::string::npos);
+  typr_io_free_string(err);
+  ok = typr_io_sender_type_text_bulk_utf8(sender, NULL);
+  REQUIRE(ok == false);
+  err = typr_io_get_last_error();
+  REQUIRE(err != nullptr);
+  REQUIRE(std::string(err).find("utf8_text") != std::string::npos);
+  typr_io_free_string(err);
+  typr_io_clear_last_error();
+
+  /* The pointer + length variants accept NULL only for empty text. */
+  ok = typr_io_sender_type_text_utf8_n(NULL, "abc", 3);
+  REQUIRE(ok == false);
+  err = typr_io_get_last_error();
+  REQUIRE(err != nullptr);
+  REQUIRE(std::string(err).find("sender") != std::string::npos);
+  typr_io_free_string(err);
+  ok = typr_io_sender_type_text_utf8_n(sender, NULL, 3);
+  REQUIRE(ok == false);
+  err = typr_io_get_last_error();
+  REQUIRE(err != nullptr);
+  REQUIRE(std::string(err).find("utf8_text") != std::string::npos);
+  typr_io_free_string(err);
+  ok = typr_io_sender_type_text_bulk_utf8_n(sender, NULL, 1);
+  REQUIRE(ok == false);
+  err = typr_io_get_last_error();
+  REQUIRE(err != nullptr);
+  REQUIRE(std::string(err).find("utf8_text") != std::string::npos);
+  typr_io_free_string(err);
+  typr_io_clear_last_error();
+  (void)typr_io_sender_type_text_utf8_n(sender, NULL, 0);
+  err = typr_io_get_last_error();
+  REQUIRE(err == nullptr);
+
   /* Misc calls should be safe / no-ops in tests */
   typr_io_sender_set_key_delay(sender, 1000);
   typr_io_sender_flush(sender);
@@ -79,6 +124,30 @@ TEST_CASE("typr-io C API - sender creation and error handling", "[c_api]") {
   typr_io_sender_destroy(sender);
 }
 
+TEST_CASE("typr-io C API - senders sharing a device pool", "[c_api]") {
+  typr_io_sender_options_t options;
+  options.shared_device_pool = 1;
+  typr_io_sender_t a = typr_io_sender_create_with_options(&options);
+  typr_io_sender_t b = typr_io_sender_create_with_options(&options);
+  typr_io_sender_t c = typr_io_sender_create_with_options(NULL);
+  REQUIRE(a != nullptr);
+  REQUIRE(b != nullptr);
+  REQUIRE(c != nullptr);
+
+  /* Pooled senders behave like any other sender, with or without a device */
+  REQUIRE(typr_io_sender_is_ready(a) == typr_io_sender_is_ready(b));
+  if (typr_io_sender_is_ready(a)) {
+    REQUIRE(typr_io_sender_key_down(a, typr_io_string_to_key("ShiftLeft")));
+    REQUIRE(typr_io_sender_tap(b, typr_io_string_to_key("Escape")));
+    REQUIRE(typr_io_sender_key_up(a, typr_io_string_to_key("ShiftLeft")));
+  }
+
+  /* Destroying a sender that still holds a key must not disturb the other */
+  typr_io_sender_destroy(a);
+  typr_io_sender_destroy(b);
+  typr_io_sender_destroy(c);
+}
+
 TEST_CASE("typr-io C API - listener create/start/stop", "[c_api]") {
   typr_io_clear_last_error();
 
@@ -113,3 +182,204 @@ TEST_CASE("typr-io C API - listener create/start/stop", "[c_api]") {
 
   typr_io_listener_destroy(listener);
 }
+
+TEST_CASE("typr-io C API - queued listener", "[c_api]") {
+  typr_io_clear_last_error();
+
+  /* NULL handles are rejected without crashing. */
+  typr_io_event_t events[8];
+  REQUIRE(typr_io_listener_start_queued(NULL, 64) == false);
+  REQUIRE(typr_io_listener_read_events(NULL, events, 8) == 0);
+  REQUIRE(typr_io_listener_dropped_events(NULL) == 0);
+  typr_io_clear_last_error();
+
+  typr_io_listener_t listener = typr_io_listener_create();
+  REQUIRE(listener != nullptr);
+
+  /* Reading before a queued start returns nothing. */
+  REQUIRE(typr_io_listener_read_events(listener, events, 8) == 0);
+  REQUIRE(typr_io_listener_read_events(listener, NULL, 0) == 0);
+
+  /* Starting may fail without permissions; draining must be safe either
+     way. */
+  bool ok = typr_io_listener_start_queued(listener, 64);
+  (void)typr_io_listener_read_events(listener, events, 8);
+  REQUIRE(typr_io_listener_dropped_events(listener) == 0);
+  if (ok)
+    typr_io_listener_stop(listener);
+  typr_io_clear_last_error();
+
+  typr_io_listener_destroy(listener);
+}
+
+static void noop_event_cb(const typr_io_event_t *ev, void *user_data) {
+  (void)ev;
+  (void)user_data;
+}
+
+TEST_CASE("typr-io C API - listener with seat and device options", "[c_api]") {
+  typr_io_clear_last_error();
+
+  const char *seats[] = {"seat0", NULL};
+  const char *devices[] = {"/dev/input/typr-io-test-missing"};
+  typr_io_listener_options_t options;
+  options.seats = seats;
+  options.seat_count = 2;
+  options.devices = devices;
+  options.device_count = 1;
+  options.parallel_callbacks = false;
+  options.raw_input = false;
+  typr_io_listener_t listener = typr_io_listener_create_with_options(&options);
+  REQUIRE(listener != nullptr);
+  REQUIRE_FALSE(typr_io_listener_is_listening(listener));
+
+  /* A missing device node is waited for rather than failing the start; the
+     seat may still be unavailable without permissions. */
+  bool ok = typr_io_listener_start_events(listener, noop_event_cb, NULL);
+  REQUIRE(typr_io_listener_is_listening(listener) == ok);
+  typr_io_listener_stop(listener);
+  REQUIRE_FALSE(typr_io_listener_is_listening(listener));
+  typr_io_listener_destroy(listener);
+
+  typr_io_listener_t defaults = typr_io_listener_create_with_options(NULL);
+  REQUIRE(defaults != nullptr);
+  typr_io_listener_destroy(defaults);
+  typr_io_clear_last_error();
+}
+
+TEST_CASE("typr-io C API - stats and event callbacks", "[c_api]") {
+  typr_io_clear_last_error();
+
+  typr_io_listener_stats_t lstats;
+  typr_io_sender_stats_t sstats;
+  REQUIRE_FALSE(typr_io_listener_get_stats(NULL, &lstats));
+  REQUIRE_FALSE(typr_io_sender_get_stats(NULL, &sstats));
+  REQUIRE_FALSE(typr_io_listener_start_events(NULL, noop_event_cb, NULL));
+  typr_io_clear_last_error();
+
+  typr_io_listener_t listener = typr_io_listener_create();
+  REQUIRE(listener != nullptr);
+  REQUIRE_FALSE(typr_io_listener_get_stats(listener, NULL));
+  REQUIRE_FALSE(typr_io_listener_start_events(listener, NULL, NULL));
+
+  REQUIRE(typr_io_listener_get_stats(listener, &lstats));
+  REQUIRE(lstats.events == 0);
+  REQUIRE(lstats.filtered_events == 0);
+  REQUIRE(lstats.hook_latency.count == 0);
+
+  bool ok = typr_io_listener_start_events(listener, noop_event_cb, NULL);
+  if (ok)
+    typr_io_listener_stop(listener);
+  typr_io_clear_last_error();
+  typr_io_listener_destroy(listener);
+
+  typr_io_sender_t sender = typr_io_sender_create();
+  if (sender) {
+    REQUIRE_FALSE(typr_io_sender_get_stats(sender, NULL));
+    REQUIRE(typr_io_sender_get_stats(sender, &sstats));
+    REQUIRE(sstats.failed_calls <= sstats.inject_calls);
+    typr_io_sender_destroy(sender);
+  }
+  typr_io_clear_last_error();
+}
+
+static void count_hotkey_cb(uint32_t hotkey_id, void *user_data) {
+  *static_cast<uint32_t *>(user_data) = hotkey_id;
+}
+
+TEST_CASE("typr-io C API - hotkeys", "[c_api]") {
+  typr_io_clear_last_error();
+  typr_io_hotkeys_t h = typr_io_hotkeys_create();
+  REQUIRE(h != nullptr);
+
+  uint32_t fired = 0;
+  REQUIRE(typr_io_hotkeys_add(nullptr, "Ctrl+K", count_hotkey_cb, &fired) == 0);
+  REQUIRE(typr_io_hotkeys_add(h, nullptr, count_hotkey_cb, &fired) == 0);
+  REQUIRE(typr_io_hotkeys_add(h, "Ctrl+K", nullptr, &fired) == 0);
+  REQUIRE(typr_io_hotkeys_add(h, "Bogus+K", count_hotkey_cb, &fired) == 0);
+  char *err = typr_io_get_last_error();
+  REQUIRE(err != nullptr);
+  REQUIRE(std::string(err).find("Bogus+K") != std::string::npos);
+  typr_io_free_string(err);
+
+  const uint32_t id =
+      typr_io_hotkeys_add(h, "Ctrl+K, Ctrl+S", count_hotkey_cb, &fired);
+  REQUIRE(id != 0);
+  typr_io_hotkeys_set_step_timeout_ms(h, 0);
+
+  typr_io_event_t ev{};
+  ev.key = typr_io_string_to_key("K");
+  ev.mods = 0x02; /* Ctrl */
+  ev.pressed = true;
+  ev.timestamp_ns = 1;
+  REQUIRE_FALSE(typr_io_hotkeys_feed(h, &ev));
+  ev.key = typr_io_string_to_key("S");
+  ev.timestamp_ns = 2;
+  REQUIRE(typr_io_hotkeys_feed(h, &ev));
+  REQUIRE(fired == id);
+  REQUIRE_FALSE(typr_io_hotkeys_feed(h, nullptr));
+
+  REQUIRE(typr_io_hotkeys_remove(h, id));
+  REQUIRE_FALSE(typr_io_hotkeys_remove(h, id));
+  REQUIRE_FALSE(typr_io_hotkeys_attach(h, nullptr));
+
+  typr_io_hotkeys_destroy(h);
+  typr_io_hotkeys_destroy(nullptr);
+}
+
+TEST_CASE("typr-io C API - batch injection and per-thread errors",
+          "[c_api]") {
+  typr_io_sender_t sender = typr_io_sender_create();
+  REQUIRE(sender != nullptr);
+  const typr_io_key_t keys[] = {typr_io_string_to_key("Escape"),
+                                typr_io_string_to_key("Escape")};
+
+  typr_io_clear_last_error();
+  REQUIRE(typr_io_sender_tap_many(NULL, keys, 2) == 0);
+  REQUIRE(std::string(typr_io_last_error_message()).find("sender") !=
+          std::string::npos);
+  REQUIRE(typr_io_sender_tap_many(sender, NULL, 2) == 0);
+  REQUIRE(std::string(typr_io_last_error_message()).find("keys") !=
+          std::string::npos);
+  REQUIRE(typr_io_sender_send_events(sender, NULL, 1) == 0);
+  REQUIRE(std::string(typr_io_last_error_message()).find("events") !=
+          std::string::npos);
+
+  /* Empty batches succeed and clear the error */
+  REQUIRE(typr_io_sender_tap_many(sender, NULL, 0) == 0);
+  REQUIRE(typr_io_last_error_message() == nullptr);
+  REQUIRE(typr_io_sender_send_events(sender, NULL, 0) == 0);
+  REQUIRE(typr_io_last_error_message() == nullptr);
+
+  if (typr_io_sender_is_ready(sender)) {
+    REQUIRE(typr_io_sender_tap_many(sender, keys, 2) == 2);
+    typr_io_event_t events[2]{};
+    events[0].key = typr_io_string_to_key("ShiftLeft");
+    events[0].pressed = true;
+    events[1].key = events[0].key;
+    events[1].pressed = false;
+    REQUIRE(typr_io_sender_send_events(sender, events, 2) == 2);
+    REQUIRE(typr_io_sender_active_modifiers(sender) == 0);
+  }
+
+  /* Each thread sees only its own last error */
+  REQUIRE(typr_io_sender_tap_many(NULL, keys, 1) == 0);
+  bool otherClean = false;
+  bool otherOwn = false;
+  std::thread other([&]() {
+    otherClean = typr_io_last_error_message() == nullptr;
+    (void)typr_io_sender_send_events(NULL, NULL, 0);
+    otherOwn = typr_io_last_error_message() != nullptr;
+    typr_io_clear_last_error();
+  });
+  other.join();
+  REQUIRE(otherClean);
+  REQUIRE(otherOwn);
+  char *err = typr_io_get_last_error();
+  REQUIRE(err != nullptr);
+  REQUIRE(std::string(err).find("sender") != std::string::npos);
+  typr_io_free_string(err);
+  typr_io_clear_last_error();
+
+  typr_io_sender_destroy(sender);
+}
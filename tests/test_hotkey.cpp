@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <typr-io/hotkey.hpp>
+
+using typr::io::HotkeyMatcher;
+using typr::io::Key;
+using typr::io::Listener;
+using typr::io::Modifier;
+
+namespace {
+
+constexpr uint64_t kMs = 1'000'000;
+
+Listener::Event press(Key key, Modifier mods, uint64_t timestampNs,
+                      bool pressed = true) {
+  Listener::Event e;
+  e.key = key;
+  e.mods = mods;
+  e.pressed = pressed;
+  e.timestampNs = timestampNs;
+  return e;
+}
+
+} // namespace
+
+TEST_CASE("HotkeyMatcher - parse", "[hotkey]") {
+  auto chords = HotkeyMatcher::parse("Ctrl+Shift+P");
+  REQUIRE(chords.has_value());
+  REQUIRE(chords->size() == 1);
+  REQUIRE((*chords)[0].key == Key::P);
+  REQUIRE((*chords)[0].mods == (Modifier::Ctrl | Modifier::Shift));
+
+  chords = HotkeyMatcher::parse(" control + k ,cmd+S ");
+  REQUIRE(chords.has_value());
+  REQUIRE(chords->size() == 2);
+  REQUIRE((*chords)[0].key == Key::K);
+  REQUIRE((*chords)[0].mods == Modifier::Ctrl);
+  REQUIRE((*chords)[1].key == Key::S);
+  REQUIRE((*chords)[1].mods == Modifier::Super);
+
+  chords = HotkeyMatcher::parse("F9");
+  REQUIRE(chords.has_value());
+  REQUIRE((*chords)[0].mods == Modifier::None);
+
+  REQUIRE_FALSE(HotkeyMatcher::parse("").has_value());
+  REQUIRE_FALSE(HotkeyMatcher::parse("Ctrl+").has_value());
+  REQUIRE_FALSE(HotkeyMatcher::parse("Ctrl").has_value());
+  REQUIRE_FALSE(HotkeyMatcher::parse("Hyper+K").has_value());
+  REQUIRE_FALSE(HotkeyMatcher::parse("Ctrl+K,").has_value());
+  REQUIRE_FALSE(HotkeyMatcher::parse("Ctrl+NoSuchKey").has_value());
+}
+
+TEST_CASE("HotkeyMatcher - chords match exactly", "[hotkey]") {
+  HotkeyMatcher m;
+  std::vector<HotkeyMatcher::Id> fired;
+  const auto id = m.add("Ctrl+Shift+P", [&](auto hid) { fired.push_back(hid); });
+  REQUIRE(id != 0);
+  REQUIRE(m.size() == 1);
+
+  REQUIRE_FALSE(m.feed(press(Key::P, Modifier::Ctrl, 1)));
+  REQUIRE_FALSE(m.feed(press(Key::P, Modifier::Ctrl | Modifier::Shift |
+                                         Modifier::Alt,
+                             2)));
+  // Releases and modifier key presses are ignored
+  REQUIRE_FALSE(m.feed(press(Key::P, Modifier::Ctrl | Modifier::Shift, 3,
+                             false)));
+  REQUIRE(fired.empty());
+
+  // Lock states do not take part in matching
+  REQUIRE(m.feed(press(Key::P,
+                       Modifier::Ctrl | Modifier::Shift | Modifier::CapsLock,
+                       4)));
+  REQUIRE(fired == std::vector<HotkeyMatcher::Id>{id});
+
+  REQUIRE(m.remove(id));
+  REQUIRE_FALSE(m.remove(id));
+  REQUIRE_FALSE(m.feed(press(Key::P, Modifier::Ctrl | Modifier::Shift, 5)));
+  REQUIRE(fired.size() == 1);
+}
+
+TEST_CASE("HotkeyMatcher - sequences and timeouts", "[hotkey]") {
+  HotkeyMatcher m;
+  int saves = 0;
+  int closes = 0;
+  m.add("Ctrl+K, Ctrl+S", [&](auto) { ++saves; });
+  m.add("Ctrl+K, W", [&](auto) { ++closes; });
+  m.setStepTimeout(std::chrono::milliseconds(500));
+  REQUIRE(m.stepTimeout() == std::chrono::milliseconds(500));
+
+  SECTION("completes within the timeout") {
+    REQUIRE_FALSE(m.feed(press(Key::K, Modifier::Ctrl, 100 * kMs)));
+    // Modifier key presses between steps keep the sequence alive
+    REQUIRE_FALSE(m.feed(press(Key::CtrlLeft, Modifier::Ctrl, 150 * kMs)));
+    REQUIRE(m.feed(press(Key::S, Modifier::Ctrl, 200 * kMs)));
+    REQUIRE(saves == 1);
+
+    REQUIRE_FALSE(m.feed(press(Key::K, Modifier::Ctrl, 300 * kMs)));
+    REQUIRE(m.feed(press(Key::W, Modifier::None, 400 * kMs)));
+    REQUIRE(closes == 1);
+  }
+
+  SECTION("expires after the timeout") {
+    REQUIRE_FALSE(m.feed(press(Key::K, Modifier::Ctrl, 100 * kMs)));
+    REQUIRE_FALSE(m.feed(press(Key::S, Modifier::Ctrl, 700 * kMs)));
+    REQUIRE(saves == 0);
+  }
+
+  SECTION("a non-continuation restarts matching") {
+    REQUIRE_FALSE(m.feed(press(Key::K, Modifier::Ctrl, 100 * kMs)));
+    REQUIRE_FALSE(m.feed(press(Key::X, Modifier::None, 150 * kMs)));
+    REQUIRE_FALSE(m.feed(press(Key::S, Modifier::Ctrl, 200 * kMs)));
+    REQUIRE(saves == 0);
+
+    // The breaking press may itself start a sequence
+    REQUIRE_FALSE(m.feed(press(Key::K, Modifier::Ctrl, 300 * kMs)));
+    REQUIRE_FALSE(m.feed(press(Key::K, Modifier::Ctrl, 350 * kMs)));
+    REQUIRE(m.feed(press(Key::S, Modifier::Ctrl, 400 * kMs)));
+    REQUIRE(saves == 1);
+  }
+
+  SECTION("zero disables the timeout") {
+    m.setStepTimeout(std::chrono::milliseconds(0));
+    REQUIRE_FALSE(m.feed(press(Key::K, Modifier::Ctrl, 100 * kMs)));
+    REQUIRE(m.feed(press(Key::S, Modifier::Ctrl, 100'000 * kMs)));
+    REQUIRE(saves == 1);
+  }
+}
+
+TEST_CASE("HotkeyMatcher - prefixes and registration from handlers",
+          "[hotkey]") {
+  HotkeyMatcher m;
+  std::vector<std::string> log;
+  m.add("Ctrl+K", [&](auto) { log.push_back("k"); });
+  m.add("Ctrl+K, Ctrl+C", [&](auto) { log.push_back("kc"); });
+  HotkeyMatcher::Id once = 0;
+  once = m.add("F1", [&](auto) {
+    log.push_back("f1");
+    m.remove(once);
+  });
+
+  REQUIRE(m.feed(press(Key::K, Modifier::Ctrl, 1 * kMs)));
+  REQUIRE(m.feed(press(Key::C, Modifier::Ctrl, 2 * kMs)));
+  REQUIRE(log == std::vector<std::string>{"k", "kc"});
+
+  REQUIRE(m.feed(press(Key::F1, Modifier::None, 3 * kMs)));
+  REQUIRE_FALSE(m.feed(press(Key::F1, Modifier::None, 4 * kMs)));
+  REQUIRE(log.back() == "f1");
+  REQUIRE(m.size() == 2);
+
+  // Invalid registrations
+  REQUIRE(m.add("Nope+K", [](auto) {}) == 0);
+  REQUIRE(m.add(HotkeyMatcher::Chord{Modifier::Ctrl, Key::CtrlLeft},
+                [](auto) {}) == 0);
+  REQUIRE(m.add(HotkeyMatcher::Chord{Modifier::Ctrl, Key::Unknown},
+                [](auto) {}) == 0);
+
+  m.clear();
+  REQUIRE(m.size() == 0);
+  REQUIRE_FALSE(m.feed(press(Key::K, Modifier::Ctrl, 5 * kMs)));
+}
+
+TEST_CASE("HotkeyMatcher - many registrations", "[hotkey]") {
+  HotkeyMatcher m;
+  int hits = 0;
+  // Every (modifier combination, letter) pair followed by every digit
+  for (uint8_t mods = 0; mods < 16; ++mods)
+    for (int k = 0; k < 26; ++k)
+      for (int d = 0; d < 10; ++d) {
+        const HotkeyMatcher::Chord seq[] = {
+            {static_cast<Modifier>(mods), static_cast<Key>(
+                                              static_cast<int>(Key::A) + k)},
+            {Modifier::None,
+             static_cast<Key>(static_cast<int>(Key::Num0) + d)}};
+        REQUIRE(m.add(seq, [&](auto) { ++hits; }) != 0);
+      }
+  REQUIRE(m.size() == 16 * 26 * 10);
+
+  REQUIRE_FALSE(m.feed(press(Key::Q, Modifier::Alt | Modifier::Super, 1)));
+  REQUIRE(m.feed(press(Key::Num7, Modifier::None, 2)));
+  REQUIRE(hits == 1);
+}
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <string>
 #include <thread>
+#include <typr-io/key_sequence.hpp>
 #include <typr-io/log.hpp>
 #include <typr-io/sender.hpp>
 
@@ -135,4 +136,31 @@ TEST_CASE("Sender Integration Suite", "[integration]") {
     // settings.
     CHECK(count >= 3);
   }
+
+  // --- SECTION 4: Replayed sequences ---
+  SECTION("KeySequence Replay") {
+    TYPR_IO_LOG_INFO("Integration test: KeySequence Replay");
+    std::cout << "[RUNNING] Playing a compiled sequence twice (producing "
+                 "'Ab1Ab1')..."
+              << std::endl;
+
+    KeySequence seq;
+    seq.combo(Modifier::Shift, Key::A).typeText("b").delay(5ms).tap(Key::Num1);
+
+    auto task = std::async(std::launch::async, [&sender, &seq]() {
+      std::this_thread::sleep_for(500ms);
+      // The second play replays the cached program
+      bool ok = sender.play(seq);
+      ok &= sender.play(seq);
+      sender.tap(Key::Enter);
+      return ok;
+    });
+
+    std::string received;
+    std::getline(std::cin, received);
+    CHECK(task.get());
+
+    INFO("Received string: " << received);
+    CHECK(received.find("Ab1Ab1") != std::string::npos);
+  }
 }
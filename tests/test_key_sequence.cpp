@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <typr-io/key_sequence.hpp>
+
+#include "sender/sequence_cache.hpp"
+
+using typr::io::Key;
+using typr::io::KeySequence;
+using typr::io::Modifier;
+using typr::io::detail::SequenceCache;
+using Kind = KeySequence::StepKind;
+
+TEST_CASE("KeySequence - combos expand like Sender::combo", "[key_sequence]") {
+  KeySequence seq;
+  seq.combo(Modifier::Ctrl | Modifier::Shift, Key::S);
+
+  const auto &steps = seq.steps();
+  REQUIRE(steps.size() == 6);
+  REQUIRE(steps[0].kind == Kind::KeyDown);
+  REQUIRE(steps[0].key == Key::ShiftLeft);
+  REQUIRE(steps[1].kind == Kind::KeyDown);
+  REQUIRE(steps[1].key == Key::CtrlLeft);
+  REQUIRE(steps[2].kind == Kind::KeyDown);
+  REQUIRE(steps[2].key == Key::S);
+  REQUIRE(steps[3].kind == Kind::KeyUp);
+  REQUIRE(steps[3].key == Key::S);
+  REQUIRE(steps[4].kind == Kind::KeyUp);
+  REQUIRE(steps[4].key == Key::ShiftLeft);
+  REQUIRE(steps[5].kind == Kind::KeyUp);
+  REQUIRE(steps[5].key == Key::CtrlLeft);
+}
+
+TEST_CASE("KeySequence - text and delays", "[key_sequence]") {
+  KeySequence seq;
+  seq.typeText("héllo").delay(std::chrono::milliseconds(5)).typeText(U"🙂");
+  seq.typeText("").delay(std::chrono::microseconds(0)); // no-ops
+
+  const auto &steps = seq.steps();
+  REQUIRE(steps.size() == 3);
+  REQUIRE(steps[0].kind == Kind::Text);
+  REQUIRE(seq.textOf(steps[0]) == U"héllo");
+  REQUIRE(steps[1].kind == Kind::Delay);
+  REQUIRE(steps[1].delayUs == 5000);
+  REQUIRE(seq.textOf(steps[1]).empty());
+  REQUIRE(seq.textOf(steps[2]) == U"🙂");
+
+  seq.clear();
+  REQUIRE(seq.empty());
+}
+
+TEST_CASE("KeySequence - identity and revisions", "[key_sequence]") {
+  KeySequence a;
+  const auto r0 = a.revision();
+  a.tap(Key::A);
+  REQUIRE(a.revision() > r0);
+
+  KeySequence b = a;
+  REQUIRE(b.id() != a.id());
+  REQUIRE(b.steps().size() == a.steps().size());
+
+  const auto id = a.id();
+  const auto revision = a.revision();
+  KeySequence c = std::move(a);
+  REQUIRE(c.id() == id);
+  REQUIRE(c.revision() == revision);
+  REQUIRE(a.id() != id);
+  REQUIRE(a.empty());
+}
+
+TEST_CASE("SequenceCache - compiles once per revision", "[key_sequence]") {
+  SequenceCache<std::size_t> cache;
+  int compiles = 0;
+  auto compile = [&compiles](const KeySequence &seq) {
+    ++compiles;
+    return seq.steps().size();
+  };
+
+  KeySequence seq;
+  seq.tap(Key::A);
+  REQUIRE(cache.get(seq, compile) == 2);
+  REQUIRE(cache.get(seq, compile) == 2);
+  REQUIRE(compiles == 1);
+
+  seq.tap(Key::B);
+  REQUIRE(cache.get(seq, compile) == 4);
+  REQUIRE(compiles == 2);
+
+  cache.clear();
+  REQUIRE(cache.get(seq, compile) == 4);
+  REQUIRE(compiles == 3);
+}
+
+TEST_CASE("SequenceCache - evicts the least recently played", "[key_sequence]") {
+  using Cache = SequenceCache<int>;
+  Cache cache;
+  int compiles = 0;
+  auto compile = [&compiles](const KeySequence &) { return ++compiles; };
+
+  std::vector<KeySequence> seqs(Cache::kCapacity + 1);
+  for (std::size_t i = 0; i < Cache::kCapacity; ++i)
+    cache.get(seqs[i], compile);
+  // Touch the first so the second becomes the eviction victim
+  cache.get(seqs[0], compile);
+  REQUIRE(compiles == static_cast<int>(Cache::kCapacity));
+
+  cache.get(seqs[Cache::kCapacity], compile);
+  REQUIRE(compiles == static_cast<int>(Cache::kCapacity) + 1);
+  cache.get(seqs[0], compile);
+  REQUIRE(compiles == static_cast<int>(Cache::kCapacity) + 1);
+  cache.get(seqs[1], compile);
+  REQUIRE(compiles == static_cast<int>(Cache::kCapacity) + 2);
+}
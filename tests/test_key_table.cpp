@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#include "common/key_table.hpp"
+
+using typr::io::Key;
+using typr::io::kKeyCount;
+using typr::io::detail::CodepointTable;
+using typr::io::detail::KeyTable;
+
+namespace {
+
+struct CharKey {
+  int code{-1};
+  bool shift{false};
+};
+
+} // namespace
+
+TEST_CASE("KeyTable - insert and find", "[key_table]") {
+  KeyTable<int, -1> table;
+  REQUIRE(table.empty());
+  REQUIRE(table.find(Key::A) == -1);
+  REQUIRE_FALSE(table.contains(Key::A));
+
+  REQUIRE(table.insert(Key::A, 30));
+  REQUIRE(table.insert(Key::RFKill, 247));
+  REQUIRE(table.find(Key::A) == 30);
+  REQUIRE(table.find(Key::RFKill) == 247);
+  REQUIRE(table.size() == 2);
+
+  // First mapping wins, like the layout scan expects
+  REQUIRE_FALSE(table.insert(Key::A, 31));
+  REQUIRE(table.find(Key::A) == 30);
+
+  // The sentinel is never stored and out-of-range keys are rejected
+  REQUIRE_FALSE(table.insert(Key::B, -1));
+  REQUIRE(table.find(static_cast<Key>(kKeyCount)) == -1);
+  REQUIRE_FALSE(table.insert(static_cast<Key>(kKeyCount), 1));
+
+  int visited = 0;
+  table.forEach([&table, &visited](Key key, int code) {
+    REQUIRE(table.find(key) == code);
+    ++visited;
+  });
+  REQUIRE(visited == 2);
+
+  table.clear();
+  REQUIRE(table.empty());
+  REQUIRE(table.find(Key::A) == -1);
+}
+
+TEST_CASE("CodepointTable - direct and sparse ranges", "[key_table]") {
+  CodepointTable<CharKey> table;
+  REQUIRE(table.empty());
+  REQUIRE(table.find(U'a') == nullptr);
+
+  REQUIRE(table.insert(U'a', {30, false}));
+  REQUIRE(table.insert(U'A', {30, true}));
+  REQUIRE(table.insert(U'é', {3, false}));   // direct range
+  REQUIRE(table.insert(U'€', {18, false}));  // sparse range
+  REQUIRE(table.insert(U'\U0001F600', {1, true})); // outside the BMP
+  REQUIRE(table.insert(U'Ж', {39, false}));  // inserted out of order
+  REQUIRE(table.size() == 6);
+
+  REQUIRE_FALSE(table.insert(U'a', {31, true}));
+  REQUIRE_FALSE(table.insert(U'€', {19, true}));
+
+  const CharKey *a = table.find(U'a');
+  REQUIRE(a != nullptr);
+  REQUIRE(a->code == 30);
+  REQUIRE_FALSE(a->shift);
+  REQUIRE(table.find(U'A')->shift);
+  REQUIRE(table.find(U'€')->code == 18);
+  REQUIRE(table.find(U'Ж')->code == 39);
+  REQUIRE(table.find(U'\U0001F600')->shift);
+  REQUIRE(table.find(U'b') == nullptr);
+  REQUIRE(table.find(U'₭') == nullptr);
+
+  // Iteration visits every mapping in codepoint order
+  std::u32string visited;
+  table.forEach([&visited](char32_t cp, const CharKey &) { visited += cp; });
+  REQUIRE(visited == U"AaéЖ€\U0001F600");
+  REQUIRE(visited.size() == table.size());
+
+  table.clear();
+  REQUIRE(table.empty());
+  REQUIRE(table.find(U'€') == nullptr);
+}
+
+// Per-lookup cost against the std::unordered_map tables the backends used
+// before. Hidden by default; run with: typr-io-unit-tests "[benchmark]"
+TEST_CASE("KeyTable - lookup microbenchmark", "[.][benchmark]") {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kRounds = 20000;
+
+  KeyTable<int, -1> flatKeys;
+  std::unordered_map<Key, int> hashedKeys;
+  for (std::size_t i = 1; i < kKeyCount; ++i) {
+    flatKeys.insert(static_cast<Key>(i), static_cast<int>(i));
+    hashedKeys.emplace(static_cast<Key>(i), static_cast<int>(i));
+  }
+
+  CodepointTable<CharKey> flatChars;
+  std::unordered_map<char32_t, CharKey> hashedChars;
+  const std::u32string text =
+      U"The quick brown fox jumps over the lazy dog. Ça coûte 5 €!";
+  for (char32_t cp : text) {
+    flatChars.insert(cp, {static_cast<int>(cp & 0xff), false});
+    hashedChars.emplace(cp, CharKey{static_cast<int>(cp & 0xff), false});
+  }
+
+  auto nsPerLookup = [](auto &&body, std::size_t perRound) {
+    auto t0 = Clock::now();
+    std::uint64_t sink = 0;
+    for (int r = 0; r < kRounds; ++r)
+      sink += body();
+    auto ns = std::chrono::duration<double, std::nano>(Clock::now() - t0);
+    volatile std::uint64_t keep = sink;
+    (void)keep;
+    return ns.count() / (static_cast<double>(kRounds) * perRound);
+  };
+
+  const std::size_t keys = kKeyCount - 1;
+  double flatKeyNs = nsPerLookup(
+      [&]() {
+        std::uint64_t s = 0;
+        for (std::size_t i = 1; i < kKeyCount; ++i)
+          s += static_cast<std::uint64_t>(flatKeys.find(static_cast<Key>(i)));
+        return s;
+      },
+      keys);
+  double hashKeyNs = nsPerLookup(
+      [&]() {
+        std::uint64_t s = 0;
+        for (std::size_t i = 1; i < kKeyCount; ++i)
+          s += static_cast<std::uint64_t>(
+              hashedKeys.find(static_cast<Key>(i))->second);
+        return s;
+      },
+      keys);
+  double flatCharNs = nsPerLookup(
+      [&]() {
+        std::uint64_t s = 0;
+        for (char32_t cp : text)
+          s += static_cast<std::uint64_t>(flatChars.find(cp)->code);
+        return s;
+      },
+      text.size());
+  double hashCharNs = nsPerLookup(
+      [&]() {
+        std::uint64_t s = 0;
+        for (char32_t cp : text)
+          s += static_cast<std::uint64_t>(hashedChars.find(cp)->second.code);
+        return s;
+      },
+      text.size());
+
+  std::printf("Key lookup:       flat %.2f ns, unordered_map %.2f ns\n",
+              flatKeyNs, hashKeyNs);
+  std::printf("Codepoint lookup: flat %.2f ns, unordered_map %.2f ns\n",
+              flatCharNs, hashCharNs);
+  SUCCEED();
+}
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cctype>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -291,6 +292,40 @@ TEST_CASE("keyToString returns expected canonical values",
   REQUIRE(keyToString(Key::Minus) == "-");
 }
 
+TEST_CASE("Aliased enumerators keep the first canonical name",
+          "[key_utils][canonical]") {
+  // Key::AsciiDEL is an alias of Key::Delete
+  REQUIRE(keyToString(Key::Delete) == "Delete");
+  REQUIRE(keyToStringView(Key::AsciiDEL) == "Delete");
+  REQUIRE(stringToKey(keyToString(Key::Delete)) == Key::Delete);
+  REQUIRE(stringToKey("DEL") == Key::Delete);
+}
+
+TEST_CASE("keyToStringView matches keyToString without allocating",
+          "[key_utils][canonical]") {
+  for (std::size_t i = 0; i < kKeyCount + 4; ++i) {
+    Key k = static_cast<Key>(i);
+    std::string_view view = keyToStringView(k);
+    REQUIRE(view == keyToString(k));
+    // Views point at static literals and are usable as C strings
+    REQUIRE(view.data()[view.size()] == '\0');
+  }
+  REQUIRE(keyToStringView(Key::Enter).data() ==
+          keyToStringView(Key::Enter).data());
+}
+
+TEST_CASE("stringToKey accepts non-null-terminated views",
+          "[key_utils][edge]") {
+  std::string_view buffer = "EscapeXYZ";
+  REQUIRE(stringToKey(buffer.substr(0, 6)) == Key::Escape);
+  REQUIRE(stringToKey(buffer.substr(0, 3)) == Key::Escape); // "Esc" alias
+  REQUIRE(stringToKey(std::string_view("\0", 1)) == Key::AsciiNUL);
+  // Exact-case aliases win over case-insensitive matches
+  REQUIRE(stringToKey("OE") == Key::OE);
+  REQUIRE(stringToKey("oe") == Key::oe);
+  REQUIRE(stringToKey("Oe") == Key::oe);
+}
+
 TEST_CASE("Modifier bit-ops and helpers", "[modifier]") {
   TYPR_IO_LOG_INFO("test_key_utils: modifier bit-ops start");
   Modifier m = Modifier::None;
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+#include "common/layout_table.hpp"
+
+using typr::io::Modifier;
+using typr::io::detail::LayoutCodepointTable;
+using typr::io::detail::utf16ToCodepoint;
+
+using Table = LayoutCodepointTable<8>;
+
+TEST_CASE("LayoutCodepointTable - modifier states", "[layout_table]") {
+  REQUIRE(Table::stateFor(Modifier::None) == 0);
+  REQUIRE(Table::stateFor(Modifier::Shift) == Table::kShift);
+  REQUIRE(Table::stateFor(Modifier::Ctrl | Modifier::Alt) ==
+          (Table::kCtrl | Table::kAlt));
+  REQUIRE(Table::stateFor(Modifier::Shift | Modifier::CapsLock) ==
+          (Table::kShift | Table::kCapsLock));
+  // Super never selects a layout level
+  REQUIRE(Table::stateFor(Modifier::Super) == 0);
+  REQUIRE(Table::stateFor(Modifier::Super | Modifier::Shift) == Table::kShift);
+}
+
+TEST_CASE("LayoutCodepointTable - build and find", "[layout_table]") {
+  Table table;
+  REQUIRE_FALSE(table.built());
+  REQUIRE(table.find(0, Modifier::None) == 0);
+
+  int calls = 0;
+  table.build([&](std::size_t key, unsigned state) -> char32_t {
+    ++calls;
+    if (key == 7)
+      return 0; // e.g. a dead key
+    const char32_t base = (state & Table::kShift) ? U'A' : U'a';
+    return static_cast<char32_t>(base + key);
+  });
+  REQUIRE(table.built());
+  REQUIRE(calls == static_cast<int>(8 * Table::kStates));
+
+  REQUIRE(table.find(0, Modifier::None) == U'a');
+  REQUIRE(table.find(2, Modifier::Shift) == U'C');
+  REQUIRE(table.find(2, Modifier::Shift | Modifier::Super) == U'C');
+  REQUIRE(table.find(7, Modifier::None) == 0);
+  REQUIRE(table.find(8, Modifier::None) == 0); // outside the table
+
+  table.clear();
+  REQUIRE_FALSE(table.built());
+  REQUIRE(table.find(0, Modifier::None) == 0);
+}
+
+TEST_CASE("utf16ToCodepoint - units and surrogates", "[layout_table]") {
+  const uint16_t bmp[] = {0x00E9};
+  REQUIRE(utf16ToCodepoint(bmp, 1) == U'é');
+  REQUIRE(utf16ToCodepoint(bmp, 0) == 0);
+
+  const uint16_t pair[] = {0xD83D, 0xDE00};
+  REQUIRE(utf16ToCodepoint(pair, 2) == U'\U0001F600');
+  // A lone high surrogate is not a character
+  const uint16_t broken[] = {0xD83D, 0x0041};
+  REQUIRE(utf16ToCodepoint(broken, 2) == 0);
+
+  // Only the first character of longer output is kept
+  const uint16_t several[] = {0x0061, 0x0062, 0x0063};
+  REQUIRE(utf16ToCodepoint(several, 3) == U'a');
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <typr-io/listener.hpp>
+
+using typr::io::Key;
+using typr::io::ListenerFilter;
+using typr::io::Modifier;
+
+TEST_CASE("ListenerFilter - default accepts everything", "[listener_filter]") {
+  const ListenerFilter f;
+  REQUIRE(f.acceptsAll());
+  REQUIRE(f.needCodepoint);
+  REQUIRE(f.wantsKey(Key::Unknown));
+  REQUIRE(f.acceptsKey(Key::A, true));
+  REQUIRE(f.acceptsKey(Key::RFKill, false));
+  REQUIRE(f.acceptsMods(Modifier::None));
+  REQUIRE(f.acceptsMods(Modifier::Ctrl | Modifier::Shift | Modifier::CapsLock));
+}
+
+TEST_CASE("ListenerFilter - key set", "[listener_filter]") {
+  ListenerFilter f;
+  f.addKey(Key::F9).addKey(Key::Escape);
+  REQUIRE_FALSE(f.acceptsAll());
+  REQUIRE(f.wantsKey(Key::F9));
+  REQUIRE(f.wantsKey(Key::Escape));
+  REQUIRE_FALSE(f.wantsKey(Key::A));
+  REQUIRE_FALSE(f.wantsKey(Key::Unknown));
+  REQUIRE(f.acceptsKey(Key::F9, true));
+  REQUIRE(f.acceptsKey(Key::F9, false));
+  REQUIRE_FALSE(f.acceptsKey(Key::F10, true));
+
+  // Out-of-range values are neither stored nor matched
+  f.addKey(static_cast<Key>(0xFFFF));
+  REQUIRE_FALSE(f.wantsKey(static_cast<Key>(0xFFFF)));
+}
+
+TEST_CASE("ListenerFilter - edges", "[listener_filter]") {
+  ListenerFilter f;
+  f.releases = false;
+  REQUIRE_FALSE(f.acceptsAll());
+  REQUIRE(f.acceptsKey(Key::A, true));
+  REQUIRE_FALSE(f.acceptsKey(Key::A, false));
+  REQUIRE(f.wantsKey(Key::A));
+
+  f.presses = false;
+  REQUIRE_FALSE(f.wantsKey(Key::A));
+  REQUIRE_FALSE(f.acceptsKey(Key::A, true));
+}
+
+TEST_CASE("ListenerFilter - modifiers", "[listener_filter]") {
+  ListenerFilter f;
+  f.requiredMods = Modifier::Ctrl | Modifier::Shift;
+  f.rejectedMods = Modifier::Alt;
+  REQUIRE_FALSE(f.acceptsAll());
+  REQUIRE(f.acceptsMods(Modifier::Ctrl | Modifier::Shift));
+  // Modifiers outside both masks do not matter
+  REQUIRE(f.acceptsMods(Modifier::Ctrl | Modifier::Shift | Modifier::CapsLock));
+  REQUIRE_FALSE(f.acceptsMods(Modifier::Ctrl));
+  REQUIRE_FALSE(f.acceptsMods(Modifier::Ctrl | Modifier::Shift | Modifier::Alt));
+
+  // Codepoint translation is independent of matching
+  f.needCodepoint = false;
+  REQUIRE(f.acceptsMods(Modifier::Ctrl | Modifier::Shift));
+}
@@ -0,0 +1,161 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "common/pacer.hpp"
+
+using namespace std::chrono_literals;
+using typr::io::detail::deadlineAfter;
+using typr::io::detail::PacerClock;
+using typr::io::detail::rateToInterval;
+using typr::io::detail::tapDeadlines;
+
+TEST_CASE("rateToInterval - disabled, regular and saturated rates",
+          "[pacer]") {
+  REQUIRE(rateToInterval(0.0) == 0ns);
+  REQUIRE(rateToInterval(-5.0) == 0ns);
+  REQUIRE(rateToInterval(std::nan("")) == 0ns);
+  REQUIRE(rateToInterval(-std::numeric_limits<double>::infinity()) == 0ns);
+
+  REQUIRE(rateToInterval(1000.0) == 1ms);
+  REQUIRE(rateToInterval(4.0) == 250ms);
+  REQUIRE(rateToInterval(std::numeric_limits<double>::infinity()) == 0ns);
+
+  // Rates too small for the nanosecond range saturate instead of overflowing
+  REQUIRE(rateToInterval(1e-12) == std::chrono::nanoseconds::max());
+  REQUIRE(rateToInterval(std::numeric_limits<double>::denorm_min()) ==
+          std::chrono::nanoseconds::max());
+}
+
+TEST_CASE("deadlineAfter - offsets and saturates at the clock's range",
+          "[pacer]") {
+  const auto now = PacerClock::now();
+  REQUIRE(deadlineAfter(now, 1500us) - now == 1500us);
+  REQUIRE(deadlineAfter(now, 0us) == now);
+  REQUIRE(deadlineAfter(now, -3ms) == now);
+
+  const auto max = PacerClock::time_point::max();
+  REQUIRE(deadlineAfter(now, std::chrono::microseconds::max()) == max);
+  REQUIRE(deadlineAfter(now, std::chrono::nanoseconds::max()) == max);
+  REQUIRE(deadlineAfter(now, std::chrono::hours::max()) == max);
+  REQUIRE(deadlineAfter(max - 1ns, 1s) == max);
+}
+
+TEST_CASE("tapDeadlines - evenly spaced presses and half-interval holds",
+          "[pacer]") {
+  const auto start = PacerClock::now();
+  const auto interval = rateToInterval(50.0); // 20 ms
+
+  for (uint32_t i = 0; i < 5; ++i) {
+    const auto edges = tapDeadlines(start, interval, i);
+    // Press i sits exactly i intervals after the start, measured from the
+    // same anchor rather than from the previous edge.
+    REQUIRE(edges.press - start == interval * i);
+    REQUIRE(edges.release - edges.press == 10ms);
+    if (i > 0) {
+      const auto previous = tapDeadlines(start, interval, i - 1);
+      REQUIRE(edges.press - previous.press == interval);
+      REQUIRE(edges.press - previous.release == 10ms);
+    }
+  }
+
+  // Odd intervals truncate the hold, never the press spacing
+  const auto odd = tapDeadlines(start, 3ns, 7);
+  REQUIRE(odd.press - start == 21ns);
+  REQUIRE(odd.release - odd.press == 1ns);
+
+  // A huge interval saturates instead of wrapping around
+  const auto max = PacerClock::time_point::max();
+  const auto huge = tapDeadlines(start, rateToInterval(1e-12), 3);
+  REQUIRE(huge.press == max);
+  REQUIRE(huge.release == max);
+  REQUIRE(tapDeadlines(start, rateToInterval(1e-12), 0).press == start);
+}
+
+TEST_CASE("Pacer - zero or negative interval never waits", "[pacer]") {
+  typr::io::detail::Pacer pacer;
+  const auto begin = PacerClock::now();
+  for (int i = 0; i < 1000; ++i)
+    pacer.wait();
+  pacer.setInterval(-5ms);
+  for (int i = 0; i < 1000; ++i)
+    pacer.wait();
+  REQUIRE(PacerClock::now() - begin < 50ms);
+}
+
+TEST_CASE("Pacer - N waits do not accumulate drift", "[pacer]") {
+  constexpr int kWaits = 50;
+  typr::io::detail::Pacer pacer;
+  pacer.setInterval(2ms);
+  REQUIRE(pacer.interval() == 2ms);
+
+  const auto begin = PacerClock::now();
+  for (int i = 0; i < kWaits; ++i)
+    pacer.wait();
+  const auto elapsed = PacerClock::now() - begin;
+
+  // Deadlines are absolute, so the total tracks N intervals instead of
+  // N * (interval + wake-up latency). The upper bound is generous to stay
+  // stable on loaded CI machines.
+  REQUIRE(elapsed >= kWaits * 2ms);
+  REQUIRE(elapsed < kWaits * 2ms + 40ms);
+}
+
+TEST_CASE("Pacer - re-anchors after falling behind instead of bursting",
+          "[pacer]") {
+  typr::io::detail::Pacer pacer;
+  pacer.setInterval(10ms);
+  pacer.wait();
+
+  // Stay idle for several intervals; the missed deadlines must not be
+  // replayed back to back.
+  typr::io::detail::sleepUntil(PacerClock::now() + 50ms);
+  auto before = PacerClock::now();
+  pacer.wait();
+  REQUIRE(PacerClock::now() - before >= 10ms);
+
+  // reset() forgets the schedule the same way
+  pacer.reset();
+  before = PacerClock::now();
+  pacer.wait();
+  REQUIRE(PacerClock::now() - before >= 10ms);
+
+  // Falling behind by less than an interval keeps the schedule: the next
+  // deadline is still one interval after the previous one (~10 ms after the
+  // last return) rather than a fresh interval after the late call (~18 ms).
+  pacer.wait();
+  const auto onTime = PacerClock::now();
+  typr::io::detail::sleepUntil(onTime + 8ms);
+  pacer.wait();
+  const auto next = PacerClock::now() - onTime;
+  REQUIRE(next >= 8ms);
+  REQUIRE(next < 16ms);
+}
+
+TEST_CASE("Pacer - a saturated interval saturates the deadline", "[pacer]") {
+  typr::io::detail::Pacer pacer;
+  const auto max = PacerClock::time_point::max();
+
+  // A tiny typing rate saturates the interval; the schedule must follow it
+  // to time_point::max() instead of overflowing.
+  pacer.setInterval(rateToInterval(1e-12));
+  REQUIRE(pacer.interval() == std::chrono::nanoseconds::max());
+  REQUIRE(pacer.advance() == max);
+  REQUIRE(pacer.advance() == max);
+
+  // Back to a regular rate, the next deadline is one interval out again
+  pacer.setInterval(5ms);
+  const auto before = PacerClock::now();
+  const auto deadline = pacer.advance();
+  REQUIRE(deadline - before >= 5ms);
+  REQUIRE(deadline - before < 5ms + 20ms);
+  REQUIRE(pacer.advance() - deadline == 5ms);
+
+  // Disabled intervals never move the schedule ahead of now
+  pacer.setInterval(0ns);
+  const auto disabled = pacer.advance();
+  REQUIRE(disabled <= PacerClock::now());
+}
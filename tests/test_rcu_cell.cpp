@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "common/rcu_cell.hpp"
+
+using typr::io::detail::RcuCell;
+
+TEST_CASE("RcuCell - store, visit and reset", "[rcu_cell]") {
+  RcuCell<std::function<int(int)>> cell;
+  REQUIRE_FALSE(cell.hasValue());
+  REQUIRE_FALSE(cell.visit([](const auto &) { FAIL("no value expected"); }));
+
+  cell.store([](int v) { return v + 1; });
+  REQUIRE(cell.hasValue());
+  int result = 0;
+  REQUIRE(cell.visit([&](const auto &fn) { result = fn(41); }));
+  REQUIRE(result == 42);
+
+  cell.store([](int v) { return v * 2; });
+  REQUIRE(cell.visit([&](const auto &fn) { result = fn(21); }));
+  REQUIRE(result == 42);
+
+  cell.reset();
+  REQUIRE_FALSE(cell.hasValue());
+}
+
+TEST_CASE("RcuCell - readers never observe a freed value", "[rcu_cell]") {
+  // Each published value checks a canary on every read; a use-after-free
+  // shows up as a canary mismatch (and as an error under ASan / TSan).
+  constexpr unsigned kAlive = 0xA11CE;
+  struct Payload {
+    unsigned canary{kAlive};
+    int id{0};
+    explicit Payload(int i) : id(i) {}
+    Payload(Payload &&other) noexcept : id(other.id) {}
+    ~Payload() { canary = 0; }
+  };
+
+  RcuCell<Payload> cell;
+  cell.store(Payload(0));
+
+  std::atomic<bool> done{false};
+  std::atomic<bool> corrupted{false};
+  std::atomic<long> reads{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&]() {
+      while (!done.load(std::memory_order_relaxed)) {
+        cell.visit([&](const Payload &p) {
+          if (p.canary != kAlive)
+            corrupted.store(true);
+        });
+        reads.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  while (reads.load() == 0)
+    std::this_thread::yield();
+  for (int i = 1; i <= 2000; ++i) {
+    if (i % 7 == 0)
+      cell.reset();
+    else
+      cell.store(Payload(i));
+  }
+  done.store(true);
+  for (auto &t : readers)
+    t.join();
+
+  REQUIRE_FALSE(corrupted.load());
+  REQUIRE(reads.load() > 0);
+}
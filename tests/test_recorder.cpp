@@ -0,0 +1,226 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <typr-io/hotkey.hpp>
+#include <typr-io/recorder.hpp>
+
+#include "common/stats_recorder.hpp"
+#include "common/varint.hpp"
+
+using typr::io::Key;
+using typr::io::Listener;
+using typr::io::Modifier;
+using typr::io::Recorder;
+using typr::io::RecordingReader;
+
+namespace {
+
+Listener::Event makeEvent(Key key, char32_t cp, Modifier mods, bool pressed,
+                          uint64_t timestampNs) {
+  Listener::Event e;
+  e.key = key;
+  e.codepoint = cp;
+  e.mods = mods;
+  e.pressed = pressed;
+  e.timestampNs = timestampNs;
+  return e;
+}
+
+} // namespace
+
+TEST_CASE("varint - roundtrip and truncation", "[recorder]") {
+  using namespace typr::io::detail;
+  const uint64_t values[] = {0,       1,          127,        128,
+                             300,     16383,      16384,      0x10FFFF * 2 + 1,
+                             1u << 31, UINT64_MAX};
+  for (uint64_t v : values) {
+    uint8_t buf[kMaxVarintBytes];
+    const std::size_t n = encodeVarint(v, buf);
+    REQUIRE(n >= 1);
+    REQUIRE(n <= kMaxVarintBytes);
+    uint64_t decoded = 0;
+    REQUIRE(decodeVarint(buf, n, decoded) == n);
+    REQUIRE(decoded == v);
+    if (n > 1)
+      REQUIRE(decodeVarint(buf, n - 1, decoded) == 0);
+  }
+
+  uint8_t small[kMaxVarintBytes];
+  REQUIRE(encodeVarint(100, small) == 1);
+  REQUIRE(encodeVarint(1000, small) == 2);
+}
+
+TEST_CASE("Recorder - events roundtrip through the binary log",
+          "[recorder]") {
+  std::stringstream log;
+  std::vector<Listener::Event> input = {
+      makeEvent(Key::A, U'a', Modifier::None, true, 0),
+      makeEvent(Key::A, U'a', Modifier::None, false, 0),
+      makeEvent(Key::ShiftLeft, 0, Modifier::Shift, true, 0),
+      makeEvent(Key::Unknown, U'€', Modifier::Shift | Modifier::Alt, true, 0),
+      makeEvent(Key::ShiftLeft, 0, Modifier::None, false, 0),
+  };
+
+  {
+    Recorder recorder(log, 16);
+    // Stamp relative to "now" so the deltas between events are known
+    const uint64_t t0 = typr::io::detail::steadyNowNs();
+    const uint64_t offsetsUs[] = {1000, 1500, 250000, 250010, 300000};
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      input[i].timestampNs = t0 + offsetsUs[i] * 1000;
+      recorder.record(input[i]);
+    }
+    recorder.stop();
+    REQUIRE(recorder.recordedEvents() == input.size());
+    REQUIRE(recorder.droppedEvents() == 0);
+
+    // After stop() everything is dropped, not written
+    recorder.record(input[0]);
+    REQUIRE(recorder.droppedEvents() == 1);
+  }
+
+  const std::string bytes = log.str();
+  REQUIRE(bytes.compare(0, 7, "TYPRREC") == 0);
+  REQUIRE(static_cast<uint8_t>(bytes[7]) == 1);
+  // Compact: a handful of bytes per event after the header
+  REQUIRE(bytes.size() - 8 <= input.size() * 8);
+
+  RecordingReader reader(log);
+  REQUIRE(reader.valid());
+  std::vector<Listener::Event> output;
+  while (auto e = reader.next())
+    output.push_back(*e);
+  REQUIRE(reader.valid());
+  REQUIRE(output.size() == input.size());
+
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    REQUIRE(output[i].key == input[i].key);
+    REQUIRE(output[i].codepoint == input[i].codepoint);
+    REQUIRE(output[i].mods == input[i].mods);
+    REQUIRE(output[i].pressed == input[i].pressed);
+  }
+  // Relative timing survives at microsecond resolution
+  REQUIRE(output[1].timestampNs - output[0].timestampNs == 500'000);
+  REQUIRE(output[2].timestampNs - output[1].timestampNs == 248'500'000);
+  REQUIRE(output[3].timestampNs - output[2].timestampNs == 10'000);
+  REQUIRE(output[4].timestampNs - output[3].timestampNs == 49'990'000);
+}
+
+TEST_CASE("Recorder - full ring drops instead of blocking", "[recorder]") {
+  std::stringstream log;
+  Recorder recorder(log, 4);
+  const auto e = makeEvent(Key::B, U'b', Modifier::None, true, 0);
+  for (int i = 0; i < 10000; ++i)
+    recorder.record(e);
+  recorder.stop();
+  REQUIRE(recorder.recordedEvents() + recorder.droppedEvents() == 10000);
+
+  RecordingReader reader(log);
+  uint64_t count = 0;
+  while (reader.next())
+    ++count;
+  REQUIRE(reader.valid());
+  REQUIRE(count == recorder.recordedEvents());
+}
+
+TEST_CASE("Recorder - events racing stop() are written or dropped",
+          "[recorder]") {
+  for (int round = 0; round < 20; ++round) {
+    std::stringstream log;
+    Recorder recorder(log, 64);
+    const auto e = makeEvent(Key::D, U'd', Modifier::None, true, 0);
+    std::atomic<bool> started{false};
+    std::thread producer([&]() {
+      for (int i = 0; i < 2000; ++i) {
+        recorder.record(e);
+        started.store(true, std::memory_order_release);
+      }
+    });
+    while (!started.load(std::memory_order_acquire))
+      std::this_thread::yield();
+    recorder.stop();
+    producer.join();
+    REQUIRE(recorder.recordedEvents() + recorder.droppedEvents() == 2000);
+
+    // Every event counted as recorded made it into the stream
+    RecordingReader reader(log);
+    uint64_t count = 0;
+    while (reader.next())
+      ++count;
+    REQUIRE(reader.valid());
+    REQUIRE(count == recorder.recordedEvents());
+  }
+}
+
+TEST_CASE("RecordingReader - rejects bad headers and truncated records",
+          "[recorder]") {
+  SECTION("wrong magic") {
+    std::stringstream log("NOTAREC\x01");
+    RecordingReader reader(log);
+    REQUIRE_FALSE(reader.valid());
+    REQUIRE_FALSE(reader.next().has_value());
+  }
+
+  SECTION("unknown version") {
+    std::stringstream log(std::string("TYPRREC\x02", 8));
+    RecordingReader reader(log);
+    REQUIRE_FALSE(reader.valid());
+  }
+
+  SECTION("empty recording") {
+    std::stringstream log(std::string("TYPRREC\x01", 8));
+    RecordingReader reader(log);
+    REQUIRE(reader.valid());
+    REQUIRE_FALSE(reader.next().has_value());
+    REQUIRE(reader.valid());
+  }
+
+  SECTION("truncated record") {
+    std::stringstream full;
+    {
+      Recorder recorder(full);
+      recorder.record(makeEvent(Key::C, U'c', Modifier::None, true, 0));
+      recorder.record(makeEvent(Key::C, U'c', Modifier::None, false, 0));
+    }
+    std::string bytes = full.str();
+    bytes.pop_back();
+    std::stringstream log(bytes);
+    RecordingReader reader(log);
+    REQUIRE(reader.next().has_value());
+    REQUIRE_FALSE(reader.next().has_value());
+    REQUIRE_FALSE(reader.valid());
+  }
+}
+
+TEST_CASE("Single-consumer delivery refuses parallel callbacks",
+          "[recorder][listener]") {
+  typr::io::ListenerOptions options;
+  options.seats = {"seat0", "seat1"};
+  options.parallelCallbacks = true;
+  Listener parallel(options);
+#if defined(__linux__)
+  REQUIRE(parallel.concurrentCallbacks());
+#endif
+  if (parallel.concurrentCallbacks()) {
+    std::stringstream log;
+    Recorder recorder(log);
+    typr::io::HotkeyMatcher hotkeys;
+    REQUIRE_FALSE(parallel.startQueued(16));
+    REQUIRE_FALSE(recorder.attach(parallel));
+    REQUIRE_FALSE(hotkeys.attach(parallel));
+    REQUIRE_FALSE(parallel.isListening());
+  }
+
+  // Serialized delivery (the default) and a single worker are fine
+  options.parallelCallbacks = false;
+  REQUIRE_FALSE(Listener(options).concurrentCallbacks());
+  options.parallelCallbacks = true;
+  options.seats = {"seat0"};
+  REQUIRE_FALSE(Listener(options).concurrentCallbacks());
+}
@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "common/spsc_ring.hpp"
+
+using typr::io::detail::SpscRing;
+
+TEST_CASE("SpscRing - capacity, full and bulk pop", "[spsc_ring]") {
+  SpscRing<int> ring(5);
+  REQUIRE(ring.capacity() == 8);
+
+  for (int i = 0; i < 8; ++i)
+    REQUIRE(ring.tryPush(i));
+  REQUIRE_FALSE(ring.tryPush(99));
+  REQUIRE(ring.size() == 8);
+
+  int out[16] = {};
+  REQUIRE(ring.popBulk(out, 3) == 3);
+  REQUIRE(out[0] == 0);
+  REQUIRE(out[2] == 2);
+
+  // Wrap around the end of the buffer
+  REQUIRE(ring.tryPush(8));
+  REQUIRE(ring.tryPush(9));
+  REQUIRE(ring.popBulk(out, 16) == 7);
+  for (int i = 0; i < 7; ++i)
+    REQUIRE(out[i] == i + 3);
+  REQUIRE(ring.popBulk(out, 16) == 0);
+  REQUIRE(ring.size() == 0);
+}
+
+TEST_CASE("SpscRing - ordered hand-off between threads", "[spsc_ring]") {
+  constexpr uint32_t kCount = 200000;
+  SpscRing<uint32_t> ring(256);
+
+  std::thread producer([&]() {
+    for (uint32_t i = 0; i < kCount;) {
+      if (ring.tryPush(i))
+        ++i;
+      else
+        std::this_thread::yield();
+    }
+  });
+
+  std::vector<uint32_t> batch(64);
+  uint32_t expected = 0;
+  bool ordered = true;
+  while (expected < kCount) {
+    std::size_t n = ring.popBulk(batch.data(), batch.size());
+    for (std::size_t i = 0; i < n; ++i)
+      ordered = ordered && batch[i] == expected++;
+    if (n == 0)
+      std::this_thread::yield();
+  }
+  producer.join();
+
+  REQUIRE(ordered);
+  REQUIRE(ring.size() == 0);
+}
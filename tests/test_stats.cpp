@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <typr-io/listener.hpp>
+#include <typr-io/stats.hpp>
+
+#include "common/stats_recorder.hpp"
+
+using typr::io::LatencyHistogram;
+using typr::io::detail::AtomicHistogram;
+using typr::io::detail::ListenerStatsRecorder;
+using typr::io::detail::SenderStatsRecorder;
+
+TEST_CASE("LatencyHistogram - bucket boundaries", "[stats]") {
+  STATIC_REQUIRE(LatencyHistogram::bucketFor(0) == 0);
+  STATIC_REQUIRE(LatencyHistogram::bucketFor(1) == 0);
+  STATIC_REQUIRE(LatencyHistogram::bucketFor(2) == 1);
+  STATIC_REQUIRE(LatencyHistogram::bucketFor(3) == 1);
+  STATIC_REQUIRE(LatencyHistogram::bucketFor(1024) == 10);
+  STATIC_REQUIRE(LatencyHistogram::bucketFor(UINT64_MAX) ==
+                 LatencyHistogram::kBuckets - 1);
+  STATIC_REQUIRE(LatencyHistogram::bucketUpperNs(10) == 2048);
+}
+
+TEST_CASE("LatencyHistogram - mean and percentiles", "[stats]") {
+  LatencyHistogram empty;
+  REQUIRE(empty.meanNs() == 0.0);
+  REQUIRE(empty.percentileNs(50) == 0);
+
+  AtomicHistogram recorder;
+  for (int i = 0; i < 99; ++i)
+    recorder.record(1000); // bucket [512, 1024)
+  recorder.record(1000000);
+
+  LatencyHistogram h = recorder.snapshot();
+  REQUIRE(h.count == 100);
+  REQUIRE(h.maxNs == 1000000);
+  REQUIRE(h.totalNs == 99 * 1000 + 1000000);
+  REQUIRE(h.meanNs() == static_cast<double>(h.totalNs) / 100.0);
+  REQUIRE(h.percentileNs(50) == 1024);
+  REQUIRE(h.percentileNs(99) == 1024);
+  REQUIRE(h.percentileNs(100) == 1000000); // clamped to the max
+  REQUIRE(h.percentileNs(-5) == 1024);
+
+  recorder.reset();
+  REQUIRE(recorder.snapshot().count == 0);
+}
+
+TEST_CASE("AtomicHistogram - concurrent recording", "[stats]") {
+  AtomicHistogram recorder;
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 10000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t)
+    threads.emplace_back([&recorder, t]() {
+      for (int i = 0; i < kPerThread; ++i)
+        recorder.record(static_cast<uint64_t>(t * kPerThread + i));
+    });
+  for (auto &th : threads)
+    th.join();
+
+  LatencyHistogram h = recorder.snapshot();
+  REQUIRE(h.count == kThreads * kPerThread);
+  REQUIRE(h.maxNs == kThreads * kPerThread - 1);
+  uint64_t sum = 0;
+  for (uint64_t b : h.buckets)
+    sum += b;
+  REQUIRE(sum == h.count);
+}
+
+TEST_CASE("ListenerStatsRecorder - timed delivery", "[stats]") {
+  ListenerStatsRecorder recorder;
+  REQUIRE(recorder.snapshot(0).uptimeNs == 0);
+
+  recorder.reset();
+  int delivered = 0;
+  const uint64_t eventNs = typr::io::detail::steadyNowNs();
+  recorder.timed(eventNs, [&]() { ++delivered; });
+  recorder.timed(eventNs + 1000000000u, [&]() { ++delivered; }); // future
+
+  typr::io::ListenerStats s = recorder.snapshot(7);
+  REQUIRE(delivered == 2);
+  REQUIRE(s.events == 2);
+  REQUIRE(s.droppedEvents == 7);
+  REQUIRE(s.uptimeNs > 0);
+  REQUIRE(s.eventsPerSecond > 0.0);
+  REQUIRE(s.hookLatency.count == 2);
+  REQUIRE(s.callbackDuration.count == 2);
+  // Timestamps ahead of now are clamped rather than wrapping around
+  REQUIRE(s.hookLatency.maxNs < 1000000000u);
+}
+
+TEST_CASE("SenderStatsRecorder - counts calls and failures", "[stats]") {
+  SenderStatsRecorder recorder;
+  REQUIRE(recorder.timed(3, []() { return true; }));
+  REQUIRE_FALSE(recorder.timed(2, []() { return false; }));
+
+  typr::io::SenderStats s = recorder.snapshot();
+  REQUIRE(s.injectCalls == 2);
+  REQUIRE(s.injectedEvents == 5);
+  REQUIRE(s.failedCalls == 1);
+  REQUIRE(s.lastInjectNs != 0);
+  REQUIRE(s.injectDuration.count == 2);
+}
+
+TEST_CASE("nativeToSteadyNs - carries event age over", "[stats]") {
+  using typr::io::detail::nativeToSteadyNs;
+  using typr::io::detail::steadyNowNs;
+
+  const uint64_t before = steadyNowNs();
+  const uint64_t ts = nativeToSteadyNs(5000, 5000 + 1000000);
+  const uint64_t after = steadyNowNs();
+  REQUIRE(ts + 1000000 >= before);
+  REQUIRE(ts + 1000000 <= after);
+
+  // Event stamped "after" now is clamped to now
+  REQUIRE(nativeToSteadyNs(10, 5) >= before);
+}
+
+TEST_CASE("Listener - stats before start", "[stats]") {
+  typr::io::Listener listener;
+  typr::io::ListenerStats s = listener.stats();
+  REQUIRE(s.events == 0);
+  REQUIRE(s.droppedEvents == 0);
+  REQUIRE(s.hookLatency.count == 0);
+}
@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "common/utf8.hpp"
+
+using typr::io::detail::utf32ToUtf16;
+using typr::io::detail::utf8ToUtf16;
+using typr::io::detail::utf8ToUtf32;
+using typr::io::detail::Utf8Errors;
+
+TEST_CASE("utf8ToUtf32 - well-formed input", "[utf8]") {
+  REQUIRE(utf8ToUtf32("").empty());
+  REQUIRE(utf8ToUtf32("abc") == U"abc");
+  REQUIRE(utf8ToUtf32("Ça coûte 5 € — Жук 🙂") == U"Ça coûte 5 € — Жук 🙂");
+  REQUIRE(utf8ToUtf32(std::string("a\0b", 3)) == std::u32string(U"a\0b", 3));
+}
+
+TEST_CASE("utf8 - ASCII runs across vector block boundaries", "[utf8]") {
+  // Place a multi-byte character at every offset of a long ASCII run so each
+  // vector width sees full blocks, partial blocks and a non-ASCII byte in
+  // every lane
+  for (size_t offset = 0; offset < 80; ++offset) {
+    std::string text(offset, 'x');
+    text += "é";
+    text += std::string(70, 'y');
+    std::u32string expected(offset, U'x');
+    expected += U'é';
+    expected += std::u32string(70, U'y');
+
+    REQUIRE(utf8ToUtf32(text) == expected);
+    REQUIRE(utf8ToUtf16(text) == utf32ToUtf16(expected));
+  }
+}
+
+TEST_CASE("utf8ToUtf16 - surrogate pairs", "[utf8]") {
+  REQUIRE(utf8ToUtf16("a€🙂") == u"a€🙂");
+  const std::u16string units = utf8ToUtf16("\xF0\x9F\x99\x82");
+  REQUIRE(units.size() == 2);
+  REQUIRE(units[0] == 0xD83D);
+  REQUIRE(units[1] == 0xDE42);
+}
+
+TEST_CASE("utf8 - ill-formed input is replaced per maximal subpart",
+          "[utf8]") {
+  // Stray continuation byte
+  REQUIRE(utf8ToUtf32("a\x80z") == U"a�z");
+  // Lead bytes that never appear in UTF-8
+  REQUIRE(utf8ToUtf32("\xC0\xAF") == U"��");
+  REQUIRE(utf8ToUtf32("\xFF") == U"�");
+  // Overlong three-byte encoding of '/'
+  REQUIRE(utf8ToUtf32("\xE0\x80\xAF") == U"���");
+  // Encoded surrogate U+D800
+  REQUIRE(utf8ToUtf32("\xED\xA0\x80") == U"���");
+  // Above U+10FFFF
+  REQUIRE(utf8ToUtf32("\xF4\x90\x80\x80") ==
+          U"����");
+  // Truncated sequences form a single error and do not eat the next byte
+  REQUIRE(utf8ToUtf32("\xE2\x82z") == U"�z");
+  REQUIRE(utf8ToUtf32("\xF0\x9F\x99") == U"�");
+  REQUIRE(utf8ToUtf16("x\xE2\x82") == u"x�");
+}
+
+TEST_CASE("utf8 - Skip drops ill-formed bytes", "[utf8]") {
+  REQUIRE(utf8ToUtf32("a\x80z", Utf8Errors::Skip) == U"az");
+  REQUIRE(utf8ToUtf32("\xE2\x82z\xED\xA0\x80!", Utf8Errors::Skip) == U"z!");
+  REQUIRE(utf8ToUtf16("\xF0\x9F\x99\x82\xF0", Utf8Errors::Skip) == u"🙂");
+}
+
+TEST_CASE("utf32ToUtf16 - skips non-scalar values", "[utf8]") {
+  const std::u32string text{U'a', 0xD800, U'🙂', 0x110000, U'b'};
+  REQUIRE(utf32ToUtf16(text) == u"a🙂b");
+}
@@ -0,0 +1,197 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+#include <xkbcommon/xkbcommon.h>
+
+#include "common/xkb_layout.hpp"
+
+using typr::io::Key;
+using typr::io::detail::XkbLayout;
+using typr::io::detail::XkbNames;
+
+namespace {
+
+std::string tempSnapshotPath() {
+  return "/tmp/typr-io-test-layout-" + std::to_string(getpid()) + ".bin";
+}
+
+XkbNames frenchNames() {
+  XkbNames names;
+  names.layout = "fr";
+  names.variant = "oss";
+  return names;
+}
+
+} // namespace
+
+TEST_CASE("XkbLayout - snapshot round trip", "[xkb_layout]") {
+  XkbLayout layout;
+  layout.names = frenchNames();
+  layout.keys.insert(Key::A, 16); // AZERTY: A sits on the Q position
+  layout.keys.insert(Key::Enter, 28);
+  layout.chars.insert(U'a', {16, false});
+  layout.chars.insert(U'A', {16, true});
+  layout.chars.insert(U'€', {18, false}); // sparse range (Euro sign)
+
+  const std::string path = tempSnapshotPath();
+  REQUIRE(typr::io::detail::saveXkbLayoutSnapshot(layout, path));
+
+  auto loaded = typr::io::detail::loadXkbLayoutSnapshot(path, frenchNames());
+  REQUIRE(loaded);
+  REQUIRE(loaded->keymap == nullptr);
+  REQUIRE(loaded->names == frenchNames());
+  REQUIRE(loaded->keys.size() == 2);
+  REQUIRE(loaded->keys.find(Key::A) == 16);
+  REQUIRE(loaded->keys.find(Key::Enter) == 28);
+  // The keycode table is rebuilt from the stored keys
+  REQUIRE(loaded->codes.size() == 2);
+  REQUIRE(loaded->codes.find(16) == Key::A);
+  REQUIRE(loaded->codes.find(28) == Key::Enter);
+  REQUIRE(loaded->chars.size() == 3);
+  REQUIRE(loaded->chars.find(U'A')->code == 16);
+  REQUIRE(loaded->chars.find(U'A')->shift);
+  REQUIRE_FALSE(loaded->chars.find(U'a')->shift);
+  REQUIRE(loaded->chars.find(U'€')->code == 18);
+
+  // A snapshot for other names is never used
+  XkbNames other = frenchNames();
+  other.variant.clear();
+  REQUIRE_FALSE(typr::io::detail::loadXkbLayoutSnapshot(path, other));
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("XkbLayout - malformed snapshots are rejected", "[xkb_layout]") {
+  const std::string path = tempSnapshotPath();
+  REQUIRE_FALSE(typr::io::detail::loadXkbLayoutSnapshot(path, frenchNames()));
+
+  XkbLayout layout;
+  layout.names = frenchNames();
+  layout.chars.insert(U'a', {16, false});
+  REQUIRE(typr::io::detail::saveXkbLayoutSnapshot(layout, path));
+
+  // Truncate the file: the size no longer matches the header
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 4));
+  }
+  REQUIRE_FALSE(typr::io::detail::loadXkbLayoutSnapshot(path, frenchNames()));
+
+  // Not a snapshot at all
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "definitely not a layout snapshot";
+  }
+  REQUIRE_FALSE(typr::io::detail::loadXkbLayoutSnapshot(path, frenchNames()));
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("XkbLayout - cache shares one layout per names", "[xkb_layout]") {
+  typr::io::detail::clearXkbLayoutCache();
+  XkbNames names = frenchNames();
+
+  auto first = typr::io::detail::acquireXkbLayout(names, false);
+  auto second = typr::io::detail::acquireXkbLayout(names, false);
+  REQUIRE(first);
+  REQUIRE(first.get() == second.get());
+  // The layout-independent keys are always available
+  REQUIRE(first->keys.contains(Key::ShiftLeft));
+  REQUIRE(first->keys.contains(Key::F12));
+  // ... in both directions
+  REQUIRE(first->codes.find(static_cast<std::size_t>(
+              first->keys.find(Key::ShiftLeft))) == Key::ShiftLeft);
+  REQUIRE(first->codes.find(static_cast<std::size_t>(
+              first->keys.find(Key::NumpadEnter))) == Key::NumpadEnter);
+
+  names.variant = "latin9";
+  auto third = typr::io::detail::acquireXkbLayout(names, false);
+  REQUIRE(third.get() != first.get());
+
+  typr::io::detail::clearXkbLayoutCache();
+  auto fourth = typr::io::detail::acquireXkbLayout(frenchNames(), false);
+  REQUIRE(fourth.get() != first.get());
+  typr::io::detail::clearXkbLayoutCache();
+}
+
+TEST_CASE("XkbLayout - canonical modifier codes win over virtual keys",
+          "[xkb_layout]") {
+  typr::io::detail::clearXkbLayoutCache();
+  XkbNames names;
+  names.layout = "us";
+
+  // <LVL3> (evdev 84) also produces ISO_Level3_Shift and is scanned before
+  // the physical Right Alt key; the Sender must still press KEY_RIGHTALT.
+  auto layout = typr::io::detail::acquireXkbLayout(names, true);
+  REQUIRE(layout);
+  REQUIRE(layout->keys.find(Key::AltRight) == 100); // KEY_RIGHTALT
+  REQUIRE(layout->keys.find(Key::AltLeft) == 56);   // KEY_LEFTALT
+  REQUIRE(layout->keys.find(Key::Home) == 102);     // KEY_HOME, not KP_Home
+  REQUIRE(layout->codes.find(100) == Key::AltRight);
+  typr::io::detail::clearXkbLayoutCache();
+}
+
+TEST_CASE("XkbModMasks - serialized mask to Modifier", "[xkb_layout]") {
+  using typr::io::Modifier;
+  typr::io::detail::XkbModMasks masks;
+  // Indices as in the usual evdev keymaps: Shift, Lock, Control, Mod1,
+  // Mod2 (NumLock), Mod4
+  masks.shift = 1u << 0;
+  masks.capsLock = 1u << 1;
+  masks.ctrl = 1u << 2;
+  masks.alt = 1u << 3;
+  masks.super = 1u << 6;
+
+  REQUIRE(masks.toModifier(0) == Modifier::None);
+  REQUIRE(masks.toModifier(1u << 0) == Modifier::Shift);
+  REQUIRE(masks.toModifier((1u << 2) | (1u << 3)) ==
+          (Modifier::Ctrl | Modifier::Alt));
+  REQUIRE(masks.toModifier((1u << 1) | (1u << 6)) ==
+          (Modifier::CapsLock | Modifier::Super));
+  // Bits the masks do not name (Mod2 here) are ignored
+  REQUIRE(masks.toModifier(1u << 4) == Modifier::None);
+
+  // A modifier missing from the keymap never matches
+  typr::io::detail::XkbModMasks none;
+  REQUIRE(none.toModifier(0xFFFFFFFFu) == Modifier::None);
+}
+
+TEST_CASE("keysymToKey - one translation for every table", "[xkb_layout]") {
+  using typr::io::detail::keysymToKey;
+  REQUIRE(keysymToKey(XKB_KEY_a) == Key::A);
+  REQUIRE(keysymToKey(XKB_KEY_Z) == Key::Z);
+  REQUIRE(keysymToKey(XKB_KEY_7) == Key::Num7);
+  REQUIRE(keysymToKey(XKB_KEY_F11) == Key::F11);
+  REQUIRE(keysymToKey(XKB_KEY_KP_0) == Key::Numpad0);
+  REQUIRE(keysymToKey(XKB_KEY_KP_9) == Key::Numpad9);
+  REQUIRE(keysymToKey(XKB_KEY_KP_Enter) == Key::NumpadEnter);
+  REQUIRE(keysymToKey(XKB_KEY_Return) == Key::Enter);
+  REQUIRE(keysymToKey(XKB_KEY_Shift_R) == Key::ShiftRight);
+  REQUIRE(keysymToKey(XKB_KEY_Super_L) == Key::SuperLeft);
+  REQUIRE(keysymToKey(XKB_KEY_bracketleft) == Key::LeftBracket);
+  REQUIRE(keysymToKey(XKB_KEY_grave) == Key::Grave);
+  REQUIRE(keysymToKey(XKB_KEY_NoSymbol) == Key::Unknown);
+}
+
+TEST_CASE("CodeKeyTable - first mapping wins, out of range is unknown",
+          "[xkb_layout]") {
+  typr::io::detail::CodeKeyTable<16> table;
+  REQUIRE(table.empty());
+  REQUIRE(table.insert(3, Key::A));
+  REQUIRE_FALSE(table.insert(3, Key::B));
+  REQUIRE_FALSE(table.insert(4, Key::Unknown));
+  REQUIRE_FALSE(table.insert(16, Key::C));
+  REQUIRE(table.size() == 1);
+  REQUIRE(table.find(3) == Key::A);
+  REQUIRE(table.find(4) == Key::Unknown);
+  REQUIRE(table.find(1000) == Key::Unknown);
+}